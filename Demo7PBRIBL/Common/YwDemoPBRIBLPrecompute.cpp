@@ -408,71 +408,10 @@ namespace yw
             return false;
         }
 
-        // Render constants.
+        // Map constants.
         const int32_t targetWidth = 512;
         const int32_t targetHeight = 512;
         const Yw3dFormat targetFormat = Yw3d_FMT_R32G32B32A32F;
-        const float fovy = YW_PI / 2.0f;
-        const float aspect = 1.0f;
-        const float ZNear = 0.1f;
-        const float zFar = 10.0f;
-        const uint32_t numVertices = 4;
-
-        // Create primitive data.
-
-        // Define vertex format.
-        struct VertexElement
-        {
-            Vector3 position;
-            Vector2 uv;
-        };
-
-        // Vertex element declaration.
-        Yw3dVertexElement VertexDeclaration[] =
-        {
-            YW3D_VERTEX_FORMAT_DECL(0, Yw3d_VET_Vector3, 0),
-            YW3D_VERTEX_FORMAT_DECL(0, Yw3d_VET_Vector2, 1)
-        };
-
-        // Create vertex format.
-        Yw3dVertexFormat* vertexFormat = nullptr;
-        if (YW3D_FAILED(device->CreateVertexFormat(&vertexFormat, VertexDeclaration, sizeof(VertexDeclaration))))
-        {
-            return false;
-        }
-
-        // Create vertex buffer.
-        Yw3dVertexBuffer* vertexBuffer = nullptr;
-        if (YW3D_FAILED(device->CreateVertexBuffer(&vertexBuffer, sizeof(VertexElement) * numVertices)))
-        {
-            return false;
-        }
-
-        // Get vertex buffer pointer.
-        VertexElement* vertexElement = nullptr;
-        if (YW3D_FAILED(vertexBuffer->GetPointer(0, (void**)&vertexElement)))
-        {
-            return false;
-        }
-
-        // NDC vertex position and texture coordinates.
-        vertexElement[0].position = Vector3(-1.0f, -1.0f, 0.0f);
-        vertexElement[0].uv = Vector2(1.0f / (float)targetWidth, 1.0f);
-        vertexElement[1].position = Vector3(-1.0f, 1.0f, 0.0f);
-        vertexElement[1].uv = Vector2(1.0f / (float)targetWidth, 0.0f);
-        vertexElement[2].position = Vector3(1.0f, -1.0f, 0.0f);
-        vertexElement[2].uv = Vector2(1.0f, 1.0f);
-        vertexElement[3].position = Vector3(1.0f, 1.0f, 0.0f);
-        vertexElement[3].uv = Vector2(1.0f, 0.0f);
-
-        // Create render target and render texture.
-
-        // Create a temp render target.
-        Yw3dRenderTarget* rtBRDFMap = nullptr;
-        if (YW3D_FAILED(device->CreateRenderTarget(&rtBRDFMap, targetWidth, targetHeight, targetFormat, Yw3d_FMT_R32F, Yw3d_FMT_R32F)))
-        {
-            return false;
-        }
 
         // Create brdf texture, no need mipmap.
         YW_SAFE_RELEASE(*preintegrateBRDFTexture);
@@ -482,69 +421,23 @@ namespace yw
             return false;
         }
 
-        // Backup old viewport matrix.sss
-        const Matrix44* matViewportCurrentPointer;
-        device->GetViewportMatrix(matViewportCurrentPointer);
-        Matrix44 matViewportCurrent(*matViewportCurrentPointer);
-
-        // Set device viewport.
-        Matrix44 matViewportCubeMap;
-        Matrix44Viewport(matViewportCubeMap, 0, 0, targetWidth, targetHeight, 0.0f, 1.0f);
-        device->SetViewportMatrix(&matViewportCubeMap);
-
-        // Construct view matrices.
-        Camera* camera = graphics->GetCurrentCamera();
-        Matrix44 matViews; // = graphics->GetCurrentCamera()->GetViewMatrix();
-        Matrix44LookAtLH(matViews, Vector3(0.0f, 0.0f, -2.0f), Vector3(0.0f, 0.0f, 1.0f), Vector3(0.0f, 1.0f, 0.0f));
-
-        // Construct projection matrix.
-        Matrix44 matProjection;
-        Matrix44PerspectiveFovLH(matProjection, fovy, aspect, ZNear, zFar);
-
         // Create shader.
-        DemoPBRIBLPreintegrateBRDFMapVertexShader* preintegrateBRDFMapVertexShader = new DemoPBRIBLPreintegrateBRDFMapVertexShader();
-        DemoPBRIBLPreintegrateBRDFMapPixelShader* preintegrateBRDFMapPixelShader = new DemoPBRIBLPreintegrateBRDFMapPixelShader();
+        DemoPBRIBLPreintegrateBRDFMapComputeShader* preintegrateBRDFMapComputeShader = new DemoPBRIBLPreintegrateBRDFMapComputeShader();
 
-        // Set render target.
-        graphics->SetRenderTarget(rtBRDFMap);
-
-        // Set states.
-        graphics->SetRenderState(Yw3d_RS_CullMode, Yw3d_Cull_CCW); // Yw3d_Cull_CW
-        graphics->SetRenderState(Yw3d_RS_FillMode, Yw3d_Fill_Solid);
-
-        // Set primitive data.
-        // This non-persistent data should not be saved in "Graphics", because the data address will be invalid when leaving the stack of this function.
-        device->SetVertexFormat(vertexFormat);
-        device->SetVertexStream(0, vertexBuffer, 0, sizeof(VertexElement));
-
-        // Set vertex and pixel shader.
-        device->SetVertexShader(preintegrateBRDFMapVertexShader);
-        device->SetPixelShader(preintegrateBRDFMapPixelShader);
+        // Write the texels straight into the texture, no render target, primitive or copy is needed.
+        Yw3dSurface* brdfSurface = (*preintegrateBRDFTexture)->AcquireMipLevel(0);
+        device->SetComputeShader(preintegrateBRDFMapComputeShader);
+        device->SetComputeSurface(0, brdfSurface);
 
-        // Render to target and copy to cube face.
-        device->Clear(nullptr, Vector4(0.0f, 0.0f, 0.0f, 1.0f), 1.0f, 0);
+        // One thread per texel with the default thread group size of 8 x 8 x 1.
+        const bool dispatched = YW3D_SUCCESSFUL(device->Dispatch(targetWidth / 8, targetHeight / 8, 1));
 
-        // NDC vertices, no need transforms.
+        // Unbind and release temp resources.
+        device->SetComputeSurface(0, nullptr);
+        device->SetComputeShader(nullptr);
+        YW_SAFE_RELEASE(brdfSurface);
+        YW_SAFE_RELEASE(preintegrateBRDFMapComputeShader);
 
-        // Render Quad.
-        device->DrawPrimitive(Yw3d_PT_TriangleStrip, 0, 2);
-
-        // Copy pixels from render target to cube face.
-        Yw3dSurface* srcSurface = rtBRDFMap->AcquireColorBuffer();
-        Yw3dSurface* dstSurface = (*preintegrateBRDFTexture)->AcquireMipLevel(0);
-        srcSurface->CopyToSurface(nullptr, dstSurface, nullptr, Yw3d_TF_Linear);
-        YW_SAFE_RELEASE(dstSurface);
-        YW_SAFE_RELEASE(srcSurface);
-
-        // Recovery viewport.
-        device->SetViewportMatrix(&matViewportCurrent);
-
-        YW_SAFE_RELEASE(vertexFormat);
-        YW_SAFE_RELEASE(vertexBuffer);
-        YW_SAFE_RELEASE(rtBRDFMap);
-        YW_SAFE_RELEASE(preintegrateBRDFMapVertexShader);
-        YW_SAFE_RELEASE(preintegrateBRDFMapPixelShader);
-
-        return true;
+        return dispatched;
     }
 }
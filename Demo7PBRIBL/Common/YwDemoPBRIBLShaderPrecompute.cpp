@@ -224,45 +224,18 @@ namespace yw
     // ------------------------------------------------------------------
     // Pre-integrate brdf map shader.
 
-    // Pre-integrate brdf map vertex shader.
+    // Pre-integrate brdf map compute shader.
 
-    void DemoPBRIBLPreintegrateBRDFMapVertexShader::Execute(const Yw3dShaderRegister* vsShaderInput, float4& position, Yw3dShaderRegister* vsShaderOutput)
+    void DemoPBRIBLPreintegrateBRDFMapComputeShader::Execute(const Yw3dComputeThreadId& threadId)
     {
-        // The NDC vertex position.
-        position = float4(vsShaderInput[0], 1.0f);
-
-        // Vertex texcoord.
-        vsShaderOutput[0] = vsShaderInput[1];
-    }
-
-    Yw3dShaderRegisterType DemoPBRIBLPreintegrateBRDFMapVertexShader::GetOutputRegisters(uint32_t shaderRegister)
-    {
-        switch (shaderRegister)
-        {
-        case 0:
-            return Yw3d_SRT_Vector2; // Vertex texcoord.
-        default:
-            return Yw3d_SRT_Unused;
-        }
-    }
-
-    // Pre-integrate brdf map pixel shader.
-
-    bool DemoPBRIBLPreintegrateBRDFMapPixelShader::MightKillPixels()
-    {
-        return false;
-    }
-
-    bool DemoPBRIBLPreintegrateBRDFMapPixelShader::Execute(const Yw3dShaderRegister* input, float4& color, float& depth)
-    {
-        float2 texCoords = input[0];
-        float2 integratedBRDF = IntegrateBRDF(texCoords.x, texCoords.y);
-        color = integratedBRDF;
-
-        return true;
+        // NdotV runs along x and starts at one texel to avoid the division by zero, roughness runs along y.
+        const float NdotV = (float)(threadId.dispatchX + 1) / (float)GetSurfaceWidth(0);
+        const float roughness = ((float)threadId.dispatchY + 0.5f) / (float)GetSurfaceHeight(0);
+        float2 integratedBRDF = IntegrateBRDF(NdotV, roughness);
+        StoreSurface(0, threadId.dispatchX, threadId.dispatchY, float4(integratedBRDF.x, integratedBRDF.y, 0.0f, 1.0f));
     }
 
-    float2 DemoPBRIBLPreintegrateBRDFMapPixelShader::IntegrateBRDF(float NdotV, float roughness)
+    float2 DemoPBRIBLPreintegrateBRDFMapComputeShader::IntegrateBRDF(float NdotV, float roughness)
     {
         float3 V;
         V.x = sqrt(1.0f - NdotV * NdotV);
@@ -90,27 +90,13 @@ namespace yw
     // ------------------------------------------------------------------
     // Pre-integrate brdf map shader.
 
-    // Pre-integrate brdf map vertex shader.
-    class DemoPBRIBLPreintegrateBRDFMapVertexShader : public IYw3dVertexShader
+    // Pre-integrate brdf map compute shader, writes one texel of the map bound to compute surface slot 0 per thread.
+    class DemoPBRIBLPreintegrateBRDFMapComputeShader : public IYw3dComputeShader, public DemoPBRIBLShaderCommon
     {
     protected:
         // Shader main entry.
-        void Execute(const Yw3dShaderRegister* vsShaderInput, Vector4& position, Yw3dShaderRegister* vsShaderOutput);
-
-        // Shader stream channel.
-        Yw3dShaderRegisterType GetOutputRegisters(uint32_t shaderRegister);
-    };
-
-    // Pre-integrate brdf map pixel shader.
-    class DemoPBRIBLPreintegrateBRDFMapPixelShader : public IYw3dPixelShader, public DemoPBRIBLShaderCommon
-    {
-    protected:
-        // Whether kill pixel or not.
-        bool MightKillPixels();
+        void Execute(const Yw3dComputeThreadId& threadId);
 
-        // Shader main entry.
-        bool Execute(const Yw3dShaderRegister* input, Vector4& color, float& depth);
-        
     private:
         // Calculating BRDF integration value for a given roughness and NdotV (one-pixel).
         Vector2 IntegrateBRDF(float NdotV, float roughness);
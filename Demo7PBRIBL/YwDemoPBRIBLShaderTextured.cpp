@@ -79,7 +79,7 @@ namespace yw
         );
 
         // Material properties.
-        const float3 albedo = pow(float3(tex2D(0, 3, texCoord)), 2.2f);
+        const float3 albedo = float3(tex2D(0, 3, texCoord)); // sRGB albedo map, decoded to linear by the sampler.
         const float3 worldNormal = normalize(UnpackScaleNormal(tex2D(0, 4, texCoord), 1.0f) * TBN);
         const float metallic = tex2D(0, 5, texCoord).r;
         const float roughness = tex2D(0, 6, texCoord).r;
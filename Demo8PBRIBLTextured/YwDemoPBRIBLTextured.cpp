@@ -140,6 +140,9 @@ namespace yw
         m_PBRIBLTexturedVertexShader = new DemoPBRIBLTexturedVertexShader();
         m_PBRIBLTexturedPixelShader = new DemoPBRIBLTexturedPixelShader();
 
+        // Material maps are shown from their coarsest mip-level while they are decoded in background.
+        resManager->SetProgressiveTextureLoading(true);
+
         // Load rusted iron assets.
         if (!LoadRustedIronResources())
         {
@@ -152,6 +155,8 @@ namespace yw
             return false;
         }
 
+        resManager->SetProgressiveTextureLoading(false);
+
         return true;
     }
 
@@ -182,7 +187,7 @@ namespace yw
         ResourceManager* resManager = GetScene()->GetApplication()->GetResourceManager();
 
         // Load and get rusted iron.
-        m_RustedIronAlbedoMapResource = ResourceHelper::LoadResource(resManager, "PBR/RustedIron/albedo.png");
+        m_RustedIronAlbedoMapResource = ResourceHelper::LoadResource(resManager, "PBR/RustedIron/albedo.png", true);
         if (nullptr == m_RustedIronAlbedoMapResource)
         {
             return false;
@@ -220,7 +225,7 @@ namespace yw
         ResourceManager* resManager = GetScene()->GetApplication()->GetResourceManager();
 
         // Load and get rusted iron.
-        m_AluminiumInsulatorAlbedoMapResource = ResourceHelper::LoadResource(resManager, "PBR/SubstancePainter/AluminiumInsulator/AI_BaseColor.png");
+        m_AluminiumInsulatorAlbedoMapResource = ResourceHelper::LoadResource(resManager, "PBR/SubstancePainter/AluminiumInsulator/AI_BaseColor.png", true);
         if (nullptr == m_AluminiumInsulatorAlbedoMapResource)
         {
             return false;
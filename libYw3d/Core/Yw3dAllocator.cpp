@@ -0,0 +1,266 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d memory allocator class.
+
+#include "Yw3dAllocator.h"
+#include <stdlib.h>
+
+#if defined(_WIN32) || defined(WIN32)
+    #include <windows.h>
+#elif defined(LINUX_X11) || defined(_LINUX)
+    #include <sys/mman.h>
+#endif
+
+namespace yw
+{
+    // Rounds a size up to a multiple of a power of two.
+    static inline size_t AlignSize(size_t bytes, size_t alignment)
+    {
+        return (bytes + alignment - 1) & ~(alignment - 1);
+    }
+
+    Yw3dAllocator::Yw3dAllocator() :
+        m_PoolBytes(0),
+        m_MaxPoolBytes(0),
+        m_UseHugePages(false)
+    {
+        m_FrameMarker.chunk = 0;
+        m_FrameMarker.offset = 0;
+    }
+
+    Yw3dAllocator::~Yw3dAllocator()
+    {
+        TrimPool();
+
+        for (size_t chunkIdx = 0; chunkIdx < m_FrameChunks.size(); chunkIdx++)
+        {
+            FreeSystem(m_FrameChunks[chunkIdx].data);
+        }
+    }
+
+    Yw3dResult Yw3dAllocator::Create(bool useHugePages, size_t maxPoolBytes)
+    {
+        m_UseHugePages = useHugePages;
+        m_MaxPoolBytes = maxPoolBytes;
+
+        return Yw3d_S_OK;
+    }
+
+    void* Yw3dAllocator::Allocate(size_t bytes)
+    {
+        if (0 == bytes)
+        {
+            return nullptr;
+        }
+
+        bytes = AlignSize(bytes, YW3D_ALLOCATION_ALIGNMENT);
+
+        // Reuse a pooled block of the same size.
+        {
+            std::lock_guard<std::mutex> lock(m_PoolMutex);
+            std::unordered_map<size_t, std::vector<void*>>::iterator itBlocks = m_Pool.find(bytes);
+            if ((itBlocks != m_Pool.end()) && !itBlocks->second.empty())
+            {
+                void* memory = itBlocks->second.back();
+                itBlocks->second.pop_back();
+                m_PoolBytes -= bytes;
+
+                return memory;
+            }
+        }
+
+        return AllocateSystem(bytes);
+    }
+
+    void Yw3dAllocator::Free(void* memory)
+    {
+        if (nullptr == memory)
+        {
+            return;
+        }
+
+        const size_t bytes = ((const BlockHeader*)memory - 1)->bytes;
+
+        {
+            std::lock_guard<std::mutex> lock(m_PoolMutex);
+            if (m_PoolBytes + bytes <= m_MaxPoolBytes)
+            {
+                m_Pool[bytes].push_back(memory);
+                m_PoolBytes += bytes;
+
+                return;
+            }
+        }
+
+        FreeSystem(memory);
+    }
+
+    void Yw3dAllocator::TrimPool()
+    {
+        std::lock_guard<std::mutex> lock(m_PoolMutex);
+        for (std::unordered_map<size_t, std::vector<void*>>::iterator itBlocks = m_Pool.begin(); itBlocks != m_Pool.end(); ++itBlocks)
+        {
+            for (size_t blockIdx = 0; blockIdx < itBlocks->second.size(); blockIdx++)
+            {
+                FreeSystem(itBlocks->second[blockIdx]);
+            }
+        }
+
+        m_Pool.clear();
+        m_PoolBytes = 0;
+    }
+
+    size_t Yw3dAllocator::GetPoolBytes() const
+    {
+        std::lock_guard<std::mutex> lock(m_PoolMutex);
+        return m_PoolBytes;
+    }
+
+    void* Yw3dAllocator::AllocateFrame(size_t bytes)
+    {
+        bytes = AlignSize((0 == bytes) ? 1 : bytes, YW3D_ALLOCATION_ALIGNMENT);
+
+        // Find a chunk with enough free space, chunks after the current one are empty.
+        while (m_FrameMarker.chunk < m_FrameChunks.size())
+        {
+            FrameChunk& curChunk = m_FrameChunks[m_FrameMarker.chunk];
+            if (m_FrameMarker.offset + bytes <= curChunk.bytes)
+            {
+                void* memory = curChunk.data + m_FrameMarker.offset;
+                m_FrameMarker.offset += bytes;
+
+                return memory;
+            }
+
+            m_FrameMarker.chunk++;
+            m_FrameMarker.offset = 0;
+        }
+
+        // Append a new chunk.
+        FrameChunk newChunk;
+        newChunk.bytes = (bytes > YW3D_FRAME_ARENA_CHUNK_SIZE) ? bytes : YW3D_FRAME_ARENA_CHUNK_SIZE;
+        newChunk.data = (uint8_t*)AllocateSystem(newChunk.bytes);
+        if (nullptr == newChunk.data)
+        {
+            return nullptr;
+        }
+
+        m_FrameChunks.push_back(newChunk);
+        m_FrameMarker.chunk = (uint32_t)m_FrameChunks.size() - 1;
+        m_FrameMarker.offset = bytes;
+
+        return newChunk.data;
+    }
+
+    Yw3dAllocator::FrameMarker Yw3dAllocator::GetFrameMarker() const
+    {
+        return m_FrameMarker;
+    }
+
+    void Yw3dAllocator::RewindFrame(const FrameMarker& marker)
+    {
+        m_FrameMarker = marker;
+    }
+
+    void Yw3dAllocator::ResetFrame()
+    {
+        m_FrameMarker.chunk = 0;
+        m_FrameMarker.offset = 0;
+
+        // A frame needed more than one chunk, replace them by a single chunk large enough for the next frame.
+        if (m_FrameChunks.size() > 1)
+        {
+            size_t totalBytes = 0;
+            for (size_t chunkIdx = 0; chunkIdx < m_FrameChunks.size(); chunkIdx++)
+            {
+                totalBytes += m_FrameChunks[chunkIdx].bytes;
+                FreeSystem(m_FrameChunks[chunkIdx].data);
+            }
+
+            m_FrameChunks.clear();
+
+            FrameChunk newChunk;
+            newChunk.bytes = totalBytes;
+            newChunk.data = (uint8_t*)AllocateSystem(newChunk.bytes);
+            if (nullptr != newChunk.data)
+            {
+                m_FrameChunks.push_back(newChunk);
+            }
+        }
+    }
+
+    void* Yw3dAllocator::AllocateSystem(size_t bytes)
+    {
+        void* systemMemory = nullptr;
+        size_t systemBytes = 0;
+        bool hugePages = false;
+
+        // Large blocks are backed by huge pages if enabled and granted, the block header takes the first cache line.
+        if (m_UseHugePages && (bytes >= YW3D_HUGE_PAGE_SIZE))
+        {
+        #if defined(_WIN32) || defined(WIN32)
+            // Requires the "Lock pages in memory" privilege.
+            const size_t largePageSize = GetLargePageMinimum();
+            if (0 != largePageSize)
+            {
+                systemBytes = AlignSize(bytes + YW3D_ALLOCATION_ALIGNMENT, largePageSize);
+                systemMemory = VirtualAlloc(nullptr, systemBytes, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+            }
+        #elif (defined(LINUX_X11) || defined(_LINUX)) && defined(MADV_HUGEPAGE)
+            // Transparent huge pages need the range to be aligned to the huge page size.
+            systemBytes = AlignSize(bytes + YW3D_ALLOCATION_ALIGNMENT, YW3D_HUGE_PAGE_SIZE);
+            if (0 == posix_memalign(&systemMemory, YW3D_HUGE_PAGE_SIZE, systemBytes))
+            {
+                madvise(systemMemory, systemBytes, MADV_HUGEPAGE);
+            }
+            else
+            {
+                systemMemory = nullptr;
+            }
+        #endif
+
+            hugePages = (nullptr != systemMemory);
+        }
+
+        uint8_t* memory = nullptr;
+        if (hugePages)
+        {
+            memory = (uint8_t*)systemMemory + YW3D_ALLOCATION_ALIGNMENT;
+        }
+        else
+        {
+            // Room for the header and the alignment.
+            systemBytes = bytes + sizeof(BlockHeader) + YW3D_ALLOCATION_ALIGNMENT - 1;
+            systemMemory = malloc(systemBytes);
+            if (nullptr == systemMemory)
+            {
+                return nullptr;
+            }
+
+            memory = (uint8_t*)AlignSize((size_t)systemMemory + sizeof(BlockHeader), YW3D_ALLOCATION_ALIGNMENT);
+        }
+
+        BlockHeader* header = (BlockHeader*)memory - 1;
+        header->bytes = bytes;
+        header->systemMemory = systemMemory;
+        header->systemBytes = systemBytes;
+        header->hugePages = hugePages;
+
+        return memory;
+    }
+
+    void Yw3dAllocator::FreeSystem(void* memory)
+    {
+        const BlockHeader* header = (const BlockHeader*)memory - 1;
+        if (!header->hugePages)
+        {
+            free(header->systemMemory);
+            return;
+        }
+
+    #if defined(_WIN32) || defined(WIN32)
+        VirtualFree(header->systemMemory, 0, MEM_RELEASE);
+    #else
+        free(header->systemMemory);
+    #endif
+    }
+}
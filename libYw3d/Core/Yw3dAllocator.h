@@ -0,0 +1,189 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d memory allocator class.
+
+#ifndef __YW_3D_ALLOCATOR_H__
+#define __YW_3D_ALLOCATOR_H__
+
+#include "Yw3dBase.h"
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+namespace yw
+{
+    // Alignment of all blocks returned by Yw3dAllocator, matches a cache line and the widest SIMD registers.
+    #define YW3D_ALLOCATION_ALIGNMENT 64
+
+    // Blocks of at least this size are backed by huge pages if enabled.
+    #define YW3D_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+    // Default size of a chunk of the frame arena.
+    #define YW3D_FRAME_ARENA_CHUNK_SIZE (256 * 1024)
+
+    // Frees a block of a Yw3dAllocator and resets the pointer.
+    #define YW3D_SAFE_FREE(allocator, p) {if (nullptr != (p)) {(allocator)->Free(p); (p) = nullptr;}}
+
+    // Yw3dAllocator provides the memory of surfaces, volumes, vertex- and index-buffers.
+    // Blocks are aligned to YW3D_ALLOCATION_ALIGNMENT bytes. Freed blocks are kept in a pool and reused by the next allocation of the same size, so creating and releasing resources of the same dimensions doesn't hit the heap.
+    // The allocator also owns a linear frame arena for transient allocations of the device, which is reset on every Present().
+    // The allocator is owned by Yw3dDevice, resources allocated from it keep a reference to their device so it outlives them.
+    class Yw3dAllocator
+    {
+    public:
+        // Position in the frame arena, returned by GetFrameMarker().
+        struct FrameMarker
+        {
+            // Index of the current chunk.
+            uint32_t chunk;
+
+            // Used bytes in the current chunk.
+            size_t offset;
+        };
+
+    public:
+        // Constructor.
+        Yw3dAllocator();
+
+        // Destructor, frees all pooled blocks and the frame arena. All blocks must have been freed before.
+        ~Yw3dAllocator();
+
+    public:
+        // Initializes the allocator.
+        // @param[in] useHugePages true to back large blocks with huge pages, falls back to normal pages if the system doesn't grant them.
+        // @param[in] maxPoolBytes maximum number of bytes kept in the pool, freed blocks exceeding it are returned to the system.
+        // @return Yw3d_S_OK if the function succeeds.
+        Yw3dResult Create(bool useHugePages, size_t maxPoolBytes = 256 * 1024 * 1024);
+
+        // Allocates an aligned block, a pooled block of the same size is reused if available. Thread safe.
+        // @param[in] bytes size of the block.
+        // @return the block, nullptr if out of memory.
+        void* Allocate(size_t bytes);
+
+        // Frees a block from Allocate(), it is kept in the pool for reuse. Thread safe.
+        // @param[in] memory the block, may be nullptr.
+        void Free(void* memory);
+
+        // Returns all pooled blocks to the system. Thread safe.
+        void TrimPool();
+
+        //< Returns the number of bytes kept in the pool.
+        size_t GetPoolBytes() const;
+
+        // Allocates an aligned block from the frame arena, it is valid until the frame arena is rewound or reset. Not thread safe.
+        // @param[in] bytes size of the block.
+        // @return the block, nullptr if out of memory.
+        void* AllocateFrame(size_t bytes);
+
+        //< Returns the current position in the frame arena.
+        FrameMarker GetFrameMarker() const;
+
+        // Frees all frame arena blocks allocated after a marker.
+        // @param[in] marker position in the frame arena returned by GetFrameMarker().
+        void RewindFrame(const FrameMarker& marker);
+
+        // Frees all frame arena blocks, called by the device at the end of a frame.
+        void ResetFrame();
+
+    private:
+        // Allocates a block from the system and fills its header.
+        // @param[in] bytes size of the block, a multiple of YW3D_ALLOCATION_ALIGNMENT.
+        // @return the aligned block, nullptr if out of memory.
+        void* AllocateSystem(size_t bytes);
+
+        // Returns a block from AllocateSystem() to the system.
+        void FreeSystem(void* memory);
+
+    private:
+        // Header in front of every block.
+        struct BlockHeader
+        {
+            // Size of the block, without the header.
+            size_t bytes;
+
+            // Start of the memory allocated from the system.
+            void* systemMemory;
+
+            // Size of the memory allocated from the system.
+            size_t systemBytes;
+
+            // True if the block is backed by huge pages.
+            bool hugePages;
+        };
+
+        // A chunk of the frame arena.
+        struct FrameChunk
+        {
+            // Start of the chunk.
+            uint8_t* data;
+
+            // Size of the chunk.
+            size_t bytes;
+        };
+
+    private:
+        // Guards the pool.
+        mutable std::mutex m_PoolMutex;
+
+        // Freed blocks by their size.
+        std::unordered_map<size_t, std::vector<void*>> m_Pool;
+
+        // Bytes kept in the pool.
+        size_t m_PoolBytes;
+
+        // Maximum bytes kept in the pool.
+        size_t m_MaxPoolBytes;
+
+        // True if large blocks should be backed by huge pages.
+        bool m_UseHugePages;
+
+        // Chunks of the frame arena.
+        std::vector<FrameChunk> m_FrameChunks;
+
+        // Current chunk and used bytes in it.
+        FrameMarker m_FrameMarker;
+    };
+
+    // STL allocator allocating from the frame arena of a Yw3dAllocator, deallocation is a no-op.
+    template <class T>
+    class Yw3dFrameAllocator
+    {
+        template <class U> friend class Yw3dFrameAllocator;
+
+    public:
+        typedef T value_type;
+
+    public:
+        // Constructors.
+        explicit Yw3dFrameAllocator(Yw3dAllocator* allocator) : m_Allocator(allocator) {}
+        template <class U> Yw3dFrameAllocator(const Yw3dFrameAllocator<U>& other) : m_Allocator(other.m_Allocator) {}
+
+    public:
+        // Allocates storage for n objects from the frame arena.
+        T* allocate(size_t n)
+        {
+            T* memory = (T*)m_Allocator->AllocateFrame(n * sizeof(T));
+            if (nullptr == memory)
+            {
+                throw std::bad_alloc();
+            }
+
+            return memory;
+        }
+
+        // Storage is freed when the frame arena is rewound.
+        void deallocate(T*, size_t) {}
+
+        // Allocators of the same arena are interchangeable.
+        template <class U> bool operator ==(const Yw3dFrameAllocator<U>& other) const { return m_Allocator == other.m_Allocator; }
+        template <class U> bool operator !=(const Yw3dFrameAllocator<U>& other) const { return m_Allocator != other.m_Allocator; }
+
+    private:
+        // The allocator owning the frame arena.
+        Yw3dAllocator* m_Allocator;
+    };
+
+    // Index list filled by a primitive assembler, allocated from the frame arena.
+    typedef std::vector<uint32_t, Yw3dFrameAllocator<uint32_t>> Yw3dIndexList;
+}
+
+#endif // !__YW_3D_ALLOCATOR_H__
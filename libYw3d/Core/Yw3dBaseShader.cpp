@@ -2,6 +2,7 @@
 // YW Soft Renderer 3d base shader class.
 
 #include "Yw3dBaseShader.h"
+#include "Yw3dConstantBuffer.h"
 #include "Yw3dDevice.h"
 
 namespace yw
@@ -9,6 +10,20 @@ namespace yw
     const float IYw3dBaseShader::PI = (float)YW_PI;
     const float IYw3dBaseShader::INV_PI = (float)YW_INV_PI;
 
+    IYw3dBaseShader::IYw3dBaseShader() :
+        m_Device(nullptr)
+    {
+        memset(m_ConstantBufferData, 0, YW3D_MAX_CONSTANT_BUFFERS * sizeof(const void*));
+    }
+
+    void IYw3dBaseShader::SetConstantBuffers(Yw3dConstantBuffer* const* constantBuffers)
+    {
+        for (uint32_t slot = 0; slot < YW3D_MAX_CONSTANT_BUFFERS; slot++)
+        {
+            m_ConstantBufferData[slot] = (nullptr != constantBuffers[slot]) ? constantBuffers[slot]->GetData() : nullptr;
+        }
+    }
+
     void IYw3dBaseShader::SetFloat(uint32_t index, float value)
     {
         if (index >= YW3D_NUM_SHADER_CONSTANTS)
@@ -122,4 +137,53 @@ namespace yw
 
         return m_Device->SampleTexture(color, samplerNumber, u, v, w, lod, xGradient, yGradient);
     }
+
+    float4xN IYw3dBaseShader::tex2DBatch(uint32_t samplerNumber, const float2xN& s, const float2xN& ddx, const float2xN& ddy)
+    {
+        float u[YW3D_WIDE_LANES], v[YW3D_WIDE_LANES];
+        float ddxU[YW3D_WIDE_LANES], ddxV[YW3D_WIDE_LANES];
+        float ddyU[YW3D_WIDE_LANES], ddyV[YW3D_WIDE_LANES];
+        s.x.Store(u);
+        s.y.Store(v);
+        ddx.x.Store(ddxU);
+        ddx.y.Store(ddxV);
+        ddy.x.Store(ddyU);
+        ddy.y.Store(ddyV);
+
+        float r[YW3D_WIDE_LANES], g[YW3D_WIDE_LANES], b[YW3D_WIDE_LANES], a[YW3D_WIDE_LANES];
+        for (uint32_t lane = 0; lane < YW3D_WIDE_LANES; lane++)
+        {
+            const Vector4 xGradient(ddxU[lane], ddxV[lane], 0.0f, 0.0f);
+            const Vector4 yGradient(ddyU[lane], ddyV[lane], 0.0f, 0.0f);
+            Vector4 color(0.0f, 0.0f, 0.0f, 0.0f);
+            SampleTexture(color, samplerNumber, u[lane], v[lane], 0.0f, -1.0f, &xGradient, &yGradient);
+            r[lane] = color.x;
+            g[lane] = color.y;
+            b[lane] = color.z;
+            a[lane] = color.w;
+        }
+
+        return float4xN(floatxN(r), floatxN(g), floatxN(b), floatxN(a));
+    }
+
+    float4xN IYw3dBaseShader::tex2DlodBatch(uint32_t samplerNumber, const float4xN& s)
+    {
+        float u[YW3D_WIDE_LANES], v[YW3D_WIDE_LANES], lod[YW3D_WIDE_LANES];
+        s.x.Store(u);
+        s.y.Store(v);
+        s.w.Store(lod);
+
+        float r[YW3D_WIDE_LANES], g[YW3D_WIDE_LANES], b[YW3D_WIDE_LANES], a[YW3D_WIDE_LANES];
+        for (uint32_t lane = 0; lane < YW3D_WIDE_LANES; lane++)
+        {
+            Vector4 color(0.0f, 0.0f, 0.0f, 0.0f);
+            SampleTexture(color, samplerNumber, u[lane], v[lane], 0.0f, lod[lane], nullptr, nullptr);
+            r[lane] = color.x;
+            g[lane] = color.y;
+            b[lane] = color.z;
+            a[lane] = color.w;
+        }
+
+        return float4xN(floatxN(r), floatxN(g), floatxN(b), floatxN(a));
+    }
 }
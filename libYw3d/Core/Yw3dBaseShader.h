@@ -6,6 +6,7 @@
 
 #include "Yw3dBase.h"
 #include "Yw3dTypes.h"
+#include "Yw3dShaderWide.h"
 
 namespace yw
 {
@@ -54,6 +55,10 @@ namespace yw
         // Returns the combined matrix of world, view and projection.
         const Matrix44* GetWVPMatrix() const;
 
+    protected:
+        // Accessible by derived shaders only.
+        IYw3dBaseShader();
+
     protected:
         // Accessible by Yw3dDevice - Sets the rendering-device.
         // @param[in] device the device.
@@ -69,6 +74,27 @@ namespace yw
             return m_Device;
         }
 
+        // Accessible by Yw3dDevice - Sets the constant buffers bound to the device right before drawing, the shader keeps the pointers to their constants.
+        // @param[in] constantBuffers the constant buffer slots of the device, YW3D_MAX_CONSTANT_BUFFERS entries.
+        void SetConstantBuffers(class Yw3dConstantBuffer* const* constantBuffers);
+
+        // Returns the constants of the constant buffer bound to a slot of the device while drawing.
+        // @param[in] slot number of the slot.
+        // @return the constants, nullptr if no constant buffer is bound to the slot.
+        inline const void* GetConstantBuffer(uint32_t slot) const
+        {
+            return (slot < YW3D_MAX_CONSTANT_BUFFERS) ? m_ConstantBufferData[slot] : nullptr;
+        }
+
+        // Returns the constants of the constant buffer bound to a slot of the device while drawing, as a typed block.
+        // @param[in] slot number of the slot.
+        // @return the constants, nullptr if no constant buffer is bound to the slot. T has to match the layout of the buffer.
+        template <typename T>
+        inline const T* GetConstants(uint32_t slot) const
+        {
+            return (const T*)GetConstantBuffer(slot);
+        }
+
         // Samples the texture and returns the looked-up color. This simply functions
         // simply forwards the sampling-call to the device.
         // @param[out] color receives the color of the pixel to be looked up.
@@ -83,6 +109,20 @@ namespace yw
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         Yw3dResult SampleTexture(Vector4& color, uint32_t samplerNumber, float u, float v, float w = 0.0f, float lod= 0.0f, const Vector4* xGradient = nullptr, const Vector4* yGradient = nullptr);
 
+        // Samples the texture for each lane of a batch shader, the mip-level is chosen from the partial derivatives of each lane.
+        // @param[in] samplerNumber number of the sampler.
+        // @param[in] s texture coordinates of the lanes.
+        // @param[in] ddx partial derivatives of the texture coordinates with respect to the screen-space x coordinate.
+        // @param[in] ddy partial derivatives of the texture coordinates with respect to the screen-space y coordinate.
+        // @return the looked-up colors, black for lanes whose lookup failed.
+        float4xN tex2DBatch(uint32_t samplerNumber, const float2xN& s, const float2xN& ddx, const float2xN& ddy);
+
+        // Samples the texture for each lane of a batch shader at an explicit mip-level, e.g. in batch vertex shaders.
+        // @param[in] samplerNumber number of the sampler.
+        // @param[in] s texture coordinates of the lanes in xy and the level of detail in w.
+        // @return the looked-up colors, black for lanes whose lookup failed.
+        float4xN tex2DlodBatch(uint32_t samplerNumber, const float4xN& s);
+
     protected:
         /**
          * @brief Clamps a floating-point value.
@@ -144,6 +184,54 @@ namespace yw
             return yw::Clamp(v, l, u);
         }
 
+        /**
+         * @brief Clamps each lane of a floatxN value.
+         * @param[in] v value to clamp.
+         * @param[in] l minimum value.
+         * @param[in] u maximum value.
+         * @return clamped value in [l,u].
+         */
+        static inline floatxN clamp(const floatxN& v, const float l, const float u)
+        {
+            return floatxN::Min(floatxN::Max(v, floatxN(l)), floatxN(u));
+        }
+
+        /**
+         * @brief Clamps each lane of a float2xN value.
+         * @param[in] v value to clamp.
+         * @param[in] l minimum value.
+         * @param[in] u maximum value.
+         * @return clamped value in [l,u].
+         */
+        static inline float2xN clamp(const float2xN& v, const float l, const float u)
+        {
+            return float2xN(clamp(v.x, l, u), clamp(v.y, l, u));
+        }
+
+        /**
+         * @brief Clamps each lane of a float3xN value.
+         * @param[in] v value to clamp.
+         * @param[in] l minimum value.
+         * @param[in] u maximum value.
+         * @return clamped value in [l,u].
+         */
+        static inline float3xN clamp(const float3xN& v, const float l, const float u)
+        {
+            return float3xN(clamp(v.x, l, u), clamp(v.y, l, u), clamp(v.z, l, u));
+        }
+
+        /**
+         * @brief Clamps each lane of a float4xN value.
+         * @param[in] v value to clamp.
+         * @param[in] l minimum value.
+         * @param[in] u maximum value.
+         * @return clamped value in [l,u].
+         */
+        static inline float4xN clamp(const float4xN& v, const float l, const float u)
+        {
+            return float4xN(clamp(v.x, l, u), clamp(v.y, l, u), clamp(v.z, l, u), clamp(v.w, l, u));
+        }
+
         /**
          * @brief Clamps a floating-point value to [0.0f,1.0f].
          * @param[in] v value to saturate.
@@ -184,6 +272,46 @@ namespace yw
             return yw::Saturate(v);
         }
 
+        /**
+         * @brief Clamps each lane of a floatxN value to [0.0f,1.0f].
+         * @param[in] v value to saturate.
+         * @return saturated value in [0.0f,1.0f].
+         */
+        static inline floatxN saturate(const floatxN& v)
+        {
+            return clamp(v, 0.0f, 1.0f);
+        }
+
+        /**
+         * @brief Clamps each lane of a float2xN value to [0.0f,1.0f].
+         * @param[in] v value to saturate.
+         * @return saturated value in [0.0f,1.0f].
+         */
+        static inline float2xN saturate(const float2xN& v)
+        {
+            return clamp(v, 0.0f, 1.0f);
+        }
+
+        /**
+         * @brief Clamps each lane of a float3xN value to [0.0f,1.0f].
+         * @param[in] v value to saturate.
+         * @return saturated value in [0.0f,1.0f].
+         */
+        static inline float3xN saturate(const float3xN& v)
+        {
+            return clamp(v, 0.0f, 1.0f);
+        }
+
+        /**
+         * @brief Clamps each lane of a float4xN value to [0.0f,1.0f].
+         * @param[in] v value to saturate.
+         * @return saturated value in [0.0f,1.0f].
+         */
+        static inline float4xN saturate(const float4xN& v)
+        {
+            return clamp(v, 0.0f, 1.0f);
+        }
+
         /**
          * @brief Linearly interpolates between two values.
          * @param[in] a first value.
@@ -232,6 +360,54 @@ namespace yw
             return yw::Lerp(a, b, t);
         }
 
+        /**
+         * @brief Linearly interpolates between two floatxN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @param[in] t interpolation factor in [0.0f,1.0f].
+         * @return Linearly interpolates between two values.
+         */
+        static inline floatxN lerp(const floatxN& a, const floatxN& b, const floatxN& t)
+        {
+            return a + (b - a) * t;
+        }
+
+        /**
+         * @brief Linearly interpolates between two float2xN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @param[in] t interpolation factor in [0.0f,1.0f].
+         * @return Linearly interpolates between two values.
+         */
+        static inline float2xN lerp(const float2xN& a, const float2xN& b, const floatxN& t)
+        {
+            return a + (b - a) * t;
+        }
+
+        /**
+         * @brief Linearly interpolates between two float3xN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @param[in] t interpolation factor in [0.0f,1.0f].
+         * @return Linearly interpolates between two values.
+         */
+        static inline float3xN lerp(const float3xN& a, const float3xN& b, const floatxN& t)
+        {
+            return a + (b - a) * t;
+        }
+
+        /**
+         * @brief Linearly interpolates between two float4xN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @param[in] t interpolation factor in [0.0f,1.0f].
+         * @return Linearly interpolates between two values.
+         */
+        static inline float4xN lerp(const float4xN& a, const float4xN& b, const floatxN& t)
+        {
+            return a + (b - a) * t;
+        }
+
         /**
          * @brief The minimum result of two vector2. These all operate component-wise. The calculation is per component.
          * @param[in] a first value.
@@ -265,6 +441,50 @@ namespace yw
             return Minimum(a, b);
         }
 
+        /**
+         * @brief The minimum of each lane of two floatxN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the minimum of each respective component of two values.
+         */
+        static inline floatxN minimum(const floatxN& a, const floatxN& b)
+        {
+            return floatxN::Min(a, b);
+        }
+
+        /**
+         * @brief The minimum of each lane of two float2xN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the minimum of each respective component of two values.
+         */
+        static inline float2xN minimum(const float2xN& a, const float2xN& b)
+        {
+            return float2xN(floatxN::Min(a.x, b.x), floatxN::Min(a.y, b.y));
+        }
+
+        /**
+         * @brief The minimum of each lane of two float3xN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the minimum of each respective component of two values.
+         */
+        static inline float3xN minimum(const float3xN& a, const float3xN& b)
+        {
+            return float3xN(floatxN::Min(a.x, b.x), floatxN::Min(a.y, b.y), floatxN::Min(a.z, b.z));
+        }
+
+        /**
+         * @brief The minimum of each lane of two float4xN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the minimum of each respective component of two values.
+         */
+        static inline float4xN minimum(const float4xN& a, const float4xN& b)
+        {
+            return float4xN(floatxN::Min(a.x, b.x), floatxN::Min(a.y, b.y), floatxN::Min(a.z, b.z), floatxN::Min(a.w, b.w));
+        }
+
         /**
          * @brief The maximum result of two vector2. These all operate component-wise. The calculation is per component.
          * @param[in] a first value.
@@ -298,6 +518,50 @@ namespace yw
             return Maximum(a, b);
         }
 
+        /**
+         * @brief The maximum of each lane of two floatxN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the maximum of each respective component of two values.
+         */
+        static inline floatxN maximum(const floatxN& a, const floatxN& b)
+        {
+            return floatxN::Max(a, b);
+        }
+
+        /**
+         * @brief The maximum of each lane of two float2xN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the maximum of each respective component of two values.
+         */
+        static inline float2xN maximum(const float2xN& a, const float2xN& b)
+        {
+            return float2xN(floatxN::Max(a.x, b.x), floatxN::Max(a.y, b.y));
+        }
+
+        /**
+         * @brief The maximum of each lane of two float3xN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the maximum of each respective component of two values.
+         */
+        static inline float3xN maximum(const float3xN& a, const float3xN& b)
+        {
+            return float3xN(floatxN::Max(a.x, b.x), floatxN::Max(a.y, b.y), floatxN::Max(a.z, b.z));
+        }
+
+        /**
+         * @brief The maximum of each lane of two float4xN. These all operate component-wise.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the maximum of each respective component of two values.
+         */
+        static inline float4xN maximum(const float4xN& a, const float4xN& b)
+        {
+            return float4xN(floatxN::Max(a.x, b.x), floatxN::Max(a.y, b.y), floatxN::Max(a.z, b.z), floatxN::Max(a.w, b.w));
+        }
+
         /**
          * @brief Returns true if any component of v is not equal to 0. Returns false otherwise.
          * @param[in] v value that to be checked.
@@ -368,6 +632,36 @@ namespace yw
             return v.Length();
         }
 
+        /**
+         * @brief Computes the length of each lane of a float2xN value.
+         * @param[in] v the vector.
+         * @return length of each lane.
+         */
+        static inline floatxN length(const float2xN& v)
+        {
+            return floatxN::Sqrt(dot(v, v));
+        }
+
+        /**
+         * @brief Computes the length of each lane of a float3xN value.
+         * @param[in] v the vector.
+         * @return length of each lane.
+         */
+        static inline floatxN length(const float3xN& v)
+        {
+            return floatxN::Sqrt(dot(v, v));
+        }
+
+        /**
+         * @brief Computes the length of each lane of a float4xN value.
+         * @param[in] v the vector.
+         * @return length of each lane.
+         */
+        static inline floatxN length(const float4xN& v)
+        {
+            return floatxN::Sqrt(dot(v, v));
+        }
+
         /**
          * @brief The result of two vector2 dot product.
          * @param[in] a first value.
@@ -401,6 +695,39 @@ namespace yw
             return Vector4Dot(a, b);
         }
 
+        /**
+         * @brief Computes the dot product of each lane of two float2xN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the dot product value of each lane.
+         */
+        static inline floatxN dot(const float2xN& a, const float2xN& b)
+        {
+            return a.x * b.x + a.y * b.y;
+        }
+
+        /**
+         * @brief Computes the dot product of each lane of two float3xN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the dot product value of each lane.
+         */
+        static inline floatxN dot(const float3xN& a, const float3xN& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        /**
+         * @brief Computes the dot product of each lane of two float4xN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the dot product value of each lane.
+         */
+        static inline floatxN dot(const float4xN& a, const float4xN& b)
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
         /**
          * @brief The result of two vector3 cross product.
          * @param[in] a first value.
@@ -413,6 +740,17 @@ namespace yw
             return Vector3Cross(result, a, b);
         }
 
+        /**
+         * @brief Computes the cross product of each lane of two float3xN values.
+         * @param[in] a first value.
+         * @param[in] b second value.
+         * @return the cross product value of each lane.
+         */
+        static inline float3xN cross(const float3xN& a, const float3xN& b)
+        {
+            return float3xN(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+        }
+
         /**
          * @brief The normalized result of Vector2 value.
          * @param[in] v value to be normalized.
@@ -446,6 +784,36 @@ namespace yw
             return Vector4Normalize(result, v);
         }
 
+        /**
+         * @brief Normalizes each lane of a float2xN value.
+         * @param[in] v the vector.
+         * @return the normalized float2xN value.
+         */
+        static inline float2xN normalize(const float2xN& v)
+        {
+            return v / length(v);
+        }
+
+        /**
+         * @brief Normalizes each lane of a float3xN value.
+         * @param[in] v the vector.
+         * @return the normalized float3xN value.
+         */
+        static inline float3xN normalize(const float3xN& v)
+        {
+            return v / length(v);
+        }
+
+        /**
+         * @brief Normalizes each lane of a float4xN value.
+         * @param[in] v the vector.
+         * @return the normalized float4xN value.
+         */
+        static inline float4xN normalize(const float4xN& v)
+        {
+            return v / length(v);
+        }
+
         /**
          * Returns the specified value raised to the specified power.
          * @param[in] v The specified value.
@@ -523,6 +891,136 @@ namespace yw
             return Pow(v, p);
         }
 
+        /**
+         * @brief Raises each lane of a floatxN value to a power, each lane is computed by the scalar pow.
+         * @param[in] v the value.
+         * @param[in] p the power.
+         * @return The v parameter raised to the power of the p parameter.
+         */
+        static inline floatxN pow(const floatxN& v, const floatxN& p)
+        {
+            return floatxN::Apply(v, p, [](float a, float b) { return Pow(a, b); });
+        }
+
+        /**
+         * @brief Raises each lane of a floatxN value to a power, each lane is computed by the scalar pow.
+         * @param[in] v the value.
+         * @param[in] p the power.
+         * @return The v parameter raised to the power of the p parameter.
+         */
+        static inline floatxN pow(const floatxN& v, const float p)
+        {
+            return pow(v, floatxN(p));
+        }
+
+        /**
+         * @brief Raises each lane of a float3xN value to a power. The calculation is per component.
+         * @param[in] v the value.
+         * @param[in] p the power.
+         * @return The v parameter raised to the power of the p parameter.
+         */
+        static inline float3xN pow(const float3xN& v, const float p)
+        {
+            return float3xN(pow(v.x, p), pow(v.y, p), pow(v.z, p));
+        }
+
+        /**
+         * @brief Raises each lane of a float4xN value to a power. The calculation is per component.
+         * @param[in] v the value.
+         * @param[in] p the power.
+         * @return The v parameter raised to the power of the p parameter.
+         */
+        static inline float4xN pow(const float4xN& v, const float p)
+        {
+            return float4xN(pow(v.x, p), pow(v.y, p), pow(v.z, p), pow(v.w, p));
+        }
+
+        // Fast approximations, opt-in by name so the exact functions above keep their results. The precision is selected by YW_MATH_FAST_PRECISION, see YwMathFast.h.
+
+        /**
+         * Returns an approximation of the reciprocal of the specified value.
+         * @param[in] v The specified non-zero value.
+         * @return 1 / v.
+         */
+        static inline float fastrcp(const float v)
+        {
+            return FastRcp(v);
+        }
+
+        /**
+         * Returns an approximation of the reciprocal of the square root of the specified value.
+         * @param[in] v The specified positive value.
+         * @return 1 / sqrt(v).
+         */
+        static inline float fastrsqrt(const float v)
+        {
+            return FastRsqrt(v);
+        }
+
+        /**
+         * Returns an approximation of the base-2 exponential of the specified value.
+         * @param[in] v The specified value, clamped to [-126,128).
+         * @return 2 raised to the power of v.
+         */
+        static inline float fastexp2(const float v)
+        {
+            return FastExp2(v);
+        }
+
+        /**
+         * Returns an approximation of the base-2 logarithm of the specified value.
+         * @param[in] v The specified positive value.
+         * @return The base-2 logarithm of v.
+         */
+        static inline float fastlog2(const float v)
+        {
+            return FastLog2(v);
+        }
+
+        /**
+         * Returns an approximation of the specified value raised to the specified power.
+         * Unlike pow(), fastpow(0, p) returns about 1e-38 instead of 0 and negative bases are not supported.
+         * @param[in] v The specified non-negative value.
+         * @param[in] p The specified power.
+         * @return The v parameter raised to the power of the p parameter.
+         */
+        static inline float fastpow(const float v, const float p)
+        {
+            return FastPow(v, p);
+        }
+
+        /**
+         * Returns an approximation of the specified vector raised to the specified power per component, see fastpow(float, float).
+         * @param[in] v The specified vector of non-negative values.
+         * @param[in] p The specified power.
+         * @return The v parameter raised to the power of the p parameter.
+         */
+        static inline Vector3 fastpow(const Vector3& v, const float p)
+        {
+            return Vector3(FastPow(v.x, p), FastPow(v.y, p), FastPow(v.z, p));
+        }
+
+        /**
+         * Returns an approximation of the arccosine of the specified value.
+         * @param[in] v The specified value, clamped to [-1,1].
+         * @return The arccosine of v in [0,PI].
+         */
+        static inline float fastacos(const float v)
+        {
+            return FastAcos(v);
+        }
+
+        /**
+         * Returns an approximation of the arctangent of two values.
+         * @param[in] y The y value.
+         * @param[in] x The x value.
+         * @return The arctangent of y / x in [-PI,PI].
+         */
+        static inline float fastatan2(const float y, const float x)
+        {
+            return FastAtan2(y, x);
+        }
+
         /**
          * This function calculates the reflection vector using the following formula: v = i - 2 * n * dot(i n) .
          * @param[in] ii incident vector.
@@ -556,6 +1054,61 @@ namespace yw
             return i - 2.0f * n * dot(i, n);
         }
 
+        /**
+         * @brief Calculates the reflection vector of each lane of float3xN values.
+         * @param[in] i incident vector.
+         * @param[in] n normal vector.
+         * @return Returns a reflection vector using an incident ray and a surface normal.
+         */
+        static inline float3xN reflect(const float3xN& i, const float3xN& n)
+        {
+            return i - 2.0f * n * dot(i, n);
+        }
+
+        /**
+         * @brief Calculates the reflection vector of each lane of float4xN values.
+         * @param[in] i incident vector.
+         * @param[in] n normal vector.
+         * @return Returns a reflection vector using an incident ray and a surface normal.
+         */
+        static inline float4xN reflect(const float4xN& i, const float4xN& n)
+        {
+            return i - 2.0f * n * dot(i, n);
+        }
+
+        /**
+         * @brief Transforms a vector by a matrix, v * m.
+         * @param[in] v the vector.
+         * @param[in] m the matrix.
+         * @return the transformed vector.
+         */
+        static inline Vector4 mul(const Vector4& v, const Matrix44& m)
+        {
+            return v * m;
+        }
+
+        /**
+         * @brief Transforms each lane of a float3xN value by a matrix, v * m.
+         * @param[in] v the vector.
+         * @param[in] m the matrix.
+         * @return the transformed vector.
+         */
+        static inline float3xN mul(const float3xN& v, const Matrix33& m)
+        {
+            return v * m;
+        }
+
+        /**
+         * @brief Transforms each lane of a float4xN value by a matrix, v * m.
+         * @param[in] v the vector.
+         * @param[in] m the matrix.
+         * @return the transformed vector.
+         */
+        static inline float4xN mul(const float4xN& v, const Matrix44& m)
+        {
+            return v * m;
+        }
+
     private:
         // Single float-constants.
         float m_FloatConstants[YW3D_NUM_SHADER_CONSTANTS];
@@ -569,6 +1122,9 @@ namespace yw
         // The Yw3d-device currently used for rendering.
         class Yw3dDevice* m_Device;
 
+        // Constants of the constant buffers bound to the device currently used for rendering.
+        const void* m_ConstantBufferData[YW3D_MAX_CONSTANT_BUFFERS];
+
     protected:
         // PI.
         static const float PI;
@@ -27,4 +27,60 @@ namespace yw
 
         return m_Device;
     }
+
+    Yw3dSampleFunction IYw3dBaseTexture::GetSampleFunction(const uint32_t* /*samplerStates*/) const
+    {
+        return &IYw3dBaseTexture::SampleTextureGeneric;
+    }
+
+    void IYw3dBaseTexture::ResolveFastClear()
+    {
+    }
+
+    Yw3dResult IYw3dBaseTexture::SampleTextureGeneric(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
+    {
+        // Correct u, v, w by input type and address type.
+        switch (texture->GetTextureSampleInput())
+        {
+        case Yw3d_TSI_Vector:
+            if ((0.0f == u) && (0.0f == v) && (0.0f == w))
+            {
+                color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+                LOGE(_T("IYw3dBaseTexture::SampleTextureGeneric: sampling vector [u,v,w] = [0,0,0].\n"));
+                return Yw3d_E_InvalidParameters;
+            }
+
+            break;
+        case Yw3d_TSI_3Coords:
+            switch (samplerStates[Yw3d_TSS_AddressW])
+            {
+            case Yw3d_TA_Wrap: w -= floor(w);
+            case Yw3d_TA_Clamp: w = Saturate(w); break;
+            default: color = Vector4(1.0f, 1.0f, 1.0f, 1.0f); LOGE(_T("IYw3dBaseTexture::SampleTextureGeneric: value of texture sampler state Yw3d_TSS_AddressW is invalid.\n")); return Yw3d_E_InvalidState;
+            }
+        case Yw3d_TSI_2CoordsLayer:
+        case Yw3d_TSI_2Coords:
+            switch (samplerStates[Yw3d_TSS_AddressV])
+            {
+            case Yw3d_TA_Wrap: v -= floor(v);
+            case Yw3d_TA_Clamp: v = Saturate(v); break;
+            default: color = Vector4(1.0f, 1.0f, 1.0f, 1.0f); LOGE(_T("IYw3dBaseTexture::SampleTextureGeneric: value of texture sampler state Yw3d_TSS_AddressV is invalid.\n")); return Yw3d_E_InvalidState;
+            }
+
+            switch (samplerStates[Yw3d_TSS_AddressU])
+            {
+            case Yw3d_TA_Wrap: u -= floor(u);
+            case Yw3d_TA_Clamp: u = Saturate(u); break;
+            default: color = Vector4(1.0f, 1.0f, 1.0f, 1.0f); LOGE(_T("IYw3dBaseTexture::SampleTextureGeneric: value of texture sampler state Yw3d_TSS_AddressU is invalid.\n")); return Yw3d_E_InvalidState;
+            }
+
+            break;
+        default:
+            color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+            LOGE(_T("IYw3dBaseTexture::SampleTextureGeneric: invalid texture-sampling input!\n"));
+            return Yw3d_E_InvalidState;
+        }
+
+        return texture->SampleTexture(color, u, v, w, lod, xGradient, yGradient, samplerStates);
+    }
 }
@@ -9,6 +9,10 @@
 
 namespace yw
 {
+    // Sampling function of a texture, resolved by the device for the states of a texture sampler, see IYw3dBaseTexture::GetSampleFunction().
+    // The parameters match IYw3dBaseTexture::SampleTexture(), u, v and w have not been addressed yet.
+    typedef Yw3dResult (*Yw3dSampleFunction)(class IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
     // The base class of texture.
     class IYw3dBaseTexture : public IBase
     {
@@ -38,7 +42,30 @@ namespace yw
         // @return Yw3d_S_OK if the function succeeds.
         virtual Yw3dResult SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates) = 0;
 
+        // Returns the sampling function for a set of sampler states, called by the device when the texture or a state of a sampler changes.
+        // A texture may return a function specialized for its format and the address, filter and mip states, the default is SampleTextureGeneric().
+        // @param[in] samplerStates texture sampler states.
+        virtual Yw3dSampleFunction GetSampleFunction(const uint32_t* samplerStates) const;
+
+        // Accessible by Yw3dDevice. Writes the pending fast cleared tiles of all surfaces of the texture, called when the texture is bound or used by a draw call or a dispatch.
+        // The sampling functions only read the surfaces, so they are free of side effects and may be called by several threads at once. The default does nothing.
+        virtual void ResolveFastClear();
+
+        // Sampling function handling all textures and sampler states: addresses u, v and w by the sampler states and calls SampleTexture(). The layer index of texture arrays is not addressed.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if a cube texture is sampled with vector [0,0,0].
+        // @return Yw3d_E_InvalidState if an address state is invalid.
+        static Yw3dResult SampleTextureGeneric(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
     public:
+        // Selects the mip-level from the partial derivatives of the texture coordinates, the bias and the clamping of the sampler states are applied by the texture.
+        // @param[in] xGradient partial derivatives of the texture coordinates with respect to the screen-space x coordinate.
+        // @param[in] yGradient partial derivatives of the texture coordinates with respect to the screen-space y coordinate.
+        // @param[in] squaredWidth squared width of the most detailed mip-level.
+        // @param[in] squaredHeight squared height of the most detailed mip-level.
+        // @return the mip-level if the texture is minified, or -1 if it is magnified and sampled at the most detailed mip-level with the magnification filter.
+        static inline float SelectMipLevel(const Vector4& xGradient, const Vector4& yGradient, const float squaredWidth, const float squaredHeight);
+
         // Returns a pointer to the associated device. Calling this function will increase the internal reference count of the device. 
         // Failure to call Release() when finished using the pointer will result in a memory leak.
         class Yw3dDevice* AcquireDevice();
@@ -47,6 +74,22 @@ namespace yw
         // Pointer to device.
         class Yw3dDevice* m_Device;
     };
+
+    inline float IYw3dBaseTexture::SelectMipLevel(const Vector4& xGradient, const Vector4& yGradient, const float squaredWidth, const float squaredHeight)
+    {
+        const float lenXGrad = xGradient.x * xGradient.x * squaredWidth + xGradient.y * xGradient.y * squaredHeight;
+        const float lenYGrad = yGradient.x * yGradient.x * squaredWidth + yGradient.y * yGradient.y * squaredHeight;
+        const float texelsPerScreenPixel = (lenXGrad > lenYGrad) ? lenXGrad : lenYGrad; // Old: sqrtf(lenXGrad > lenYGrad ? lenXGrad : lenYGrad);
+
+        // If texelsPerScreenPixel <= 1.0f -> magnification, no mipmapping needed.
+        if (texelsPerScreenPixel <= 1.0f)
+        {
+            return -1.0f;
+        }
+
+        // Old: logf(sqrtf(texelsPerScreenPixel)) / logf(2.0f); because: "log2(sqrtf(texelsPerScreenPixel)) = 0.5 * log2(texelsPerScreenPixel)", so we get better performance.
+        return 0.5f * FastLog2(texelsPerScreenPixel);
+    }
 }
 
 #endif
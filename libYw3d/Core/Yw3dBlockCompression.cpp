@@ -0,0 +1,823 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d block compression helpers.
+
+#include "Yw3dBlockCompression.h"
+#include <float.h>
+
+namespace yw
+{
+    // ------------------------------------------------------------------
+    // Shared helpers.
+
+    // Finds the end points of a line fitting a set of points, the line follows the principal axis of the points and ends at their extreme projections.
+    // @param[in] points the points.
+    // @param[in] count number of points, greater than 0.
+    // @param[out] outMinEnd receives the end point at the lower extreme.
+    // @param[out] outMaxEnd receives the end point at the upper extreme.
+    static void FindLineEndpoints(const float (*points)[3], const uint32_t count, float* outMinEnd, float* outMaxEnd)
+    {
+        float mean[3] = {0.0f, 0.0f, 0.0f};
+        float boxMin[3] = {points[0][0], points[0][1], points[0][2]};
+        float boxMax[3] = {points[0][0], points[0][1], points[0][2]};
+        for (uint32_t i = 0; i < count; i++)
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                mean[c] += points[i][c];
+                boxMin[c] = (points[i][c] < boxMin[c]) ? points[i][c] : boxMin[c];
+                boxMax[c] = (points[i][c] > boxMax[c]) ? points[i][c] : boxMax[c];
+            }
+        }
+
+        const float invCount = 1.0f / (float)count;
+        mean[0] *= invCount;
+        mean[1] *= invCount;
+        mean[2] *= invCount;
+
+        // Covariance matrix, symmetric: xx, xy, xz, yy, yz, zz.
+        float covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float x = points[i][0] - mean[0];
+            const float y = points[i][1] - mean[1];
+            const float z = points[i][2] - mean[2];
+            covariance[0] += x * x;
+            covariance[1] += x * y;
+            covariance[2] += x * z;
+            covariance[3] += y * y;
+            covariance[4] += y * z;
+            covariance[5] += z * z;
+        }
+
+        // Power iteration for the principal axis, starting with the diagonal of the bounding box.
+        float axis[3] = {boxMax[0] - boxMin[0], boxMax[1] - boxMin[1], boxMax[2] - boxMin[2]};
+        for (uint32_t iteration = 0; iteration < 8; iteration++)
+        {
+            const float x = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+            const float y = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+            const float z = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+
+            const float length = sqrtf(x * x + y * y + z * z);
+            if (length <= 0.0f)
+            {
+                break;
+            }
+
+            axis[0] = x / length;
+            axis[1] = y / length;
+            axis[2] = z / length;
+        }
+
+        const float axisLength = sqrtf(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2]);
+        if (axisLength <= 0.0f)
+        {
+            // All points are equal.
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                outMinEnd[c] = outMaxEnd[c] = mean[c];
+            }
+
+            return;
+        }
+
+        axis[0] /= axisLength;
+        axis[1] /= axisLength;
+        axis[2] /= axisLength;
+
+        float minProjection = 0.0f;
+        float maxProjection = 0.0f;
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float projection = (points[i][0] - mean[0]) * axis[0] + (points[i][1] - mean[1]) * axis[1] + (points[i][2] - mean[2]) * axis[2];
+            minProjection = (projection < minProjection) ? projection : minProjection;
+            maxProjection = (projection > maxProjection) ? projection : maxProjection;
+        }
+
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            outMinEnd[c] = mean[c] + axis[c] * minProjection;
+            outMaxEnd[c] = mean[c] + axis[c] * maxProjection;
+        }
+    }
+
+    // Reads a little endian value from a block.
+    static inline uint32_t ReadUInt16(const uint8_t* data)
+    {
+        return (uint32_t)data[0] | ((uint32_t)data[1] << 8);
+    }
+
+    static inline uint32_t ReadUInt32(const uint8_t* data)
+    {
+        return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+    }
+
+    static inline uint64_t ReadUInt64(const uint8_t* data)
+    {
+        return (uint64_t)ReadUInt32(data) | ((uint64_t)ReadUInt32(data + 4) << 32);
+    }
+
+    // Writes a little endian value to a block.
+    static inline void WriteUInt16(uint8_t* data, const uint32_t value)
+    {
+        data[0] = (uint8_t)value;
+        data[1] = (uint8_t)(value >> 8);
+    }
+
+    static inline void WriteUInt32(uint8_t* data, const uint32_t value)
+    {
+        WriteUInt16(data, value);
+        WriteUInt16(data + 2, value >> 16);
+    }
+
+    static inline void WriteUInt64(uint8_t* data, const uint64_t value)
+    {
+        WriteUInt32(data, (uint32_t)value);
+        WriteUInt32(data + 4, (uint32_t)(value >> 32));
+    }
+
+    // ------------------------------------------------------------------
+    // Color blocks of BC1 and BC3.
+
+    // Converts a color to RGB565.
+    static inline uint32_t EncodeRGB565(const float* color)
+    {
+        const uint32_t r = (uint32_t)(Saturate(color[0]) * 31.0f + 0.5f);
+        const uint32_t g = (uint32_t)(Saturate(color[1]) * 63.0f + 0.5f);
+        const uint32_t b = (uint32_t)(Saturate(color[2]) * 31.0f + 0.5f);
+        return (r << 11) | (g << 5) | b;
+    }
+
+    // Converts RGB565 to a color, the bits are replicated like an 8-bit expansion would do.
+    static inline void DecodeRGB565(const uint32_t packed, float* outColor)
+    {
+        const uint32_t r = (packed >> 11) & 0x1f;
+        const uint32_t g = (packed >> 5) & 0x3f;
+        const uint32_t b = packed & 0x1f;
+        outColor[0] = (float)((r << 3) | (r >> 2)) * (1.0f / 255.0f);
+        outColor[1] = (float)((g << 2) | (g >> 4)) * (1.0f / 255.0f);
+        outColor[2] = (float)((b << 3) | (b >> 2)) * (1.0f / 255.0f);
+    }
+
+    // Builds the four colors of a color block.
+    // @param[in] endpoint0, endpoint1 the RGB565 end points.
+    // @param[in] fourColorMode true to always interpolate two colors (BC3), otherwise endpoint0 <= endpoint1 selects the mode with one interpolated color and transparent black.
+    // @param[out] outPalette receives the four colors, alpha in the fourth channel.
+    static void BuildColorPalette(const uint32_t endpoint0, const uint32_t endpoint1, const bool fourColorMode, float (*outPalette)[4])
+    {
+        DecodeRGB565(endpoint0, outPalette[0]);
+        DecodeRGB565(endpoint1, outPalette[1]);
+        outPalette[0][3] = 1.0f;
+        outPalette[1][3] = 1.0f;
+
+        if (fourColorMode || (endpoint0 > endpoint1))
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                outPalette[2][c] = (2.0f * outPalette[0][c] + outPalette[1][c]) * (1.0f / 3.0f);
+                outPalette[3][c] = (outPalette[0][c] + 2.0f * outPalette[1][c]) * (1.0f / 3.0f);
+            }
+
+            outPalette[2][3] = 1.0f;
+            outPalette[3][3] = 1.0f;
+        }
+        else
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                outPalette[2][c] = (outPalette[0][c] + outPalette[1][c]) * 0.5f;
+                outPalette[3][c] = 0.0f;
+            }
+
+            outPalette[2][3] = 1.0f;
+            outPalette[3][3] = 0.0f;
+        }
+    }
+
+    // Selects the nearest palette color of each pixel.
+    // @param[in] colors the 16 pixel colors.
+    // @param[in] transparent transparent pixels of the block, nullptr if all are opaque.
+    // @param[in] palette the palette of the end points.
+    // @param[in] numColors number of opaque palette colors, 3 or 4.
+    // @param[out] outIndices receives the 2-bit indices.
+    // @return the squared error of the opaque pixels.
+    static float SelectColorIndices(const float (*colors)[3], const bool* transparent, const float (*palette)[4], const uint32_t numColors, uint32_t& outIndices)
+    {
+        float error = 0.0f;
+        outIndices = 0;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            if ((nullptr != transparent) && transparent[i])
+            {
+                outIndices |= 3 << (2 * i);
+                continue;
+            }
+
+            uint32_t bestIndex = 0;
+            float bestDistance = FLT_MAX;
+            for (uint32_t p = 0; p < numColors; p++)
+            {
+                const float r = colors[i][0] - palette[p][0];
+                const float g = colors[i][1] - palette[p][1];
+                const float b = colors[i][2] - palette[p][2];
+                const float distance = r * r + g * g + b * b;
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    bestIndex = p;
+                }
+            }
+
+            outIndices |= bestIndex << (2 * i);
+            error += bestDistance;
+        }
+
+        return error;
+    }
+
+    // Encodes the colors of a block to a color block of BC1 or BC3.
+    // @param[in] pixels the 16 pixels.
+    // @param[in] allowTransparent true to encode pixels with alpha below 0.5 as transparent black (BC1).
+    // @param[out] outBlock receives the 8 bytes color block.
+    static void EncodeColorBlock(const Vector4* pixels, const bool allowTransparent, uint8_t* outBlock)
+    {
+        float colors[16][3];
+        float opaqueColors[16][3];
+        bool transparent[16];
+        uint32_t numOpaque = 0;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            colors[i][0] = Saturate(pixels[i].r);
+            colors[i][1] = Saturate(pixels[i].g);
+            colors[i][2] = Saturate(pixels[i].b);
+
+            transparent[i] = allowTransparent && (pixels[i].a < 0.5f);
+            if (!transparent[i])
+            {
+                opaqueColors[numOpaque][0] = colors[i][0];
+                opaqueColors[numOpaque][1] = colors[i][1];
+                opaqueColors[numOpaque][2] = colors[i][2];
+                numOpaque++;
+            }
+        }
+
+        // All transparent, endpoint0 <= endpoint1 selects the mode with transparent black.
+        if (0 == numOpaque)
+        {
+            WriteUInt16(outBlock, 0);
+            WriteUInt16(outBlock + 2, 0);
+            WriteUInt32(outBlock + 4, 0xffffffff);
+            return;
+        }
+
+        float minEnd[3];
+        float maxEnd[3];
+        FindLineEndpoints(opaqueColors, numOpaque, minEnd, maxEnd);
+
+        uint32_t endpoint0 = EncodeRGB565(maxEnd);
+        uint32_t endpoint1 = EncodeRGB565(minEnd);
+
+        // The order of the end points selects the mode.
+        const bool threeColorMode = (numOpaque < 16);
+        if (threeColorMode ? (endpoint0 > endpoint1) : (endpoint0 < endpoint1))
+        {
+            const uint32_t swap = endpoint0;
+            endpoint0 = endpoint1;
+            endpoint1 = swap;
+        }
+
+        float palette[4][4];
+        BuildColorPalette(endpoint0, endpoint1, !threeColorMode, palette);
+
+        uint32_t indices = 0;
+        float error = SelectColorIndices(colors, transparent, palette, threeColorMode ? 3 : 4, indices);
+
+        // Refit the end points of the four color mode to the selected indices by least squares.
+        if (!threeColorMode && (endpoint0 != endpoint1))
+        {
+            static const float weights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+
+            float alpha2 = 0.0f;
+            float beta2 = 0.0f;
+            float alphaBeta = 0.0f;
+            float alphaX[3] = {0.0f, 0.0f, 0.0f};
+            float betaX[3] = {0.0f, 0.0f, 0.0f};
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                const float alpha = weights[(indices >> (2 * i)) & 3];
+                const float beta = 1.0f - alpha;
+                alpha2 += alpha * alpha;
+                beta2 += beta * beta;
+                alphaBeta += alpha * beta;
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    alphaX[c] += alpha * colors[i][c];
+                    betaX[c] += beta * colors[i][c];
+                }
+            }
+
+            const float determinant = alpha2 * beta2 - alphaBeta * alphaBeta;
+            if (fabsf(determinant) > 1e-6f)
+            {
+                float refitEnd0[3];
+                float refitEnd1[3];
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    refitEnd0[c] = (alphaX[c] * beta2 - betaX[c] * alphaBeta) / determinant;
+                    refitEnd1[c] = (betaX[c] * alpha2 - alphaX[c] * alphaBeta) / determinant;
+                }
+
+                uint32_t refitEndpoint0 = EncodeRGB565(refitEnd0);
+                uint32_t refitEndpoint1 = EncodeRGB565(refitEnd1);
+                if (refitEndpoint0 < refitEndpoint1)
+                {
+                    const uint32_t swap = refitEndpoint0;
+                    refitEndpoint0 = refitEndpoint1;
+                    refitEndpoint1 = swap;
+                }
+
+                float refitPalette[4][4];
+                BuildColorPalette(refitEndpoint0, refitEndpoint1, true, refitPalette);
+
+                uint32_t refitIndices = 0;
+                const float refitError = SelectColorIndices(colors, nullptr, refitPalette, 4, refitIndices);
+                if (refitError < error)
+                {
+                    endpoint0 = refitEndpoint0;
+                    endpoint1 = refitEndpoint1;
+                    indices = refitIndices;
+                    error = refitError;
+                }
+            }
+        }
+
+        // Equal end points of the four color mode would select the three color mode, all pixels use endpoint0 then.
+        if (!threeColorMode && (endpoint0 == endpoint1))
+        {
+            indices = 0;
+        }
+
+        WriteUInt16(outBlock, endpoint0);
+        WriteUInt16(outBlock + 2, endpoint1);
+        WriteUInt32(outBlock + 4, indices);
+    }
+
+    // Decodes one pixel of a color block.
+    static void DecodeColorPixel(const uint8_t* block, const uint32_t pixel, const bool fourColorMode, float* outColor)
+    {
+        const uint32_t endpoint0 = ReadUInt16(block);
+        const uint32_t endpoint1 = ReadUInt16(block + 2);
+        const uint32_t index = (ReadUInt32(block + 4) >> (2 * pixel)) & 3;
+
+        switch (index)
+        {
+        case 0:
+            DecodeRGB565(endpoint0, outColor);
+            outColor[3] = 1.0f;
+            break;
+        case 1:
+            DecodeRGB565(endpoint1, outColor);
+            outColor[3] = 1.0f;
+            break;
+        default:
+            {
+                float palette[4][4];
+                BuildColorPalette(endpoint0, endpoint1, fourColorMode, palette);
+                outColor[0] = palette[index][0];
+                outColor[1] = palette[index][1];
+                outColor[2] = palette[index][2];
+                outColor[3] = palette[index][3];
+            }
+            break;
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Single channel blocks of BC3 alpha and BC5.
+
+    // Builds the eight values of a single channel block.
+    static void BuildChannelPalette(const uint32_t endpoint0, const uint32_t endpoint1, float* outPalette)
+    {
+        outPalette[0] = (float)endpoint0;
+        outPalette[1] = (float)endpoint1;
+        if (endpoint0 > endpoint1)
+        {
+            // Six interpolated values.
+            for (uint32_t i = 2; i < 8; i++)
+            {
+                outPalette[i] = ((float)(8 - i) * (float)endpoint0 + (float)(i - 1) * (float)endpoint1) * (1.0f / 7.0f);
+            }
+        }
+        else
+        {
+            // Four interpolated values plus 0 and 255.
+            for (uint32_t i = 2; i < 6; i++)
+            {
+                outPalette[i] = ((float)(6 - i) * (float)endpoint0 + (float)(i - 1) * (float)endpoint1) * (1.0f / 5.0f);
+            }
+
+            outPalette[6] = 0.0f;
+            outPalette[7] = 255.0f;
+        }
+
+        for (uint32_t i = 0; i < 8; i++)
+        {
+            outPalette[i] *= (1.0f / 255.0f);
+        }
+    }
+
+    // Encodes 16 values to a single channel block.
+    // @param[in] values the 16 values.
+    // @param[out] outBlock receives the 8 bytes block.
+    static void EncodeChannelBlock(const float* values, uint8_t* outBlock)
+    {
+        float minValue = 1.0f;
+        float maxValue = 0.0f;
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            const float value = Saturate(values[i]);
+            minValue = (value < minValue) ? value : minValue;
+            maxValue = (value > maxValue) ? value : maxValue;
+        }
+
+        // endpoint0 > endpoint1 selects six interpolated values, equal end points need index 0 only.
+        const uint32_t endpoint0 = (uint32_t)(maxValue * 255.0f + 0.5f);
+        const uint32_t endpoint1 = (uint32_t)(minValue * 255.0f + 0.5f);
+
+        float palette[8];
+        BuildChannelPalette(endpoint0, endpoint1, palette);
+
+        uint64_t indices = 0;
+        if (endpoint0 != endpoint1)
+        {
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                const float value = Saturate(values[i]);
+
+                uint64_t bestIndex = 0;
+                float bestDistance = FLT_MAX;
+                for (uint32_t p = 0; p < 8; p++)
+                {
+                    const float distance = fabsf(value - palette[p]);
+                    if (distance < bestDistance)
+                    {
+                        bestDistance = distance;
+                        bestIndex = p;
+                    }
+                }
+
+                indices |= bestIndex << (3 * i);
+            }
+        }
+
+        // Two bytes end points and six bytes indices.
+        outBlock[0] = (uint8_t)endpoint0;
+        outBlock[1] = (uint8_t)endpoint1;
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            outBlock[2 + i] = (uint8_t)(indices >> (8 * i));
+        }
+    }
+
+    // Decodes one value of a single channel block.
+    static float DecodeChannelPixel(const uint8_t* block, const uint32_t pixel)
+    {
+        const uint32_t endpoint0 = block[0];
+        const uint32_t endpoint1 = block[1];
+        const uint32_t bitOffset = 3 * pixel;
+        const uint32_t byteOffset = 2 + (bitOffset >> 3);
+
+        // An index may cross a byte boundary.
+        uint32_t bits = block[byteOffset];
+        if (byteOffset < 7)
+        {
+            bits |= (uint32_t)block[byteOffset + 1] << 8;
+        }
+
+        const uint32_t index = (bits >> (bitOffset & 7)) & 7;
+        switch (index)
+        {
+        case 0:
+            return (float)endpoint0 * (1.0f / 255.0f);
+        case 1:
+            return (float)endpoint1 * (1.0f / 255.0f);
+        default:
+            {
+                float palette[8];
+                BuildChannelPalette(endpoint0, endpoint1, palette);
+                return palette[index];
+            }
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // BC6H, unsigned half floats in the single region mode with 10-bit end points and 4-bit indices.
+
+    // Mode bits of the single region mode with 10-bit end points.
+    #define YW3D_BC6H_MODE_11 0x03
+
+    // Interpolation weights of 4-bit indices.
+    static const int32_t s_BC6HWeights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    // Reads bits of a 128-bit block.
+    static inline uint32_t ReadBits128(const uint64_t low, const uint64_t high, const uint32_t position, const uint32_t bits)
+    {
+        uint64_t value = 0;
+        if (position >= 64)
+        {
+            value = high >> (position - 64);
+        }
+        else if (position + bits <= 64)
+        {
+            value = low >> position;
+        }
+        else
+        {
+            value = (low >> position) | (high << (64 - position));
+        }
+
+        return (uint32_t)(value & ((1ull << bits) - 1));
+    }
+
+    // Writes bits of a 128-bit block.
+    static inline void WriteBits128(uint64_t& low, uint64_t& high, const uint32_t position, const uint32_t bits, const uint32_t value)
+    {
+        const uint64_t masked = (uint64_t)value & ((1ull << bits) - 1);
+        if (position >= 64)
+        {
+            high |= masked << (position - 64);
+        }
+        else
+        {
+            low |= masked << position;
+            if (position + bits > 64)
+            {
+                high |= masked >> (64 - position);
+            }
+        }
+    }
+
+    // Returns the bit position of the index of a pixel, the first pixel is the anchor with an implicit leading zero bit.
+    static inline uint32_t GetBC6HIndexPosition(const uint32_t pixel)
+    {
+        return (0 == pixel) ? 65 : (64 + 4 * pixel);
+    }
+
+    // Expands a 10-bit end point to the 16-bit interpolation range.
+    static inline int32_t UnquantizeBC6H(const uint32_t value)
+    {
+        if (0 == value)
+        {
+            return 0;
+        }
+
+        if (0x3ff == value)
+        {
+            return 0xffff;
+        }
+
+        return (int32_t)(((value << 16) + 0x8000) >> 10);
+    }
+
+    // Interpolates two expanded end points.
+    static inline int32_t InterpolateBC6H(const int32_t endpoint0, const int32_t endpoint1, const uint32_t index)
+    {
+        return ((64 - s_BC6HWeights[index]) * endpoint0 + s_BC6HWeights[index] * endpoint1 + 32) >> 6;
+    }
+
+    static void EncodeBC6HBlock(const Vector4* pixels, uint8_t* outBlock)
+    {
+        // Pixels in the interpolation range, which maps to half floats by x * 31 / 64.
+        float values[16][3];
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            const float color[3] = {pixels[i].r, pixels[i].g, pixels[i].b};
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                uint32_t half = EncodeHalf((color[c] > 0.0f) ? color[c] : 0.0f);
+                half = (half > 0x7bff) ? 0x7bff : half;
+                values[i][c] = (float)((half * 64 + 30) / 31);
+            }
+        }
+
+        float minEnd[3];
+        float maxEnd[3];
+        FindLineEndpoints(values, 16, minEnd, maxEnd);
+
+        uint32_t endpoints[2][3];
+        int32_t expanded[2][3];
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            const int32_t quantized0 = (int32_t)((minEnd[c] - 32.0f) * (1.0f / 64.0f) + 0.5f);
+            const int32_t quantized1 = (int32_t)((maxEnd[c] - 32.0f) * (1.0f / 64.0f) + 0.5f);
+            endpoints[0][c] = (uint32_t)Clamp(quantized0, 0, 0x3ff);
+            endpoints[1][c] = (uint32_t)Clamp(quantized1, 0, 0x3ff);
+            expanded[0][c] = UnquantizeBC6H(endpoints[0][c]);
+            expanded[1][c] = UnquantizeBC6H(endpoints[1][c]);
+        }
+
+        float palette[16][3];
+        for (uint32_t p = 0; p < 16; p++)
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                palette[p][c] = (float)InterpolateBC6H(expanded[0][c], expanded[1][c], p);
+            }
+        }
+
+        uint32_t indices[16];
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            float bestDistance = FLT_MAX;
+            indices[i] = 0;
+            for (uint32_t p = 0; p < 16; p++)
+            {
+                const float r = values[i][0] - palette[p][0];
+                const float g = values[i][1] - palette[p][1];
+                const float b = values[i][2] - palette[p][2];
+                const float distance = r * r + g * g + b * b;
+                if (distance < bestDistance)
+                {
+                    bestDistance = distance;
+                    indices[i] = p;
+                }
+            }
+        }
+
+        // The anchor index has no leading bit, swap the end points if it's set.
+        if (indices[0] >= 8)
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                const uint32_t swap = endpoints[0][c];
+                endpoints[0][c] = endpoints[1][c];
+                endpoints[1][c] = swap;
+            }
+
+            for (uint32_t i = 0; i < 16; i++)
+            {
+                indices[i] = 15 - indices[i];
+            }
+        }
+
+        uint64_t low = 0;
+        uint64_t high = 0;
+        WriteBits128(low, high, 0, 5, YW3D_BC6H_MODE_11);
+        for (uint32_t e = 0; e < 2; e++)
+        {
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                WriteBits128(low, high, 5 + (e * 3 + c) * 10, 10, endpoints[e][c]);
+            }
+        }
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            WriteBits128(low, high, GetBC6HIndexPosition(i), (0 == i) ? 3 : 4, indices[i]);
+        }
+
+        WriteUInt64(outBlock, low);
+        WriteUInt64(outBlock + 8, high);
+    }
+
+    static void DecodeBC6HPixel(const uint8_t* block, const uint32_t pixel, Vector4& outColor)
+    {
+        const uint64_t low = ReadUInt64(block);
+        const uint64_t high = ReadUInt64(block + 8);
+        if (YW3D_BC6H_MODE_11 != ReadBits128(low, high, 0, 5))
+        {
+            // Other modes are not supported.
+            outColor.Set(0.0f, 0.0f, 0.0f, 1.0f);
+            return;
+        }
+
+        const uint32_t index = ReadBits128(low, high, GetBC6HIndexPosition(pixel), (0 == pixel) ? 3 : 4);
+
+        float color[3];
+        for (uint32_t c = 0; c < 3; c++)
+        {
+            const int32_t endpoint0 = UnquantizeBC6H(ReadBits128(low, high, 5 + c * 10, 10));
+            const int32_t endpoint1 = UnquantizeBC6H(ReadBits128(low, high, 35 + c * 10, 10));
+            color[c] = DecodeHalf((uint16_t)((InterpolateBC6H(endpoint0, endpoint1, index) * 31) >> 6));
+        }
+
+        outColor.Set(color[0], color[1], color[2], 1.0f);
+    }
+
+    // ------------------------------------------------------------------
+    // Block compressed formats.
+
+    uint32_t GetCompressedBlockBytes(const Yw3dFormat format)
+    {
+        switch (format)
+        {
+        case Yw3d_FMT_BC1:
+            return 8;
+        case Yw3d_FMT_BC3:
+        case Yw3d_FMT_BC5:
+        case Yw3d_FMT_BC6H:
+            return 16;
+        default:
+            return 0;
+        }
+    }
+
+    Yw3dFormat GetCompressedBlockFloatFormat(const Yw3dFormat format)
+    {
+        switch (format)
+        {
+        case Yw3d_FMT_BC1:
+        case Yw3d_FMT_BC3:
+            return Yw3d_FMT_R32G32B32A32F;
+        case Yw3d_FMT_BC5:
+            return Yw3d_FMT_R32G32F;
+        case Yw3d_FMT_BC6H:
+            return Yw3d_FMT_R32G32B32F;
+        default:
+            return Yw3d_FMT_NumFormats;
+        }
+    }
+
+    void DecodeCompressedPixel(const Yw3dFormat format, const uint8_t* block, const uint32_t x, const uint32_t y, Vector4& outColor)
+    {
+        const uint32_t pixel = y * YW3D_COMPRESSION_BLOCK_SIZE + x;
+        switch (format)
+        {
+        case Yw3d_FMT_BC1:
+            {
+                float color[4];
+                DecodeColorPixel(block, pixel, false, color);
+                outColor.Set(color[0], color[1], color[2], color[3]);
+            }
+            break;
+        case Yw3d_FMT_BC3:
+            {
+                // Alpha block followed by the color block.
+                float color[4];
+                DecodeColorPixel(block + 8, pixel, true, color);
+                outColor.Set(color[0], color[1], color[2], DecodeChannelPixel(block, pixel));
+            }
+            break;
+        case Yw3d_FMT_BC5:
+            outColor.Set(DecodeChannelPixel(block, pixel), DecodeChannelPixel(block + 8, pixel), 0.0f, 1.0f);
+            break;
+        case Yw3d_FMT_BC6H:
+            DecodeBC6HPixel(block, pixel, outColor);
+            break;
+        default:
+            outColor.Set(0.0f, 0.0f, 0.0f, 1.0f);
+            break;
+        }
+    }
+
+    void DecodeCompressedBlock(const Yw3dFormat format, const uint8_t* block, Vector4* outPixels)
+    {
+        for (uint32_t y = 0; y < YW3D_COMPRESSION_BLOCK_SIZE; y++)
+        {
+            for (uint32_t x = 0; x < YW3D_COMPRESSION_BLOCK_SIZE; x++)
+            {
+                DecodeCompressedPixel(format, block, x, y, outPixels[y * YW3D_COMPRESSION_BLOCK_SIZE + x]);
+            }
+        }
+    }
+
+    void EncodeCompressedBlock(const Yw3dFormat format, const Vector4* pixels, uint8_t* outBlock)
+    {
+        switch (format)
+        {
+        case Yw3d_FMT_BC1:
+            EncodeColorBlock(pixels, true, outBlock);
+            break;
+        case Yw3d_FMT_BC3:
+            {
+                float alphas[16];
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    alphas[i] = pixels[i].a;
+                }
+
+                EncodeChannelBlock(alphas, outBlock);
+                EncodeColorBlock(pixels, false, outBlock + 8);
+            }
+            break;
+        case Yw3d_FMT_BC5:
+            {
+                float reds[16];
+                float greens[16];
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    reds[i] = pixels[i].r;
+                    greens[i] = pixels[i].g;
+                }
+
+                EncodeChannelBlock(reds, outBlock);
+                EncodeChannelBlock(greens, outBlock + 8);
+            }
+            break;
+        case Yw3d_FMT_BC6H:
+            EncodeBC6HBlock(pixels, outBlock);
+            break;
+        default:
+            break;
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d block compression helpers.
+
+#ifndef __YW_3D_BLOCK_COMPRESSION_H__
+#define __YW_3D_BLOCK_COMPRESSION_H__
+
+#include "Yw3dBase.h"
+#include "Yw3dTypes.h"
+
+namespace yw
+{
+    // Edge length of the pixel blocks of block compressed formats.
+    #define YW3D_COMPRESSION_BLOCK_SIZE 4
+
+    // Returns true if a format is block compressed.
+    // @param[in] format member of the enumeration Yw3dFormat.
+    inline bool IsBlockCompressedFormat(const Yw3dFormat format)
+    {
+        return (format >= Yw3d_FMT_BC1) && (format <= Yw3d_FMT_BC6H);
+    }
+
+    // Returns the number of bytes of a 4x4 block of a block compressed format, 0 for other formats.
+    // @param[in] format member of the enumeration Yw3dFormat.
+    uint32_t GetCompressedBlockBytes(const Yw3dFormat format);
+
+    // Returns the float format holding all channels of a block compressed format, e.g. when it's decoded or before it's encoded.
+    // @param[in] format block compressed format.
+    // @return Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_NumFormats for other formats.
+    Yw3dFormat GetCompressedBlockFloatFormat(const Yw3dFormat format);
+
+    // Decodes one pixel of a block.
+    // @param[in] format block compressed format.
+    // @param[in] block the encoded block.
+    // @param[in] x position of the pixel in the block along x-axis, e [0,3].
+    // @param[in] y position of the pixel in the block along y-axis, e [0,3].
+    // @param[out] outColor receives the color of the pixel, undefined channels are set to the defaults of Yw3dFormat.
+    void DecodeCompressedPixel(const Yw3dFormat format, const uint8_t* block, const uint32_t x, const uint32_t y, Vector4& outColor);
+
+    // Decodes all pixels of a block.
+    // @param[in] format block compressed format.
+    // @param[in] block the encoded block.
+    // @param[out] outPixels receives the 16 pixels of the block row by row.
+    void DecodeCompressedBlock(const Yw3dFormat format, const uint8_t* block, Vector4* outPixels);
+
+    // Encodes the pixels of a block.
+    // @param[in] format block compressed format.
+    // @param[in] pixels the 16 pixels of the block row by row. Blocks at the edges of a surface should repeat the edge pixels.
+    // @param[out] outBlock receives the encoded block of GetCompressedBlockBytes() bytes.
+    void EncodeCompressedBlock(const Yw3dFormat format, const Vector4* pixels, uint8_t* outBlock);
+}
+
+#endif // !__YW_3D_BLOCK_COMPRESSION_H__
@@ -0,0 +1,130 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer constant buffer class.
+
+#include "Yw3dConstantBuffer.h"
+#include "Yw3dAllocator.h"
+#include "Yw3dDevice.h"
+
+namespace yw
+{
+    Yw3dConstantBuffer::Yw3dConstantBuffer(Yw3dDevice* device) :
+        m_Device(device),
+        m_Length(0),
+        m_FrontData(nullptr),
+        m_BackData(nullptr)
+    {
+        m_Device->AddRef();
+    }
+
+    Yw3dConstantBuffer::~Yw3dConstantBuffer()
+    {
+        if (m_BackData != m_FrontData)
+        {
+            YW3D_SAFE_FREE(m_Device->GetAllocator(), m_BackData);
+        }
+
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_FrontData);
+        YW_SAFE_RELEASE(m_Device);
+    }
+
+    Yw3dResult Yw3dConstantBuffer::Create(const uint32_t length, bool doubleBuffered)
+    {
+        if (0 == length)
+        {
+            LOGE(_T("Yw3dConstantBuffer::Create: parameter length is 0.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        // Get length.
+        m_Length = length;
+
+        // Create buffers by length, both are zeroed so shaders never read uninitialized constants.
+        m_FrontData = (uint8_t*)m_Device->GetAllocator()->Allocate(m_Length);
+        m_BackData = doubleBuffered ? (uint8_t*)m_Device->GetAllocator()->Allocate(m_Length) : m_FrontData;
+        if ((nullptr == m_FrontData) || (nullptr == m_BackData))
+        {
+            LOGE(_T("Yw3dConstantBuffer::Create: out of memory, cannot create constant buffer.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        memset(m_FrontData, 0, m_Length);
+        if (m_BackData != m_FrontData)
+        {
+            memset(m_BackData, 0, m_Length);
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dDevice* Yw3dConstantBuffer::AcquireDevice()
+    {
+        if (nullptr != m_Device)
+        {
+            m_Device->AddRef();
+        }
+
+        return m_Device;
+    }
+
+    Yw3dResult Yw3dConstantBuffer::Update(const void* data, const uint32_t offset, const uint32_t length)
+    {
+        if (nullptr == data)
+        {
+            LOGE(_T("Yw3dConstantBuffer::Update: parameter data points to null.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (offset >= m_Length)
+        {
+            LOGE(_T("Yw3dConstantBuffer::Update: offset exceeds constant buffer length.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        const uint32_t copyLength = (0 == length) ? (m_Length - offset) : length;
+        if (copyLength > m_Length - offset)
+        {
+            LOGE(_T("Yw3dConstantBuffer::Update: length exceeds constant buffer length.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        memcpy(m_BackData + offset, data, copyLength);
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dConstantBuffer::GetPointer(const uint32_t offset, void** pointer) const
+    {
+        if (nullptr == pointer)
+        {
+            LOGE(_T("Yw3dConstantBuffer::GetPointer: parameter pointer points to null.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (offset >= m_Length)
+        {
+            *pointer = nullptr;
+            LOGE(_T("Yw3dConstantBuffer::GetPointer: offset exceeds constant buffer length.\n"));
+
+            return Yw3d_E_InvalidParameters;
+        }
+
+        *pointer = m_BackData + offset;
+        return Yw3d_S_OK;
+    }
+
+    void Yw3dConstantBuffer::Flip()
+    {
+        uint8_t* frontData = m_FrontData;
+        m_FrontData = m_BackData;
+        m_BackData = frontData;
+    }
+
+    uint32_t Yw3dConstantBuffer::GetLength() const
+    {
+        return m_Length;
+    }
+
+    bool Yw3dConstantBuffer::IsDoubleBuffered() const
+    {
+        return m_FrontData != m_BackData;
+    }
+}
@@ -0,0 +1,88 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer constant buffer class.
+
+#ifndef __YW_3D_CONSTANT_BUFFER_H__
+#define __YW_3D_CONSTANT_BUFFER_H__
+
+#include "Yw3dBase.h"
+#include "Yw3dTypes.h"
+
+namespace yw
+{
+    // Constant buffers are memory blocks of shader constants, usually a struct declared by the application and its shaders.
+    // A buffer is updated as a whole and bound to a slot of the device, where vertex, triangle and pixel shaders read it.
+    // A double-buffered constant buffer is written to its back buffer while shaders read the front buffer, Flip() publishes the written constants.
+    class Yw3dConstantBuffer : public IBase
+    {
+        friend class Yw3dDevice;
+
+    protected:
+        // Accessible by Yw3dDevice which is the only class that may create a constant buffer.
+        // @param[in] device a pointer to the parent Yw3dDevice-object.
+        Yw3dConstantBuffer(class Yw3dDevice* device);
+
+        // Accessible by IBase. The destructor is called when the reference count reaches zero.
+        ~Yw3dConstantBuffer();
+
+    protected:
+        // Accessible by Yw3dDevice which is the only class that may create a constant buffer. The constants are initialized to 0.
+        // @param[in] length length of the constant buffer to be created in bytes.
+        // @param[in] doubleBuffered true to create a front and a back buffer.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult Create(const uint32_t length, bool doubleBuffered);
+
+    public:
+        // Returns a pointer to the associated device. Calling this function will increase the internal reference count of the device. 
+        // Failure to call Release() when finished using the pointer will result in a memory leak.
+        class Yw3dDevice* AcquireDevice();
+
+        // Copies constants to the buffer, the back buffer if double-buffered.
+        // @param[in] data the constants to be copied.
+        // @param[in] offset has to be specified in bytes.
+        // @param[in] length number of bytes to be copied, 0 copies up to the end of the buffer.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        Yw3dResult Update(const void* data, const uint32_t offset = 0, const uint32_t length = 0);
+
+        // Returns a pointer to the desired position in the buffer for writing constants in place, the back buffer if double-buffered.
+        // @param[in] offset has to be specified in bytes.
+        // @param[out] pointer receives the pointer to the constant buffer.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        Yw3dResult GetPointer(const uint32_t offset, void** pointer) const;
+
+        // Swaps the front and the back buffer of a double-buffered constant buffer, shaders read the constants written since the last flip.
+        // The new back buffer holds the constants before the last flip, so update it as a whole. Does nothing if the buffer is not double-buffered.
+        // Must not be called while the device is drawing.
+        void Flip();
+
+        // Returns the constants read by shaders, the front buffer if double-buffered.
+        inline const void* GetData() const;
+
+        // Returns the length of the buffer in bytes.
+        uint32_t GetLength() const;
+
+        // Returns true if the buffer is double-buffered.
+        bool IsDoubleBuffered() const;
+
+    private:
+        // Pointer to device.
+        class Yw3dDevice* m_Device;
+
+        // Length of the constant buffer in bytes.
+        uint32_t m_Length;
+
+        // Pointers to the front and the back buffer data, both point to the same data if not double-buffered.
+        uint8_t* m_FrontData;
+        uint8_t* m_BackData;
+    };
+
+    inline const void* Yw3dConstantBuffer::GetData() const
+    {
+        return m_FrontData;
+    }
+}
+
+#endif // !__YW_3D_CONSTANT_BUFFER_H__
@@ -43,17 +43,26 @@ namespace yw
 
 // ------------------------------------------------------------------
 // Include all core-headers.
+#include "Yw3dAllocator.h"
+#include "Yw3dBlockCompression.h"
+#include "Yw3dConstantBuffer.h"
+#include "Yw3dCpu.h"
 #include "Yw3dCubeTexture.h"
 #include "Yw3dDevice.h"
 #include "Yw3dIndexBuffer.h"
+#include "Yw3dMipmap.h"
 #include "Yw3dPrimitiveAssembler.h"
 #include "Yw3dRenderTarget.h"
 #include "Yw3dShader.h"
+#include "Yw3dShaderWide.h"
 #include "Yw3dSurface.h"
 #include "Yw3dTexture.h"
+#include "Yw3dTextureArray.h"
 #include "Yw3dVertexBuffer.h"
 #include "Yw3dVertexFormat.h"
+#include "Yw3dVirtualTexture.h"
 #include "Yw3dVolume.h"
 #include "Yw3dVolumeTexture.h"
+#include "Yw3dWorkerPool.h"
 
 #endif // !__YW_3D_CORE_H__
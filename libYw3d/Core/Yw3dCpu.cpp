@@ -0,0 +1,740 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer CPU feature detection and SIMD kernel dispatch.
+
+#include "Yw3dCpu.h"
+
+// The AVX2 and AVX-512 kernels are compiled for their target per function, so the rest of the library keeps the SSE2 baseline.
+// Only kernels meant to fuse multiplications and additions enable FMA, the compiler could contract the others and change their results.
+// AVX-512 implies FMA, so kernels multiplying and adding keep their AVX2 version in the AVX-512 table.
+#if defined(YW3D_SSE2) && (defined(_M_X64) || defined(_M_AMD64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__))
+    #define YW3D_CPU_X86 1
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+        #define YW3D_TARGET_AVX2
+        #define YW3D_TARGET_AVX2_FMA
+        #define YW3D_TARGET_AVX512
+    #else
+        #include <cpuid.h>
+        #include <immintrin.h>
+        #define YW3D_TARGET_AVX2 __attribute__((target("avx2")))
+        #define YW3D_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+        #define YW3D_TARGET_AVX512 __attribute__((target("avx512f")))
+    #endif
+#endif
+
+namespace yw
+{
+    // ------------------------------------------------------------------
+    // Feature detection.
+
+#ifdef YW3D_CPU_X86
+    // Queries a cpuid leaf, info receives eax, ebx, ecx and edx.
+    static void CpuId(uint32_t* info, uint32_t leaf, uint32_t subLeaf)
+    {
+    #if defined(_MSC_VER)
+        __cpuidex((int32_t*)info, (int32_t)leaf, (int32_t)subLeaf);
+    #else
+        __cpuid_count(leaf, subLeaf, info[0], info[1], info[2], info[3]);
+    #endif
+    }
+
+    // Returns the register state the OS saves on context switches, only valid if cpuid reports OSXSAVE.
+    static uint64_t ReadXcr0()
+    {
+    #if defined(_MSC_VER)
+        return _xgetbv(0);
+    #else
+        uint32_t eax = 0;
+        uint32_t edx = 0;
+        __asm__ volatile("xgetbv" : "=a" (eax), "=d" (edx) : "c" (0));
+        return ((uint64_t)edx << 32) | eax;
+    #endif
+    }
+#endif
+
+    static uint32_t DetectCpuFeatures()
+    {
+        uint32_t features = 0;
+
+    #ifdef YW3D_CPU_X86
+        uint32_t info[4] = {0, 0, 0, 0};
+        CpuId(info, 0, 0);
+        const uint32_t maxLeaf = info[0];
+
+        CpuId(info, 1, 0);
+        features |= (0 != (info[3] & (1 << 26))) ? Yw3d_CPU_SSE2 : 0;
+        features |= (0 != (info[2] & (1 << 19))) ? Yw3d_CPU_SSE41 : 0;
+
+        // The wide registers are only usable if the OS saves them: XMM and YMM state for AVX, additionally opmask and ZMM state for AVX-512.
+        const uint64_t xcr0 = (0 != (info[2] & (1 << 27))) ? ReadXcr0() : 0;
+        const bool ymmEnabled = (0x06 == (xcr0 & 0x06));
+        const bool zmmEnabled = (0xe6 == (xcr0 & 0xe6));
+        features |= (ymmEnabled && (0 != (info[2] & (1 << 28)))) ? Yw3d_CPU_AVX : 0;
+        features |= (ymmEnabled && (0 != (info[2] & (1 << 12)))) ? Yw3d_CPU_FMA : 0;
+
+        if (maxLeaf >= 7)
+        {
+            CpuId(info, 7, 0);
+            features |= (ymmEnabled && (0 != (info[1] & (1 << 5)))) ? Yw3d_CPU_AVX2 : 0;
+            features |= (zmmEnabled && (0 != (info[1] & (1 << 16)))) ? Yw3d_CPU_AVX512F : 0;
+        }
+    #endif
+
+        return features;
+    }
+
+    uint32_t QueryCpuFeatures()
+    {
+        static const uint32_t s_CpuFeatures = DetectCpuFeatures();
+        return s_CpuFeatures;
+    }
+
+    Yw3dSimdLevel SelectSimdLevel(uint32_t cpuFeatures, Yw3dSimdLevel maxLevel)
+    {
+        if ((maxLevel >= Yw3d_SIMD_AVX512) && (0 != (cpuFeatures & Yw3d_CPU_AVX512F)) && (0 != (cpuFeatures & Yw3d_CPU_AVX2)) && (0 != (cpuFeatures & Yw3d_CPU_FMA)))
+        {
+            return Yw3d_SIMD_AVX512;
+        }
+
+        if ((maxLevel >= Yw3d_SIMD_AVX2) && (0 != (cpuFeatures & Yw3d_CPU_AVX2)) && (0 != (cpuFeatures & Yw3d_CPU_FMA)))
+        {
+            return Yw3d_SIMD_AVX2;
+        }
+
+        if ((maxLevel >= Yw3d_SIMD_SSE2) && (0 != (cpuFeatures & Yw3d_CPU_SSE2)))
+        {
+            return Yw3d_SIMD_SSE2;
+        }
+
+        return Yw3d_SIMD_Scalar;
+    }
+
+    // ------------------------------------------------------------------
+    // Scalar kernels.
+
+    // Converts a channel value to 8 bits.
+    static inline uint8_t ConvertChannel(float value)
+    {
+        return (uint8_t)(Clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    static void FillPixelsScalar(float* destination, const float* pixel, uint32_t pixelFloats, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            for (uint32_t c = 0; c < pixelFloats; c++)
+            {
+                *destination++ = pixel[c];
+            }
+        }
+    }
+
+    static void ConvertToBGRXScalar(uint8_t* destination, const float* source, uint32_t sourceStride, uint32_t count)
+    {
+        for (uint32_t x = 0; x < count; x++, source += sourceStride, destination += 4)
+        {
+            destination[0] = ConvertChannel(source[2]);
+            destination[1] = ConvertChannel(source[1]);
+            destination[2] = ConvertChannel(source[0]);
+            destination[3] = 0;
+        }
+    }
+
+    static void AccumulateWeightedScalar(float* destination, const float* source, float weight, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            destination[i] += weight * source[i];
+        }
+    }
+
+    static void DownsampleBoxEvenRow4Scalar(const float* const* srcRows, uint32_t numRows, float* destRow, uint32_t destWidth)
+    {
+        const float scale = 1.0f / (float)(2 * numRows);
+        for (uint32_t x = 0; x < destWidth; x++)
+        {
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                float sum = 0.0f;
+                for (uint32_t r = 0; r < numRows; r++)
+                {
+                    sum += srcRows[r][8 * x + c] + srcRows[r][8 * x + 4 + c];
+                }
+
+                destRow[4 * x + c] = sum * scale;
+            }
+        }
+    }
+
+    static void TransformBatchScalar(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float x = v.x[i], y = v.y[i], z = v.z[i], w = v.w[i];
+            result.x[i] = x * m._11 + y * m._21 + z * m._31 + w * m._41;
+            result.y[i] = x * m._12 + y * m._22 + z * m._32 + w * m._42;
+            result.z[i] = x * m._13 + y * m._23 + z * m._33 + w * m._43;
+            result.w[i] = x * m._14 + y * m._24 + z * m._34 + w * m._44;
+        }
+    }
+
+    static void TransformNormalBatchScalar(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            const float x = v.x[i], y = v.y[i], z = v.z[i];
+            result.x[i] = x * m._11 + y * m._21 + z * m._31;
+            result.y[i] = x * m._12 + y * m._22 + z * m._32;
+            result.z[i] = x * m._13 + y * m._23 + z * m._33;
+            result.w[i] = 0.0f;
+        }
+    }
+
+    static void StepRegistersScalar(float* registers, const float* ddx, const uint32_t* mask, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (0 != mask[i])
+            {
+                registers[i] += ddx[i];
+            }
+        }
+    }
+
+    static void ScaleRegistersScalar(float* destination, const float* source, const uint32_t* mask, float value, uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (0 != mask[i])
+            {
+                destination[i] = source[i] * value;
+            }
+        }
+    }
+
+    static void FilterBilinear4Scalar(float* destination, const float* const* pixels, float weightX, float weightY)
+    {
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            const float top = Lerp(pixels[0][c], pixels[1][c], weightX);
+            const float bottom = Lerp(pixels[2][c], pixels[3][c], weightX);
+            destination[c] = Lerp(top, bottom, weightY);
+        }
+    }
+
+    static const Yw3dSimdKernels s_ScalarKernels =
+    {
+        Yw3d_SIMD_Scalar,
+        FillPixelsScalar,
+        ConvertToBGRXScalar,
+        AccumulateWeightedScalar,
+        DownsampleBoxEvenRow4Scalar,
+        TransformBatchScalar,
+        TransformNormalBatchScalar,
+        StepRegistersScalar,
+        ScaleRegistersScalar,
+        FilterBilinear4Scalar
+    };
+
+    // ------------------------------------------------------------------
+    // SSE2 kernels.
+
+#ifdef YW3D_SSE2
+    static void FillPixelsSSE2(float* destination, const float* pixel, uint32_t pixelFloats, uint32_t count)
+    {
+        // 12 floats hold a whole number of pixels of 2, 3 or 4 floats, the pattern is stored with 3 vectors.
+        float pattern[12];
+        for (uint32_t i = 0; i < 12; i++)
+        {
+            pattern[i] = pixel[i % pixelFloats];
+        }
+
+        const __m128 pattern0 = _mm_loadu_ps(pattern);
+        const __m128 pattern1 = _mm_loadu_ps(pattern + 4);
+        const __m128 pattern2 = _mm_loadu_ps(pattern + 8);
+        const uint32_t patternPixels = 12 / pixelFloats;
+        uint32_t x = 0;
+        for (; x + patternPixels <= count; x += patternPixels, destination += 12)
+        {
+            _mm_storeu_ps(destination, pattern0);
+            _mm_storeu_ps(destination + 4, pattern1);
+            _mm_storeu_ps(destination + 8, pattern2);
+        }
+
+        FillPixelsScalar(destination, pixel, pixelFloats, count - x);
+    }
+
+    static void ConvertToBGRXSSE2(uint8_t* destination, const float* source, uint32_t sourceStride, uint32_t count)
+    {
+        // Four floats are loaded per pixel, a 3 float pixel reads the first float of the next pixel, so leave the last one to the scalar loop.
+        const uint32_t vectorCount = (3 == sourceStride) ? count - 1 : count;
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 scale = _mm_set1_ps(255.0f);
+        const __m128i colorMask = _mm_set1_epi32(0x00ffffff);
+        uint32_t x = 0;
+        for (; x + 4 <= vectorCount; x += 4, source += sourceStride * 4, destination += 16)
+        {
+            // Clamp, reorder to b, g, r, a and scale each pixel, then pack 4 pixels down to bytes.
+            __m128i pixels[4];
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                __m128 color = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source + sourceStride * i), zero), one);
+                color = _mm_shuffle_ps(color, color, _MM_SHUFFLE(3, 0, 1, 2));
+                pixels[i] = _mm_cvtps_epi32(_mm_mul_ps(color, scale));
+            }
+
+            const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(pixels[0], pixels[1]), _mm_packs_epi32(pixels[2], pixels[3]));
+            _mm_storeu_si128((__m128i*)destination, _mm_and_si128(packed, colorMask));
+        }
+
+        ConvertToBGRXScalar(destination, source, sourceStride, count - x);
+    }
+
+    static void AccumulateWeightedSSE2(float* destination, const float* source, float weight, uint32_t count)
+    {
+        const __m128 weightSIMD = _mm_set1_ps(weight);
+        uint32_t i = 0;
+        for (; i + 4 <= count; i += 4)
+        {
+            _mm_storeu_ps(destination + i, _mm_add_ps(_mm_loadu_ps(destination + i), _mm_mul_ps(weightSIMD, _mm_loadu_ps(source + i))));
+        }
+
+        AccumulateWeightedScalar(destination + i, source + i, weight, count - i);
+    }
+
+    static void DownsampleBoxEvenRow4SSE2(const float* const* srcRows, uint32_t numRows, float* destRow, uint32_t destWidth)
+    {
+        // Sum the rows first, then add the horizontal neighbours.
+        const __m128 scale = _mm_set1_ps(1.0f / (float)(2 * numRows));
+        for (uint32_t x = 0; x < destWidth; x++)
+        {
+            __m128 sum = _mm_setzero_ps();
+            for (uint32_t r = 0; r < numRows; r++)
+            {
+                sum = _mm_add_ps(sum, _mm_add_ps(_mm_loadu_ps(srcRows[r] + 8 * x), _mm_loadu_ps(srcRows[r] + 8 * x + 4)));
+            }
+
+            _mm_storeu_ps(destRow + 4 * x, _mm_mul_ps(sum, scale));
+        }
+    }
+
+    static void TransformBatchSSE2(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count)
+    {
+        // Each matrix element is broadcast once and applied to 4 vertices per instruction, the sums are in the order of Vector4 * Matrix44.
+        const __m128 m11 = _mm_set1_ps(m._11), m12 = _mm_set1_ps(m._12), m13 = _mm_set1_ps(m._13), m14 = _mm_set1_ps(m._14);
+        const __m128 m21 = _mm_set1_ps(m._21), m22 = _mm_set1_ps(m._22), m23 = _mm_set1_ps(m._23), m24 = _mm_set1_ps(m._24);
+        const __m128 m31 = _mm_set1_ps(m._31), m32 = _mm_set1_ps(m._32), m33 = _mm_set1_ps(m._33), m34 = _mm_set1_ps(m._34);
+        const __m128 m41 = _mm_set1_ps(m._41), m42 = _mm_set1_ps(m._42), m43 = _mm_set1_ps(m._43), m44 = _mm_set1_ps(m._44);
+        for (uint32_t i = 0; i < count; i += 4)
+        {
+            const __m128 x = _mm_loadu_ps(&v.x[i]);
+            const __m128 y = _mm_loadu_ps(&v.y[i]);
+            const __m128 z = _mm_loadu_ps(&v.z[i]);
+            const __m128 w = _mm_loadu_ps(&v.w[i]);
+            _mm_storeu_ps(&result.x[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)), _mm_mul_ps(z, m31)), _mm_mul_ps(w, m41)));
+            _mm_storeu_ps(&result.y[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)), _mm_mul_ps(z, m32)), _mm_mul_ps(w, m42)));
+            _mm_storeu_ps(&result.z[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m13), _mm_mul_ps(y, m23)), _mm_mul_ps(z, m33)), _mm_mul_ps(w, m43)));
+            _mm_storeu_ps(&result.w[i], _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m14), _mm_mul_ps(y, m24)), _mm_mul_ps(z, m34)), _mm_mul_ps(w, m44)));
+        }
+    }
+
+    static void TransformNormalBatchSSE2(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count)
+    {
+        const __m128 m11 = _mm_set1_ps(m._11), m12 = _mm_set1_ps(m._12), m13 = _mm_set1_ps(m._13);
+        const __m128 m21 = _mm_set1_ps(m._21), m22 = _mm_set1_ps(m._22), m23 = _mm_set1_ps(m._23);
+        const __m128 m31 = _mm_set1_ps(m._31), m32 = _mm_set1_ps(m._32), m33 = _mm_set1_ps(m._33);
+        for (uint32_t i = 0; i < count; i += 4)
+        {
+            const __m128 x = _mm_loadu_ps(&v.x[i]);
+            const __m128 y = _mm_loadu_ps(&v.y[i]);
+            const __m128 z = _mm_loadu_ps(&v.z[i]);
+            _mm_storeu_ps(&result.x[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m11), _mm_mul_ps(y, m21)), _mm_mul_ps(z, m31)));
+            _mm_storeu_ps(&result.y[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m12), _mm_mul_ps(y, m22)), _mm_mul_ps(z, m32)));
+            _mm_storeu_ps(&result.z[i], _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m13), _mm_mul_ps(y, m23)), _mm_mul_ps(z, m33)));
+            _mm_storeu_ps(&result.w[i], _mm_setzero_ps());
+        }
+    }
+
+    static void StepRegistersSSE2(float* registers, const float* ddx, const uint32_t* mask, uint32_t count)
+    {
+        // Unused floats add 0 and keep their value.
+        for (uint32_t i = 0; i < count; i += 4)
+        {
+            const __m128 step = _mm_and_ps(_mm_loadu_ps(ddx + i), _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(mask + i))));
+            _mm_storeu_ps(registers + i, _mm_add_ps(_mm_loadu_ps(registers + i), step));
+        }
+    }
+
+    static void ScaleRegistersSSE2(float* destination, const float* source, const uint32_t* mask, float value, uint32_t count)
+    {
+        const __m128 valueSIMD = _mm_set1_ps(value);
+        for (uint32_t i = 0; i < count; i += 4)
+        {
+            const __m128 used = _mm_castsi128_ps(_mm_loadu_si128((const __m128i*)(mask + i)));
+            const __m128 scaled = _mm_mul_ps(_mm_loadu_ps(source + i), valueSIMD);
+            _mm_storeu_ps(destination + i, _mm_or_ps(_mm_and_ps(used, scaled), _mm_andnot_ps(used, _mm_loadu_ps(destination + i))));
+        }
+    }
+
+    static void FilterBilinear4SSE2(float* destination, const float* const* pixels, float weightX, float weightY)
+    {
+        const __m128 topLeft = _mm_loadu_ps(pixels[0]);
+        const __m128 bottomLeft = _mm_loadu_ps(pixels[2]);
+        const __m128 weightXSIMD = _mm_set1_ps(weightX);
+        const __m128 top = _mm_add_ps(topLeft, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pixels[1]), topLeft), weightXSIMD));
+        const __m128 bottom = _mm_add_ps(bottomLeft, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pixels[3]), bottomLeft), weightXSIMD));
+        _mm_storeu_ps(destination, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(weightY))));
+    }
+
+    static const Yw3dSimdKernels s_SSE2Kernels =
+    {
+        Yw3d_SIMD_SSE2,
+        FillPixelsSSE2,
+        ConvertToBGRXSSE2,
+        AccumulateWeightedSSE2,
+        DownsampleBoxEvenRow4SSE2,
+        TransformBatchSSE2,
+        TransformNormalBatchSSE2,
+        StepRegistersSSE2,
+        ScaleRegistersSSE2,
+        FilterBilinear4SSE2
+    };
+#endif
+
+    // ------------------------------------------------------------------
+    // AVX2 kernels.
+
+#ifdef YW3D_CPU_X86
+    YW3D_TARGET_AVX2 static void FillPixelsAVX2(float* destination, const float* pixel, uint32_t pixelFloats, uint32_t count)
+    {
+        // 24 floats hold a whole number of pixels of 2, 3 or 4 floats, the pattern is stored with 3 vectors.
+        float pattern[24];
+        for (uint32_t i = 0; i < 24; i++)
+        {
+            pattern[i] = pixel[i % pixelFloats];
+        }
+
+        const __m256 pattern0 = _mm256_loadu_ps(pattern);
+        const __m256 pattern1 = _mm256_loadu_ps(pattern + 8);
+        const __m256 pattern2 = _mm256_loadu_ps(pattern + 16);
+        const uint32_t patternPixels = 24 / pixelFloats;
+        uint32_t x = 0;
+        for (; x + patternPixels <= count; x += patternPixels, destination += 24)
+        {
+            _mm256_storeu_ps(destination, pattern0);
+            _mm256_storeu_ps(destination + 8, pattern1);
+            _mm256_storeu_ps(destination + 16, pattern2);
+        }
+
+        FillPixelsScalar(destination, pixel, pixelFloats, count - x);
+    }
+
+    YW3D_TARGET_AVX2 static void ConvertToBGRXAVX2(uint8_t* destination, const float* source, uint32_t sourceStride, uint32_t count)
+    {
+        // Pixels of 3 floats can't be loaded in pairs.
+        if (4 != sourceStride)
+        {
+            ConvertToBGRXSSE2(destination, source, sourceStride, count);
+            return;
+        }
+
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 scale = _mm256_set1_ps(255.0f);
+        const __m256i colorMask = _mm256_set1_epi32(0x00ffffff);
+
+        // Packing works within 128-bit lanes, the 8 pixels end up in the order 0, 2, 4, 6, 1, 3, 5, 7.
+        const __m256i pixelOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        uint32_t x = 0;
+        for (; x + 8 <= count; x += 8, source += 32, destination += 32)
+        {
+            // Clamp, reorder to b, g, r, a and scale 2 pixels per vector, then pack 8 pixels down to bytes.
+            __m256i pixels[4];
+            for (uint32_t i = 0; i < 4; i++)
+            {
+                __m256 color = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(source + 8 * i), zero), one);
+                color = _mm256_shuffle_ps(color, color, _MM_SHUFFLE(3, 0, 1, 2));
+                pixels[i] = _mm256_cvtps_epi32(_mm256_mul_ps(color, scale));
+            }
+
+            const __m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(pixels[0], pixels[1]), _mm256_packs_epi32(pixels[2], pixels[3]));
+            _mm256_storeu_si256((__m256i*)destination, _mm256_and_si256(_mm256_permutevar8x32_epi32(packed, pixelOrder), colorMask));
+        }
+
+        ConvertToBGRXSSE2(destination, source, sourceStride, count - x);
+    }
+
+    YW3D_TARGET_AVX2_FMA static void AccumulateWeightedAVX2(float* destination, const float* source, float weight, uint32_t count)
+    {
+        const __m256 weightSIMD = _mm256_set1_ps(weight);
+        uint32_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm256_storeu_ps(destination + i, _mm256_fmadd_ps(weightSIMD, _mm256_loadu_ps(source + i), _mm256_loadu_ps(destination + i)));
+        }
+
+        AccumulateWeightedScalar(destination + i, source + i, weight, count - i);
+    }
+
+    YW3D_TARGET_AVX2 static void DownsampleBoxEvenRow4AVX2(const float* const* srcRows, uint32_t numRows, float* destRow, uint32_t destWidth)
+    {
+        // Two destination pixels from four source pixels of each row, the rows are summed first, then the horizontal neighbours.
+        const __m256 scale = _mm256_set1_ps(1.0f / (float)(2 * numRows));
+        uint32_t x = 0;
+        for (; x + 2 <= destWidth; x += 2)
+        {
+            __m256 left = _mm256_setzero_ps();
+            __m256 right = _mm256_setzero_ps();
+            for (uint32_t r = 0; r < numRows; r++)
+            {
+                left = _mm256_add_ps(left, _mm256_loadu_ps(srcRows[r] + 8 * x));
+                right = _mm256_add_ps(right, _mm256_loadu_ps(srcRows[r] + 8 * x + 8));
+            }
+
+            const __m256 sum = _mm256_add_ps(_mm256_permute2f128_ps(left, right, 0x20), _mm256_permute2f128_ps(left, right, 0x31));
+            _mm256_storeu_ps(destRow + 4 * x, _mm256_mul_ps(sum, scale));
+        }
+
+        if (x < destWidth)
+        {
+            const float* remainingRows[4];
+            for (uint32_t r = 0; r < numRows; r++)
+            {
+                remainingRows[r] = srcRows[r] + 8 * x;
+            }
+
+            DownsampleBoxEvenRow4SSE2(remainingRows, numRows, destRow + 4 * x, destWidth - x);
+        }
+    }
+
+    YW3D_TARGET_AVX2 static void TransformBatchAVX2(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count)
+    {
+        // Like the SSE2 kernel with 8 vertices per instruction, products are not fused to keep the results of Vector4 * Matrix44.
+        const __m256 m11 = _mm256_set1_ps(m._11), m12 = _mm256_set1_ps(m._12), m13 = _mm256_set1_ps(m._13), m14 = _mm256_set1_ps(m._14);
+        const __m256 m21 = _mm256_set1_ps(m._21), m22 = _mm256_set1_ps(m._22), m23 = _mm256_set1_ps(m._23), m24 = _mm256_set1_ps(m._24);
+        const __m256 m31 = _mm256_set1_ps(m._31), m32 = _mm256_set1_ps(m._32), m33 = _mm256_set1_ps(m._33), m34 = _mm256_set1_ps(m._34);
+        const __m256 m41 = _mm256_set1_ps(m._41), m42 = _mm256_set1_ps(m._42), m43 = _mm256_set1_ps(m._43), m44 = _mm256_set1_ps(m._44);
+        uint32_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(&v.x[i]);
+            const __m256 y = _mm256_loadu_ps(&v.y[i]);
+            const __m256 z = _mm256_loadu_ps(&v.z[i]);
+            const __m256 w = _mm256_loadu_ps(&v.w[i]);
+            _mm256_storeu_ps(&result.x[i], _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m11), _mm256_mul_ps(y, m21)), _mm256_mul_ps(z, m31)), _mm256_mul_ps(w, m41)));
+            _mm256_storeu_ps(&result.y[i], _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m12), _mm256_mul_ps(y, m22)), _mm256_mul_ps(z, m32)), _mm256_mul_ps(w, m42)));
+            _mm256_storeu_ps(&result.z[i], _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m13), _mm256_mul_ps(y, m23)), _mm256_mul_ps(z, m33)), _mm256_mul_ps(w, m43)));
+            _mm256_storeu_ps(&result.w[i], _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m14), _mm256_mul_ps(y, m24)), _mm256_mul_ps(z, m34)), _mm256_mul_ps(w, m44)));
+        }
+
+        // A batch of 4 vertices.
+        if (i < count)
+        {
+            Yw3dShaderRegisterBatch remaining;
+            memcpy(remaining.x, &v.x[i], 4 * sizeof(float));
+            memcpy(remaining.y, &v.y[i], 4 * sizeof(float));
+            memcpy(remaining.z, &v.z[i], 4 * sizeof(float));
+            memcpy(remaining.w, &v.w[i], 4 * sizeof(float));
+            TransformBatchSSE2(remaining, remaining, m, 4);
+            memcpy(&result.x[i], remaining.x, 4 * sizeof(float));
+            memcpy(&result.y[i], remaining.y, 4 * sizeof(float));
+            memcpy(&result.z[i], remaining.z, 4 * sizeof(float));
+            memcpy(&result.w[i], remaining.w, 4 * sizeof(float));
+        }
+    }
+
+    YW3D_TARGET_AVX2 static void TransformNormalBatchAVX2(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count)
+    {
+        const __m256 m11 = _mm256_set1_ps(m._11), m12 = _mm256_set1_ps(m._12), m13 = _mm256_set1_ps(m._13);
+        const __m256 m21 = _mm256_set1_ps(m._21), m22 = _mm256_set1_ps(m._22), m23 = _mm256_set1_ps(m._23);
+        const __m256 m31 = _mm256_set1_ps(m._31), m32 = _mm256_set1_ps(m._32), m33 = _mm256_set1_ps(m._33);
+        uint32_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 x = _mm256_loadu_ps(&v.x[i]);
+            const __m256 y = _mm256_loadu_ps(&v.y[i]);
+            const __m256 z = _mm256_loadu_ps(&v.z[i]);
+            _mm256_storeu_ps(&result.x[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m11), _mm256_mul_ps(y, m21)), _mm256_mul_ps(z, m31)));
+            _mm256_storeu_ps(&result.y[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m12), _mm256_mul_ps(y, m22)), _mm256_mul_ps(z, m32)));
+            _mm256_storeu_ps(&result.z[i], _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, m13), _mm256_mul_ps(y, m23)), _mm256_mul_ps(z, m33)));
+            _mm256_storeu_ps(&result.w[i], _mm256_setzero_ps());
+        }
+
+        // A batch of 4 vertices.
+        for (; i < count; i++)
+        {
+            const float x = v.x[i], y = v.y[i], z = v.z[i];
+            result.x[i] = x * m._11 + y * m._21 + z * m._31;
+            result.y[i] = x * m._12 + y * m._22 + z * m._32;
+            result.z[i] = x * m._13 + y * m._23 + z * m._33;
+            result.w[i] = 0.0f;
+        }
+    }
+
+    YW3D_TARGET_AVX2 static void StepRegistersAVX2(float* registers, const float* ddx, const uint32_t* mask, uint32_t count)
+    {
+        uint32_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 step = _mm256_and_ps(_mm256_loadu_ps(ddx + i), _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(mask + i))));
+            _mm256_storeu_ps(registers + i, _mm256_add_ps(_mm256_loadu_ps(registers + i), step));
+        }
+
+        // A register left.
+        StepRegistersSSE2(registers + i, ddx + i, mask + i, count - i);
+    }
+
+    YW3D_TARGET_AVX2 static void ScaleRegistersAVX2(float* destination, const float* source, const uint32_t* mask, float value, uint32_t count)
+    {
+        const __m256 valueSIMD = _mm256_set1_ps(value);
+        uint32_t i = 0;
+        for (; i + 8 <= count; i += 8)
+        {
+            const __m256 used = _mm256_castsi256_ps(_mm256_loadu_si256((const __m256i*)(mask + i)));
+            const __m256 scaled = _mm256_mul_ps(_mm256_loadu_ps(source + i), valueSIMD);
+            _mm256_storeu_ps(destination + i, _mm256_blendv_ps(_mm256_loadu_ps(destination + i), scaled, used));
+        }
+
+        // A register left.
+        ScaleRegistersSSE2(destination + i, source + i, mask + i, value, count - i);
+    }
+
+    YW3D_TARGET_AVX2 static void FilterBilinear4AVX2(float* destination, const float* const* pixels, float weightX, float weightY)
+    {
+        // The top row in the lower and the bottom row in the upper lane, both rows are interpolated at once.
+        const __m256 left = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pixels[0])), _mm_loadu_ps(pixels[2]), 1);
+        const __m256 right = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(pixels[1])), _mm_loadu_ps(pixels[3]), 1);
+        const __m256 rows = _mm256_add_ps(left, _mm256_mul_ps(_mm256_sub_ps(right, left), _mm256_set1_ps(weightX)));
+        const __m128 top = _mm256_castps256_ps128(rows);
+        const __m128 bottom = _mm256_extractf128_ps(rows, 1);
+        _mm_storeu_ps(destination, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(weightY))));
+    }
+
+    static const Yw3dSimdKernels s_AVX2Kernels =
+    {
+        Yw3d_SIMD_AVX2,
+        FillPixelsAVX2,
+        ConvertToBGRXAVX2,
+        AccumulateWeightedAVX2,
+        DownsampleBoxEvenRow4AVX2,
+        TransformBatchAVX2,
+        TransformNormalBatchAVX2,
+        StepRegistersAVX2,
+        ScaleRegistersAVX2,
+        FilterBilinear4AVX2
+    };
+
+    // ------------------------------------------------------------------
+    // AVX-512 kernels.
+
+    YW3D_TARGET_AVX512 static void FillPixelsAVX512(float* destination, const float* pixel, uint32_t pixelFloats, uint32_t count)
+    {
+        // 48 floats hold a whole number of pixels of 2, 3 or 4 floats, the pattern is stored with 3 vectors.
+        float pattern[48];
+        for (uint32_t i = 0; i < 48; i++)
+        {
+            pattern[i] = pixel[i % pixelFloats];
+        }
+
+        const __m512 pattern0 = _mm512_loadu_ps(pattern);
+        const __m512 pattern1 = _mm512_loadu_ps(pattern + 16);
+        const __m512 pattern2 = _mm512_loadu_ps(pattern + 32);
+        const uint32_t patternPixels = 48 / pixelFloats;
+        uint32_t x = 0;
+        for (; x + patternPixels <= count; x += patternPixels, destination += 48)
+        {
+            _mm512_storeu_ps(destination, pattern0);
+            _mm512_storeu_ps(destination + 16, pattern1);
+            _mm512_storeu_ps(destination + 32, pattern2);
+        }
+
+        FillPixelsAVX2(destination, pixel, pixelFloats, count - x);
+    }
+
+    YW3D_TARGET_AVX512 static void AccumulateWeightedAVX512(float* destination, const float* source, float weight, uint32_t count)
+    {
+        const __m512 weightSIMD = _mm512_set1_ps(weight);
+        uint32_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            _mm512_storeu_ps(destination + i, _mm512_fmadd_ps(weightSIMD, _mm512_loadu_ps(source + i), _mm512_loadu_ps(destination + i)));
+        }
+
+        AccumulateWeightedAVX2(destination + i, source + i, weight, count - i);
+    }
+
+    // Returns the lanes of a vector of 16 floats covering the remaining count floats.
+    YW3D_TARGET_AVX512 static inline __mmask16 RemainingLanes(uint32_t count)
+    {
+        return (count >= 16) ? (__mmask16)0xffff : (__mmask16)((1u << count) - 1);
+    }
+
+    YW3D_TARGET_AVX512 static void StepRegistersAVX512(float* registers, const float* ddx, const uint32_t* mask, uint32_t count)
+    {
+        // The unused and the remaining floats are masked out of the loads, the adds and the stores.
+        for (uint32_t i = 0; i < count; i += 16)
+        {
+            const __mmask16 lanes = RemainingLanes(count - i);
+            const __m512i maskSIMD = _mm512_maskz_loadu_epi32(lanes, mask + i);
+            const __mmask16 used = _mm512_test_epi32_mask(maskSIMD, maskSIMD);
+            const __m512 values = _mm512_maskz_loadu_ps(used, registers + i);
+            _mm512_mask_storeu_ps(registers + i, used, _mm512_add_ps(values, _mm512_maskz_loadu_ps(used, ddx + i)));
+        }
+    }
+
+    YW3D_TARGET_AVX512 static void ScaleRegistersAVX512(float* destination, const float* source, const uint32_t* mask, float value, uint32_t count)
+    {
+        const __m512 valueSIMD = _mm512_set1_ps(value);
+        for (uint32_t i = 0; i < count; i += 16)
+        {
+            const __mmask16 lanes = RemainingLanes(count - i);
+            const __m512i maskSIMD = _mm512_maskz_loadu_epi32(lanes, mask + i);
+            const __mmask16 used = _mm512_test_epi32_mask(maskSIMD, maskSIMD);
+            _mm512_mask_storeu_ps(destination + i, used, _mm512_mul_ps(_mm512_maskz_loadu_ps(used, source + i), valueSIMD));
+        }
+    }
+
+    // Packing bytes needs AVX-512 BW, the downsample is bound by memory and the transforms and the bilinear filter would be fused, so these keep the AVX2 kernels.
+    static const Yw3dSimdKernels s_AVX512Kernels =
+    {
+        Yw3d_SIMD_AVX512,
+        FillPixelsAVX512,
+        ConvertToBGRXAVX2,
+        AccumulateWeightedAVX512,
+        DownsampleBoxEvenRow4AVX2,
+        TransformBatchAVX2,
+        TransformNormalBatchAVX2,
+        StepRegistersAVX512,
+        ScaleRegistersAVX512,
+        FilterBilinear4AVX2
+    };
+#endif
+
+    // ------------------------------------------------------------------
+    // Dispatch.
+
+    const Yw3dSimdKernels* GetSimdLevelKernels(Yw3dSimdLevel level)
+    {
+    #ifdef YW3D_CPU_X86
+        if (level >= Yw3d_SIMD_AVX512)
+        {
+            return &s_AVX512Kernels;
+        }
+
+        if (level >= Yw3d_SIMD_AVX2)
+        {
+            return &s_AVX2Kernels;
+        }
+    #endif
+
+    #ifdef YW3D_SSE2
+        if (level >= Yw3d_SIMD_SSE2)
+        {
+            return &s_SSE2Kernels;
+        }
+    #endif
+
+        return &s_ScalarKernels;
+    }
+}
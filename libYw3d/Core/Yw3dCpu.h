@@ -0,0 +1,91 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer CPU feature detection and SIMD kernel dispatch.
+
+#ifndef __YW_3D_CPU_H__
+#define __YW_3D_CPU_H__
+
+#include "Yw3dBase.h"
+#include "Yw3dTypes.h"
+
+namespace yw
+{
+    // Hot loops with a version for each Yw3dSimdLevel, so a single binary built for the SSE2 baseline uses the wider units of the CPU it runs on.
+    // The device selects a table at creation time, see Yw3dDevice::GetSimdKernels(). All versions compute the same results up to float rounding.
+    struct Yw3dSimdKernels
+    {
+        // The level of this table. Member of the enumeration Yw3dSimdLevel.
+        Yw3dSimdLevel level;
+
+        // Fills pixels of 2, 3 or 4 floats with the same value, used to clear float surfaces.
+        // @param[out] destination the first pixel.
+        // @param[in] pixel the value of a pixel.
+        // @param[in] pixelFloats number of floats of a pixel.
+        // @param[in] count number of pixels.
+        void (*fillPixels)(float* destination, const float* pixel, uint32_t pixelFloats, uint32_t count);
+
+        // Converts a span of colorbuffer pixels to 32-bit b, g, r, x backbuffer pixels without sRGB encoding.
+        // @param[out] destination the first backbuffer pixel.
+        // @param[in] source the first colorbuffer pixel.
+        // @param[in] sourceStride floats between two source pixels, 0 to convert a single color. Pixels are read as 4 floats except the last one.
+        // @param[in] count number of pixels.
+        void (*convertToBGRX)(uint8_t* destination, const float* source, uint32_t sourceStride, uint32_t count);
+
+        // Adds a weighted row to another one: destination[i] += weight * source[i], used by the separable mip filters.
+        // @param[in,out] destination the accumulated row.
+        // @param[in] source the row to be added.
+        // @param[in] weight the weight of the source row.
+        // @param[in] count number of floats.
+        void (*accumulateWeighted)(float* destination, const float* source, float weight, uint32_t count);
+
+        // Downsamples a row of 4 float pixels with the 2x2 (2x2x2) box kernel, the source dimensions are even.
+        // @param[in] srcRows the 2 (4) source rows covered by the destination row.
+        // @param[in] numRows number of source rows.
+        // @param[out] destRow the destination row.
+        // @param[in] destWidth number of pixels of the destination row.
+        void (*downsampleBoxEvenRow4)(const float* const* srcRows, uint32_t numRows, float* destRow, uint32_t destWidth);
+
+        // Transforms a register of a batch of vertices by a matrix, see IYw3dVertexShader::TransformBatch().
+        void (*transformBatch)(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count);
+
+        // Transforms the xyz-components of a register of a batch of vertices by a matrix, see IYw3dVertexShader::TransformNormalBatch().
+        void (*transformNormalBatch)(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count);
+
+        // Steps the shader registers of a scanline to the next pixel: registers[i] += ddx[i] for the used floats.
+        // @param[in,out] registers the floats of the shader registers.
+        // @param[in] ddx the partial derivatives of the registers with respect to the screen-space x-coordinate.
+        // @param[in] mask all bits set for each used float, 0 for the others, which are left unchanged.
+        // @param[in] count number of floats, a multiple of 4.
+        void (*stepRegisters)(float* registers, const float* ddx, const uint32_t* mask, uint32_t count);
+
+        // Multiplies the shader registers by a value, used to divide the interpolated registers by w: destination[i] = source[i] * value for the used floats.
+        // @param[in,out] destination the multiplied registers, may be source.
+        // @param[in] source the registers to be multiplied.
+        // @param[in] mask all bits set for each used float, 0 for the others, which are left unchanged in the destination.
+        // @param[in] value the factor.
+        // @param[in] count number of floats, a multiple of 4.
+        void (*scaleRegisters)(float* destination, const float* source, const uint32_t* mask, float value, uint32_t count);
+
+        // Filters 4 pixels of 4 floats bilinearly, like Vector4Lerp() of the rows and then of the columns, used by the linear texture filter.
+        // @param[out] destination the filtered 4 floats.
+        // @param[in] pixels the top-left, top-right, bottom-left and bottom-right pixels.
+        // @param[in] weightX the interpolation factor between the left and the right pixels.
+        // @param[in] weightY the interpolation factor between the top and the bottom row.
+        void (*filterBilinear4)(float* destination, const float* const* pixels, float weightX, float weightY);
+    };
+
+    // Detects the features of the CPU with cpuid once, later calls return the cached result.
+    // @return a combination of Yw3dCpuFeature flags, 0 on other architectures than x86.
+    uint32_t QueryCpuFeatures();
+
+    // Returns the best SIMD level supported by a CPU.
+    // @param[in] cpuFeatures a combination of Yw3dCpuFeature flags.
+    // @param[in] maxLevel highest level to be selected. Member of the enumeration Yw3dSimdLevel.
+    // @return the selected level. Member of the enumeration Yw3dSimdLevel.
+    Yw3dSimdLevel SelectSimdLevel(uint32_t cpuFeatures, Yw3dSimdLevel maxLevel);
+
+    // Returns the kernels of a SIMD level, levels not compiled into this build fall back to the next lower one.
+    // @param[in] level member of the enumeration Yw3dSimdLevel.
+    const Yw3dSimdKernels* GetSimdLevelKernels(Yw3dSimdLevel level);
+}
+
+#endif // !__YW_3D_CPU_H__
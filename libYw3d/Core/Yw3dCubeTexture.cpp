@@ -4,6 +4,7 @@
 #include "Yw3dCubeTexture.h"
 #include "Yw3dDevice.h"
 #include "Yw3dTexture.h"
+#include "Yw3dWorkerPool.h"
 
 namespace yw
 {
@@ -25,7 +26,7 @@ namespace yw
         }
     }
 
-    Yw3dResult Yw3dCubeTexture::Create(uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format)
+    Yw3dResult Yw3dCubeTexture::Create(uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout)
     {
         if (0 == edgeLength)
         {
@@ -33,7 +34,7 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
-        if ((format < Yw3d_FMT_R32F) || (format > Yw3d_FMT_R32G32B32A32F))
+        if (((format < Yw3d_FMT_R32F) || (format > Yw3d_FMT_R32G32B32A32F)) && !IsBlockCompressedFormat(format) && !IsCompactFormat(format))
         {
             LOGE(_T("Yw3dCubeTexture::Create: invalid format specified.\n"));
             return Yw3d_E_InvalidFormat;
@@ -42,7 +43,7 @@ namespace yw
         Yw3dResult resCreate = Yw3d_E_Unknown;
         for (uint32_t faceIdx = Yw3d_CF_Positive_X; faceIdx <= Yw3d_CF_Negative_Z; faceIdx++)
         {
-            resCreate = m_Device->CreateTexture(&m_CubeFaces[faceIdx], edgeLength, edgeLength, mipLevels, format);
+            resCreate = m_Device->CreateTexture(&m_CubeFaces[faceIdx], edgeLength, edgeLength, mipLevels, format, layout);
             if (YW3D_FAILED(resCreate))
             {
                 return resCreate;
@@ -58,6 +59,52 @@ namespace yw
     }
 
     Yw3dResult Yw3dCubeTexture::SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
+    {
+        float faceU = 0.0f;
+        float faceV = 0.0f;
+        const Yw3dCubeFaces face = GetFaceCoordinates(u, v, w, faceU, faceV);
+
+        return m_CubeFaces[face]->SampleTexture(color, faceU, faceV, 0.0f, lod, xGradient, yGradient, samplerStates);
+    }
+
+    void Yw3dCubeTexture::ResolveFastClear()
+    {
+        for (uint32_t faceIdx = Yw3d_CF_Positive_X; faceIdx <= Yw3d_CF_Negative_Z; faceIdx++)
+        {
+            m_CubeFaces[faceIdx]->ResolveFastClear();
+        }
+    }
+
+    Yw3dSampleFunction Yw3dCubeTexture::GetSampleFunction(const uint32_t* samplerStates) const
+    {
+        // Sampling functions by format, mip-filter, minification-filter and magnification-filter.
+        #define YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, min) { &Yw3dCubeTexture::SampleTextureSpecialized<format, mip, min, false>, &Yw3dCubeTexture::SampleTextureSpecialized<format, mip, min, true> }
+        #define YW3D_SAMPLE_FUNCTIONS_MIN(format, mip) { YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, false), YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, true) }
+        #define YW3D_SAMPLE_FUNCTIONS_MIP(format) { YW3D_SAMPLE_FUNCTIONS_MIN(format, false), YW3D_SAMPLE_FUNCTIONS_MIN(format, true) }
+
+        static const Yw3dSampleFunction sampleFunctions[Yw3d_FMT_NumFormats][2][2][2] =
+        {
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32B32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32B32A32F),
+            {}, {}, {}, {}, {}, {}, {}, {}, // Index, packed depth and block compressed formats.
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8A8),
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16B16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16B16A16F),
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8_SRGB), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8A8_SRGB)
+        };
+
+        #undef YW3D_SAMPLE_FUNCTIONS_MIP
+        #undef YW3D_SAMPLE_FUNCTIONS_MIN
+        #undef YW3D_SAMPLE_FUNCTIONS_MAG
+
+        const Yw3dSampleFunction sampleFunction = sampleFunctions[GetFormat()]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MipFilter]) ? 1 : 0]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MinFilter]) ? 1 : 0]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MagFilter]) ? 1 : 0];
+
+        // Packed depth and block compressed textures are sampled by the generic function.
+        return (nullptr != sampleFunction) ? sampleFunction : IYw3dBaseTexture::GetSampleFunction(samplerStates);
+    }
+
+    Yw3dCubeFaces Yw3dCubeTexture::GetFaceCoordinates(float u, float v, float w, float& faceU, float& faceV)
     {
         // Determine face and local u/v coordinates ...
         // source: https://www.nvidia.com/object/cube_map_ogl_tutorial.html
@@ -142,21 +189,91 @@ namespace yw
         // s = (sc / |ma| + 1) / 2.
         // t = (tc / |ma| + 1) / 2.
         invMag *= 0.5f;
-        const float finalU = /*Saturate*/(cu * invMag + 0.5f);
-        const float finalV = /*Saturate*/(cv * invMag + 0.5f);
+        faceU = /*Saturate*/(cu * invMag + 0.5f);
+        faceV = /*Saturate*/(cv * invMag + 0.5f);
 
-        return m_CubeFaces[face]->SampleTexture(color, finalU, finalV, 0.0f, lod, xGradient, yGradient, samplerStates);
+        return face;
     }
 
-    Yw3dResult Yw3dCubeTexture::GenerateMipSubLevels(uint32_t srcLevel)
+    template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag>
+    Yw3dResult Yw3dCubeTexture::SampleTextureSpecialized(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
     {
-        Yw3dResult resFace = Yw3d_E_Unknown;
-        for (uint32_t faceIdx = Yw3d_CF_Positive_X; faceIdx <= Yw3d_CF_Negative_Z; faceIdx++)
+        if ((0.0f == u) && (0.0f == v) && (0.0f == w))
+        {
+            color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
+            LOGE(_T("Yw3dCubeTexture::SampleTextureSpecialized: sampling vector [u,v,w] = [0,0,0].\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        float faceU = 0.0f;
+        float faceV = 0.0f;
+        const Yw3dCubeFaces face = GetFaceCoordinates(u, v, w, faceU, faceV);
+
+        // The face coordinates may exceed [0,1] by rounding errors.
+        ((Yw3dCubeTexture*)texture)->m_CubeFaces[face]->SampleMipLevels<format, linearMip, linearMin, linearMag>(color, Saturate(faceU), Saturate(faceV), lod, xGradient, yGradient, samplerStates);
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dCubeTexture::GenerateMipSubLevels(uint32_t srcLevel, Yw3dMipFilter filter)
+    {
+        if ((srcLevel + 1) > GetMipLevels())
+        {
+            LOGE(_T("Yw3dCubeTexture::GenerateMipSubLevels: srcLevel refers either to last mip-level or is larger than the number of mip-levels.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        // Compact and block compressed faces are converted through float textures face by face.
+        if (0 == GetFormatFloats())
+        {
+            for (uint32_t faceIdx = Yw3d_CF_Positive_X; faceIdx <= Yw3d_CF_Negative_Z; faceIdx++)
+            {
+                Yw3dResult resFace = m_CubeFaces[faceIdx]->GenerateMipSubLevels(srcLevel, filter);
+                if (YW3D_FAILED(resFace))
+                {
+                    return resFace;
+                }
+            }
+
+            return Yw3d_S_OK;
+        }
+
+        if ((filter < Yw3d_MF_Box) || (filter >= Yw3d_MF_NumMipFilters))
         {
-            resFace = m_CubeFaces[faceIdx]->GenerateMipSubLevels(srcLevel);
-            if (YW3D_FAILED(resFace))
+            LOGE(_T("Yw3dCubeTexture::GenerateMipSubLevels: invalid mip filter specified.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        // Generate by each mip level, the rows of all six faces are downsampled concurrently.
+        for (uint32_t level = srcLevel + 1; level < GetMipLevels(); level++)
+        {
+            Yw3dMipLevelData levelData[Yw3d_CF_Negative_Z + 1];
+            Yw3dResult resLock = Yw3d_S_OK;
+            uint32_t lockedFaces = 0;
+            for (; lockedFaces <= Yw3d_CF_Negative_Z; lockedFaces++)
+            {
+                resLock = m_CubeFaces[lockedFaces]->LockMipLevelData(level, levelData[lockedFaces]);
+                if (YW3D_FAILED(resLock))
+                {
+                    break;
+                }
+            }
+
+            if (YW3D_SUCCESSFUL(resLock))
+            {
+                GenerateMipLevels(m_Device->GetWorkerPool(), m_Device->GetSimdKernels(), levelData, lockedFaces, GetFormatFloats(), filter);
+            }
+
+            // Unlock data.
+            for (uint32_t faceIdx = 0; faceIdx < lockedFaces; faceIdx++)
+            {
+                m_CubeFaces[faceIdx]->UnlockRect(level);
+                m_CubeFaces[faceIdx]->UnlockRect(level - 1);
+            }
+
+            if (YW3D_FAILED(resLock))
             {
-                return resFace;
+                return resLock;
             }
         }
 
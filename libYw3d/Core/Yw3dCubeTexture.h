@@ -27,12 +27,13 @@ namespace yw
         // Accessible by Yw3dDevice which is the only class that may create a cube texture.
         // @param[in] edgeLength edge length of the cube texture to be created in pixels.
         // @param[in] mipLevels number of mip-levels to be created. Specify 0 to create a full mip-chain.
-        // @param[in] format format of the texture to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // @param[in] format format of the texture to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
+        // @param[in] layout memory layout of the mip-levels of each face. Member of the enumeration Yw3dSurfaceLayout.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
-        Yw3dResult Create(uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format);
+        Yw3dResult Create(uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout = Yw3d_SL_Linear);
 
         // Sampling this texture requires a 3-dimensional floating point vector.
         Yw3dTextureSampleInput GetTextureSampleInput() const;
@@ -50,12 +51,35 @@ namespace yw
         // @return Yw3d_S_OK if the function succeeds.
         Yw3dResult SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
 
+        // Returns a sampling function specialized for the format of the texture and the filter and mip states.
+        // @param[in] samplerStates texture sampler states.
+        Yw3dSampleFunction GetSampleFunction(const uint32_t* samplerStates) const;
+
+        // Writes the pending fast cleared tiles of all mip-levels of the six faces.
+        void ResolveFastClear();
+
+    private:
+        // Determines the cube face a lookup-vector points to and the coordinates on this face.
+        // @param[in] u u-component of the lookup-vector.
+        // @param[in] v v-component of the lookup-vector.
+        // @param[in] w w-component of the lookup-vector.
+        // @param[out] faceU receives the u-coordinate on the face.
+        // @param[out] faceV receives the v-coordinate on the face.
+        // @return the cube face.
+        static Yw3dCubeFaces GetFaceCoordinates(float u, float v, float w, float& faceU, float& faceV);
+
+        // Sampling function specialized for the format and the filter states.
+        template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag>
+        static Yw3dResult SampleTextureSpecialized(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
     public:
-        // Generates mip-sublevels through downsampling (using a box-filter) a given source mip-level.
+        // Generates mip-sublevels through downsampling (using a box-filter by default) a given source mip-level.
+        // The rows of all six faces are downsampled concurrently by the worker pool of the device.
         // @param[in] srcLevel the mip-level which will be taken as the starting point.
+        // @param[in] filter member of the enumeration Yw3dMipFilter.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
-        Yw3dResult GenerateMipSubLevels(uint32_t srcLevel);
+        Yw3dResult GenerateMipSubLevels(uint32_t srcLevel, Yw3dMipFilter filter = Yw3d_MF_Box);
 
         // Returns a pointer to the contents of a given mip-level.
         // @param[in] face cube face that is requested. Member of the enumeration m3dcubefaces.
@@ -75,10 +99,10 @@ namespace yw
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         Yw3dResult UnlockRect(Yw3dCubeFaces face, uint32_t mipLevel);
 
-        // Returns the format of the texture. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // Returns the format of the texture. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
         Yw3dFormat GetFormat() const;
 
-        // Returns the number of floats of the format, e [1,4].
+        // Returns the number of floats of the format, e [1,4], 0 for block compressed and compact formats.
         uint32_t GetFormatFloats() const;
 
         // Returns the number of mip-levels this texture consists of.
@@ -1,24 +1,36 @@
 // Add by Yaukey at 2018-01-30.
 // YW Soft Renderer 3d device class.
 
+#include "Yw3dAllocator.h"
 #include "Yw3dCore.h"
+#include "Yw3dCpu.h"
 #include "Yw3dDevice.h"
 #include "Yw3dPresentTarget.h"
+#include "Yw3dWorkerPool.h"
 
 namespace yw
 {
     Yw3dDevice::Yw3dDevice(Yw3d* yw3d, const Yw3dDeviceParameters* deviceParameters) :
         m_Parent(yw3d),
         m_PresentTarget(nullptr),
+        m_WorkerPool(nullptr),
+        m_Allocator(nullptr),
+        m_CpuFeatures(0),
+        m_SimdLevel(Yw3d_SIMD_Scalar),
+        m_SimdKernels(nullptr),
         m_VertexFormat(nullptr),
         m_PrimitiveAssembler(nullptr),
         m_VertexShader(nullptr),
         m_TriangleShader(nullptr),
         m_PixelShader(nullptr),
+        m_ComputeShader(nullptr),
         m_IndexBuffer(nullptr),
         m_RenderTarget(nullptr),
         m_NumValidCacheEntries(0),
         m_FetchedVertices(0),
+        m_ShadedVertices(nullptr),
+        m_FirstShadedVertex(0),
+        m_NumShadedVertices(0),
         m_NextFreeClipVertex(0)
     {
         m_Parent->AddRef();
@@ -31,6 +43,17 @@ namespace yw
         memset(m_ClipVertices, 0, YW3D_CLIP_VERTEX_CACHE_SIZE * sizeof(Yw3dVSOutput));
         memset(m_ClipVerticesStages[0], 0, YW3D_CLIP_VERTEX_CACHE_SIZE * sizeof(Yw3dVSOutput*));
         memset(m_ClipVerticesStages[1], 0, YW3D_CLIP_VERTEX_CACHE_SIZE * sizeof(Yw3dVSOutput*));
+        memset(m_ConstantBuffers, 0, YW3D_MAX_CONSTANT_BUFFERS * sizeof(Yw3dConstantBuffer*));
+        memset(m_ComputeSurfaces, 0, YW3D_MAX_COMPUTE_SURFACES * sizeof(Yw3dSurface*));
+
+        // Select the SIMD kernels before any resource is created, the default rendertarget is cleared with them.
+        m_CpuFeatures = QueryCpuFeatures();
+        m_SimdLevel = SelectSimdLevel(m_CpuFeatures, m_DeviceParameters.maxSimdLevel);
+        m_SimdKernels = GetSimdLevelKernels(m_SimdLevel);
+
+        // Create the memory allocator, the default rendertarget is allocated from it.
+        m_Allocator = new Yw3dAllocator();
+        m_Allocator->Create(m_DeviceParameters.useHugePages);
 
         // Set some default values.
         SetDefaultRenderStates();
@@ -42,11 +65,27 @@ namespace yw
     Yw3dDevice::~Yw3dDevice()
     {
         YW_SAFE_RELEASE(m_PresentTarget);
+        YW_SAFE_DELETE(m_WorkerPool);
+        YW_SAFE_DELETE(m_Allocator);
         YW_SAFE_RELEASE(m_Parent);
     }
 
     Yw3dResult Yw3dDevice::Create()
     {
+        // Create the worker pool using all hardware threads.
+        m_WorkerPool = new Yw3dWorkerPool();
+        if (nullptr == m_WorkerPool)
+        {
+            LOGE(_T("Yw3dDevice::Create: out of memory, cannot create worker pool.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        Yw3dResult resPool = m_WorkerPool->Create(0);
+        if (YW3D_FAILED(resPool))
+        {
+            return resPool;
+        }
+
         // Create the present-target.
 
         // NOTE: add support for other platforms here.
@@ -84,11 +123,35 @@ namespace yw
         return m_DeviceParameters;
     }
 
+    Yw3dWorkerPool* Yw3dDevice::GetWorkerPool()
+    {
+        return m_WorkerPool;
+    }
+
+    Yw3dAllocator* Yw3dDevice::GetAllocator()
+    {
+        return m_Allocator;
+    }
+
+    uint32_t Yw3dDevice::GetCpuFeatures() const
+    {
+        return m_CpuFeatures;
+    }
+
+    Yw3dSimdLevel Yw3dDevice::GetSimdLevel() const
+    {
+        return m_SimdLevel;
+    }
+
+    const Yw3dSimdKernels* Yw3dDevice::GetSimdKernels() const
+    {
+        return m_SimdKernels;
+    }
+
     Yw3dResult Yw3dDevice::Clear(const Yw3dRect* rect, const Vector4& color, const float depth, const uint32_t stencil)
     {
         m_RenderTarget->ClearColorBuffer(color, rect);
-        m_RenderTarget->ClearDepthBuffer(depth, rect);
-        m_RenderTarget->ClearStencilBuffer(stencil, rect);
+        m_RenderTarget->ClearDepthStencilBuffer(depth, stencil, rect);
 
         return Yw3d_S_OK;
     }
@@ -125,19 +188,23 @@ namespace yw
            return  Yw3d_E_InvalidFormat;
         }
 
+        // Untouched fast cleared tiles are presented from the clear value.
         const float* sourceBufData = nullptr;
-        if (YW3D_FAILED(colorBuffer->LockRect((void**)&sourceBufData, 0)))
+        if (YW3D_FAILED(colorBuffer->LockRect((void**)&sourceBufData, 0, false)))
         {
            YW_SAFE_RELEASE(colorBuffer);
            LOGE(_T("Yw3dDevice::Present: couldn't access colorbuffer.\n"));
            return Yw3d_E_Unknown;
         }
 
-        Yw3dResult resPresent = m_PresentTarget->Present(sourceBufData, floatCount);
+        Yw3dResult resPresent = m_PresentTarget->Present(sourceBufData, floatCount, colorBuffer->GetFastClearTiles(), colorBuffer->GetFastClearValue());
 
         colorBuffer->UnlockRect();
         YW_SAFE_RELEASE(colorBuffer);
 
+        // Transient data of this frame is not used anymore.
+        m_Allocator->ResetFrame();
+
         return resPresent;
     }
 
@@ -173,6 +240,10 @@ namespace yw
             return resCheck;
         }
 
+        // Shade all vertices at once if the vertex shader has a batch entry point.
+        const Yw3dAllocator::FrameMarker frameMarker = m_Allocator->GetFrameMarker();
+        ShadeVertexBatches(startVertex, numVertices);
+
         uint32_t vertexIndicies[3] = { startVertex, startVertex + 1, startVertex + 2 };
         bool flip4TriStrip = false; // used when drawing triangle strips.
         while (primitiveCount-- > 0)
@@ -186,6 +257,7 @@ namespace yw
                 {
                     LOGE(_T("Yw3dDevice::DrawPrimitive: couldn't fetch vertex from streams.\n"));
                     PostRender();
+                    m_Allocator->RewindFrame(frameMarker);
 
                     return resFetch;
                 }
@@ -227,6 +299,7 @@ namespace yw
 
         // Process post render state reset.
         PostRender();
+        m_Allocator->RewindFrame(frameMarker);
 
         return Yw3d_S_OK;
     }
@@ -263,6 +336,10 @@ namespace yw
             return resCheck;
         }
 
+        // Shade all vertices at once if the vertex shader has a batch entry point.
+        const Yw3dAllocator::FrameMarker frameMarker = m_Allocator->GetFrameMarker();
+        ShadeVertexBatches(baseVertexIndex + minIndex, numVertices);
+
         uint32_t vertexIndicies[3] = { startIndex, startIndex + 1, startIndex + 2 };
         bool flip4TriStrip = false; // used when drawing triangle strips.
         while (primitiveCount-- > 0)
@@ -276,6 +353,7 @@ namespace yw
                 {
                     LOGE(_T("Yw3dDevice::DrawIndexedPrimitive: couldn't read vertex index from indexbuffer.\n"));
 				    PostRender();
+                    m_Allocator->RewindFrame(frameMarker);
 
 				    return resGetVertexIndex;
                 }
@@ -286,6 +364,7 @@ namespace yw
                 {
                     LOGE(_T("Yw3dDevice::DrawIndexedPrimitive: couldn't fetch vertex from streams.\n"));
                     PostRender();
+                    m_Allocator->RewindFrame(frameMarker);
 
                     return resFetch;
                 }
@@ -327,6 +406,7 @@ namespace yw
 
         // Process post render state reset.
         PostRender();
+        m_Allocator->RewindFrame(frameMarker);
 
         return Yw3d_S_OK;
     }
@@ -351,8 +431,9 @@ namespace yw
             return resCheck;
         }
 
-        // Execute primitive assembler.
-        std::vector<uint32_t> vertexIndices;
+        // Execute primitive assembler, the indices are allocated from the frame arena and released when leaving.
+        const Yw3dAllocator::FrameMarker frameMarker = m_Allocator->GetFrameMarker();
+        Yw3dIndexList vertexIndices((Yw3dFrameAllocator<uint32_t>(m_Allocator)));
         Yw3dPrimitiveType primitiveType = m_PrimitiveAssembler->Execute(vertexIndices, numVertices);
 
         // Get primitive count by type.
@@ -370,11 +451,13 @@ namespace yw
             break;
         default:
             LOGE(_T("Yw3dDevice::DrawDynamicPrimitive: invalid primitive type specified.\n"));
+            m_Allocator->RewindFrame(frameMarker);
             return Yw3d_E_InvalidParameters;
         }
 
         if (0 == primitiveCount)
         {
+            m_Allocator->RewindFrame(frameMarker);
             return Yw3d_S_OK;
         }
 
@@ -391,6 +474,7 @@ namespace yw
                 {
                     LOGE(_T("Yw3dDevice::DrawDynamicPrimitive: couldn't fetch vertex from streams.\n"));
                     PostRender();
+                    m_Allocator->RewindFrame(frameMarker);
 
                     return resFetch;
                 }
@@ -432,6 +516,120 @@ namespace yw
 
         // Process post render state reset.
         PostRender();
+        m_Allocator->RewindFrame(frameMarker);
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+    {
+        if (nullptr == m_ComputeShader)
+        {
+            LOGE(_T("Yw3dDevice::Dispatch: no compute shader has been set.\n"));
+            return Yw3d_E_InvalidState;
+        }
+
+        // Each thread group is an item of the worker pool.
+        const uint64_t numGroups = (uint64_t)groupsX * groupsY * groupsZ;
+        if (numGroups > 0xffffffff)
+        {
+            LOGE(_T("Yw3dDevice::Dispatch: too many thread groups.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (0 == numGroups)
+        {
+            return Yw3d_S_OK;
+        }
+
+        uint32_t groupSizeX = 0;
+        uint32_t groupSizeY = 0;
+        uint32_t groupSizeZ = 0;
+        m_ComputeShader->GetThreadGroupSize(groupSizeX, groupSizeY, groupSizeZ);
+        if ((0 == groupSizeX) || (0 == groupSizeY) || (0 == groupSizeZ))
+        {
+            LOGE(_T("Yw3dDevice::Dispatch: invalid thread group size of compute shader.\n"));
+            return Yw3d_E_InvalidState;
+        }
+
+        // Lock the bound surfaces for the whole dispatch, pending fast cleared tiles are written by the lock.
+        Yw3dComputeSurface computeSurfaces[YW3D_MAX_COMPUTE_SURFACES];
+        for (uint32_t slot = 0; slot < YW3D_MAX_COMPUTE_SURFACES; slot++)
+        {
+            Yw3dSurface* surface = m_ComputeSurfaces[slot];
+            if (nullptr == surface)
+            {
+                continue;
+            }
+
+            Yw3dComputeSurface& computeSurface = computeSurfaces[slot];
+            if (YW3D_FAILED(surface->LockRect((void**)&computeSurface.data, nullptr)))
+            {
+                LOGE(_T("Yw3dDevice::Dispatch: couldn't access compute surface.\n"));
+                for (uint32_t lockedSlot = 0; lockedSlot < slot; lockedSlot++)
+                {
+                    if (nullptr != computeSurfaces[lockedSlot].data)
+                    {
+                        m_ComputeSurfaces[lockedSlot]->UnlockRect();
+                    }
+                }
+
+                return Yw3d_E_InvalidState;
+            }
+
+            computeSurface.width = surface->GetWidth();
+            computeSurface.height = surface->GetHeight();
+            computeSurface.floats = surface->GetFormatFloats();
+        }
+
+        // The kernel samples the bound textures concurrently, so their pending tiles must be written before.
+        ResolveTextureFastClears();
+
+        // Initialize shader's pointer to the device, the constant buffers and the surfaces of this dispatch.
+        IYw3dComputeShader* computeShader = m_ComputeShader;
+        computeShader->SetDevice(this);
+        computeShader->SetConstantBuffers(m_ConstantBuffers);
+        computeShader->SetSurfaces(computeSurfaces);
+
+        // A worker runs whole thread groups, the threads of a group are executed one after another.
+        const uint32_t groupsXY = groupsX * groupsY;
+        m_WorkerPool->ParallelFor((uint32_t)numGroups, [&](uint32_t groupIdx)
+        {
+            // Make ftol() returns expected integer values when the shader samples textures on this thread.
+            fpuTruncate();
+
+            Yw3dComputeThreadId threadId;
+            threadId.groupZ = groupIdx / groupsXY;
+            threadId.groupY = (groupIdx - threadId.groupZ * groupsXY) / groupsX;
+            threadId.groupX = groupIdx - threadId.groupZ * groupsXY - threadId.groupY * groupsX;
+            for (threadId.threadZ = 0; threadId.threadZ < groupSizeZ; threadId.threadZ++)
+            {
+                threadId.dispatchZ = threadId.groupZ * groupSizeZ + threadId.threadZ;
+                for (threadId.threadY = 0; threadId.threadY < groupSizeY; threadId.threadY++)
+                {
+                    threadId.dispatchY = threadId.groupY * groupSizeY + threadId.threadY;
+                    for (threadId.threadX = 0; threadId.threadX < groupSizeX; threadId.threadX++)
+                    {
+                        threadId.dispatchX = threadId.groupX * groupSizeX + threadId.threadX;
+                        computeShader->Execute(threadId);
+                    }
+                }
+            }
+
+            // Reset FPU to default(rounding) mode.
+            fpuReset();
+        });
+
+        // Clear the dispatch state of the shader and unlock the surfaces.
+        computeShader->SetSurfaces(nullptr);
+        computeShader->SetDevice(nullptr);
+        for (uint32_t slot = 0; slot < YW3D_MAX_COMPUTE_SURFACES; slot++)
+        {
+            if (nullptr != computeSurfaces[slot].data)
+            {
+                m_ComputeSurfaces[slot]->UnlockRect();
+            }
+        }
 
         return Yw3d_S_OK;
     }
@@ -511,7 +709,32 @@ namespace yw
         return Yw3d_S_OK;
     }
 
-    Yw3dResult Yw3dDevice::CreateSurface(Yw3dSurface** surface, uint32_t width, uint32_t height, Yw3dFormat format)
+    Yw3dResult Yw3dDevice::CreateConstantBuffer(Yw3dConstantBuffer** constantBuffer, uint32_t length, bool doubleBuffered)
+    {
+        if (nullptr == constantBuffer)
+        {
+            LOGE(_T("Yw3dDevice::CreateConstantBuffer: parameter constantBuffer points to null.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        *constantBuffer = new Yw3dConstantBuffer(this);
+        if (nullptr == (*constantBuffer))
+        {
+            LOGE(_T("Yw3dDevice::CreateConstantBuffer: out of memory, cannot create constant buffer.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        Yw3dResult resCreate = (*constantBuffer)->Create(length, doubleBuffered);
+        if (YW3D_FAILED(resCreate))
+        {
+            YW_SAFE_RELEASE(*constantBuffer);
+            return resCreate;
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::CreateSurface(Yw3dSurface** surface, uint32_t width, uint32_t height, Yw3dFormat format, Yw3dSurfaceLayout layout)
     {
         if (nullptr == surface)
         {
@@ -526,7 +749,32 @@ namespace yw
             return Yw3d_E_OutOfMemory;
         }
 
-        Yw3dResult resCreate = (*surface)->Create(width, height, format);
+        Yw3dResult resCreate = (*surface)->Create(width, height, format, layout);
+        if (YW3D_FAILED(resCreate))
+        {
+            YW_SAFE_RELEASE(*surface);
+            return resCreate;
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::CreateSurfaceFromMemory(Yw3dSurface** surface, uint32_t width, uint32_t height, Yw3dFormat format, Yw3dSurfaceLayout layout, void* data, size_t dataSize, IBase* dataOwner)
+    {
+        if ((nullptr == surface) || (nullptr == data))
+        {
+            LOGE(_T("Yw3dDevice::CreateSurfaceFromMemory: parameter surface or data points to null.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        *surface = new Yw3dSurface(this);
+        if (nullptr == (*surface))
+        {
+            LOGE(_T("Yw3dDevice::CreateSurfaceFromMemory: out of memory, cannot create surface.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        Yw3dResult resCreate = (*surface)->Create(width, height, format, layout, data, dataSize, dataOwner);
         if (YW3D_FAILED(resCreate))
         {
             YW_SAFE_RELEASE(*surface);
@@ -536,7 +784,7 @@ namespace yw
         return Yw3d_S_OK;
     }
 
-    Yw3dResult Yw3dDevice::CreateTexture(Yw3dTexture** texture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format)
+    Yw3dResult Yw3dDevice::CreateTexture(Yw3dTexture** texture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout)
     {
         if (nullptr == texture)
         {
@@ -551,7 +799,7 @@ namespace yw
             return  Yw3d_E_OutOfMemory;
         }
 
-        Yw3dResult resCreate = (*texture)->Create(width, height, mipLevels, format);
+        Yw3dResult resCreate = (*texture)->Create(width, height, mipLevels, format, layout);
         if (YW3D_FAILED(resCreate))
         {
             YW_SAFE_RELEASE(*texture);
@@ -561,7 +809,32 @@ namespace yw
         return  Yw3d_S_OK;
     }
 
-    Yw3dResult Yw3dDevice::CreateCubeTexture(Yw3dCubeTexture** cubeTexture, uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format)
+    Yw3dResult Yw3dDevice::CreateTextureFromMemory(Yw3dTexture** texture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout, void* const* mipLevelsData, const size_t* mipLevelsDataSize, IBase* dataOwner)
+    {
+        if ((nullptr == texture) || (nullptr == mipLevelsData) || (nullptr == mipLevelsDataSize))
+        {
+            LOGE(_T("Yw3dDevice::CreateTextureFromMemory: parameter texture or mip-level data points to null.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        *texture = new Yw3dTexture(this);
+        if (nullptr == (*texture))
+        {
+            LOGE(_T("Yw3dDevice::CreateTextureFromMemory: out of memory, cannot create texture.\n"));
+            return  Yw3d_E_OutOfMemory;
+        }
+
+        Yw3dResult resCreate = (*texture)->Create(width, height, mipLevels, format, layout, mipLevelsData, mipLevelsDataSize, dataOwner);
+        if (YW3D_FAILED(resCreate))
+        {
+            YW_SAFE_RELEASE(*texture);
+            return resCreate;
+        }
+
+        return  Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::CreateCubeTexture(Yw3dCubeTexture** cubeTexture, uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout)
     {
         if (nullptr == cubeTexture)
         {
@@ -576,7 +849,7 @@ namespace yw
             return  Yw3d_E_OutOfMemory;
         }
 
-        Yw3dResult resCreate = (*cubeTexture)->Create(edgeLength, mipLevels, format);
+        Yw3dResult resCreate = (*cubeTexture)->Create(edgeLength, mipLevels, format, layout);
         if (YW3D_FAILED(resCreate))
         {
             YW_SAFE_RELEASE(*cubeTexture);
@@ -586,7 +859,32 @@ namespace yw
         return Yw3d_S_OK;
     }
 
-    Yw3dResult Yw3dDevice::CreateVolume(Yw3dVolume** volume, uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format)
+    Yw3dResult Yw3dDevice::CreateTextureArray(Yw3dTextureArray** textureArray, uint32_t width, uint32_t height, uint32_t layers, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout)
+    {
+        if (nullptr == textureArray)
+        {
+            LOGE(_T("Yw3dDevice::CreateTextureArray: parameter textureArray points to null.\n"));
+            return  Yw3d_E_InvalidParameters;
+        }
+
+        *textureArray = new Yw3dTextureArray(this);
+        if (nullptr == (*textureArray))
+        {
+            LOGE(_T("Yw3dDevice::CreateTextureArray: out of memory, cannot create texture-array.\n"));
+            return  Yw3d_E_OutOfMemory;
+        }
+
+        Yw3dResult resCreate = (*textureArray)->Create(width, height, layers, mipLevels, format, layout);
+        if (YW3D_FAILED(resCreate))
+        {
+            YW_SAFE_RELEASE(*textureArray);
+            return resCreate;
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::CreateVolume(Yw3dVolume** volume, uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format, Yw3dVolumeLayout layout)
     {
         if (nullptr == volume)
         {
@@ -601,7 +899,7 @@ namespace yw
             return  Yw3d_E_OutOfMemory;
         }
 
-        Yw3dResult resCreate = (*volume)->Create(width, height, depth, format);
+        Yw3dResult resCreate = (*volume)->Create(width, height, depth, format, layout);
         if (YW3D_FAILED(resCreate))
         {
             YW_SAFE_RELEASE(*volume);
@@ -611,7 +909,7 @@ namespace yw
         return Yw3d_S_OK;
     }
 
-    Yw3dResult Yw3dDevice::CreateVolumeTexture(Yw3dVolumeTexture** volumeTexture, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format)
+    Yw3dResult Yw3dDevice::CreateVolumeTexture(Yw3dVolumeTexture** volumeTexture, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format, Yw3dVolumeLayout layout)
     {
         if (nullptr == volumeTexture)
         {
@@ -626,7 +924,7 @@ namespace yw
             return  Yw3d_E_OutOfMemory;
         }
 
-        Yw3dResult resCreate = (*volumeTexture)->Create(width, height, depth, mipLevels, format);
+        Yw3dResult resCreate = (*volumeTexture)->Create(width, height, depth, mipLevels, format, layout);
         if (YW3D_FAILED(resCreate))
         {
             YW_SAFE_RELEASE(*volumeTexture);
@@ -636,6 +934,31 @@ namespace yw
         return Yw3d_S_OK;
     }
 
+    Yw3dResult Yw3dDevice::CreateVirtualTexture(Yw3dVirtualTexture** virtualTexture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, uint32_t pageSize, size_t memoryBudget)
+    {
+        if (nullptr == virtualTexture)
+        {
+            LOGE(_T("Yw3dDevice::CreateVirtualTexture: parameter virtualTexture points to null.\n"));
+            return  Yw3d_E_InvalidParameters;
+        }
+
+        *virtualTexture = new Yw3dVirtualTexture(this);
+        if (nullptr == (*virtualTexture))
+        {
+            LOGE(_T("Yw3dDevice::CreateVirtualTexture: out of memory, cannot create virtual texture.\n"));
+            return  Yw3d_E_OutOfMemory;
+        }
+
+        Yw3dResult resCreate = (*virtualTexture)->Create(width, height, mipLevels, format, pageSize, memoryBudget);
+        if (YW3D_FAILED(resCreate))
+        {
+            YW_SAFE_RELEASE(*virtualTexture);
+            return resCreate;
+        }
+
+        return Yw3d_S_OK;
+    }
+
     Yw3dResult Yw3dDevice::CreateRenderTarget(Yw3dRenderTarget** renderTarget, uint32_t width, uint32_t height, Yw3dFormat colorFormat, Yw3dFormat depthFormat, Yw3dFormat stencilFormat)
     {
         if (nullptr == renderTarget)
@@ -669,9 +992,14 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
-        // Create the stencil buffer.
+        // Create the stencil buffer, a packed depth-stencil buffer is shared with depth.
         Yw3dSurface* stencilBuffer = nullptr;
-        if (YW3D_FAILED(CreateSurface(&stencilBuffer, width, height, stencilFormat)))
+        if ((Yw3d_FMT_D24S8 == depthFormat) && (Yw3d_FMT_D24S8 == stencilFormat))
+        {
+            stencilBuffer = depthBuffer;
+            stencilBuffer->AddRef();
+        }
+        else if (YW3D_FAILED(CreateSurface(&stencilBuffer, width, height, stencilFormat)))
         {
             YW_SAFE_RELEASE(depthBuffer);
             YW_SAFE_RELEASE(colorBuffer);
@@ -680,6 +1008,11 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
+        // Buffers of a render target are cleared every frame, only mark the cleared tiles.
+        colorBuffer->SetFastClear(true);
+        depthBuffer->SetFastClear(true);
+        stencilBuffer->SetFastClear(true);
+
         // Set color buffer and depth buffer.
         (*renderTarget)->SetColorBuffer(colorBuffer);
         (*renderTarget)->SetDepthBuffer(depthBuffer);
@@ -901,6 +1234,22 @@ namespace yw
         return m_PixelShader;
     }
 
+    Yw3dResult Yw3dDevice::SetComputeShader(IYw3dComputeShader* computeShader)
+    {
+        m_ComputeShader = computeShader;
+        return Yw3d_S_OK;
+    }
+
+    IYw3dComputeShader* Yw3dDevice::AcquireComputeShader()
+    {
+        if (nullptr != m_ComputeShader)
+        {
+            m_ComputeShader->AddRef();
+        }
+
+        return m_ComputeShader;
+    }
+
     Yw3dResult Yw3dDevice::SetIndexBuffer(Yw3dIndexBuffer* indexBuffer)
     {
         m_IndexBuffer = indexBuffer;
@@ -983,6 +1332,82 @@ namespace yw
         return Yw3d_S_OK;
     }
 
+    Yw3dResult Yw3dDevice::SetConstantBuffer(uint32_t slot, Yw3dConstantBuffer* constantBuffer)
+    {
+        if (slot >= YW3D_MAX_CONSTANT_BUFFERS)
+        {
+            LOGE(_T("Yw3dDevice::SetConstantBuffer: slot exceeds number of available constant buffer slots.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        m_ConstantBuffers[slot] = constantBuffer;
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::AcquireConstantBuffer(uint32_t slot, Yw3dConstantBuffer** constantBuffer)
+    {
+        if (slot >= YW3D_MAX_CONSTANT_BUFFERS)
+        {
+            LOGE(_T("Yw3dDevice::AcquireConstantBuffer: slot exceeds number of available constant buffer slots.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (nullptr == constantBuffer)
+        {
+            LOGE(_T("Yw3dDevice::AcquireConstantBuffer: parameter constantBuffer points to null.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        *constantBuffer = m_ConstantBuffers[slot];
+        if (nullptr != m_ConstantBuffers[slot])
+        {
+            m_ConstantBuffers[slot]->AddRef();
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::SetComputeSurface(uint32_t slot, Yw3dSurface* surface)
+    {
+        if (slot >= YW3D_MAX_COMPUTE_SURFACES)
+        {
+            LOGE(_T("Yw3dDevice::SetComputeSurface: slot exceeds number of available compute surface slots.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if ((nullptr != surface) && ((surface->GetFormat() < Yw3d_FMT_R32F) || (surface->GetFormat() > Yw3d_FMT_R32G32B32A32F)))
+        {
+            LOGE(_T("Yw3dDevice::SetComputeSurface: invalid compute surface format.\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
+        m_ComputeSurfaces[slot] = surface;
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dDevice::AcquireComputeSurface(uint32_t slot, Yw3dSurface** surface)
+    {
+        if (slot >= YW3D_MAX_COMPUTE_SURFACES)
+        {
+            LOGE(_T("Yw3dDevice::AcquireComputeSurface: slot exceeds number of available compute surface slots.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (nullptr == surface)
+        {
+            LOGE(_T("Yw3dDevice::AcquireComputeSurface: parameter surface points to null.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        *surface = m_ComputeSurfaces[slot];
+        if (nullptr != m_ComputeSurfaces[slot])
+        {
+            m_ComputeSurfaces[slot]->AddRef();
+        }
+
+        return Yw3d_S_OK;
+    }
+
     Yw3dResult Yw3dDevice::SetTexture(uint32_t samplerNumber, IYw3dBaseTexture* texture)
     {
         if (samplerNumber >= YW3D_MAX_TEXTURE_SAMPLERS)
@@ -992,9 +1417,12 @@ namespace yw
         }
 
         m_TextureSamplers[samplerNumber].texture = texture;
+        UpdateSampleFunction(samplerNumber);
+
+        // The texture may have been rendered to since it was cleared.
         if (nullptr != texture)
         {
-            m_TextureSamplers[samplerNumber].textureSampleInput = texture->GetTextureSampleInput();
+            texture->ResolveFastClear();
         }
 
         return Yw3d_S_OK;
@@ -1039,6 +1467,8 @@ namespace yw
         }
 
         m_TextureSamplers[samplerNumber].textureSamplerStates[textureSamplerState] = state;
+        UpdateSampleFunction(samplerNumber);
+
         return Yw3d_S_OK;
     }
 
@@ -1064,6 +1494,29 @@ namespace yw
         return Yw3d_S_OK;
     }
 
+    void Yw3dDevice::UpdateSampleFunction(uint32_t samplerNumber)
+    {
+        TextureSampler& textureSampler = m_TextureSamplers[samplerNumber];
+        if (nullptr == textureSampler.texture)
+        {
+            textureSampler.sampleFunction = nullptr;
+            return;
+        }
+
+        textureSampler.sampleFunction = textureSampler.texture->GetSampleFunction(textureSampler.textureSamplerStates);
+    }
+
+    void Yw3dDevice::ResolveTextureFastClears()
+    {
+        for (uint32_t samplerNumber = 0; samplerNumber < YW3D_MAX_TEXTURE_SAMPLERS; samplerNumber++)
+        {
+            if (nullptr != m_TextureSamplers[samplerNumber].texture)
+            {
+                m_TextureSamplers[samplerNumber].texture->ResolveFastClear();
+            }
+        }
+    }
+
     Yw3dResult Yw3dDevice::SampleTexture(Vector4& color, uint32_t samplerNumber, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient)
     {
         if (samplerNumber >= YW3D_MAX_TEXTURE_SAMPLERS)
@@ -1084,48 +1537,8 @@ namespace yw
             return Yw3d_E_InvalidState;
         }
 
-        // Correct u, v, w by input type and address type.
-        switch (textureSampler.textureSampleInput)
-        {
-        case Yw3d_TSI_Vector:
-            if ((0.0f == u) && (0.0f == v) && (0.0f == w))
-            {
-                color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
-                LOGE(_T("Yw3dDevice::SampleTexture: sampling vector [u,v,w] = [0,0,0].\n"));
-                return Yw3d_E_InvalidParameters;
-            }
-
-            break;
-        case Yw3d_TSI_3Coords:
-            switch (textureSampler.textureSamplerStates[Yw3d_TSS_AddressW])
-            {
-            case Yw3d_TA_Wrap: w -= floor(w);
-            case Yw3d_TA_Clamp: w = Saturate(w); break;
-            default: color = Vector4(1.0f, 1.0f, 1.0f, 1.0f); LOGE(_T("Yw3dDevice::SampleTexture: value of texture sampler state Yw3d_TSS_AddressW is invalid.\n")); return Yw3d_E_InvalidState;
-            }
-        case Yw3d_TSI_2Coords:
-            switch (textureSampler.textureSamplerStates[Yw3d_TSS_AddressV])
-            {
-            case Yw3d_TA_Wrap: v -= floor(v);
-            case Yw3d_TA_Clamp: v = Saturate(v); break;
-            default: color = Vector4(1.0f, 1.0f, 1.0f, 1.0f); LOGE(_T("Yw3dDevice::SampleTexture: value of texture sampler state Yw3d_TSS_AddressV is invalid.\n")); return Yw3d_E_InvalidState;
-            }
-
-            switch (textureSampler.textureSamplerStates[Yw3d_TSS_AddressU])
-            {
-            case Yw3d_TA_Wrap: u -= floor(u);
-            case Yw3d_TA_Clamp: u = Saturate(u); break;
-            default: color = Vector4(1.0f, 1.0f, 1.0f, 1.0f); LOGE(_T("Yw3dDevice::SampleTexture: value of texture sampler state Yw3d_TSS_AddressU is invalid.\n")); return Yw3d_E_InvalidState;
-            }
-
-            break;
-        default:
-            color = Vector4(1.0f, 1.0f, 1.0f, 1.0f);
-            LOGE(_T("Yw3dDevice::SampleTexture: invalid texture-sampling input!\n"));
-            return Yw3d_E_InvalidState;
-        }
-
-        return texture->SampleTexture(color, u, v, w, lod, xGradient, yGradient, textureSampler.textureSamplerStates);
+        // Call the sampling function resolved for the texture and sampler states.
+        return textureSampler.sampleFunction(texture, color, u, v, w, lod, xGradient, yGradient, textureSampler.textureSamplerStates);
     }
 
     void Yw3dDevice::SetRenderTarget(Yw3dRenderTarget* renderTarget)
@@ -1365,6 +1778,9 @@ namespace yw
             return Yw3d_E_InvalidState;
         }
 
+        // Textures rendered to since they have been bound are sampled by this draw call.
+        ResolveTextureFastClears();
+
         // Get color buffer, depth buffer and stencil buffer.
         Yw3dSurface* colorBuffer = m_RenderTarget->AcquireColorBuffer();
         Yw3dSurface* depthBuffer = m_RenderStates[Yw3d_RS_ZEnable] ? m_RenderTarget->AcquireDepthBuffer() : nullptr;
@@ -1529,16 +1945,28 @@ namespace yw
         // Initialize internal render-info structure.
 
         // Store output register types in the internal render-info structure.
+        // The type is the number of floats of a register, the used floats are masked for the SIMD register kernels.
+        m_RenderInfo.vsOutputRegisterFloats = 0;
         for (uint32_t regIdx = 0; regIdx < YW3D_PIXEL_SHADER_REGISTERS; regIdx++)
         {
             m_RenderInfo.vsOutputRegisterTypes[regIdx] = m_VertexShader->GetOutputRegisters(regIdx);
+
+            for (uint32_t c = 0; c < 4; c++)
+            {
+                m_RenderInfo.vsOutputRegisterMask[4 * regIdx + c] = (c < (uint32_t)m_RenderInfo.vsOutputRegisterTypes[regIdx]) ? 0xffffffff : 0;
+            }
+
+            if (Yw3d_SRT_Unused != m_RenderInfo.vsOutputRegisterTypes[regIdx])
+            {
+                m_RenderInfo.vsOutputRegisterFloats = 4 * (regIdx + 1);
+            }
         }
 
         // Store color buffer related states.
         colorBuffer = m_RenderTarget->AcquireColorBuffer();
         if (nullptr != colorBuffer)
         {
-            Yw3dResult resBuffer = colorBuffer->LockRect((void**)&m_RenderInfo.frameData, nullptr);
+            Yw3dResult resBuffer = colorBuffer->LockRect((void**)&m_RenderInfo.frameData, nullptr, false);
             if (YW3D_FAILED(resBuffer))
             {
                 LOGI(_T("Yw3dDevice::PreRender: couldn't access color buffer.\n"));
@@ -1567,14 +1995,65 @@ namespace yw
             m_RenderInfo.colorWriteEnabled = false;
         }
 
+        // Store the colorbuffer attachments, the attachments besides the colorbuffer are only written by Yw3d_PSO_MultipleColors pixel shaders.
+        const bool multipleColors = (Yw3d_PSO_MultipleColors == m_PixelShader->GetShaderOutput());
+        m_RenderInfo.numColorBuffers = multipleColors ? m_RenderTarget->GetNumColorBuffers() : 1;
+        m_RenderInfo.colorBuffersData[0] = m_RenderInfo.frameData;
+        m_RenderInfo.colorBuffersFloats[0] = m_RenderInfo.colorFloats;
+        m_RenderInfo.colorBuffersPitch[0] = m_RenderInfo.colorBufferPitch;
+        for (uint32_t bufferIdx = 1; bufferIdx < YW3D_MAX_COLOR_BUFFERS; bufferIdx++)
+        {
+            m_RenderInfo.colorBuffersData[bufferIdx] = nullptr;
+            m_RenderInfo.colorBuffersFloats[bufferIdx] = 0;
+            m_RenderInfo.colorBuffersPitch[bufferIdx] = 0;
+        }
+
+        bool hasColorBuffers = (nullptr != m_RenderInfo.frameData);
+        for (uint32_t bufferIdx = 1; bufferIdx < m_RenderInfo.numColorBuffers; bufferIdx++)
+        {
+            Yw3dSurface* attachment = m_RenderTarget->AcquireColorBuffer(bufferIdx);
+            if (nullptr == attachment)
+            {
+                continue;
+            }
+
+            Yw3dResult resBuffer = attachment->LockRect((void**)&m_RenderInfo.colorBuffersData[bufferIdx], nullptr, false);
+            if (YW3D_FAILED(resBuffer))
+            {
+                LOGI(_T("Yw3dDevice::PreRender: couldn't access color buffer attachment.\n"));
+                m_RenderInfo.colorBuffersData[bufferIdx] = nullptr;
+                UnlockColorAttachments();
+                if (nullptr != m_RenderInfo.frameData)
+                {
+                    colorBuffer->UnlockRect();
+                }
+
+                YW_SAFE_RELEASE(attachment);
+                YW_SAFE_RELEASE(colorBuffer);
+
+                return resBuffer;
+            }
+
+            m_RenderInfo.colorBuffersFloats[bufferIdx] = attachment->GetFormatFloats();
+            m_RenderInfo.colorBuffersPitch[bufferIdx] = attachment->GetWidth() * m_RenderInfo.colorBuffersFloats[bufferIdx];
+            hasColorBuffers = true;
+            YW_SAFE_RELEASE(attachment);
+        }
+
+        if (multipleColors)
+        {
+            m_RenderInfo.colorWriteEnabled = (m_RenderStates[Yw3d_RS_ColorWriteEnable] && hasColorBuffers) ? true : false;
+        }
+
         // Get depth buffer related states.
         depthBuffer = m_RenderStates[Yw3d_RS_ZEnable] ? m_RenderTarget->AcquireDepthBuffer() : nullptr;
         if (nullptr != depthBuffer)
         {
-            Yw3dResult resBuffer = depthBuffer->LockRect((void**)&m_RenderInfo.depthData, nullptr);
+            Yw3dResult resBuffer = depthBuffer->LockRect((void**)&m_RenderInfo.depthData, nullptr, false);
             if (YW3D_FAILED(resBuffer))
             {
                 LOGI(_T("Yw3dDevice::PreRender: couldn't access depth buffer.\n"));
+                UnlockColorAttachments();
                 if (nullptr != m_RenderInfo.frameData)
                 {
                     colorBuffer->UnlockRect();
@@ -1586,7 +2065,22 @@ namespace yw
                 return resBuffer;
             }
 
-            m_RenderInfo.depthBufferPitch = depthBuffer->GetWidth();
+            m_RenderInfo.depthFormat = depthBuffer->GetFormat();
+            m_RenderInfo.depthBytes = depthBuffer->GetFormatBytes();
+            m_RenderInfo.depthBufferPitch = depthBuffer->GetWidth() * m_RenderInfo.depthBytes;
+            switch (m_RenderInfo.depthFormat)
+            {
+            case Yw3d_FMT_D24S8:
+                m_RenderInfo.depthPrecision = 0.5f / YW3D_DEPTH24_MAX;
+                break;
+            case Yw3d_FMT_D16:
+                m_RenderInfo.depthPrecision = 0.5f / YW3D_DEPTH16_MAX;
+                break;
+            default:
+                m_RenderInfo.depthPrecision = YW_FLOAT_PRECISION;
+                break;
+            }
+
             m_RenderInfo.depthCompare = (Yw3dCompareFunction)m_RenderStates[Yw3d_RS_ZFunc];
             m_RenderInfo.depthWriteEnabled = m_RenderStates[Yw3d_RS_ZWriteEnable] ? true : false;
         }
@@ -1594,6 +2088,9 @@ namespace yw
         {
             m_RenderInfo.depthData = nullptr;
             m_RenderInfo.depthBufferPitch = 0;
+            m_RenderInfo.depthBytes = sizeof(float);
+            m_RenderInfo.depthFormat = Yw3d_FMT_R32F;
+            m_RenderInfo.depthPrecision = YW_FLOAT_PRECISION;
             m_RenderInfo.depthCompare = Yw3d_CMP_Always;
             m_RenderInfo.depthWriteEnabled = false;
         }
@@ -1602,10 +2099,21 @@ namespace yw
         stencilBuffer = m_RenderStates[Yw3d_RS_StencilEnable] ? m_RenderTarget->AcquireStencilBuffer() : nullptr;
         if (nullptr != stencilBuffer)
         {
-            Yw3dResult resBuffer = stencilBuffer->LockRect((void**)&m_RenderInfo.stencilData, nullptr);
+            // A shared depth-stencil buffer is already locked if depth is enabled.
+            Yw3dResult resBuffer = Yw3d_S_OK;
+            if ((stencilBuffer == depthBuffer) && (nullptr != m_RenderInfo.depthData))
+            {
+                m_RenderInfo.stencilData = (uint32_t*)m_RenderInfo.depthData;
+            }
+            else
+            {
+                resBuffer = stencilBuffer->LockRect((void**)&m_RenderInfo.stencilData, nullptr, false);
+            }
+
             if (YW3D_FAILED(resBuffer))
             {
                 LOGI(_T("Yw3dDevice::PreRender: couldn't access stencil buffer.\n"));
+                UnlockColorAttachments();
                 if (nullptr != m_RenderInfo.frameData)
                 {
                     colorBuffer->UnlockRect();
@@ -1624,6 +2132,7 @@ namespace yw
             }
 
             m_RenderInfo.stencilBufferPitch = stencilBuffer->GetWidth();
+            m_RenderInfo.stencilBitsMask = (Yw3d_FMT_D24S8 == stencilBuffer->GetFormat()) ? YW3D_D24S8_STENCIL_MASK : 0xffffffff;
             m_RenderInfo.stencilOperatonPass = (Yw3dStencilOperaton)m_RenderStates[Yw3d_RS_StencilPass];
             m_RenderInfo.stencilOperatonFail = (Yw3dStencilOperaton)m_RenderStates[Yw3d_RS_StencilFail];
             m_RenderInfo.stencilOperatonZFail = (Yw3dStencilOperaton)m_RenderStates[Yw3d_RS_StencilZFail];
@@ -1637,6 +2146,7 @@ namespace yw
         {
             m_RenderInfo.stencilData = nullptr;
             m_RenderInfo.stencilBufferPitch = 0;
+            m_RenderInfo.stencilBitsMask = 0xffffffff;
             m_RenderInfo.stencilOperatonPass = Yw3d_StencilOp_Keep;
             m_RenderInfo.stencilOperatonFail = Yw3d_StencilOp_Keep;
             m_RenderInfo.stencilOperatonZFail = Yw3d_StencilOp_Keep;
@@ -1647,6 +2157,38 @@ namespace yw
             m_RenderInfo.stencilEnabled = false;
         }
 
+        // Buffers locked with pending fast cleared tiles, these tiles are written when the rasterizer reaches them.
+        m_RenderInfo.numFastClearSurfaces = 0;
+        if ((nullptr != m_RenderInfo.frameData) && colorBuffer->GetFastClear())
+        {
+            m_RenderInfo.fastClearSurfaces[m_RenderInfo.numFastClearSurfaces++] = colorBuffer;
+        }
+
+        if ((nullptr != m_RenderInfo.depthData) && depthBuffer->GetFastClear())
+        {
+            m_RenderInfo.fastClearSurfaces[m_RenderInfo.numFastClearSurfaces++] = depthBuffer;
+        }
+
+        if ((nullptr != m_RenderInfo.stencilData) && (stencilBuffer != depthBuffer) && stencilBuffer->GetFastClear())
+        {
+            m_RenderInfo.fastClearSurfaces[m_RenderInfo.numFastClearSurfaces++] = stencilBuffer;
+        }
+
+        for (uint32_t bufferIdx = 1; bufferIdx < m_RenderInfo.numColorBuffers; bufferIdx++)
+        {
+            if (nullptr != m_RenderInfo.colorBuffersData[bufferIdx])
+            {
+                // The rendertarget keeps a reference of the attachment until PostRender().
+                Yw3dSurface* attachment = m_RenderTarget->AcquireColorBuffer(bufferIdx);
+                if (attachment->GetFastClear())
+                {
+                    m_RenderInfo.fastClearSurfaces[m_RenderInfo.numFastClearSurfaces++] = attachment;
+                }
+
+                YW_SAFE_RELEASE(attachment);
+            }
+        }
+
         YW_SAFE_RELEASE(colorBuffer);
         YW_SAFE_RELEASE(depthBuffer);
         YW_SAFE_RELEASE(stencilBuffer);
@@ -1666,6 +2208,10 @@ namespace yw
             m_RenderInfo.fpRasterizeScanline = &Yw3dDevice::RasterizeScanline_ColorDepth;
             m_RenderInfo.fpDrawPixel = &Yw3dDevice::DrawPixel_ColorDepth;
             break;
+        case Yw3d_PSO_MultipleColors:
+            m_RenderInfo.fpRasterizeScanline = &Yw3dDevice::RasterizeScanline_MultipleColors;
+            m_RenderInfo.fpDrawPixel = &Yw3dDevice::DrawPixel_MultipleColors;
+            break;
         default:
             LOGE(_T("Yw3dDevice::PreRender: type of pixel shader is invalid.\n"));
             return Yw3d_E_InvalidState;
@@ -1681,6 +2227,14 @@ namespace yw
             m_TriangleShader->SetDevice(this);
         }
 
+        // Let all shaders read the constants of the bound constant buffers directly.
+        m_VertexShader->SetConstantBuffers(m_ConstantBuffers);
+        m_PixelShader->SetConstantBuffers(m_ConstantBuffers);
+        if (nullptr != m_TriangleShader)
+        {
+            m_TriangleShader->SetConstantBuffers(m_ConstantBuffers);
+        }
+
         // Initialize pixel shader's pointers to info structures.
         m_PixelShader->SetInfo(m_RenderInfo.vsOutputRegisterTypes, &m_TriangleInfo);
 
@@ -1731,6 +2285,9 @@ namespace yw
             YW_SAFE_RELEASE(colorBuffer);
         }
 
+        // Unlock the other colorbuffer attachments.
+        UnlockColorAttachments();
+
         // Unlock and release depth buffer.
         if (nullptr != m_RenderInfo.depthData)
         {
@@ -1743,11 +2300,11 @@ namespace yw
             YW_SAFE_RELEASE(depthBuffer)
         }
 
-        // Unlock and release stencil buffer.
+        // Unlock and release stencil buffer, a shared depth-stencil buffer has been unlocked with depth.
         if (nullptr != m_RenderInfo.stencilData)
         {
             Yw3dSurface* stencilBuffer = m_RenderTarget->AcquireStencilBuffer();
-            if (nullptr != stencilBuffer)
+            if ((nullptr != stencilBuffer) && ((void*)m_RenderInfo.stencilData != (void*)m_RenderInfo.depthData))
             {
                 stencilBuffer->UnlockRect();
             }
@@ -1755,6 +2312,10 @@ namespace yw
             YW_SAFE_RELEASE(stencilBuffer)
         }
 
+        // Vertices shaded in the pre-pass are only valid during the draw-call.
+        m_ShadedVertices = nullptr;
+        m_NumShadedVertices = 0;
+
         // Clear current device associated with used shaders.
         m_VertexShader->SetDevice(nullptr);
         m_PixelShader->SetDevice(nullptr);
@@ -1834,6 +2395,13 @@ namespace yw
 
     Yw3dResult Yw3dDevice::FetchVertex(Yw3dVertexCacheEntry** vertexCacheEntry, uint32_t vertexIndex)
     {
+        // Vertices of the range shaded in the pre-pass are returned directly.
+        if ((nullptr != m_ShadedVertices) && (vertexIndex - m_FirstShadedVertex < m_NumShadedVertices))
+        {
+            *vertexCacheEntry = &m_ShadedVertices[vertexIndex - m_FirstShadedVertex];
+            return Yw3d_S_OK;
+        }
+
         if ((nullptr != *vertexCacheEntry) && ((*vertexCacheEntry)->vertexIndex == vertexIndex))
         {
             (*vertexCacheEntry)->fetchTime = m_FetchedVertices++;
@@ -1887,10 +2455,81 @@ namespace yw
         // Execute vertex shader.
         m_VertexShader->Execute(destEntry->vertexOutput.sourceInput.shaderInputs, destEntry->vertexOutput.position, destEntry->vertexOutput.shaderOutputs);
 
-        // Fill result.
-        *vertexCacheEntry = destEntry;
+        // Fill result.
+        *vertexCacheEntry = destEntry;
+
+        return Yw3d_S_OK;
+    }
+
+    void Yw3dDevice::ShadeVertexBatches(uint32_t firstVertex, uint32_t numVertices)
+    {
+        m_ShadedVertices = nullptr;
+        m_FirstShadedVertex = 0;
+        m_NumShadedVertices = 0;
+
+        // Only vertex shaders with a batch entry point are shaded in the pre-pass.
+        const uint32_t batchSize = m_VertexShader->GetBatchSize();
+        if ((4 != batchSize) && (8 != batchSize) && (16 != batchSize))
+        {
+            return;
+        }
+
+        Yw3dVertexCacheEntry* shadedVertices = (Yw3dVertexCacheEntry*)m_Allocator->AllocateFrame(sizeof(Yw3dVertexCacheEntry) * numVertices);
+        Yw3dVSInputBatch* inputBatch = (Yw3dVSInputBatch*)m_Allocator->AllocateFrame(sizeof(Yw3dVSInputBatch));
+        Yw3dVSOutputBatch* outputBatch = (Yw3dVSOutputBatch*)m_Allocator->AllocateFrame(sizeof(Yw3dVSOutputBatch));
+        if ((nullptr == shadedVertices) || (nullptr == inputBatch) || (nullptr == outputBatch))
+        {
+            return;
+        }
+
+        for (uint32_t batchStart = 0; batchStart < numVertices; batchStart += batchSize)
+        {
+            const uint32_t batchVertices = ((numVertices - batchStart) < batchSize) ? (numVertices - batchStart) : batchSize;
+
+            // Decode the vertices of this batch and transpose them to SoA layout, the last vertex is replicated into unused lanes.
+            for (uint32_t lane = 0; lane < batchSize; lane++)
+            {
+                Yw3dVertexCacheEntry* entry = &shadedVertices[batchStart + ((lane < batchVertices) ? lane : (batchVertices - 1))];
+                if (lane < batchVertices)
+                {
+                    entry->vertexIndex = firstVertex + batchStart + lane;
+                    entry->fetchTime = 0;
+                    if (YW3D_FAILED(DecodeVertexStream(entry->vertexOutput.sourceInput, entry->vertexIndex)))
+                    {
+                        return;
+                    }
+                }
+
+                const Yw3dShaderRegister* shaderInputs = entry->vertexOutput.sourceInput.shaderInputs;
+                for (uint32_t reg = 0; reg < YW3D_VERTEX_SHADER_REGISTERS; reg++)
+                {
+                    Yw3dShaderRegisterBatch& batchRegister = inputBatch->shaderInputs[reg];
+                    batchRegister.x[lane] = shaderInputs[reg].x;
+                    batchRegister.y[lane] = shaderInputs[reg].y;
+                    batchRegister.z[lane] = shaderInputs[reg].z;
+                    batchRegister.w[lane] = shaderInputs[reg].w;
+                }
+            }
+
+            // Execute vertex shader.
+            m_VertexShader->ExecuteBatch(*inputBatch, *outputBatch);
 
-        return Yw3d_S_OK;
+            // Transpose the results back to the vertices of this batch.
+            for (uint32_t lane = 0; lane < batchVertices; lane++)
+            {
+                Yw3dVSOutput& vertexOutput = shadedVertices[batchStart + lane].vertexOutput;
+                vertexOutput.position = Vector4(outputBatch->position.x[lane], outputBatch->position.y[lane], outputBatch->position.z[lane], outputBatch->position.w[lane]);
+                for (uint32_t reg = 0; reg < YW3D_PIXEL_SHADER_REGISTERS; reg++)
+                {
+                    const Yw3dShaderRegisterBatch& batchRegister = outputBatch->shaderOutputs[reg];
+                    vertexOutput.shaderOutputs[reg] = Yw3dShaderRegister(batchRegister.x[lane], batchRegister.y[lane], batchRegister.z[lane], batchRegister.w[lane]);
+                }
+            }
+        }
+
+        m_ShadedVertices = shadedVertices;
+        m_FirstShadedVertex = firstVertex;
+        m_NumShadedVertices = numVertices;
     }
 
     void Yw3dDevice::ProcessTriangle(const Yw3dVSOutput* vsOutput0, const Yw3dVSOutput* vsOutput1, const Yw3dVSOutput* vsOutput2)
@@ -1984,27 +2623,8 @@ namespace yw
 
     void Yw3dDevice::MultiplyVertexShaderOutputRegisters(Yw3dVSOutput* dest, const Yw3dVSOutput* src, float value)
     {
-        // Multiply registers.
-        Yw3dShaderRegister* regDest = dest->shaderOutputs;
-        const Yw3dShaderRegister* regSrc = src->shaderOutputs;
-
-        for (uint32_t regIdx = 0; regIdx < YW3D_PIXEL_SHADER_REGISTERS; regIdx++, regDest++, regSrc++)
-        {
-            switch (m_RenderInfo.vsOutputRegisterTypes[regIdx])
-            {
-            case Yw3d_SRT_Vector4:
-                regDest->w = regSrc->w * value;
-            case Yw3d_SRT_Vector3:
-                regDest->z = regSrc->z * value;
-            case Yw3d_SRT_Vector2:
-                regDest->y = regSrc->y * value;
-            case Yw3d_SRT_Float32:
-                regDest->x = regSrc->x * value;
-            case Yw3d_SRT_Unused:
-            default:    // Can not happen.
-                break;
-            }
-        }
+        // Multiply the used floats of the registers, this runs for each pixel so it is dispatched to the SIMD kernels.
+        m_SimdKernels->scaleRegisters(&dest->shaderOutputs[0].x, &src->shaderOutputs[0].x, m_RenderInfo.vsOutputRegisterMask, value, m_RenderInfo.vsOutputRegisterFloats);
     }
 
     void Yw3dDevice::SubdivideTriangle_Simple(uint32_t subdivisionLevel, const Yw3dVSOutput* vsOutput0, const Yw3dVSOutput* vsOutput1, const Yw3dVSOutput* vsOutput2)
@@ -2454,8 +3074,12 @@ namespace yw
         // The "one over determinant" of matrix for calculating partial derivatives.
         const float oneOverDeterminant = 1.0f / (deltaX[0] * deltaY[1] - deltaX[1] * deltaY[0]);
 
-        // Set base vertex.
+        // Set base vertex, and start a new triangle for the derivatives cached per pixel quad. 0 is never used, it marks an empty cache entry.
         m_TriangleInfo.baseVertex = vsOutput0;
+        if (0 == ++m_TriangleInfo.triangleId)
+        {
+            m_TriangleInfo.triangleId = 1;
+        }
 
         // The derivatives with respect to the y-coordinate are negated, because in screen-space the y-axis is reversed.
 
@@ -2557,26 +3181,7 @@ namespace yw
         vsOutput->position.w += m_TriangleInfo.wDdx;
 
         // Get the value of each shader register.
-        Yw3dShaderRegister* regDest = vsOutput->shaderOutputs;
-        const Yw3dShaderRegister* regDdx = m_TriangleInfo.shaderOutputsDdx;
-
-        for (uint32_t regIdx = 0; regIdx < YW3D_PIXEL_SHADER_REGISTERS; regIdx++, regDest++, regDdx++)
-        {
-            switch (m_RenderInfo.vsOutputRegisterTypes[regIdx])
-            {
-            case Yw3d_SRT_Vector4:
-                regDest->w += regDdx->w;
-            case Yw3d_SRT_Vector3:
-                regDest->z += regDdx->z;
-            case Yw3d_SRT_Vector2:
-                regDest->y += regDdx->y;
-            case Yw3d_SRT_Float32:
-                regDest->x += regDdx->x;
-            case Yw3d_SRT_Unused:
-            default:    // Can not happen.
-                break;
-            }
-        }
+        m_SimdKernels->stepRegisters(&vsOutput->shaderOutputs[0].x, &m_TriangleInfo.shaderOutputsDdx[0].x, m_RenderInfo.vsOutputRegisterMask, m_RenderInfo.vsOutputRegisterFloats);
     }
 
     void Yw3dDevice::RasterizeTriangle(const Yw3dVSOutput* vsOutput0, const Yw3dVSOutput* vsOutput1, const Yw3dVSOutput* vsOutput2)
@@ -2825,6 +3430,46 @@ namespace yw
         }
     }
 
+    inline float Yw3dDevice::ReadPixelDepth(const uint8_t* depthData) const
+    {
+        switch (m_RenderInfo.depthFormat)
+        {
+        case Yw3d_FMT_D24S8:
+            return DecodeDepth24(*(const uint32_t*)depthData);
+        case Yw3d_FMT_D16:
+            return DecodeDepth16(*(const uint16_t*)depthData);
+        default:
+            return *(const float*)depthData;
+        }
+    }
+
+    inline void Yw3dDevice::WritePixelDepth(uint8_t* depthData, float depth) const
+    {
+        switch (m_RenderInfo.depthFormat)
+        {
+        case Yw3d_FMT_D24S8:
+            {
+                uint32_t* pixel = (uint32_t*)depthData;
+                *pixel = EncodeDepth24(depth) | (*pixel & YW3D_D24S8_STENCIL_MASK);
+            }
+            break;
+        case Yw3d_FMT_D16:
+            *(uint16_t*)depthData = EncodeDepth16(depth);
+            break;
+        default:
+            *(float*)depthData = depth;
+            break;
+        }
+    }
+
+    inline void Yw3dDevice::ResolveFastClearSpan(int32_t y, int32_t x1, int32_t x2)
+    {
+        for (uint32_t surfaceIdx = 0; surfaceIdx < m_RenderInfo.numFastClearSurfaces; surfaceIdx++)
+        {
+            m_RenderInfo.fastClearSurfaces[surfaceIdx]->ResolveFastClearSpan((uint32_t)y, (uint32_t)x1, (uint32_t)x2);
+        }
+    }
+
     void Yw3dDevice::RasterizeScanline_ColorOnly(int32_t y, int32_t x1, int32_t x2, Yw3dVSOutput* vsOutput)
     {
         // Skip if the y coordinate off the screen area.
@@ -2837,16 +3482,19 @@ namespace yw
         x1 = max((int32_t)m_RenderInfo.viewportRect.left, min(x1, (int32_t)m_RenderInfo.viewportRect.right));
         x2 = max((int32_t)m_RenderInfo.viewportRect.left, min(x2, (int32_t)m_RenderInfo.viewportRect.right));
 
+        // Write pending fast cleared tiles before accessing the buffers.
+        ResolveFastClearSpan(y, x1, x2);
+
         // Get color buffer data and depth buffer data.
         float* frameData = m_RenderInfo.frameData + (y * m_RenderInfo.colorBufferPitch + x1 * m_RenderInfo.colorFloats);
-        float* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x1);
-        float* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x1) : nullptr;
+        uint8_t* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x1 * m_RenderInfo.depthBytes);
+        uint32_t* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x1) : nullptr;
 
         // Start to render each pixel.
-        for (; x1 < x2; x1++, frameData += m_RenderInfo.colorFloats, depthData++, (nullptr != stencilData) ? stencilData++ : stencilData, StepXVSOutputFromGradient(vsOutput))
+        for (; x1 < x2; x1++, frameData += m_RenderInfo.colorFloats, depthData += m_RenderInfo.depthBytes, (nullptr != stencilData) ? stencilData++ : stencilData, StepXVSOutputFromGradient(vsOutput))
         {
             // Do stencil compare if stencil is enabled.
-            uint32_t* stencilDataPointer = (uint32_t*)stencilData;
+            uint32_t* stencilDataPointer = stencilData;
             bool stencilPassed = m_RenderInfo.stencilEnabled ? PerformPixelStencilTest(stencilDataPointer, m_RenderInfo.stencilReference, m_RenderInfo.stencilMask, m_RenderInfo.stencilWriteMask, m_RenderInfo.stencilCompare, m_RenderInfo.stencilOperatonFail) : false;
 
             // Get depth of current pixel.
@@ -2859,17 +3507,17 @@ namespace yw
                 YW3D_STENCIL_UPDATE_IF_ZFAIL(stencilPassed, stencilDataPointer, m_RenderInfo)
                 return;
             case Yw3d_CMP_Equal:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - *depthData) < YW_FLOAT_PRECISION, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - ReadPixelDepth(depthData)) < m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_NotEqual:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - *depthData) >= YW_FLOAT_PRECISION, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - ReadPixelDepth(depthData)) >= m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_Less:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth < *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth < ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_LessEqual:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth <= *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth <= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_Greater: 
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth > *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth > ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_GreaterEqual: 
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth >= *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth >= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_Always:
                 YW3D_STENCIL_UPDATE_IF_PASS(stencilPassed, stencilDataPointer, m_RenderInfo)
                 break;
@@ -2886,7 +3534,7 @@ namespace yw
             // Passed depth test - update depthbuffer!
             if (m_RenderInfo.depthWriteEnabled)
             {
-                *depthData = depth;
+                WritePixelDepth(depthData, depth);
             }
 
             // Update color buffer.
@@ -2963,16 +3611,19 @@ namespace yw
         x1 = max((int32_t)m_RenderInfo.viewportRect.left, min(x1, (int32_t)m_RenderInfo.viewportRect.right));
         x2 = max((int32_t)m_RenderInfo.viewportRect.left, min(x2, (int32_t)m_RenderInfo.viewportRect.right));
 
+        // Write pending fast cleared tiles before accessing the buffers.
+        ResolveFastClearSpan(y, x1, x2);
+
         // Get color buffer data and depth buffer data.
         float* frameData = m_RenderInfo.frameData + (y * m_RenderInfo.colorBufferPitch + x1 * m_RenderInfo.colorFloats);
-        float* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x1);
-        float* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x1) : nullptr;
+        uint8_t* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x1 * m_RenderInfo.depthBytes);
+        uint32_t* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x1) : nullptr;
 
         // Start to render each pixel.
-        for (; x1 < x2; x1++, frameData += m_RenderInfo.colorFloats, depthData++, (nullptr != stencilData) ? stencilData++ : stencilData, StepXVSOutputFromGradient(vsOutput))
+        for (; x1 < x2; x1++, frameData += m_RenderInfo.colorFloats, depthData += m_RenderInfo.depthBytes, (nullptr != stencilData) ? stencilData++ : stencilData, StepXVSOutputFromGradient(vsOutput))
         {
             // Do stencil compare if stencil is enabled.
-            uint32_t* stencilDataPointer = (uint32_t*)stencilData;
+            uint32_t* stencilDataPointer = stencilData;
             bool stencilPassed = m_RenderInfo.stencilEnabled ? PerformPixelStencilTest(stencilDataPointer, m_RenderInfo.stencilReference, m_RenderInfo.stencilMask, m_RenderInfo.stencilWriteMask, m_RenderInfo.stencilCompare, m_RenderInfo.stencilOperatonFail) : false;
 
             // Get depth of current pixel.
@@ -2985,17 +3636,17 @@ namespace yw
                 YW3D_STENCIL_UPDATE_IF_ZFAIL(stencilPassed, stencilDataPointer, m_RenderInfo)
                 return;
             case Yw3d_CMP_Equal:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - *depthData) < YW_FLOAT_PRECISION, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - ReadPixelDepth(depthData)) < m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_NotEqual:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - *depthData) >= YW_FLOAT_PRECISION, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - ReadPixelDepth(depthData)) >= m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_Less:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth < *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth < ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_LessEqual:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth <= *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth <= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_Greater:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth > *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth > ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_GreaterEqual:
-                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth >= *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth >= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
             case Yw3d_CMP_Always:
                 YW3D_STENCIL_UPDATE_IF_PASS(stencilPassed, stencilDataPointer, m_RenderInfo)
                 break;
@@ -3045,7 +3696,7 @@ namespace yw
                 // Passed depth-test and pixel was not killed, so update depthbuffer.
                 if (m_RenderInfo.depthWriteEnabled)
                 {
-                    *depthData = depth;
+                    WritePixelDepth(depthData, depth);
                 }
 
                 // Perform alpha test stage.
@@ -3095,12 +3746,15 @@ namespace yw
         x1 = max((int32_t)m_RenderInfo.viewportRect.left, min(x1, (int32_t)m_RenderInfo.viewportRect.right));
         x2 = max((int32_t)m_RenderInfo.viewportRect.left, min(x2, (int32_t)m_RenderInfo.viewportRect.right));
 
+        // Write pending fast cleared tiles before accessing the buffers.
+        ResolveFastClearSpan(y, x1, x2);
+
         // Get color buffer data and depth buffer data.
         float* frameData = m_RenderInfo.frameData + (y * m_RenderInfo.colorBufferPitch + x1 * m_RenderInfo.colorFloats);
-        float* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x1);
+        uint8_t* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x1 * m_RenderInfo.depthBytes);
 
         // Start to render each pixel.
-        for (; x1 < x2; x1++, frameData += m_RenderInfo.colorFloats, depthData++, StepXVSOutputFromGradient(vsOutput))
+        for (; x1 < x2; x1++, frameData += m_RenderInfo.colorFloats, depthData += m_RenderInfo.depthBytes, StepXVSOutputFromGradient(vsOutput))
         {
             // Get only shader register data only.
             // Note: psInput now only contains valid register data, position etc. are not initialized!
@@ -3140,12 +3794,12 @@ namespace yw
             switch (m_RenderInfo.depthCompare)
             {
             case Yw3d_CMP_Never: return;
-            case Yw3d_CMP_Equal: if (fabsf(depth - *depthData) < YW_FLOAT_PRECISION) break; else continue;
-            case Yw3d_CMP_NotEqual: if (fabsf(depth - *depthData) >= YW_FLOAT_PRECISION) break; else continue;
-            case Yw3d_CMP_Less: if (depth < *depthData) break; else continue;
-            case Yw3d_CMP_LessEqual: if (depth <= *depthData) break; else continue;
-            case Yw3d_CMP_Greater: if (depth > *depthData) break; else continue;
-            case Yw3d_CMP_GreaterEqual: if (depth >= *depthData) break; else continue;
+            case Yw3d_CMP_Equal: if (fabsf(depth - ReadPixelDepth(depthData)) < m_RenderInfo.depthPrecision) break; else continue;
+            case Yw3d_CMP_NotEqual: if (fabsf(depth - ReadPixelDepth(depthData)) >= m_RenderInfo.depthPrecision) break; else continue;
+            case Yw3d_CMP_Less: if (depth < ReadPixelDepth(depthData)) break; else continue;
+            case Yw3d_CMP_LessEqual: if (depth <= ReadPixelDepth(depthData)) break; else continue;
+            case Yw3d_CMP_Greater: if (depth > ReadPixelDepth(depthData)) break; else continue;
+            case Yw3d_CMP_GreaterEqual: if (depth >= ReadPixelDepth(depthData)) break; else continue;
             case Yw3d_CMP_Always: break;
             default: break; // Can not happen.
             }
@@ -3153,7 +3807,7 @@ namespace yw
             // Passed depth test - update depthbuffer!
             if (m_RenderInfo.depthWriteEnabled)
             {
-                *depthData = depth;
+                WritePixelDepth(depthData, depth);
             }
 
             // Perform alpha test stage.
@@ -3199,13 +3853,16 @@ namespace yw
             return;
         }
 
+        // Write pending fast cleared tiles before accessing the buffers.
+        ResolveFastClearSpan(y, x, x + 1);
+
         // Get color buffer data and depth buffer data.
         float* frameData = m_RenderInfo.frameData + (y * m_RenderInfo.colorBufferPitch + x * m_RenderInfo.colorFloats);
-        float* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x);
-        float* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x) : nullptr;
+        uint8_t* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x * m_RenderInfo.depthBytes);
+        uint32_t* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x) : nullptr;
 
         // Do stencil compare if stencil is enabled.
-        uint32_t* stencilDataPointer = (uint32_t*)stencilData;
+        uint32_t* stencilDataPointer = stencilData;
         bool stencilPassed = m_RenderInfo.stencilEnabled ? PerformPixelStencilTest(stencilDataPointer, m_RenderInfo.stencilReference, m_RenderInfo.stencilMask, m_RenderInfo.stencilWriteMask, m_RenderInfo.stencilCompare, m_RenderInfo.stencilOperatonFail) : false;
 
         // Get depth of current pixel.
@@ -3218,17 +3875,17 @@ namespace yw
             YW3D_STENCIL_UPDATE_IF_ZFAIL(stencilPassed, stencilDataPointer, m_RenderInfo)
             return;
         case Yw3d_CMP_Equal:
-            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(fabsf(depth - *depthData) < YW_FLOAT_PRECISION, stencilPassed, stencilDataPointer, m_RenderInfo)
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(fabsf(depth - ReadPixelDepth(depthData)) < m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
         case Yw3d_CMP_NotEqual:
-            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(fabsf(depth - *depthData) >= YW_FLOAT_PRECISION, stencilPassed, stencilDataPointer, m_RenderInfo)
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(fabsf(depth - ReadPixelDepth(depthData)) >= m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
         case Yw3d_CMP_Less:
-            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth < *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth < ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
         case Yw3d_CMP_LessEqual:
-            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth <= *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth <= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
         case Yw3d_CMP_Greater:
-            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth > *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth > ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
         case Yw3d_CMP_GreaterEqual:
-            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth >= *depthData, stencilPassed, stencilDataPointer, m_RenderInfo)
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth >= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
         case Yw3d_CMP_Always:
             YW3D_STENCIL_UPDATE_IF_PASS(stencilPassed, stencilDataPointer, m_RenderInfo)
             break;
@@ -3245,7 +3902,7 @@ namespace yw
         // Passed depth test - update depthbuffer!
         if (m_RenderInfo.depthWriteEnabled)
         {
-            *depthData = depth;
+            WritePixelDepth(depthData, depth);
         }
 
         // Update color buffer.
@@ -3313,9 +3970,12 @@ namespace yw
             return;
         }
 
+        // Write pending fast cleared tiles before accessing the buffers.
+        ResolveFastClearSpan(y, x, x + 1);
+
         // Get color buffer data and depth buffer data.
         float* frameData = m_RenderInfo.frameData + (y * m_RenderInfo.colorBufferPitch + x * m_RenderInfo.colorFloats);
-        float* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x);
+        uint8_t* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x * m_RenderInfo.depthBytes);
 
         // Read in current pixel's color in the colorbuffer.
         Vector4 pixelColor(0.0f, 0.0f, 0.0f, 1.0f);
@@ -3350,12 +4010,12 @@ namespace yw
         switch (m_RenderInfo.depthCompare)
         {
         case Yw3d_CMP_Never: return;
-        case Yw3d_CMP_Equal: if (fabsf(depth - *depthData) < YW_FLOAT_PRECISION) break; else return;
-        case Yw3d_CMP_NotEqual: if (fabsf(depth - *depthData) >= YW_FLOAT_PRECISION) break; else return;
-        case Yw3d_CMP_Less: if (depth < *depthData) break; else return;
-        case Yw3d_CMP_LessEqual: if (depth <= *depthData) break; else return;
-        case Yw3d_CMP_Greater: if (depth > *depthData) break; else return;
-        case Yw3d_CMP_GreaterEqual: if (depth >= *depthData) break; else return;
+        case Yw3d_CMP_Equal: if (fabsf(depth - ReadPixelDepth(depthData)) < m_RenderInfo.depthPrecision) break; else return;
+        case Yw3d_CMP_NotEqual: if (fabsf(depth - ReadPixelDepth(depthData)) >= m_RenderInfo.depthPrecision) break; else return;
+        case Yw3d_CMP_Less: if (depth < ReadPixelDepth(depthData)) break; else return;
+        case Yw3d_CMP_LessEqual: if (depth <= ReadPixelDepth(depthData)) break; else return;
+        case Yw3d_CMP_Greater: if (depth > ReadPixelDepth(depthData)) break; else return;
+        case Yw3d_CMP_GreaterEqual: if (depth >= ReadPixelDepth(depthData)) break; else return;
         case Yw3d_CMP_Always: break;
         default: break; // Can not happen.
         }
@@ -3363,7 +4023,7 @@ namespace yw
         // Passed depth test - update depthbuffer!
         if (m_RenderInfo.depthWriteEnabled)
         {
-            *depthData = depth;
+            WritePixelDepth(depthData, depth);
         }
 
         // Perform alpha test stage.
@@ -3399,11 +4059,272 @@ namespace yw
         m_RenderInfo.renderedPixels++;
     }
 
+    void Yw3dDevice::RasterizeScanline_MultipleColors(int32_t y, int32_t x1, int32_t x2, Yw3dVSOutput* vsOutput)
+    {
+        // Skip if the y coordinate off the screen area.
+        if (y < (int32_t)m_RenderInfo.viewportRect.top || y >= (int32_t)m_RenderInfo.viewportRect.bottom)
+        {
+            return;
+        }
+
+        // Clamp the x coordinate into screen area.
+        x1 = max((int32_t)m_RenderInfo.viewportRect.left, min(x1, (int32_t)m_RenderInfo.viewportRect.right));
+        x2 = max((int32_t)m_RenderInfo.viewportRect.left, min(x2, (int32_t)m_RenderInfo.viewportRect.right));
+
+        // Write pending fast cleared tiles before accessing the buffers.
+        ResolveFastClearSpan(y, x1, x2);
+
+        // Get depth buffer data, the colorbuffer attachments are addressed per pixel when the pixel shader is executed.
+        uint8_t* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x1 * m_RenderInfo.depthBytes);
+        uint32_t* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x1) : nullptr;
+
+        // Start to render each pixel.
+        for (; x1 < x2; x1++, depthData += m_RenderInfo.depthBytes, (nullptr != stencilData) ? stencilData++ : stencilData, StepXVSOutputFromGradient(vsOutput))
+        {
+            // Do stencil compare if stencil is enabled.
+            uint32_t* stencilDataPointer = stencilData;
+            bool stencilPassed = m_RenderInfo.stencilEnabled ? PerformPixelStencilTest(stencilDataPointer, m_RenderInfo.stencilReference, m_RenderInfo.stencilMask, m_RenderInfo.stencilWriteMask, m_RenderInfo.stencilCompare, m_RenderInfo.stencilOperatonFail) : false;
+
+            // Get depth of current pixel.
+            float depth = vsOutput->position.z;
+
+            // Perform depth test.
+            switch (m_RenderInfo.depthCompare)
+            {
+            case Yw3d_CMP_Never:
+                YW3D_STENCIL_UPDATE_IF_ZFAIL(stencilPassed, stencilDataPointer, m_RenderInfo)
+                return;
+            case Yw3d_CMP_Equal:
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - ReadPixelDepth(depthData)) < m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
+            case Yw3d_CMP_NotEqual:
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(fabsf(depth - ReadPixelDepth(depthData)) >= m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
+            case Yw3d_CMP_Less:
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth < ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+            case Yw3d_CMP_LessEqual:
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth <= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+            case Yw3d_CMP_Greater:
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth > ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+            case Yw3d_CMP_GreaterEqual:
+                YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_CONTINUE(depth >= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+            case Yw3d_CMP_Always:
+                YW3D_STENCIL_UPDATE_IF_PASS(stencilPassed, stencilDataPointer, m_RenderInfo)
+                break;
+            default:
+                break; // Can not happen.
+            }
+
+            // Check if we need to skip this pixel because of stencil test fail.
+            if (m_RenderInfo.stencilEnabled && !stencilPassed)
+            {
+                continue;
+            }
+
+            // Only update color and depth buffer when pixel is not killed.
+            if (m_RenderInfo.colorWriteEnabled || m_RenderInfo.depthWriteEnabled)
+            {
+                // Get only shader register data only.
+                // Note: psInput now only contains valid register data, position etc. are not initialized!
+                Yw3dVSOutput psInput;
+                m_TriangleInfo.curPixelInvW = 1.0f / vsOutput->position.w;
+                MultiplyVertexShaderOutputRegisters(&psInput, vsOutput, m_TriangleInfo.curPixelInvW);
+
+                // The attributes are interpolated once for all attachments.
+                if (!ShadePixel_MultipleColors(x1, y, psInput.shaderOutputs, depth, depthData))
+                {
+                    continue;
+                }
+            }
+
+            m_RenderInfo.renderedPixels++;
+        }
+    }
+
+    void Yw3dDevice::DrawPixel_MultipleColors(int32_t x, int32_t y, const Yw3dVSOutput* vsOutput)
+    {
+        // Check if coordinate in screen area.
+        if (x < (int32_t)m_RenderInfo.viewportRect.left || x >= (int32_t)m_RenderInfo.viewportRect.right ||
+            y < (int32_t)m_RenderInfo.viewportRect.top || y >= (int32_t)m_RenderInfo.viewportRect.bottom)
+        {
+            return;
+        }
+
+        // Write pending fast cleared tiles before accessing the buffers.
+        ResolveFastClearSpan(y, x, x + 1);
+
+        // Get depth buffer data.
+        uint8_t* depthData = m_RenderInfo.depthData + (y * m_RenderInfo.depthBufferPitch + x * m_RenderInfo.depthBytes);
+        uint32_t* stencilData = m_RenderInfo.stencilEnabled ? m_RenderInfo.stencilData + (y * m_RenderInfo.stencilBufferPitch + x) : nullptr;
+
+        // Do stencil compare if stencil is enabled.
+        uint32_t* stencilDataPointer = stencilData;
+        bool stencilPassed = m_RenderInfo.stencilEnabled ? PerformPixelStencilTest(stencilDataPointer, m_RenderInfo.stencilReference, m_RenderInfo.stencilMask, m_RenderInfo.stencilWriteMask, m_RenderInfo.stencilCompare, m_RenderInfo.stencilOperatonFail) : false;
+
+        // Get depth of current pixel.
+        float depth = vsOutput->position.z;
+
+        // Perform depth test.
+        switch (m_RenderInfo.depthCompare)
+        {
+        case Yw3d_CMP_Never:
+            YW3D_STENCIL_UPDATE_IF_ZFAIL(stencilPassed, stencilDataPointer, m_RenderInfo)
+            return;
+        case Yw3d_CMP_Equal:
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(fabsf(depth - ReadPixelDepth(depthData)) < m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
+        case Yw3d_CMP_NotEqual:
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(fabsf(depth - ReadPixelDepth(depthData)) >= m_RenderInfo.depthPrecision, stencilPassed, stencilDataPointer, m_RenderInfo)
+        case Yw3d_CMP_Less:
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth < ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+        case Yw3d_CMP_LessEqual:
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth <= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+        case Yw3d_CMP_Greater:
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth > ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+        case Yw3d_CMP_GreaterEqual:
+            YW3D_DEPTH_TEST_AND_STENCIL_UPDATE_FAIL_TO_RETURN(depth >= ReadPixelDepth(depthData), stencilPassed, stencilDataPointer, m_RenderInfo)
+        case Yw3d_CMP_Always:
+            YW3D_STENCIL_UPDATE_IF_PASS(stencilPassed, stencilDataPointer, m_RenderInfo)
+            break;
+        default:
+            break; // Can not happen.
+        }
+
+        // Check if we need to skip this pixel because of stencil test fail.
+        if (m_RenderInfo.stencilEnabled && !stencilPassed)
+        {
+            return;
+        }
+
+        // Only update color and depth buffer when pixel is not killed.
+        if (m_RenderInfo.colorWriteEnabled || m_RenderInfo.depthWriteEnabled)
+        {
+            m_TriangleInfo.curPixelY = y;
+            if (!ShadePixel_MultipleColors(x, y, vsOutput->shaderOutputs, depth, depthData))
+            {
+                return;
+            }
+        }
+
+        m_RenderInfo.renderedPixels++;
+    }
+
+    inline bool Yw3dDevice::ShadePixel_MultipleColors(int32_t x, int32_t y, const Yw3dShaderRegister* input, float& depth, uint8_t* depthData)
+    {
+        // Read in current pixel's colors in the colorbuffer attachments.
+        float* colorData[YW3D_MAX_COLOR_BUFFERS];
+        Vector4 pixelColors[YW3D_MAX_COLOR_BUFFERS];
+        Vector4 outputColors[YW3D_MAX_COLOR_BUFFERS];
+        for (uint32_t bufferIdx = 0; bufferIdx < YW3D_MAX_COLOR_BUFFERS; bufferIdx++)
+        {
+            Vector4& pixelColor = pixelColors[bufferIdx];
+            pixelColor = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+            colorData[bufferIdx] = nullptr;
+
+            const uint32_t colorFloats = m_RenderInfo.colorBuffersFloats[bufferIdx];
+            if ((bufferIdx < m_RenderInfo.numColorBuffers) && (nullptr != m_RenderInfo.colorBuffersData[bufferIdx]))
+            {
+                float* frameData = m_RenderInfo.colorBuffersData[bufferIdx] + (y * m_RenderInfo.colorBuffersPitch[bufferIdx] + x * colorFloats);
+                switch (colorFloats)
+                {
+                case 4:
+                    pixelColor.a = frameData[3];
+                case 3:
+                    pixelColor.b = frameData[2];
+                case 2:
+                    pixelColor.g = frameData[1];
+                case 1:
+                    pixelColor.r = frameData[0];
+                default:    // Can not happen.
+                    break;
+                }
+
+                colorData[bufferIdx] = frameData;
+            }
+
+            outputColors[bufferIdx] = pixelColor;
+        }
+
+        // Execute the pixel shader.
+        m_TriangleInfo.curPixelX = x;
+        if (!m_PixelShader->ExecuteMultipleColors(input, outputColors, depth))
+        {
+            // Pixel got killed.
+            return false;
+        }
+
+        // Passed depth-test and pixel was not killed, so update depthbuffer.
+        if (m_RenderInfo.depthWriteEnabled)
+        {
+            WritePixelDepth(depthData, depth);
+        }
+
+        // Perform alpha test stage with the color of the first attachment.
+        if (m_RenderInfo.alphaTestEnabled && !PerformAlphaTestStage(outputColors[0]))
+        {
+            return false;
+        }
+
+        if (!m_RenderInfo.colorWriteEnabled)
+        {
+            return true;
+        }
+
+        // Blend and write the new colors to the colorbuffer attachments.
+        for (uint32_t bufferIdx = 0; bufferIdx < m_RenderInfo.numColorBuffers; bufferIdx++)
+        {
+            float* frameData = colorData[bufferIdx];
+            if (nullptr == frameData)
+            {
+                continue;
+            }
+
+            Vector4 outputColor = outputColors[bufferIdx];
+            if (m_RenderInfo.alphaBlendEnabled)
+            {
+                outputColor = PerformAlphaBlendStage(outputColor, pixelColors[bufferIdx]);
+            }
+
+            switch (m_RenderInfo.colorBuffersFloats[bufferIdx])
+            {
+            case 4:
+                frameData[3] = outputColor.a;
+            case 3:
+                frameData[2] = outputColor.b;
+            case 2:
+                frameData[1] = outputColor.g;
+            case 1:
+                frameData[0] = outputColor.r;
+            default:    // Can not happen.
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    void Yw3dDevice::UnlockColorAttachments()
+    {
+        for (uint32_t bufferIdx = 1; bufferIdx < YW3D_MAX_COLOR_BUFFERS; bufferIdx++)
+        {
+            if (nullptr == m_RenderInfo.colorBuffersData[bufferIdx])
+            {
+                continue;
+            }
+
+            Yw3dSurface* attachment = m_RenderTarget->AcquireColorBuffer(bufferIdx);
+            if (nullptr != attachment)
+            {
+                attachment->UnlockRect();
+            }
+
+            YW_SAFE_RELEASE(attachment);
+            m_RenderInfo.colorBuffersData[bufferIdx] = nullptr;
+        }
+    }
+
     bool Yw3dDevice::PerformPixelStencilTest(uint32_t* stencil, uint32_t reference, uint32_t mask, uint32_t writeMask, Yw3dCompareFunction compare, Yw3dStencilOperaton operatonFail)
     {
         bool stencilPassed = false;
         uint32_t lhs = reference & mask;
-        uint32_t rhs = (*stencil) & mask;
+        uint32_t rhs = (*stencil) & m_RenderInfo.stencilBitsMask & mask;
         switch (compare)
         {
         case Yw3d_CMP_Never:
@@ -3436,8 +4357,9 @@ namespace yw
 
         if (!stencilPassed)
         {
-            // Stencil Fail.
-            *stencil = CalculatePixelStencilValue(*stencil, reference, writeMask, operatonFail);
+            // Stencil Fail, keep the bits outside the stencil of a packed pixel.
+            const uint32_t bitsMask = m_RenderInfo.stencilBitsMask;
+            *stencil = ((*stencil) & ~bitsMask) | (CalculatePixelStencilValue((*stencil) & bitsMask, reference, writeMask, operatonFail) & bitsMask);
         }
 
         return stencilPassed;
@@ -6,6 +6,7 @@
 
 #include "Yw3dBase.h"
 #include "Yw3dTypes.h"
+#include "Yw3dBaseTexture.h"
 
 namespace yw
 {
@@ -42,6 +43,26 @@ namespace yw
         // @return the device parameters.
         const Yw3dDeviceParameters& GetDeviceParameters() const;
 
+        // Get the worker pool of the device, used to split data-parallel work over all hardware threads.
+        // @return the worker pool, valid as long as the device.
+        class Yw3dWorkerPool* GetWorkerPool();
+
+        // Get the memory allocator of the device, resources and transient per-frame data are allocated from it.
+        // @return the allocator, valid as long as the device.
+        class Yw3dAllocator* GetAllocator();
+
+        // Get the features of the CPU the device runs on.
+        // @return a combination of Yw3dCpuFeature flags.
+        uint32_t GetCpuFeatures() const;
+
+        // Get the SIMD level selected at creation time, the best one supported by the CPU up to Yw3dDeviceParameters::maxSimdLevel.
+        // @return member of the enumeration Yw3dSimdLevel.
+        Yw3dSimdLevel GetSimdLevel() const;
+
+        // Get the SIMD kernels of the selected level, used by the hot loops of the device and its resources.
+        // @return the kernels, valid as long as the process.
+        const struct Yw3dSimdKernels* GetSimdKernels() const;
+
         // ------------------------------------------------------------------
         // Drawing.
 
@@ -90,6 +111,16 @@ namespace yw
         // @return Yw3d_E_InvalidState if an invalid state was encountered.
         Yw3dResult DrawDynamicPrimitive(uint32_t startVertex, uint32_t numVertices);
 
+        // Runs the current compute shader over a grid of thread groups, without rasterization. The thread groups are distributed over the worker pool and the function returns when all of them have finished.
+        // The shader reads the constant buffers and textures bound to the device and reads or writes the surfaces bound with SetComputeSurface(), which are locked during the dispatch.
+        // @param[in] groupsX number of thread groups along x-axis.
+        // @param[in] groupsY number of thread groups along y-axis.
+        // @param[in] groupsZ number of thread groups along z-axis.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if the grid exceeds 2^32 thread groups.
+        // @return Yw3d_E_InvalidState if no compute shader has been set, its thread group size is invalid or a bound surface couldn't be accessed.
+        Yw3dResult Dispatch(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ);
+
         // ------------------------------------------------------------------
         // Resource creation.
 
@@ -119,15 +150,39 @@ namespace yw
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         Yw3dResult CreateVertexBuffer(class Yw3dVertexBuffer** vertexBuffer, uint32_t length);
 
+        // Creates a constant buffer for shader constants.
+        // @param[out] constantBuffer receives a pointer to the created constant buffer.
+        // @param[in] length length of the constant buffer to be created in bytes.
+        // @param[in] doubleBuffered true to write the constants to a back buffer while shaders read the front buffer, see Yw3dConstantBuffer::Flip().
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult CreateConstantBuffer(class Yw3dConstantBuffer** constantBuffer, uint32_t length, bool doubleBuffered = false);
+
         // Creates a surface.
         // @param[out] surface receives a pointer to the created surface.
         // @param[in] width width of the surface in pixels.
         // @param[in] height height of the surface in pixels.
         // @param[in] format format of the new surface. Member of the enumeration m3dformat; either m3dfmt_index16 or m3dfmt_index32.
+        // @param[in] layout memory layout of the surface pixels. Member of the enumeration Yw3dSurfaceLayout, Yw3d_SL_Tiled4x4 is only supported by float formats.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
-        Yw3dResult CreateSurface(class Yw3dSurface** surface, uint32_t width, uint32_t height, Yw3dFormat format);
+        Yw3dResult CreateSurface(class Yw3dSurface** surface, uint32_t width, uint32_t height, Yw3dFormat format, Yw3dSurfaceLayout layout = Yw3d_SL_Linear);
+
+        // Creates a surface from pixels in its memory layout, e.g. a mip-level of a memory mapped texture file.
+        // @param[out] surface receives a pointer to the created surface.
+        // @param[in] width width of the surface in pixels.
+        // @param[in] height height of the surface in pixels.
+        // @param[in] format format of the new surface. Member of the enumeration Yw3dFormat.
+        // @param[in] layout memory layout of the surface pixels. Member of the enumeration Yw3dSurfaceLayout.
+        // @param[in] data pixels of the surface, see Yw3dSurface::GetStorage().
+        // @param[in] dataSize number of bytes of data, has to match Yw3dSurface::GetStorageSize() of the new surface.
+        // @param[in] dataOwner object keeping data alive, the surface uses data in place without copying and holds a reference to dataOwner. (Pass 0 to copy data.)
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid, e.g. data used in place isn't aligned to YW3D_ALLOCATION_ALIGNMENT bytes.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult CreateSurfaceFromMemory(class Yw3dSurface** surface, uint32_t width, uint32_t height, Yw3dFormat format, Yw3dSurfaceLayout layout, void* data, size_t dataSize, IBase* dataOwner);
 
         // Creates a standard 2d texture, which may either be used for texture data storage or as a target for rendering-operations (as frame- or depthbuffer).
         // @param[out] texture receives a pointer to the created texture.
@@ -135,20 +190,50 @@ namespace yw
         // @param[in] height height of the texture in pixels.
         // @param[in] mipLevels number of miplevels of the new texture; specify 0 to create a full mip-chain.
         // @param[in] format format of the new texture. Member of the enumeration Yw3dFormat.
+        // @param[in] layout memory layout of the mip-level pixels. Member of the enumeration Yw3dSurfaceLayout, Yw3d_SL_Tiled4x4 is only supported by float formats.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
-        Yw3dResult CreateTexture(class Yw3dTexture** texture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format);
+        Yw3dResult CreateTexture(class Yw3dTexture** texture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout = Yw3d_SL_Linear);
+
+        // Creates a standard 2d texture from the pixels of its mip-levels in their memory layout, e.g. the mip-levels of a memory mapped texture file.
+        // @param[out] texture receives a pointer to the created texture.
+        // @param[in] width width of the texture in pixels.
+        // @param[in] height height of the texture in pixels.
+        // @param[in] mipLevels number of miplevels of the new texture, the number of entries of mipLevelsData and mipLevelsDataSize.
+        // @param[in] format format of the new texture. Member of the enumeration Yw3dFormat.
+        // @param[in] layout memory layout of the mip-level pixels. Member of the enumeration Yw3dSurfaceLayout.
+        // @param[in] mipLevelsData pixels of each mip-level.
+        // @param[in] mipLevelsDataSize number of bytes of the pixels of each mip-level.
+        // @param[in] dataOwner object keeping the pixels alive, the mip-levels use them in place without copying and hold a reference to dataOwner. (Pass 0 to copy the pixels.)
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult CreateTextureFromMemory(class Yw3dTexture** texture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout, void* const* mipLevelsData, const size_t* mipLevelsDataSize, IBase* dataOwner);
 
         // Creates a cube texture. A pointer to each of the 6 faces can be obtained and used as a target for renderin-operations like a standard 2d texture.
         // @param[out] cubeTexture receives a pointer to the created texture.
         // @param[in] edgeLength edge length of the texture in pixels.
         // @param[in] mipLevels number of miplevels of the new texture; specify 0 to create a full mip-chain.
         // @param[in] format format of the new texture. Member of the enumeration Yw3dFormat.
+        // @param[in] layout memory layout of the mip-level pixels of each face. Member of the enumeration Yw3dSurfaceLayout, Yw3d_SL_Tiled4x4 is only supported by float formats.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
-        Yw3dResult CreateCubeTexture(class Yw3dCubeTexture** cubeTexture, uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format);
+        Yw3dResult CreateCubeTexture(class Yw3dCubeTexture** cubeTexture, uint32_t edgeLength, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout = Yw3d_SL_Linear);
+
+        // Creates a texture array of layers of the same size, sampled with the layer index in the w-coordinate. A pointer to each layer can be obtained and used like a standard 2d texture.
+        // @param[out] textureArray receives a pointer to the created texture.
+        // @param[in] width width of the layers in pixels.
+        // @param[in] height height of the layers in pixels.
+        // @param[in] layers number of layers of the new texture.
+        // @param[in] mipLevels number of miplevels of each layer; specify 0 to create a full mip-chain.
+        // @param[in] format format of the new texture. Member of the enumeration Yw3dFormat.
+        // @param[in] layout memory layout of the mip-level pixels of each layer. Member of the enumeration Yw3dSurfaceLayout.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult CreateTextureArray(class Yw3dTextureArray** textureArray, uint32_t width, uint32_t height, uint32_t layers, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout = Yw3d_SL_Linear);
 
         // Creates a volume.
         // @param[out] volume receives a pointer to the created volume.
@@ -156,10 +241,11 @@ namespace yw
         // @param[in] height height of the volume in pixels.
         // @param[in] depth depth of the volume in pixels.
         // @param[in] format format of the new surface. Member of the enumeration Yw3dFormat.
+        // @param[in] layout memory layout of the volume voxels. Member of the enumeration Yw3dVolumeLayout, Yw3d_VL_Bricked8x8x8 speeds up tri-linear sampling of large volumes.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
-        Yw3dResult CreateVolume(class Yw3dVolume** volume, uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format);
+        Yw3dResult CreateVolume(class Yw3dVolume** volume, uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format, Yw3dVolumeLayout layout = Yw3d_VL_Linear);
 
         // Creates a volume texture. Volume texture cannot be used as a target for rendering-operations.
         // @param[out] volumeTexture receives a pointer to the created texture.
@@ -168,18 +254,32 @@ namespace yw
         // @param[in] depth depth of the texture in pixels.
         // @param[in] mipLevels number of miplevels of the new texture; specify 0 to create a full mip-chain.
         // @param[in] format format of the new texture. Member of the enumeration Yw3dFormat.
+        // @param[in] layout memory layout of the mip-level voxels. Member of the enumeration Yw3dVolumeLayout, Yw3d_VL_Bricked8x8x8 speeds up tri-linear sampling of large volumes.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult CreateVolumeTexture(class Yw3dVolumeTexture** volumeTexture, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format, Yw3dVolumeLayout layout = Yw3d_VL_Linear);
+
+        // Creates a virtual texture, whose pages are made resident on demand within a memory budget. Virtual texture cannot be used as a target for rendering-operations.
+        // @param[out] virtualTexture receives a pointer to the created texture.
+        // @param[in] width width of the texture in pixels.
+        // @param[in] height height of the texture in pixels.
+        // @param[in] mipLevels number of miplevels of the new texture; specify 0 to create a full mip-chain.
+        // @param[in] format format of the new texture. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // @param[in] pageSize width and height of a page in pixels, a power of two.
+        // @param[in] memoryBudget maximum number of bytes of the resident pages.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
-        Yw3dResult CreateVolumeTexture(class Yw3dVolumeTexture** volumeTexture, uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format);
+        Yw3dResult CreateVirtualTexture(class Yw3dVirtualTexture** virtualTexture, uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, uint32_t pageSize, size_t memoryBudget);
 
         // Creates a render target.
         // @param[out] renderTarget receives a pointer to the created render target.
         // @param[in] width width of the volume in pixels.
         // @param[in] height height of the volume in pixels.
         // @param[in] colorFormat format of color buffer of the new surface. Member of the enumeration Yw3dFormat.
-        // @param[in] depthFormat format of depth buffer of the new surface. Member of the enumeration Yw3dFormat.
-        // @param[in] Yw3dFormat stencilFormat format of stencil buffer of the new surface. Member of the enumeration Yw3dFormat.
+        // @param[in] depthFormat format of depth buffer of the new surface. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_D24S8 or Yw3d_FMT_D16.
+        // @param[in] Yw3dFormat stencilFormat format of stencil buffer of the new surface. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F or Yw3d_FMT_D24S8. If both depthFormat and stencilFormat are Yw3d_FMT_D24S8, a single surface is shared by depth and stencil.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
@@ -265,6 +365,14 @@ namespace yw
         // Returns a pointer to the active pixel shader. Calling this function will increase the internal reference count of the pixel shader. Failure to call Release() when finished using the pointer will result in a memory leak.
         class IYw3dPixelShader* AcquirePixelShader();
 
+        // Sets the compute shader run by Dispatch().
+        // @param[in] computeShader pointer to the compute shader.
+        // @return Yw3d_S_OK if the function succeeds.
+        Yw3dResult SetComputeShader(class IYw3dComputeShader* computeShader);
+
+        // Returns a pointer to the active compute shader. Calling this function will increase the internal reference count of the compute shader. Failure to call Release() when finished using the pointer will result in a memory leak.
+        class IYw3dComputeShader* AcquireComputeShader();
+
         // Sets the index buffer.
         // @param[in] indexBuffer pointer to the index buffer.
         // @return Yw3d_S_OK if the function succeeds.
@@ -291,6 +399,36 @@ namespace yw
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         Yw3dResult AcquireVertexStream(uint32_t streamNumber, class Yw3dVertexBuffer** vertexBuffer, uint32_t* offset, uint32_t* stride);
 
+        // Sets a constant buffer to a given slot, it is read by all shaders of the following draw calls.
+        // @param[in] slot number of the slot.
+        // @param[in] constantBuffer pointer to the constant buffer.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        Yw3dResult SetConstantBuffer(uint32_t slot, class Yw3dConstantBuffer* constantBuffer);
+
+        // Returns a pointer to the active constant buffer of a given slot. Calling this function will increase the internal reference count of the constant buffer. Failure to call Release() when finished using the pointer will result in a memory leak.
+        // @param[in] slot number of the slot.
+        // @param[out] constantBuffer receives a pointer to the constant buffer.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        Yw3dResult AcquireConstantBuffer(uint32_t slot, class Yw3dConstantBuffer** constantBuffer);
+
+        // Sets a surface to a given slot, it is read and written by the compute shader of the following dispatches. A surface may only be bound to one slot.
+        // Mip-levels of textures and faces of cube textures are bound through their surfaces, see Yw3dTexture::AcquireMipLevel().
+        // @param[in] slot number of the slot.
+        // @param[in] surface pointer to the surface, format Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_InvalidFormat if the format of the surface is not supported.
+        Yw3dResult SetComputeSurface(uint32_t slot, class Yw3dSurface* surface);
+
+        // Returns a pointer to the surface of a given slot. Calling this function will increase the internal reference count of the surface. Failure to call Release() when finished using the pointer will result in a memory leak.
+        // @param[in] slot number of the slot.
+        // @param[out] surface receives a pointer to the surface.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        Yw3dResult AcquireComputeSurface(uint32_t slot, class Yw3dSurface** surface);
+
         // Sets a vertex buffer to a given sampler.
         // @param[in] samplerNumber number of the sampler.
         // @param[in] texture pointer to the texture.
@@ -384,6 +522,13 @@ namespace yw
         // Initializes samplerstates to default values.
         void SetDefaultTextureSamplerStates();
 
+        // Resolves the sampling function of a texture sampler, called when its texture or a state changes.
+        // @param[in] samplerNumber number of the sampler.
+        void UpdateSampleFunction(uint32_t samplerNumber);
+
+        // Writes the pending fast cleared tiles of the bound textures before a draw call or a dispatch samples them, the sampling functions don't resolve them.
+        void ResolveTextureFastClears();
+
         // Initializes the frustum clipping planes.
         void SetDefaultClippingPlanes();
 
@@ -413,6 +558,13 @@ namespace yw
         // @param[in] vertexIndex index of the vertex.
         Yw3dResult FetchVertex(Yw3dVertexCacheEntry** vertexCacheEntry, uint32_t vertexIndex);
 
+        // Shades a range of vertices in a pre-pass if the vertex shader has a batch entry point, FetchVertex() returns them without using the vertex cache.
+        // The vertices are decoded and transposed to SoA layout in batches of IYw3dVertexShader::GetBatchSize() vertices.
+        // Storage is allocated from the frame arena, the caller rewinds it after PostRender(). Nothing is shaded if the range cannot be decoded, FetchVertex() reports the error then.
+        // @param[in] firstVertex index of the first vertex.
+        // @param[in] numVertices number of vertices.
+        void ShadeVertexBatches(uint32_t firstVertex, uint32_t numVertices);
+
         // Begins the processing-pipeline that works on a per-triangle base. Either continues to the clipping-stage or takes care of subdivision.
         // @param[in] vsOutput0 vertex A.
         // @param[in] vsOutput1 vertex B.
@@ -565,6 +717,47 @@ namespace yw
         // @param[in] vsOutput interpolated vertex data, already divided by position w component.
         void DrawPixel_ColorDepth(int32_t x, int32_t y, const Yw3dVSOutput* vsOutput);
 
+        // Rasterizes a scanline span on screen. Writes the pixel colors, which are outputted by a Yw3d_PSO_MultipleColors pixel shader, to all colorbuffer attachments; performs the pixel stencil test and writes the pixel depth, which has been interpolated from the base triangle's vertices to the depth buffer. Supports pixel-killing.
+        // @param[in] y position in rendertarget along y-axis.
+        // @param[in] x1 left position in rendertarget along x-axis.
+        // @param[in] x2 right position in rendertarget along x-axis.
+        // @param[in,out] vsOutput interpolated vertex data.
+        void RasterizeScanline_MultipleColors(int32_t y, int32_t x1, int32_t x2, Yw3dVSOutput* vsOutput);
+
+        // Draws a single pixel. Writes the pixel colors, which are outputted by a Yw3d_PSO_MultipleColors pixel shader, to all colorbuffer attachments; performs the pixel stencil test and writes the pixel depth, which has been interpolated from the vertices to the depth buffer. Supports pixel-killing.
+        // @param[in] x position in rendertarget along x-axis.
+        // @param[in] y position in rendertarget along y-axis.
+        // @param[in] vsOutput interpolated vertex data, already divided by position w component.
+        void DrawPixel_MultipleColors(int32_t x, int32_t y, const Yw3dVSOutput* vsOutput);
+
+        // Executes a Yw3d_PSO_MultipleColors pixel shader for a pixel which passed the depth and stencil tests, then performs the alpha test with the color of attachment 0 and blends and writes the colors of all attachments.
+        // @param[in] x position in rendertarget along x-axis.
+        // @param[in] y position in rendertarget along y-axis.
+        // @param[in] input pixel shader input registers.
+        // @param[in,out] depth the interpolated depth of the pixel.
+        // @param[in] depthData the pointer to the depth buffer pixel, written if depth writing is enabled and the pixel is not killed.
+        // @return false if the pixel has been killed or failed the alpha test.
+        inline bool ShadePixel_MultipleColors(int32_t x, int32_t y, const Yw3dShaderRegister* input, float& depth, uint8_t* depthData);
+
+        // Unlocks the colorbuffer attachments locked for Yw3d_PSO_MultipleColors pixel shaders, except attachment 0 which is the regular colorbuffer.
+        void UnlockColorAttachments();
+
+        // Reads a depth value from the depth buffer, decoded according to the depth buffer format.
+        // @param[in] depthData the pointer to the depth buffer pixel.
+        // @return the depth value.
+        inline float ReadPixelDepth(const uint8_t* depthData) const;
+
+        // Writes a depth value to the depth buffer, encoded according to the depth buffer format. Stencil bits of a packed pixel are kept.
+        // @param[in,out] depthData the pointer to the depth buffer pixel.
+        // @param[in] depth the depth value to write.
+        inline void WritePixelDepth(uint8_t* depthData, float depth) const;
+
+        // Writes pending fast cleared tiles of all render-target buffers overlapping a part of a row, called before the pixels are accessed.
+        // @param[in] y the row of the pixels.
+        // @param[in] x1 first pixel of the row (inclusive).
+        // @param[in] x2 last pixel of the row (exclusive).
+        inline void ResolveFastClearSpan(int32_t y, int32_t x1, int32_t x2);
+
         // Perform a stencil test for a pixel.
         // @param[in,out] stencil the pointer to the current stencil value.
         // @param[in] reference stencil test reference value.
@@ -606,6 +799,17 @@ namespace yw
         // Base for rendering to screen.
         class IYw3dPresentTarget* m_PresentTarget;
 
+        // Worker threads of the device.
+        class Yw3dWorkerPool* m_WorkerPool;
+
+        // Memory allocator of resources and the frame arena.
+        class Yw3dAllocator* m_Allocator;
+
+        // CPU features and the SIMD kernels selected for them.
+        uint32_t m_CpuFeatures;
+        Yw3dSimdLevel m_SimdLevel;
+        const struct Yw3dSimdKernels* m_SimdKernels;
+
         // ------------------------------------------------------------------
 
         // The vertex format.
@@ -623,6 +827,9 @@ namespace yw
         // The pixel shader.
         class IYw3dPixelShader* m_PixelShader;
 
+        // The compute shader.
+        class IYw3dComputeShader* m_ComputeShader;
+
         // The index buffer.
         class Yw3dIndexBuffer* m_IndexBuffer;
 
@@ -647,6 +854,12 @@ namespace yw
         // The vertex streams;
         VertexStream m_VertexStreams[YW3D_MAX_VERTEX_STREAMS];
 
+        // The constant buffer slots.
+        class Yw3dConstantBuffer* m_ConstantBuffers[YW3D_MAX_CONSTANT_BUFFERS];
+
+        // The surface slots of the compute shader.
+        class Yw3dSurface* m_ComputeSurfaces[YW3D_MAX_COMPUTE_SURFACES];
+
         // ------------------------------------------------------------------
 
         // The transform state.
@@ -674,12 +887,12 @@ namespace yw
             // The samplers states.
             uint32_t textureSamplerStates[Yw3d_TSS_NumTextureSamplerStates];
 
-            // Type of texture coordinates for sampling.
-            Yw3dTextureSampleInput textureSampleInput;
+            // Sampling function of the texture for the sampler states, nullptr if there is no texture.
+            Yw3dSampleFunction sampleFunction;
 
             TextureSampler() : 
                 texture(nullptr),
-                textureSampleInput(Yw3d_TSI_2Coords)
+                sampleFunction(nullptr)
             {
                 memset(textureSamplerStates, 0, sizeof(uint32_t) * Yw3d_TSS_NumTextureSamplerStates);
             }
@@ -700,6 +913,12 @@ namespace yw
             // Type of vertex shader output-registers.
             Yw3dShaderRegisterType vsOutputRegisterTypes[YW3D_PIXEL_SHADER_REGISTERS];
 
+            // All bits set for each used float of the vertex shader output-registers, 0 for the others; read by the SIMD register kernels.
+            uint32_t vsOutputRegisterMask[4 * YW3D_PIXEL_SHADER_REGISTERS];
+
+            // Number of floats of the vertex shader output-registers up to the last used one, a multiple of 4.
+            uint32_t vsOutputRegisterFloats;
+
             // ------------------------------------------------------------------
             // Frame and color info.
 
@@ -715,15 +934,37 @@ namespace yw
             // True if writing to the colorbuffer has been enabled + if a colorbuffer is available.
             bool colorWriteEnabled;
 
+            // Holds pointers to the data of the colorbuffer attachments written by Yw3d_PSO_MultipleColors pixel shaders, nullptr for attachments that have not been set.
+            // Entry 0 equals frameData, the others are only locked for Yw3d_PSO_MultipleColors pixel shaders.
+            float* colorBuffersData[YW3D_MAX_COLOR_BUFFERS];
+
+            // Number of floats of each colorbuffer attachment.
+            uint32_t colorBuffersFloats[YW3D_MAX_COLOR_BUFFERS];
+
+            // Pitch of each colorbuffer attachment in multiples of sizeof(float).
+            uint32_t colorBuffersPitch[YW3D_MAX_COLOR_BUFFERS];
+
+            // Number of entries of colorBuffersData to be written, 1 for other pixel shaders than Yw3d_PSO_MultipleColors.
+            uint32_t numColorBuffers;
+
             // ------------------------------------------------------------------
             // Depth info.
 
-            // Holds a pointer to the depthbuffer data.
-            float* depthData;
+            // Holds a pointer to the depthbuffer data, layout depends on depthFormat.
+            uint8_t* depthData;
 
-            // Depthbuffer width * 1 (depthbuffers may only contain a single float); pitch in multiples of sizeof(float).
+            // Depthbuffer width * depthBytes; pitch in bytes.
             uint32_t depthBufferPitch;
 
+            // Number of bytes of a depthbuffer pixel.
+            uint32_t depthBytes;
+
+            // Format of the depthbuffer; Yw3d_FMT_R32F, Yw3d_FMT_D24S8 or Yw3d_FMT_D16.
+            Yw3dFormat depthFormat;
+
+            // Tolerance of the equal and not-equal depth compare-function, matches the precision of depthFormat.
+            float depthPrecision;
+
             // Depth compare-function. If no depthbuffer is available this is m3dcmp_always.
             Yw3dCompareFunction depthCompare;
 
@@ -733,12 +974,15 @@ namespace yw
             // ------------------------------------------------------------------
             // Stencil info.
 
-            // Holds a pointer to the stencilbuffer data.
-            float* stencilData;
+            // Holds a pointer to the stencilbuffer data, may point to the same memory as depthData for Yw3d_FMT_D24S8.
+            uint32_t* stencilData;
 
-            // Stencilbuffer width * 1 (stencilbuffers may only contain a single float); pitch in multiples of sizeof(float).
+            // Stencilbuffer width * 1 (stencilbuffers may only contain a single uint32_t); pitch in multiples of sizeof(uint32_t).
             uint32_t stencilBufferPitch;
 
+            // Bits of a stencilbuffer pixel holding the stencil value, 0xffffffff for Yw3d_FMT_R32F and YW3D_D24S8_STENCIL_MASK for Yw3d_FMT_D24S8.
+            uint32_t stencilBitsMask;
+
             // Stencil operation when stencil test pass (Both stencil and depth pass).
             Yw3dStencilOperaton stencilOperatonPass;
 
@@ -820,6 +1064,12 @@ namespace yw
             // Active viewport rectangle.
             Yw3dRect viewportRect;
 
+            // Render-target buffers with fast clears enabled, pending cleared tiles are written before the rasterizer accesses them.
+            class Yw3dSurface* fastClearSurfaces[YW3D_MAX_COLOR_BUFFERS + 2];
+
+            // Number of valid entries in fastClearSurfaces.
+            uint32_t numFastClearSurfaces;
+
             // ------------------------------------------------------------------
             // Clip info.
 
@@ -833,25 +1083,35 @@ namespace yw
             Plane scissorPlanes[4];
 
             RenderInfo() : 
-                frameData(nullptr), colorFloats(4), colorBufferPitch(0), colorWriteEnabled(true), 
-                depthData(nullptr), depthBufferPitch(0), depthCompare(Yw3d_CMP_Less), depthWriteEnabled(true), 
-                stencilData(nullptr), stencilBufferPitch(0), 
+                frameData(nullptr), colorFloats(4), colorBufferPitch(0), colorWriteEnabled(true), numColorBuffers(1), 
+                depthData(nullptr), depthBufferPitch(0), depthBytes(sizeof(float)), depthFormat(Yw3d_FMT_R32F), depthPrecision(YW_FLOAT_PRECISION), depthCompare(Yw3d_CMP_Less), depthWriteEnabled(true), 
+                stencilData(nullptr), stencilBufferPitch(0), stencilBitsMask(0xffffffff), 
                 stencilOperatonPass(Yw3d_StencilOp_Keep), stencilOperatonFail(Yw3d_StencilOp_Keep), stencilOperatonZFail(Yw3d_StencilOp_Keep), 
                 stencilCompare(Yw3d_CMP_Always), stencilReference(0), stencilMask(0x000000ff), stencilWriteMask(0x000000ff), stencilEnabled(false),
                 alphaTestRef(0), alphaTestFunc(Yw3d_CMP_Always), alphaTestEnabled(false),
                 srcBlend(Yw3d_Blend_One), destBlend(Yw3d_Blend_Zero), blendOp(Yw3d_BlendOp_Add), alphaBlendEnabled(false),
                 srcBlendAlpha(Yw3d_Blend_One), destBlendAlpha(Yw3d_Blend_Zero), blendOpAlpha(Yw3d_BlendOp_Add), separateAlphaBlendEnabled(false),
                 blendFactor(0xffffffff),
-                fpRasterizeScanline(nullptr), fpDrawPixel(nullptr), renderedPixels(0), viewportRect()
+                fpRasterizeScanline(nullptr), fpDrawPixel(nullptr), renderedPixels(0), viewportRect(), numFastClearSurfaces(0)
             {
                 // Init shader register types.
                 memset(vsInputRegisterTypes, 0, sizeof(vsInputRegisterTypes));
                 memset(vsOutputRegisterTypes, 0, sizeof(vsOutputRegisterTypes));
+                memset(vsOutputRegisterMask, 0, sizeof(vsOutputRegisterMask));
+                vsOutputRegisterFloats = 0;
 
                 // Init clip plans.
                 memset(clippingPlanes, 0, sizeof(clippingPlanes));
                 memset(clippingPlaneEnabled, 0, sizeof(clippingPlaneEnabled));
                 memset(scissorPlanes, 0, sizeof(scissorPlanes));
+
+                // Init colorbuffer attachments.
+                memset(colorBuffersData, 0, sizeof(colorBuffersData));
+                memset(colorBuffersFloats, 0, sizeof(colorBuffersFloats));
+                memset(colorBuffersPitch, 0, sizeof(colorBuffersPitch));
+
+                // Init fast clear surfaces.
+                memset(fastClearSurfaces, 0, sizeof(fastClearSurfaces));
             }
         };
 
@@ -872,6 +1132,11 @@ namespace yw
         // Vertex cache contents.
         Yw3dVertexCacheEntry m_VertexCache[YW3D_VERTEX_CACHE_SIZE];
 
+        // Vertices shaded by ShadeVertexBatches() for the current draw-call, their indices start at m_FirstShadedVertex.
+        Yw3dVertexCacheEntry* m_ShadedVertices;
+        uint32_t m_FirstShadedVertex;
+        uint32_t m_NumShadedVertices;
+
         // ------------------------------------------------------------------
 
         // Storage for vertices, that are created during clipping.
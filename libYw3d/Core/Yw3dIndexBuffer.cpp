@@ -2,6 +2,7 @@
 // YW Soft Renderer index buffer class.
 
 #include "Yw3dIndexBuffer.h"
+#include "Yw3dAllocator.h"
 #include "Yw3dDevice.h"
 
 namespace yw
@@ -17,7 +18,7 @@ namespace yw
 
     Yw3dIndexBuffer::~Yw3dIndexBuffer()
     {
-        YW_SAFE_DELETE_ARRAY(m_Data);
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_Data);
         YW_SAFE_RELEASE(m_Device);
     }
 
@@ -40,7 +41,7 @@ namespace yw
         m_Format = format;
 
         // Create buffer by length.
-        m_Data = new uint8_t[length];
+        m_Data = (uint8_t*)m_Device->GetAllocator()->Allocate(length);
         if (nullptr == m_Data)
         {
             LOGE(_T("Yw3dIndexBuffer::Create: out of memory, cannot create vertex buffer.\n"));
@@ -0,0 +1,492 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d mip-level generation helpers.
+
+#include "Yw3dMipmap.h"
+#include "Yw3dCpu.h"
+#include "Yw3dWorkerPool.h"
+#include <vector>
+
+namespace yw
+{
+    // Pixels of a level processed by one item of the worker pool, a band should be worth waking up a worker.
+    #define YW3D_MIP_BAND_PIXELS 4096
+
+    // Number of lobes of the Lanczos filter.
+    #define YW3D_MIP_LANCZOS_LOBES 2
+
+    // Taps of the box filter along one axis for one destination coordinate.
+    struct Yw3dBoxTaps
+    {
+        // Source coordinates, clamped to the source level.
+        uint32_t indices[3];
+
+        // Weights of the source coordinates, summing up to 1.
+        float weights[3];
+    };
+
+    // Box filter taps of all axes of a level.
+    struct Yw3dBoxLevelTaps
+    {
+        std::vector<Yw3dBoxTaps> tapsX;
+        std::vector<Yw3dBoxTaps> tapsY;
+        std::vector<Yw3dBoxTaps> tapsZ;
+
+        // Number of used taps of each axis, 2 for even and 3 for odd source dimensions.
+        uint32_t tapCountX;
+        uint32_t tapCountY;
+        uint32_t tapCountZ;
+
+        // True if all source dimensions are even so the 2x2 (2x2x2) kernel can be used.
+        bool even;
+    };
+
+    // Taps of a separable filter along one axis, the taps of destination coordinate i are stored at [i * tapsPerPixel, (i + 1) * tapsPerPixel).
+    struct Yw3dFilterTaps
+    {
+        uint32_t tapsPerPixel;
+        std::vector<uint32_t> indices;
+        std::vector<float> weights;
+    };
+
+    // Computes the box filter taps of an axis.
+    // Even source sizes take two taps weighted 0.5, odd sizes take three polyphase taps, see <<Non-Power-of-Two Mipmap Creation>>.
+    // @param[in] srcSize size of the source level along the axis.
+    // @param[in] destSize size of the destination level along the axis.
+    // @param[out] outTaps receives destSize taps.
+    // @return number of used taps per destination coordinate.
+    static uint32_t ComputeBoxTaps(uint32_t srcSize, uint32_t destSize, std::vector<Yw3dBoxTaps>& outTaps)
+    {
+        const bool even = (0 == (srcSize & 1));
+        const float normalize = 1.0f / (float)(2 * destSize + 1);
+        outTaps.resize(destSize);
+        for (uint32_t i = 0; i < destSize; i++)
+        {
+            Yw3dBoxTaps& taps = outTaps[i];
+            for (uint32_t t = 0; t < 3; t++)
+            {
+                taps.indices[t] = min(2 * i + t, srcSize - 1);
+            }
+
+            if (even)
+            {
+                taps.weights[0] = 0.5f;
+                taps.weights[1] = 0.5f;
+                taps.weights[2] = 0.0f;
+            }
+            else
+            {
+                taps.weights[0] = (float)(destSize - i) * normalize;
+                taps.weights[1] = (float)destSize * normalize;
+                taps.weights[2] = (float)(1 + i) * normalize;
+            }
+        }
+
+        return even ? 2 : 3;
+    }
+
+    // Evaluates the Lanczos kernel.
+    static inline float Lanczos(float x)
+    {
+        if (fabs(x) < 1e-5f)
+        {
+            return 1.0f;
+        }
+
+        if (fabs(x) >= (float)YW3D_MIP_LANCZOS_LOBES)
+        {
+            return 0.0f;
+        }
+
+        const float piX = YW_PI * x;
+        return (float)YW3D_MIP_LANCZOS_LOBES * sinf(piX) * sinf(piX / (float)YW3D_MIP_LANCZOS_LOBES) / (piX * piX);
+    }
+
+    // Computes the Lanczos filter taps of an axis, the kernel is stretched by the downsampling ratio and clamped at the borders.
+    // @param[in] srcSize size of the source level along the axis.
+    // @param[in] destSize size of the destination level along the axis.
+    // @param[out] outTaps receives the taps.
+    static void ComputeLanczosTaps(uint32_t srcSize, uint32_t destSize, Yw3dFilterTaps& outTaps)
+    {
+        const float scale = (float)srcSize / (float)destSize;
+        const float support = (float)YW3D_MIP_LANCZOS_LOBES * scale;
+        outTaps.tapsPerPixel = (uint32_t)ceilf(2.0f * support) + 1;
+        outTaps.indices.resize(destSize * outTaps.tapsPerPixel);
+        outTaps.weights.resize(destSize * outTaps.tapsPerPixel);
+
+        for (uint32_t i = 0; i < destSize; i++)
+        {
+            const float center = ((float)i + 0.5f) * scale - 0.5f;
+            const int32_t first = (int32_t)ceilf(center - support);
+            uint32_t* indices = &outTaps.indices[i * outTaps.tapsPerPixel];
+            float* weights = &outTaps.weights[i * outTaps.tapsPerPixel];
+
+            float weightSum = 0.0f;
+            for (uint32_t t = 0; t < outTaps.tapsPerPixel; t++)
+            {
+                const int32_t index = first + (int32_t)t;
+                indices[t] = (uint32_t)Clamp(index, 0, (int32_t)srcSize - 1);
+                weights[t] = Lanczos(((float)index - center) / scale);
+                weightSum += weights[t];
+            }
+
+            for (uint32_t t = 0; t < outTaps.tapsPerPixel; t++)
+            {
+                weights[t] /= weightSum;
+            }
+        }
+    }
+
+    // Runs a function over the rows of all levels in parallel, the rows are split into bands.
+    // @param[in] workerPool the worker pool.
+    // @param[in] numLevels number of levels.
+    // @param[in] rowCounts number of rows of each level.
+    // @param[in] rowPixels number of pixels of a row of each level.
+    // @param[in] function called with the level index, the first (inclusive) and the last row (exclusive) of a band.
+    template <class RowsFunction>
+    static void ParallelForRows(Yw3dWorkerPool* workerPool, uint32_t numLevels, const uint32_t* rowCounts, const uint32_t* rowPixels, const RowsFunction& function)
+    {
+        std::vector<uint32_t> rowsPerBand(numLevels);
+        std::vector<uint32_t> firstBands(numLevels + 1, 0);
+        for (uint32_t l = 0; l < numLevels; l++)
+        {
+            rowsPerBand[l] = max(1u, YW3D_MIP_BAND_PIXELS / max(1u, rowPixels[l]));
+            firstBands[l + 1] = firstBands[l] + (rowCounts[l] + rowsPerBand[l] - 1) / rowsPerBand[l];
+        }
+
+        workerPool->ParallelFor(firstBands[numLevels], [&](uint32_t band)
+        {
+            uint32_t level = 0;
+            while (band >= firstBands[level + 1])
+            {
+                level++;
+            }
+
+            const uint32_t rowBegin = (band - firstBands[level]) * rowsPerBand[level];
+            function(level, rowBegin, min(rowBegin + rowsPerBand[level], rowCounts[level]));
+        });
+    }
+
+    // Downsamples a row with the 2x2 (2x2x2) box kernel, the source dimensions are even.
+    // @param[in] srcRows the 2 (4) source rows covered by the destination row.
+    // @param[in] numRows number of source rows.
+    // @param[out] destRow the destination row.
+    // @param[in] destWidth number of pixels of the destination row.
+    // @param[in] kernels the SIMD kernels of the device, pixels of 4 floats are downsampled by them.
+    template <uint32_t floats>
+    static void DownsampleBoxEvenRow(const float* const* srcRows, uint32_t numRows, float* destRow, uint32_t destWidth, const Yw3dSimdKernels* kernels)
+    {
+        if (4 == floats)
+        {
+            kernels->downsampleBoxEvenRow4(srcRows, numRows, destRow, destWidth);
+            return;
+        }
+
+        const float scale = 1.0f / (float)(2 * numRows);
+        uint32_t x = 0;
+
+    #ifdef YW3D_SSE2
+        // Sum the rows first, then add the horizontal neighbours.
+        const __m128 scaleSIMD = _mm_set1_ps(scale);
+        if (2 == floats)
+        {
+            // Two destination pixels from four source pixels of each row.
+            for (; x + 2 <= destWidth; x += 2)
+            {
+                __m128 left = _mm_setzero_ps();
+                __m128 right = _mm_setzero_ps();
+                for (uint32_t r = 0; r < numRows; r++)
+                {
+                    left = _mm_add_ps(left, _mm_loadu_ps(srcRows[r] + 4 * x));
+                    right = _mm_add_ps(right, _mm_loadu_ps(srcRows[r] + 4 * x + 4));
+                }
+
+                const __m128 sum = _mm_add_ps(_mm_shuffle_ps(left, right, _MM_SHUFFLE(1, 0, 1, 0)), _mm_shuffle_ps(left, right, _MM_SHUFFLE(3, 2, 3, 2)));
+                _mm_storeu_ps(destRow + 2 * x, _mm_mul_ps(sum, scaleSIMD));
+            }
+        }
+        else if (1 == floats)
+        {
+            // Four destination pixels from eight source pixels of each row.
+            for (; x + 4 <= destWidth; x += 4)
+            {
+                __m128 left = _mm_setzero_ps();
+                __m128 right = _mm_setzero_ps();
+                for (uint32_t r = 0; r < numRows; r++)
+                {
+                    left = _mm_add_ps(left, _mm_loadu_ps(srcRows[r] + 2 * x));
+                    right = _mm_add_ps(right, _mm_loadu_ps(srcRows[r] + 2 * x + 4));
+                }
+
+                const __m128 sum = _mm_add_ps(_mm_shuffle_ps(left, right, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(left, right, _MM_SHUFFLE(3, 1, 3, 1)));
+                _mm_storeu_ps(destRow + x, _mm_mul_ps(sum, scaleSIMD));
+            }
+        }
+    #endif
+
+        // Remaining pixels and formats of three floats.
+        for (; x < destWidth; x++)
+        {
+            for (uint32_t c = 0; c < floats; c++)
+            {
+                float sum = 0.0f;
+                for (uint32_t r = 0; r < numRows; r++)
+                {
+                    sum += srcRows[r][2 * x * floats + c] + srcRows[r][(2 * x + 1) * floats + c];
+                }
+
+                destRow[x * floats + c] = sum * scale;
+            }
+        }
+    }
+
+    // Downsamples a row with the polyphase box filter.
+    // @param[in] srcRows the weighted source rows covered by the destination row.
+    // @param[in] rowWeights the weights of the source rows.
+    // @param[in] numRows number of source rows.
+    // @param[in] tapsX taps along x-axis.
+    // @param[in] tapCountX number of used taps along x-axis.
+    // @param[out] destRow the destination row.
+    // @param[in] destWidth number of pixels of the destination row.
+    template <uint32_t floats>
+    static void DownsampleBoxRow(const float* const* srcRows, const float* rowWeights, uint32_t numRows, const Yw3dBoxTaps* tapsX, uint32_t tapCountX, float* destRow, uint32_t destWidth)
+    {
+        for (uint32_t x = 0; x < destWidth; x++, destRow += floats)
+        {
+            const Yw3dBoxTaps& taps = tapsX[x];
+            float color[floats] = {};
+            for (uint32_t r = 0; r < numRows; r++)
+            {
+                for (uint32_t t = 0; t < tapCountX; t++)
+                {
+                    const float weight = rowWeights[r] * taps.weights[t];
+                    const float* srcPixel = srcRows[r] + taps.indices[t] * floats;
+                    for (uint32_t c = 0; c < floats; c++)
+                    {
+                        color[c] += weight * srcPixel[c];
+                    }
+                }
+            }
+
+            for (uint32_t c = 0; c < floats; c++)
+            {
+                destRow[c] = color[c];
+            }
+        }
+    }
+
+    // Downsamples rows of a level with the box filter.
+    // @param[in] level the level.
+    // @param[in] taps the box filter taps of the level.
+    // @param[in] rowBegin first destination row (inclusive), rows of all slices are counted continuously.
+    // @param[in] rowEnd last destination row (exclusive).
+    // @param[in] kernels the SIMD kernels of the device.
+    template <uint32_t floats>
+    static void DownsampleBoxRows(const Yw3dMipLevelData& level, const Yw3dBoxLevelTaps& taps, uint32_t rowBegin, uint32_t rowEnd, const Yw3dSimdKernels* kernels)
+    {
+        const uint32_t srcRowFloats = level.srcWidth * floats;
+        const uint32_t srcSliceFloats = level.srcHeight * srcRowFloats;
+        for (uint32_t row = rowBegin; row < rowEnd; row++)
+        {
+            const uint32_t y = row % level.destHeight;
+            const uint32_t z = row / level.destHeight;
+            float* destRow = level.destData + row * level.destWidth * floats;
+
+            // Gather the source rows covered by the destination row with their weights.
+            const float* srcRows[9];
+            float rowWeights[9];
+            uint32_t numRows = 0;
+            for (uint32_t tz = 0; tz < taps.tapCountZ; tz++)
+            {
+                const Yw3dBoxTaps& tapsZ = taps.tapsZ[z];
+                for (uint32_t ty = 0; ty < taps.tapCountY; ty++, numRows++)
+                {
+                    const Yw3dBoxTaps& tapsY = taps.tapsY[y];
+                    srcRows[numRows] = level.srcData + tapsZ.indices[tz] * srcSliceFloats + tapsY.indices[ty] * srcRowFloats;
+                    rowWeights[numRows] = tapsZ.weights[tz] * tapsY.weights[ty];
+                }
+            }
+
+            if (taps.even)
+            {
+                DownsampleBoxEvenRow<floats>(srcRows, numRows, destRow, level.destWidth, kernels);
+            }
+            else
+            {
+                DownsampleBoxRow<floats>(srcRows, rowWeights, numRows, &taps.tapsX[0], taps.tapCountX, destRow, level.destWidth);
+            }
+        }
+    }
+
+    // Filters rows of a level along x-axis with a separable filter.
+    // @param[in] srcRow the first source row.
+    // @param[in] srcWidth number of pixels of a source row.
+    // @param[in] taps the filter taps along x-axis.
+    // @param[out] destRow the first filtered row.
+    // @param[in] destWidth number of pixels of a filtered row.
+    // @param[in] numRows number of rows to be filtered.
+    template <uint32_t floats>
+    static void FilterRowsX(const float* srcRow, uint32_t srcWidth, const Yw3dFilterTaps& taps, float* destRow, uint32_t destWidth, uint32_t numRows)
+    {
+        for (uint32_t row = 0; row < numRows; row++, srcRow += srcWidth * floats)
+        {
+            const uint32_t* indices = &taps.indices[0];
+            const float* weights = &taps.weights[0];
+            for (uint32_t x = 0; x < destWidth; x++, destRow += floats)
+            {
+                float color[floats] = {};
+                for (uint32_t t = 0; t < taps.tapsPerPixel; t++, indices++, weights++)
+                {
+                    const float* srcPixel = srcRow + (*indices) * floats;
+                    for (uint32_t c = 0; c < floats; c++)
+                    {
+                        color[c] += (*weights) * srcPixel[c];
+                    }
+                }
+
+                for (uint32_t c = 0; c < floats; c++)
+                {
+                    destRow[c] = color[c];
+                }
+            }
+        }
+    }
+
+    // Filters rows of a level along y-axis with a separable filter, whole rows are weighted and accumulated.
+    // @param[in] srcData the rows filtered along x-axis.
+    // @param[in] rowFloats number of floats of a row.
+    // @param[in] taps the filter taps along y-axis.
+    // @param[out] destData the destination level.
+    // @param[in] rowBegin first destination row (inclusive).
+    // @param[in] rowEnd last destination row (exclusive).
+    // @param[in] kernels the SIMD kernels of the device.
+    static void FilterRowsY(const float* srcData, uint32_t rowFloats, const Yw3dFilterTaps& taps, float* destData, uint32_t rowBegin, uint32_t rowEnd, const Yw3dSimdKernels* kernels)
+    {
+        for (uint32_t y = rowBegin; y < rowEnd; y++)
+        {
+            float* destRow = destData + y * rowFloats;
+            memset(destRow, 0, rowFloats * sizeof(float));
+            for (uint32_t t = 0; t < taps.tapsPerPixel; t++)
+            {
+                const float weight = taps.weights[y * taps.tapsPerPixel + t];
+                const float* srcRow = srcData + taps.indices[y * taps.tapsPerPixel + t] * rowFloats;
+                kernels->accumulateWeighted(destRow, srcRow, weight, rowFloats);
+            }
+        }
+    }
+
+    // Downsamples the levels with the box filter.
+    template <uint32_t floats>
+    static void GenerateMipLevelsBox(Yw3dWorkerPool* workerPool, const Yw3dSimdKernels* kernels, const Yw3dMipLevelData* levels, uint32_t numLevels)
+    {
+        std::vector<Yw3dBoxLevelTaps> levelTaps(numLevels);
+        std::vector<uint32_t> rowCounts(numLevels);
+        std::vector<uint32_t> rowPixels(numLevels);
+        for (uint32_t l = 0; l < numLevels; l++)
+        {
+            const Yw3dMipLevelData& level = levels[l];
+            Yw3dBoxLevelTaps& taps = levelTaps[l];
+            taps.tapCountX = ComputeBoxTaps(level.srcWidth, level.destWidth, taps.tapsX);
+            taps.tapCountY = ComputeBoxTaps(level.srcHeight, level.destHeight, taps.tapsY);
+            if (level.srcDepth > 1)
+            {
+                taps.tapCountZ = ComputeBoxTaps(level.srcDepth, level.destDepth, taps.tapsZ);
+            }
+            else
+            {
+                // A 2-dimensional level is a single slice.
+                Yw3dBoxTaps sliceTaps = {{0, 0, 0}, {1.0f, 0.0f, 0.0f}};
+                taps.tapsZ.assign(1, sliceTaps);
+                taps.tapCountZ = 1;
+            }
+
+            taps.even = (2 == taps.tapCountX) && (2 == taps.tapCountY) && (3 != taps.tapCountZ);
+            rowCounts[l] = level.destHeight * level.destDepth;
+            rowPixels[l] = level.destWidth;
+        }
+
+        ParallelForRows(workerPool, numLevels, &rowCounts[0], &rowPixels[0], [&](uint32_t level, uint32_t rowBegin, uint32_t rowEnd)
+        {
+            DownsampleBoxRows<floats>(levels[level], levelTaps[level], rowBegin, rowEnd, kernels);
+        });
+    }
+
+    // Downsamples 2-dimensional levels with the separable Lanczos filter, first along x-axis into a temporary buffer and then along y-axis.
+    template <uint32_t floats>
+    static void GenerateMipLevelsLanczos(Yw3dWorkerPool* workerPool, const Yw3dSimdKernels* kernels, const Yw3dMipLevelData* levels, uint32_t numLevels)
+    {
+        std::vector<Yw3dFilterTaps> tapsX(numLevels);
+        std::vector<Yw3dFilterTaps> tapsY(numLevels);
+        std::vector<std::vector<float>> filteredX(numLevels);
+        std::vector<uint32_t> rowCounts(numLevels);
+        std::vector<uint32_t> rowPixels(numLevels);
+        for (uint32_t l = 0; l < numLevels; l++)
+        {
+            const Yw3dMipLevelData& level = levels[l];
+            ComputeLanczosTaps(level.srcWidth, level.destWidth, tapsX[l]);
+            ComputeLanczosTaps(level.srcHeight, level.destHeight, tapsY[l]);
+            filteredX[l].resize(level.srcHeight * level.destWidth * floats);
+            rowCounts[l] = level.srcHeight;
+            rowPixels[l] = level.srcWidth;
+        }
+
+        // Filter all source rows along x-axis.
+        ParallelForRows(workerPool, numLevels, &rowCounts[0], &rowPixels[0], [&](uint32_t level, uint32_t rowBegin, uint32_t rowEnd)
+        {
+            const Yw3dMipLevelData& curLevel = levels[level];
+            FilterRowsX<floats>(curLevel.srcData + rowBegin * curLevel.srcWidth * floats, curLevel.srcWidth, tapsX[level], &filteredX[level][rowBegin * curLevel.destWidth * floats], curLevel.destWidth, rowEnd - rowBegin);
+        });
+
+        // Filter the rows along y-axis into the destination levels.
+        for (uint32_t l = 0; l < numLevels; l++)
+        {
+            rowCounts[l] = levels[l].destHeight;
+            rowPixels[l] = levels[l].destWidth;
+        }
+
+        ParallelForRows(workerPool, numLevels, &rowCounts[0], &rowPixels[0], [&](uint32_t level, uint32_t rowBegin, uint32_t rowEnd)
+        {
+            const Yw3dMipLevelData& curLevel = levels[level];
+            FilterRowsY(&filteredX[level][0], curLevel.destWidth * floats, tapsY[level], curLevel.destData, rowBegin, rowEnd, kernels);
+        });
+    }
+
+    template <uint32_t floats>
+    static void GenerateMipLevelsFiltered(Yw3dWorkerPool* workerPool, const Yw3dSimdKernels* kernels, const Yw3dMipLevelData* levels, uint32_t numLevels, Yw3dMipFilter filter)
+    {
+        if ((Yw3d_MF_Lanczos == filter) && (1 == levels[0].srcDepth))
+        {
+            GenerateMipLevelsLanczos<floats>(workerPool, kernels, levels, numLevels);
+        }
+        else
+        {
+            GenerateMipLevelsBox<floats>(workerPool, kernels, levels, numLevels);
+        }
+    }
+
+    void GenerateMipLevels(Yw3dWorkerPool* workerPool, const Yw3dSimdKernels* kernels, const Yw3dMipLevelData* levels, uint32_t numLevels, uint32_t floats, Yw3dMipFilter filter)
+    {
+        if ((nullptr == levels) || (0 == numLevels))
+        {
+            return;
+        }
+
+        switch (floats)
+        {
+        case 1:
+            GenerateMipLevelsFiltered<1>(workerPool, kernels, levels, numLevels, filter);
+            break;
+        case 2:
+            GenerateMipLevelsFiltered<2>(workerPool, kernels, levels, numLevels, filter);
+            break;
+        case 3:
+            GenerateMipLevelsFiltered<3>(workerPool, kernels, levels, numLevels, filter);
+            break;
+        case 4:
+            GenerateMipLevelsFiltered<4>(workerPool, kernels, levels, numLevels, filter);
+            break;
+        default:
+            // This can not happen.
+            break;
+        }
+    }
+}
@@ -0,0 +1,44 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d mip-level generation helpers.
+
+#ifndef __YW_3D_MIPMAP_H__
+#define __YW_3D_MIPMAP_H__
+
+#include "Yw3dBase.h"
+#include "Yw3dTypes.h"
+
+namespace yw
+{
+    // Source and destination of one downsampling step of a mip-chain. The data of both levels is linear and made of floats.
+    struct Yw3dMipLevelData
+    {
+        // Pixels of the source level.
+        const float* srcData;
+
+        // Dimensions of the source level, the depth is 1 for 2-dimensional levels.
+        uint32_t srcWidth;
+        uint32_t srcHeight;
+        uint32_t srcDepth;
+
+        // Pixels of the destination level.
+        float* destData;
+
+        // Dimensions of the destination level, each is half of the source dimension rounded down but at least 1.
+        uint32_t destWidth;
+        uint32_t destHeight;
+        uint32_t destDepth;
+    };
+
+    // Downsamples a set of levels of the same format in parallel, e.g. the current level of all six faces of a cube texture.
+    // Rows of all levels are processed concurrently by the worker pool. Levels with even dimensions use a SIMD 2x2 (2x2x2) box kernel,
+    // NPOT levels use the polyphase box filter from <<Non-Power-of-Two Mipmap Creation>>.
+    // @param[in] workerPool the worker pool of the device.
+    // @param[in] kernels the SIMD kernels of the device.
+    // @param[in] levels the levels to be downsampled.
+    // @param[in] numLevels number of levels.
+    // @param[in] floats number of floats of a pixel, e [1,4].
+    // @param[in] filter member of the enumeration Yw3dMipFilter. Levels with a depth greater than 1 always use the box filter.
+    void GenerateMipLevels(class Yw3dWorkerPool* workerPool, const struct Yw3dSimdKernels* kernels, const Yw3dMipLevelData* levels, uint32_t numLevels, uint32_t floats, Yw3dMipFilter filter);
+}
+
+#endif // !__YW_3D_MIPMAP_H__
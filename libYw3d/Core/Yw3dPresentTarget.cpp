@@ -2,13 +2,128 @@
 // YW Soft Renderer present target class.
 
 #include "Yw3dPresentTarget.h"
+#include "Yw3dCpu.h"
 #include "Yw3dDevice.h"
+#include "Yw3dWorkerPool.h"
+#include "YwMath.h"
+#include <math.h>
 
 namespace yw
 {
     // ------------------------------------------------------------------
     // Present target base.
 
+    // Number of entries of the sRGB encoding table, linear values are quantized to 12 bits.
+    #define YW3D_SRGB_ENCODE_TABLE_SIZE 4096
+
+    // Table from quantized linear values to 8-bit sRGB values.
+    struct Yw3dSRGBEncodeTable
+    {
+        uint8_t values[YW3D_SRGB_ENCODE_TABLE_SIZE];
+
+        Yw3dSRGBEncodeTable()
+        {
+            for (uint32_t i = 0; i < YW3D_SRGB_ENCODE_TABLE_SIZE; i++)
+            {
+                const float linear = (float)i / (float)(YW3D_SRGB_ENCODE_TABLE_SIZE - 1);
+                const float srgb = EncodeSRGB(linear);
+                values[i] = (uint8_t)(srgb * 255.0f + 0.5f);
+            }
+        }
+    };
+
+    // Returns the shared sRGB encoding table, built on first use.
+    static const uint8_t* GetSRGBEncodeTable()
+    {
+        static const Yw3dSRGBEncodeTable table;
+        return table.values;
+    }
+
+    // Converts a channel value to 8 bits.
+    // @param[in] value linear channel value.
+    // @param[in] srgbTable sRGB encoding table, nullptr for no encoding.
+    static inline uint8_t ConvertChannel(float value, const uint8_t* srgbTable)
+    {
+        value = Clamp(value, 0.0f, 1.0f);
+        if (nullptr != srgbTable)
+        {
+            return srgbTable[(uint32_t)(value * (float)(YW3D_SRGB_ENCODE_TABLE_SIZE - 1) + 0.5f)];
+        }
+
+        return (uint8_t)(value * 255.0f + 0.5f);
+    }
+
+    // Converts a span of colorbuffer pixels to backbuffer pixels.
+    // @param[out] destination the first backbuffer pixel.
+    // @param[in] source the first colorbuffer pixel.
+    // @param[in] sourceStride floats between two source pixels, 0 to convert a single color.
+    // @param[in] count number of pixels.
+    // @param[in] destFormat pixel layout of the backbuffer.
+    // @param[in] srgbTable sRGB encoding table, nullptr for no encoding.
+    // @param[in] kernels the SIMD kernels of the device.
+    static void ConvertSpan(uint8_t* destination, const float* source, uint32_t sourceStride, uint32_t count, const Yw3dBackBufferFormat& destFormat, const uint8_t* srgbTable, const Yw3dSimdKernels* kernels)
+    {
+        // The common 32-bit backbuffer without encoding is converted by the kernel of the best SIMD level.
+        if ((4 == destFormat.bytes) && (nullptr == srgbTable))
+        {
+            kernels->convertToBGRX(destination, source, sourceStride, count);
+            return;
+        }
+
+        uint32_t x = 0;
+
+    #ifdef YW3D_SSE2
+        if (4 == destFormat.bytes)
+        {
+            // Table indices are computed 4 channels at once, the lookups stay scalar.
+            // Four floats are loaded per pixel, a 3 float pixel reads the first float of the next pixel, so leave the last one to the scalar loop.
+            const uint32_t vectorCount = (3 == sourceStride) ? count - 1 : count;
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 one = _mm_set1_ps(1.0f);
+            const __m128 scale = _mm_set1_ps((float)(YW3D_SRGB_ENCODE_TABLE_SIZE - 1));
+            for (; x < vectorCount; x++, source += sourceStride, destination += 4)
+            {
+                const __m128 color = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(source), zero), one);
+                int32_t indices[4];
+                _mm_storeu_si128((__m128i*)indices, _mm_cvtps_epi32(_mm_mul_ps(color, scale)));
+
+                destination[0] = srgbTable[indices[2]];
+                destination[1] = srgbTable[indices[1]];
+                destination[2] = srgbTable[indices[0]];
+                destination[3] = 0;
+            }
+        }
+    #endif
+
+        for (; x < count; x++, source += sourceStride, destination += destFormat.bytes)
+        {
+            if (2 == destFormat.bytes)
+            {
+                // 16-bit.
+                uint32_t pixel = 0;
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    const uint32_t maxValue = destFormat.maxValues[c];
+                    const uint32_t value = (nullptr != srgbTable) ? ((uint32_t)ConvertChannel(source[c], srgbTable) * maxValue + 127) / 255 : (uint32_t)(Clamp(source[c], 0.0f, 1.0f) * (float)maxValue + 0.5f);
+                    pixel |= value << destFormat.shifts[c];
+                }
+
+                *((uint16_t*)destination) = (uint16_t)pixel;
+            }
+            else
+            {
+                // 24-bit or 32-bit.
+                destination[0] = ConvertChannel(source[2], srgbTable); // b
+                destination[1] = ConvertChannel(source[1], srgbTable); // g
+                destination[2] = ConvertChannel(source[0], srgbTable); // r
+                if (4 == destFormat.bytes)
+                {
+                    destination[3] = 0;
+                }
+            }
+        }
+    }
+
     IYw3dPresentTarget::IYw3dPresentTarget(Yw3dDevice* device) :
         m_Device(device)
     {
@@ -31,6 +146,49 @@ namespace yw
 
         return m_Device;
     }
+
+    void IYw3dPresentTarget::ConvertToBackBuffer(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor, uint8_t* destination, int32_t destPitch, const Yw3dBackBufferFormat& destFormat)
+    {
+        const Yw3dDeviceParameters& deviceParameters = m_Device->GetDeviceParameters();
+        const uint32_t width = deviceParameters.backBufferWidth;
+        const uint32_t height = deviceParameters.backBufferHeight;
+        const uint8_t* srgbTable = deviceParameters.presentSRGB ? GetSRGBEncodeTable() : nullptr;
+        const Yw3dSimdKernels* kernels = m_Device->GetSimdKernels();
+
+        // Bands are as high as fast clear tiles, so a band only touches a single row of tiles.
+        const uint32_t tilesPerRow = (width + YW3D_FAST_CLEAR_TILE_SIZE - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT;
+        const uint32_t numBands = (height + YW3D_FAST_CLEAR_TILE_SIZE - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT;
+        m_Device->GetWorkerPool()->ParallelFor(numBands, [&](uint32_t band)
+        {
+            const uint8_t* tileRow = (nullptr != fastClearTiles) ? fastClearTiles + band * tilesPerRow : nullptr;
+            const uint32_t bandBottom = min((band + 1) << YW3D_FAST_CLEAR_TILE_SHIFT, height);
+            for (uint32_t y = band << YW3D_FAST_CLEAR_TILE_SHIFT; y < bandBottom; y++)
+            {
+                uint8_t* destRow = destination + (int32_t)y * destPitch;
+                const float* sourceRow = source + y * width * floats;
+                if (nullptr == tileRow)
+                {
+                    ConvertSpan(destRow, sourceRow, floats, width, destFormat, srgbTable, kernels);
+                    continue;
+                }
+
+                // Untouched fast cleared tiles are converted from the clear color.
+                for (uint32_t tileX = 0; tileX < tilesPerRow; tileX++)
+                {
+                    const uint32_t x = tileX << YW3D_FAST_CLEAR_TILE_SHIFT;
+                    const uint32_t count = min((uint32_t)YW3D_FAST_CLEAR_TILE_SIZE, width - x);
+                    if (0 != tileRow[tileX])
+                    {
+                        ConvertSpan(destRow + x * destFormat.bytes, fastClearColor, 0, count, destFormat, srgbTable, kernels);
+                    }
+                    else
+                    {
+                        ConvertSpan(destRow + x * destFormat.bytes, sourceRow + x * floats, floats, count, destFormat, srgbTable, kernels);
+                    }
+                }
+            }
+        });
+    }
 }
 
 // ------------------------------------------------------------------
@@ -248,7 +406,7 @@ namespace yw
         return Yw3d_S_OK;
     }
 
-    Yw3dResult Yw3dPresentTargetWindows::Present(const float* source, uint32_t floats)
+    Yw3dResult Yw3dPresentTargetWindows::Present(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor)
     {
         // Get device parameters.
         Yw3dDeviceParameters deviceParameters = m_Device->GetDeviceParameters();
@@ -274,62 +432,17 @@ namespace yw
             return Yw3d_E_Unknown;
         }
 
-        // Get surface byte count.
-        const uint32_t destBytes = descSurface.ddpfPixelFormat.dwRGBBitCount / 8;
-
-        // Copy pixels to the BackBuffer-surface.
-        const uint32_t destRowJump = descSurface.lPitch - deviceParameters.backBufferWidth * destBytes;
-        uint8_t* destination = (uint8_t*)descSurface.lpSurface;
-
-        fpuTruncate();
-
-        if (2 == destBytes)
+        // Describe the backbuffer pixels.
+        Yw3dBackBufferFormat destFormat;
+        destFormat.bytes = descSurface.ddpfPixelFormat.dwRGBBitCount / 8;
+        for (uint32_t c = 0; c < 3; c++)
         {
-            // 16-bit.
-            uint32_t height = deviceParameters.backBufferHeight;
-            while (height--)
-            {
-                uint32_t width = deviceParameters.backBufferWidth;
-                while (width--)
-                {
-                    const int32_t r = Clamp(ftol(source[0] * (float)m_16bitMaxVal[0]), 0, m_16bitMaxVal[0]);
-                    const int32_t g = Clamp(ftol(source[1] * (float)m_16bitMaxVal[1]), 0, m_16bitMaxVal[1]);
-                    const int32_t b = Clamp(ftol(source[2] * (float)m_16bitMaxVal[2]), 0, m_16bitMaxVal[2]);
-                    source += floats;
-
-                    *((uint16_t*)destination) = (r << m_16bitShift[0]) | (g << m_16bitShift[1]) | (b << m_16bitShift[2]);
-                    destination += destBytes;
-                }
-
-                destination += destRowJump;
-            }
+            destFormat.maxValues[c] = m_16bitMaxVal[c];
+            destFormat.shifts[c] = m_16bitShift[c];
         }
-        else
-        {
-            // 24-bit or 32-bit.
-            uint32_t height = deviceParameters.backBufferHeight;
-            while (height--)
-            {
-                uint32_t width = deviceParameters.backBufferWidth;
-                while (width--)
-                {
-                    // descSurface.ddpfPixelFormat.dwRBitMask: 0x00ff0000.
-                    // descSurface.ddpfPixelFormat.dwGBitMask: 0x0000ff00.
-                    // descSurface.ddpfPixelFormat.dwBBitMask: 0x000000ff.
-                    // descSurface.ddpfPixelFormat.dwRGBAlphaBitMask: 0x00000000.
-                    destination[0] = Clamp(ftol(source[2] * 255.0f), 0, 255); // b
-                    destination[1] = Clamp(ftol(source[1] * 255.0f), 0, 255); // g
-                    destination[2] = Clamp(ftol(source[0] * 255.0f), 0, 255); // r
-
-                    source += floats;
-                    destination += destBytes;
-                }
 
-                destination += destRowJump;
-            }
-        }
-
-        fpuReset();
+        // Copy pixels to the BackBuffer-surface.
+        ConvertToBackBuffer(source, floats, fastClearTiles, fastClearColor, (uint8_t*)descSurface.lpSurface, descSurface.lPitch, destFormat);
 
         // Unlock BackBuffer-surface and surface.
         m_DirectDrawSurfaces[1]->Unlock(nullptr);
@@ -422,7 +535,7 @@ namespace yw
         return Yw3d_E_Unknown;
     }
 
-    Yw3dResult Yw3dPresentTargetLinux::Present(const float* source, uint32_t floats)
+    Yw3dResult Yw3dPresentTargetLinux::Present(const float* source, uint32_t floats, const uint8_t* /*fastClearTiles*/, const float* /*fastClearColor*/)
     {
         return Yw3d_E_Unknown;
     }
@@ -450,7 +563,7 @@ namespace yw
         return Yw3d_E_Unknown;
     }
 
-    Yw3dResult Yw3dPresentTargetMacOSX::Present(const float* source, uint32_t floats)
+    Yw3dResult Yw3dPresentTargetMacOSX::Present(const float* source, uint32_t floats, const uint8_t* /*fastClearTiles*/, const float* /*fastClearColor*/)
     {
         return Yw3d_E_Unknown;
     }
@@ -478,7 +591,7 @@ namespace yw
         return Yw3d_E_Unknown;
     }
 
-    Yw3dResult Yw3dPresentTargetAmigaOS4::Present(const float* source, uint32_t floats)
+    Yw3dResult Yw3dPresentTargetAmigaOS4::Present(const float* source, uint32_t floats, const uint8_t* /*fastClearTiles*/, const float* /*fastClearColor*/)
     {
         return Yw3d_E_Unknown;
     }
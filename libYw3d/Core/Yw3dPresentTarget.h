@@ -12,6 +12,19 @@ namespace yw
     // ------------------------------------------------------------------
     // Present target base.
 
+    // Describes the pixel layout of a backbuffer.
+    struct Yw3dBackBufferFormat
+    {
+        // Bytes of a pixel: 2, 3 or 4. 3 and 4 byte pixels are stored as blue, green, red (, unused).
+        uint32_t bytes;
+
+        // 2 byte pixels only: maximum values of the red, green and blue channel, e.g. (31, 63, 31) for 565 mode.
+        uint16_t maxValues[3];
+
+        // 2 byte pixels only: shifts of the red, green and blue channel.
+        uint16_t shifts[3];
+    };
+
     // The base class of the present target.
     class IYw3dPresentTarget : public IBase
     {
@@ -33,17 +46,31 @@ namespace yw
         // Presents the contents of a given rendertarget's colorbuffer.
         // @param[in] source pointer to the data of the colorbuffer to be presented (backbuffer dimensions).
         // @param[in] floats format of the data (number of float32s).
+        // @param[in] fastClearTiles pending state of each fast clear tile of the colorbuffer, nullptr if no tile is pending. The data of pending tiles is stale.
+        // @param[in] fastClearColor color of pending fast cleared tiles, same format as the source data.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
         // @return Yw3d_E_InvalidState if an invalid state was encountered.
         // @return Yw3d_E_Unknown if a present-target related problem was encountered.
-        virtual Yw3dResult Present(const float* source, uint32_t floats) = 0;
+        virtual Yw3dResult Present(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor) = 0;
 
         // Returns a pointer to the associated device. Calling this function will increase the internal reference count of the device. 
         // Failure to call Release() when finished using the pointer will result in a memory leak.
         class Yw3dDevice* AcquireDevice();
 
+    protected:
+        // Converts the colorbuffer to backbuffer pixels, encoding to sRGB if enabled in the device parameters. Shared by all present targets.
+        // Bands of rows are converted in parallel on the worker pool of the device, 4 byte pixels use a SSE2 kernel if available.
+        // @param[in] source pointer to the data of the colorbuffer to be presented (backbuffer dimensions).
+        // @param[in] floats format of the data (number of float32s), 3 or 4.
+        // @param[in] fastClearTiles pending state of each fast clear tile of the colorbuffer, nullptr if no tile is pending.
+        // @param[in] fastClearColor color of pending fast cleared tiles.
+        // @param[out] destination pointer to the first backbuffer row.
+        // @param[in] destPitch distance between two backbuffer rows in bytes.
+        // @param[in] destFormat pixel layout of the backbuffer.
+        void ConvertToBackBuffer(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor, uint8_t* destination, int32_t destPitch, const Yw3dBackBufferFormat& destFormat);
+
     protected:
         // Pointer to device.
         class Yw3dDevice* m_Device;
@@ -87,12 +114,14 @@ namespace yw
         // Presents the contents of a given rendertarget's colorbuffer.
         // @param[in] source pointer to the data of the colorbuffer to be presented (backbuffer dimensions).
         // @param[in] floats format of the data (number of float32s).
+        // @param[in] fastClearTiles pending state of each fast clear tile of the colorbuffer, nullptr if no tile is pending. The data of pending tiles is stale.
+        // @param[in] fastClearColor color of pending fast cleared tiles, same format as the source data.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
         // @return Yw3d_E_InvalidState if an invalid state was encountered.
         // @return Yw3d_E_Unknown if a present-target related problem was encountered.
-        Yw3dResult Present(const float* source, uint32_t floats);
+        Yw3dResult Present(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor);
 
     private:
         // Returns low-bit and number of bits for a given color-channel mask.
@@ -153,12 +182,14 @@ namespace yw
         // Presents the contents of a given rendertarget's colorbuffer.
         // @param[in] source pointer to the data of the colorbuffer to be presented (backbuffer dimensions).
         // @param[in] floats format of the data (number of float32s).
+        // @param[in] fastClearTiles pending state of each fast clear tile of the colorbuffer, nullptr if no tile is pending. The data of pending tiles is stale.
+        // @param[in] fastClearColor color of pending fast cleared tiles, same format as the source data.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
         // @return Yw3d_E_InvalidState if an invalid state was encountered.
         // @return Yw3d_E_Unknown if a present-target related problem was encountered.
-        Yw3dResult Present(const float* source, uint32_t floats);
+        Yw3dResult Present(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor);
     };
 }
 
@@ -193,12 +224,14 @@ namespace yw
         // Presents the contents of a given rendertarget's colorbuffer.
         // @param[in] source pointer to the data of the colorbuffer to be presented (backbuffer dimensions).
         // @param[in] floats format of the data (number of float32s).
+        // @param[in] fastClearTiles pending state of each fast clear tile of the colorbuffer, nullptr if no tile is pending. The data of pending tiles is stale.
+        // @param[in] fastClearColor color of pending fast cleared tiles, same format as the source data.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
         // @return Yw3d_E_InvalidState if an invalid state was encountered.
         // @return Yw3d_E_Unknown if a present-target related problem was encountered.
-        Yw3dResult Present(const float* source, uint32_t floats);
+        Yw3dResult Present(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor);
     };
 }
 
@@ -233,12 +266,14 @@ namespace yw
         // Presents the contents of a given rendertarget's colorbuffer.
         // @param[in] source pointer to the data of the colorbuffer to be presented (backbuffer dimensions).
         // @param[in] floats format of the data (number of float32s).
+        // @param[in] fastClearTiles pending state of each fast clear tile of the colorbuffer, nullptr if no tile is pending. The data of pending tiles is stale.
+        // @param[in] fastClearColor color of pending fast cleared tiles, same format as the source data.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
         // @return Yw3d_E_InvalidState if an invalid state was encountered.
         // @return Yw3d_E_Unknown if a present-target related problem was encountered.
-        Yw3dResult Present(const float* source, uint32_t floats);
+        Yw3dResult Present(const float* source, uint32_t floats, const uint8_t* fastClearTiles, const float* fastClearColor);
     };
 }
 
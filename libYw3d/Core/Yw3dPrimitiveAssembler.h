@@ -6,6 +6,7 @@
 
 #include "Yw3dBase.h"
 #include "Yw3dTypes.h"
+#include "Yw3dAllocator.h"
 
 namespace yw
 {
@@ -17,10 +18,10 @@ namespace yw
     protected:
         // Accessible by Yw3dDevice.
         // This is the core function of a primitive assembler: It is used for DrawDynamicPrimitive() and executed after all vertices have been transformed. A primitive assembler returns indices to form primitives, which are in turn processed and rendered.
-        // @param[out] vertexIndices output vector which receives three indices.
+        // @param[out] vertexIndices output vector which receives three indices, allocated from the frame arena of the device.
         // @param[in] numVertices number of vertices.
         // @return type of assembled primitives: member of the enumeration Yw3dPrimitiveType.
-        virtual Yw3dPrimitiveType Execute(std::vector<uint32_t>& vertexIndices, uint32_t numVertices) = 0;
+        virtual Yw3dPrimitiveType Execute(Yw3dIndexList& vertexIndices, uint32_t numVertices) = 0;
     };
 }
 
@@ -9,16 +9,20 @@ namespace yw
 {
     Yw3dRenderTarget::Yw3dRenderTarget(Yw3dDevice* device) :
         m_Device(device),
-        m_ColorBuffer(nullptr),
         m_DepthBuffer(nullptr),
         m_StencilBuffer(nullptr)
     {
         m_Device->AddRef();
+        memset(m_ColorBuffers, 0, sizeof(m_ColorBuffers));
     }
 
     Yw3dRenderTarget::~Yw3dRenderTarget()
     {
-        YW_SAFE_RELEASE(m_ColorBuffer);
+        for (uint32_t bufferIdx = 0; bufferIdx < YW3D_MAX_COLOR_BUFFERS; bufferIdx++)
+        {
+            YW_SAFE_RELEASE(m_ColorBuffers[bufferIdx]);
+        }
+
         YW_SAFE_RELEASE(m_DepthBuffer);
         YW_SAFE_RELEASE(m_Device);
         YW_SAFE_RELEASE(m_StencilBuffer);
@@ -36,13 +40,42 @@ namespace yw
 
     Yw3dResult Yw3dRenderTarget::ClearColorBuffer(const Vector4& color, const Yw3dRect* rect)
     {
-        if (nullptr == m_ColorBuffer)
+        Yw3dResult result = Yw3d_S_OK;
+        bool hasColorBuffer = false;
+        for (uint32_t bufferIdx = 0; bufferIdx < YW3D_MAX_COLOR_BUFFERS; bufferIdx++)
+        {
+            if (nullptr != m_ColorBuffers[bufferIdx])
+            {
+                Yw3dResult resultClear = m_ColorBuffers[bufferIdx]->Clear(color, rect);
+                result = YW3D_FAILED(result) ? result : resultClear;
+                hasColorBuffer = true;
+            }
+        }
+
+        if (!hasColorBuffer)
         {
             LOGE(_T("Yw3dRenderTarget::ClearColorBuffer: no framebuffer has been set.\n"));
             return Yw3d_E_InvalidFormat;
         }
 
-        return m_ColorBuffer->Clear(color, rect);
+        return result;
+    }
+
+    Yw3dResult Yw3dRenderTarget::ClearColorBuffer(uint32_t index, const Vector4& color, const Yw3dRect* rect)
+    {
+        if (index >= YW3D_MAX_COLOR_BUFFERS)
+        {
+            LOGE(_T("Yw3dRenderTarget::ClearColorBuffer: invalid colorbuffer index.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (nullptr == m_ColorBuffers[index])
+        {
+            LOGE(_T("Yw3dRenderTarget::ClearColorBuffer: no framebuffer has been set.\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
+        return m_ColorBuffers[index]->Clear(color, rect);
     }
 
     Yw3dResult Yw3dRenderTarget::ClearDepthBuffer(const float depth, const Yw3dRect* rect)
@@ -53,7 +86,7 @@ namespace yw
             return Yw3d_E_InvalidFormat;
         }
 
-        return m_DepthBuffer->Clear(Vector4(depth, 0.0f, 0.0f, 0.0f), rect);
+        return m_DepthBuffer->ClearDepthStencil(depth, 0, true, false, rect);
     }
 
     Yw3dResult Yw3dRenderTarget::ClearStencilBuffer(const uint32_t stencil, const Yw3dRect* rect)
@@ -64,14 +97,36 @@ namespace yw
             return Yw3d_E_InvalidFormat;
         }
 
-        float value = 0.0f;
-        uint32_t* uintValue = (uint32_t*)(&value);
-        *uintValue = stencil;
-        return m_StencilBuffer->Clear(Vector4(value, 0.0f, 0.0f, 0.0f), rect);
+        return m_StencilBuffer->ClearDepthStencil(0.0f, stencil, false, true, rect);
+    }
+
+    Yw3dResult Yw3dRenderTarget::ClearDepthStencilBuffer(const float depth, const uint32_t stencil, const Yw3dRect* rect)
+    {
+        // A packed depth-stencil surface is cleared in a single pass.
+        if ((nullptr != m_DepthBuffer) && (m_DepthBuffer == m_StencilBuffer))
+        {
+            return m_DepthBuffer->ClearDepthStencil(depth, stencil, true, true, rect);
+        }
+
+        Yw3dResult resultDepth = ClearDepthBuffer(depth, rect);
+        Yw3dResult resultStencil = ClearStencilBuffer(stencil, rect);
+
+        return YW3D_FAILED(resultDepth) ? resultDepth : resultStencil;
     }
 
     Yw3dResult Yw3dRenderTarget::SetColorBuffer(Yw3dSurface* colorBuffer)
     {
+        return SetColorBuffer(0, colorBuffer);
+    }
+
+    Yw3dResult Yw3dRenderTarget::SetColorBuffer(uint32_t index, Yw3dSurface* colorBuffer)
+    {
+        if (index >= YW3D_MAX_COLOR_BUFFERS)
+        {
+            LOGE(_T("Yw3dRenderTarget::SetColorBuffer: invalid colorbuffer index.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
         if (nullptr != colorBuffer)
         {
             if ((colorBuffer->GetFormat() < Yw3d_FMT_R32F) || (colorBuffer->GetFormat() > Yw3d_FMT_R32G32B32A32F))
@@ -88,14 +143,20 @@ namespace yw
                     return Yw3d_E_InvalidFormat;
                 }
             }
+
+            if (!MatchDimensions(colorBuffer, index))
+            {
+                LOGE(_T("Yw3dRenderTarget::SetColorBuffer: dimensions of the framebuffer attachments are not equal.\n"));
+                return Yw3d_E_InvalidFormat;
+            }
         }
 
         // Release old buffer and assign new buffer.
-        YW_SAFE_RELEASE(m_ColorBuffer);
-        m_ColorBuffer = colorBuffer;
-        if (nullptr != m_ColorBuffer)
+        YW_SAFE_RELEASE(m_ColorBuffers[index]);
+        m_ColorBuffers[index] = colorBuffer;
+        if (nullptr != colorBuffer)
         {
-            m_ColorBuffer->AddRef();
+            colorBuffer->AddRef();
         }
 
         return Yw3d_S_OK;
@@ -105,19 +166,17 @@ namespace yw
     {
         if (nullptr != depthBuffer)
         {
-            if (Yw3d_FMT_R32F != depthBuffer->GetFormat())
+            const Yw3dFormat depthFormat = depthBuffer->GetFormat();
+            if ((Yw3d_FMT_R32F != depthFormat) && (Yw3d_FMT_D24S8 != depthFormat) && (Yw3d_FMT_D16 != depthFormat))
             {
                 LOGE(_T("Yw3dRenderTarget::SetDepthBuffer: invalid depthbuffer format.\n"));
                 return Yw3d_E_InvalidFormat;
             }
 
-            if (nullptr != m_ColorBuffer)
+            if (!MatchDimensions(depthBuffer, YW3D_MAX_COLOR_BUFFERS))
             {
-                if ((m_ColorBuffer->GetWidth() != depthBuffer->GetWidth()) || (m_ColorBuffer->GetHeight() != depthBuffer->GetHeight()))
-                {
-                    LOGE(_T("Yw3dRenderTarget::SetDepthBuffer: depthbuffer and framebuffer dimensions are not equal.\n"));
-                    return Yw3d_E_InvalidFormat;
-                }
+                LOGE(_T("Yw3dRenderTarget::SetDepthBuffer: depthbuffer and framebuffer dimensions are not equal.\n"));
+                return Yw3d_E_InvalidFormat;
             }
         }
 
@@ -136,19 +195,17 @@ namespace yw
     {
         if (nullptr != stencilBuffer)
         {
-            if (Yw3d_FMT_R32F != stencilBuffer->GetFormat())
+            const Yw3dFormat stencilFormat = stencilBuffer->GetFormat();
+            if ((Yw3d_FMT_R32F != stencilFormat) && (Yw3d_FMT_D24S8 != stencilFormat))
             {
                 LOGE(_T("Yw3dRenderTarget::SetStencilBuffer: invalid stencilbuffer format.\n"));
                 return Yw3d_E_InvalidFormat;
             }
 
-            if (nullptr != m_ColorBuffer)
+            if (!MatchDimensions(stencilBuffer, YW3D_MAX_COLOR_BUFFERS))
             {
-                if ((m_ColorBuffer->GetWidth() != stencilBuffer->GetWidth()) || (m_ColorBuffer->GetHeight() != stencilBuffer->GetHeight()))
-                {
-                    LOGE(_T("Yw3dRenderTarget::SetStencilBuffer: stencilbuffer and framebuffer dimensions are not equal.\n"));
-                    return Yw3d_E_InvalidFormat;
-                }
+                LOGE(_T("Yw3dRenderTarget::SetStencilBuffer: stencilbuffer and framebuffer dimensions are not equal.\n"));
+                return Yw3d_E_InvalidFormat;
             }
         }
 
@@ -165,12 +222,33 @@ namespace yw
 
     Yw3dSurface* Yw3dRenderTarget::AcquireColorBuffer()
     {
-        if (nullptr != m_ColorBuffer)
+        return AcquireColorBuffer(0);
+    }
+
+    Yw3dSurface* Yw3dRenderTarget::AcquireColorBuffer(uint32_t index)
+    {
+        if (index >= YW3D_MAX_COLOR_BUFFERS)
+        {
+            return nullptr;
+        }
+
+        if (nullptr != m_ColorBuffers[index])
+        {
+            m_ColorBuffers[index]->AddRef();
+        }
+
+        return m_ColorBuffers[index];
+    }
+
+    uint32_t Yw3dRenderTarget::GetNumColorBuffers() const
+    {
+        uint32_t numColorBuffers = YW3D_MAX_COLOR_BUFFERS;
+        while ((numColorBuffers > 0) && (nullptr == m_ColorBuffers[numColorBuffers - 1]))
         {
-            m_ColorBuffer->AddRef();
+            numColorBuffers--;
         }
 
-        return m_ColorBuffer;
+        return numColorBuffers;
     }
 
     Yw3dSurface* Yw3dRenderTarget::AcquireDepthBuffer()
@@ -203,4 +281,23 @@ namespace yw
 
         return viewportMatrix;
     }
+
+    bool Yw3dRenderTarget::MatchDimensions(const Yw3dSurface* surface, uint32_t ignoredColorBuffer) const
+    {
+        for (uint32_t bufferIdx = 0; bufferIdx < YW3D_MAX_COLOR_BUFFERS; bufferIdx++)
+        {
+            const Yw3dSurface* colorBuffer = m_ColorBuffers[bufferIdx];
+            if ((bufferIdx == ignoredColorBuffer) || (nullptr == colorBuffer))
+            {
+                continue;
+            }
+
+            if ((colorBuffer->GetWidth() != surface->GetWidth()) || (colorBuffer->GetHeight() != surface->GetHeight()))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
 }
@@ -27,14 +27,23 @@ namespace yw
         // Failure to call Release() when finished using the pointer will result in a memory leak.
         class Yw3dDevice* AcquireDevice();
 
-        // Clears the colorbuffer, which is associated with this rendertarget, to a given color.
-        // @param[in] color color to clear the colorbuffer to.
+        // Clears all colorbuffers, which are associated with this rendertarget, to a given color.
+        // @param[in] color color to clear the colorbuffers to.
         // @param[in] rect rectangle to restrict clearing to.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidState if no colorbuffer has been set.
         // @return Yw3d_E_InvalidParameters if the clear-rectangle exceeds the colorbuffer's dimensions.
         Yw3dResult ClearColorBuffer(const Vector4& color, const Yw3dRect* rect);
 
+        // Clears a single colorbuffer attachment to a given color, e.g. to clear the attachments of a G-buffer to different values.
+        // @param[in] index index of the attachment, must be less than YW3D_MAX_COLOR_BUFFERS.
+        // @param[in] color color to clear the colorbuffer to.
+        // @param[in] rect rectangle to restrict clearing to.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidState if no colorbuffer has been set to this attachment.
+        // @return Yw3d_E_InvalidParameters if the index is invalid or the clear-rectangle exceeds the colorbuffer's dimensions.
+        Yw3dResult ClearColorBuffer(uint32_t index, const Vector4& color, const Yw3dRect* rect);
+
         // Clears the depthbuffer, which is associated with this rendertarget, to a given depth-value.
         // @param[in] depth depth to clear the depthbuffer to.
         // @param[in] rect rectangle to restrict clearing to.
@@ -51,6 +60,15 @@ namespace yw
         // @return Yw3d_E_InvalidParameters if the clear-rectangle exceeds the stencilbuffer's dimensions.
         Yw3dResult ClearStencilBuffer(const uint32_t stencil, const Yw3dRect* rect);
 
+        // Clears the depthbuffer and the stencilbuffer, a shared Yw3d_FMT_D24S8 buffer is cleared in one pass.
+        // @param[in] depth depth to clear the depthbuffer to.
+        // @param[in] stencil stencil to clear the stencilbuffer to.
+        // @param[in] rect rectangle to restrict clearing to.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidState if no depthbuffer or stencilbuffer has been set.
+        // @return Yw3d_E_InvalidParameters if the clear-rectangle exceeds the buffer's dimensions.
+        Yw3dResult ClearDepthStencilBuffer(const float depth, const uint32_t stencil, const Yw3dRect* rect);
+
         // Associates a Yw3dSurface as colorbuffer with this rendertarget, releasing the currently set colorbuffer.
         // Calling this function will increase the internal reference count of the surface.
         // @param[in] colorBuffer new colorbuffer.
@@ -58,16 +76,27 @@ namespace yw
         // @return Yw3d_E_InvalidParameters if an invalid format was encountered.
         Yw3dResult SetColorBuffer(class Yw3dSurface* colorBuffer);
 
+        // Associates a Yw3dSurface as colorbuffer with an attachment of this rendertarget, releasing the currently set colorbuffer of this attachment.
+        // Attachment 0 is the colorbuffer written by single color pixel shaders and presented by the device, Yw3d_PSO_MultipleColors pixel shaders write all attachments.
+        // All colorbuffers, the depthbuffer and the stencilbuffer must have the same dimensions.
+        // Calling this function will increase the internal reference count of the surface.
+        // @param[in] index index of the attachment, must be less than YW3D_MAX_COLOR_BUFFERS.
+        // @param[in] colorBuffer new colorbuffer, nullptr to detach the current one.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if the index is invalid.
+        // @return Yw3d_E_InvalidFormat if an invalid format or dimensions were encountered.
+        Yw3dResult SetColorBuffer(uint32_t index, class Yw3dSurface* colorBuffer);
+
         // Associates a Yw3dSurface as depthbuffer with this rendertarget, releasing the currently set depthbuffer.
         // Calling this function will increase the internal reference count of the surface.
-        // @param[in] depthBuffer new depthbuffer.
+        // @param[in] depthBuffer new depthbuffer, format Yw3d_FMT_R32F, Yw3d_FMT_D24S8 or Yw3d_FMT_D16.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if an invalid format was encountered.
         Yw3dResult SetDepthBuffer(class Yw3dSurface* depthBuffer);
 
         // Associates a Yw3dSurface as stencilbuffer with this rendertarget, releasing the currently set stencilbuffer.
         // Calling this function will increase the internal reference count of the surface.
-        // @param[in] stencilbuffer new stencilbuffer.
+        // @param[in] stencilbuffer new stencilbuffer, format Yw3d_FMT_R32F or Yw3d_FMT_D24S8. A Yw3d_FMT_D24S8 surface may be shared with the depthbuffer.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if an invalid format was encountered.
         Yw3dResult SetStencilBuffer(class Yw3dSurface* stencilBuffer);
@@ -75,6 +104,13 @@ namespace yw
         // Returns a pointer to the rendertarget's colorbuffer. Calling this function will increase the internal reference count of the texture. Failure to call Release() when finished using the pointer will result in a memory leak.
         class Yw3dSurface* AcquireColorBuffer();
 
+        // Returns a pointer to a colorbuffer attachment of the rendertarget, nullptr if the index is invalid or no colorbuffer has been set to it. Calling this function will increase the internal reference count of the texture. Failure to call Release() when finished using the pointer will result in a memory leak.
+        // @param[in] index index of the attachment, must be less than YW3D_MAX_COLOR_BUFFERS.
+        class Yw3dSurface* AcquireColorBuffer(uint32_t index);
+
+        // Returns the number of colorbuffer attachments up to the last one that has been set, attachments in between may be empty.
+        uint32_t GetNumColorBuffers() const;
+
         // Returns a pointer to the rendertarget's depthbuffer. Calling this function will increase the internal reference count of the texture. Failure to call Release() when finished using the pointer will result in a memory leak.
         class Yw3dSurface* AcquireDepthBuffer();
 
@@ -84,12 +120,19 @@ namespace yw
         // Returns the rendertarget's viewport matrix.
         const Matrix44* GetViewportMatrix() const;
 
+    private:
+        // Checks that a surface has the same dimensions as all colorbuffers of this rendertarget.
+        // @param[in] surface the surface to be checked.
+        // @param[in] ignoredColorBuffer index of a colorbuffer attachment to be skipped, because surface is about to replace it; YW3D_MAX_COLOR_BUFFERS to check all.
+        // @return true if the dimensions match.
+        bool MatchDimensions(const class Yw3dSurface* surface, uint32_t ignoredColorBuffer) const;
+
     private:
         // Pointer to parent.
         class Yw3dDevice* m_Device;
 
-        // Pointer to the colorbuffer.
-        class Yw3dSurface* m_ColorBuffer;
+        // Pointers to the colorbuffer attachments, index 0 is the main colorbuffer.
+        class Yw3dSurface* m_ColorBuffers[YW3D_MAX_COLOR_BUFFERS];
 
         // Pointer to the depthbuffer.
         class Yw3dSurface* m_DepthBuffer;
@@ -1,21 +1,38 @@
 // Add by Yaukey at 2018-02-22.
-// YW Soft Renderer 3d shader class( vertex-shader, triangle-shader and pixel shader).
+// YW Soft Renderer 3d shader class( vertex-shader, triangle-shader, pixel shader and compute shader).
 
 #include "Yw3dShader.h"
+#include "Yw3dCpu.h"
+#include "Yw3dDevice.h"
 
 namespace yw
 {
+    void IYw3dVertexShader::TransformBatch(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count) const
+    {
+        GetDevice()->GetSimdKernels()->transformBatch(result, v, m, count);
+    }
+
+    void IYw3dVertexShader::TransformNormalBatch(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count) const
+    {
+        GetDevice()->GetSimdKernels()->transformNormalBatch(result, v, m, count);
+    }
+
     IYw3dPixelShader::IYw3dPixelShader() : 
         m_VsOutputs(nullptr),
-        m_TriangleInfo(nullptr)
+        m_TriangleInfo(nullptr),
+        m_QuadRowTriangleId(0),
+        m_QuadRow(0),
+        m_QuadRowStamp(1)
     {
-
     }
 
     void IYw3dPixelShader::SetInfo(const Yw3dShaderRegisterType* vsOutputs, const Yw3dTriangleInfo* triangleInfo)
     {
         m_VsOutputs = vsOutputs;
         m_TriangleInfo = triangleInfo;
+
+        // Triangle 0 is never drawn, so the next fetch starts a new pair of rows.
+        m_QuadRowTriangleId = 0;
     }
 
     // Partial derivative equations taken from
@@ -34,6 +51,52 @@ namespace yw
             return;
         }
 
+        ComputePartialDerivatives(shaderRegister, (float)m_TriangleInfo->curPixelX, (float)m_TriangleInfo->curPixelY, m_TriangleInfo->curPixelInvW, ddx, ddy);
+    }
+
+    void IYw3dPixelShader::BeginQuadRow(uint32_t quadRow)
+    {
+        m_QuadRowTriangleId = m_TriangleInfo->triangleId;
+        m_QuadRow = quadRow;
+
+        // Stamp 0 marks quads never computed, so they have to be reset when the stamp wraps around.
+        if (0 == ++m_QuadRowStamp)
+        {
+            for (uint32_t regIdx = 0; regIdx < YW3D_PIXEL_SHADER_REGISTERS; regIdx++)
+            {
+                for (QuadDerivatives& quad : m_QuadDerivatives[regIdx])
+                {
+                    quad.rowStamp = 0;
+                }
+            }
+
+            m_QuadRowStamp = 1;
+        }
+    }
+
+    void IYw3dPixelShader::UpdateQuadPartialDerivatives(uint32_t shaderRegister, uint32_t quadColumn)
+    {
+        std::vector<QuadDerivatives>& quads = m_QuadDerivatives[shaderRegister];
+        if (quadColumn >= quads.size())
+        {
+            quads.resize(quadColumn + 1);
+        }
+
+        QuadDerivatives& quad = quads[quadColumn];
+        quad.rowStamp = m_QuadRowStamp;
+        quad.ddx = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+        quad.ddy = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+
+        // The center of the quad is half a pixel right and below of its top-left pixel, interpolate 1/w there.
+        const float quadX = (float)(m_TriangleInfo->curPixelX & ~1u) + 0.5f;
+        const float quadY = (float)(m_TriangleInfo->curPixelY & ~1u) + 0.5f;
+        const float invW = m_TriangleInfo->baseVertex->position.w + m_TriangleInfo->wDdx * (quadX - m_TriangleInfo->baseVertex->position.x) + m_TriangleInfo->wDdy * (quadY - m_TriangleInfo->baseVertex->position.y);
+
+        ComputePartialDerivatives(shaderRegister, quadX, quadY, 1.0f / invW, quad.ddx, quad.ddy);
+    }
+
+    void IYw3dPixelShader::ComputePartialDerivatives(uint32_t shaderRegister, float pixelX, float pixelY, float pixelW, Vector4& ddx, Vector4& ddy) const
+    {
         // Get all formula parameters.
         const Yw3dShaderRegister& A = m_TriangleInfo->shaderOutputsDdx[shaderRegister];
         const Yw3dShaderRegister& B = m_TriangleInfo->shaderOutputsDdy[shaderRegister];
@@ -43,9 +106,9 @@ namespace yw
         const float& E = m_TriangleInfo->wDdy;
         const float& F = m_TriangleInfo->baseVertex->position.w;
 
-        const float deltaPixelX = (float)m_TriangleInfo->curPixelX - m_TriangleInfo->baseVertex->position.x;
-        const float deltaPixelY = (float)m_TriangleInfo->curPixelY - m_TriangleInfo->baseVertex->position.y;
-        const float invWSquare = m_TriangleInfo->curPixelInvW * m_TriangleInfo->curPixelInvW;
+        const float deltaPixelX = pixelX - m_TriangleInfo->baseVertex->position.x;
+        const float deltaPixelY = pixelY - m_TriangleInfo->baseVertex->position.y;
+        const float invWSquare = pixelW * pixelW;
 
         // Compute partial derivative with respect to the x-screen space coordinate.
         switch (m_VsOutputs[shaderRegister])
@@ -79,4 +142,14 @@ namespace yw
             break;
         }
     }
+
+    IYw3dComputeShader::IYw3dComputeShader() :
+        m_Surfaces(nullptr)
+    {
+    }
+
+    void IYw3dComputeShader::SetSurfaces(const Yw3dComputeSurface* surfaces)
+    {
+        m_Surfaces = surfaces;
+    }
 }
@@ -1,5 +1,5 @@
 // Add by Yaukey at 2018-02-22.
-// YW Soft Renderer 3d shader class (vertex-shader, triangle-shader and pixel shader).
+// YW Soft Renderer 3d shader class (vertex-shader, triangle-shader, pixel shader and compute shader).
 
 #ifndef __YW_3D_SHADER_H__
 #define __YW_3D_SHADER_H__
@@ -7,6 +7,7 @@
 #include "Yw3dBase.h"
 #include "Yw3dTypes.h"
 #include "Yw3dBaseShader.h"
+#include <vector>
 
 namespace yw
 {
@@ -26,6 +27,32 @@ namespace yw
         // Returns the type of a particular output register. Member of the enumeration Yw3dShaderRegType; if a given register is not used, return Yw3d_SRT_Unused.
         // @param[in] shaderRegister index of register, e [0,YW3D_PIXEL_SHADER_REGISTERS].
         virtual Yw3dShaderRegisterType GetOutputRegisters(uint32_t shaderRegister) = 0;
+
+        // Accessible by Yw3dDevice.
+        // Returns the number of vertices ExecuteBatch() processes at once; 4, 8 or 16. Default: 0, the shader has no batch entry point.
+        virtual uint32_t GetBatchSize() { return 0; }
+
+        // Accessible by Yw3dDevice.
+        // Optional batch entry point, transforms GetBatchSize() vertices in SoA layout at once and has to compute the same results as Execute() for each vertex.
+        // The device uses it to shade all vertices of a draw call in a pre-pass, lanes past the last vertex of the draw call hold copies of it.
+        // @param[in] vsShaderInput vertex shader input registers of the batch.
+        // @param[out] vsShaderOutput positions transformed to homogeneous clipping space and output registers of the batch.
+        virtual void ExecuteBatch(const Yw3dVSInputBatch& /*vsShaderInput*/, Yw3dVSOutputBatch& /*vsShaderOutput*/) {}
+
+    protected:
+        // Transforms a register of a batch of vertices by a matrix, like Vector4 * Matrix44 for each vertex. Runs the kernel of the SIMD level selected by the device.
+        // @param[out] result receives the transformed register, may be the source register.
+        // @param[in] v the register to be transformed.
+        // @param[in] m the transformation matrix.
+        // @param[in] count number of vertices to be transformed, a multiple of 4.
+        void TransformBatch(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count) const;
+
+        // Transforms the xyz-components of a register of a batch of vertices by the upper 3x3 part of a matrix, e.g. normals. The w-components of the result are 0.
+        // @param[out] result receives the transformed register, may be the source register.
+        // @param[in] v the register to be transformed.
+        // @param[in] m the transformation matrix.
+        // @param[in] count number of vertices to be transformed, a multiple of 4.
+        void TransformNormalBatch(Yw3dShaderRegisterBatch& result, const Yw3dShaderRegisterBatch& v, const Matrix44& m, uint32_t count) const;
     };
 
     // Defines the triangle shader interface.
@@ -68,6 +95,15 @@ namespace yw
         // @return true if the pixel shall be written to the rendertarget, false in case it shall be killed.
         virtual bool Execute(const Yw3dShaderRegister* input, Vector4& color, float& depth) = 0;
 
+        // Accessible by Yw3dDevice.
+        // Called instead of Execute() for Yw3d_PSO_MultipleColors-shader-types, the attributes are interpolated once for all colorbuffer attachments, e.g. to fill a G-buffer in a single pass.
+        // Default: calls Execute() for the first attachment and leaves the other attachments unchanged.
+        // @param[in] input pixel shader input registers, which have been set up in the vertex shader and interpolated during rasterization.
+        // @param[in,out] colors YW3D_MAX_COLOR_BUFFERS colors, each contains the value of the pixel in the corresponding attachment when ExecuteMultipleColors() is called. Colors of attachments that are not set are ignored.
+        // @param[in] depth contains the interpolated depth of the pixel.
+        // @return true if the pixel shall be written to the rendertarget, false in case it shall be killed.
+        virtual bool ExecuteMultipleColors(const Yw3dShaderRegister* input, Vector4* colors, float& depth) { return Execute(input, colors[0], depth); }
+
     protected:
         // Accessible by Yw3dDevice - Sets the triangle info.
         // @param[in] vsOutputs pointer to the pixel shader input register-types.
@@ -87,6 +123,14 @@ namespace yw
         // @param[out] ddy partial derivative with respect to the y-screen space coordinate.
         void GetPartialDerivatives(uint32_t register, Vector4& ddx, Vector4& ddy) const;
 
+        // Computes the partial derivatives of a shader register once per 2x2 pixel quad, at the center of the quad.
+        // All pixels of the quad share the result, so the texture fetches of a quad using the register select the same mip-level.
+        // The results are cached by quad column for the current pair of rows, so the second row of a quad reuses the derivatives of the first one.
+        // @param[in] shaderRegister index of the source shader register.
+        // @param[out] ddx partial derivative with respect to the x-screen space coordinate.
+        // @param[out] ddy partial derivative with respect to the y-screen space coordinate.
+        inline void GetQuadPartialDerivatives(uint32_t shaderRegister, Vector4& ddx, Vector4& ddy);
+
     protected:
         // Sample texture color.
         // @param[in] shaderRegister texture binded shader register index.
@@ -98,7 +142,7 @@ namespace yw
         {
             // Get ddx and ddy for mipmap.
             Vector4 vDdx, vDdy;
-            GetPartialDerivatives(shaderRegister, vDdx, vDdy);
+            GetQuadPartialDerivatives(shaderRegister, vDdx, vDdy);
 
             // Sample the texture.
             Vector4 texColor;
@@ -126,7 +170,7 @@ namespace yw
             Vector4 vDdx, vDdy;
             if (s.w < 0.0f)
             {
-                GetPartialDerivatives(shaderRegister, vDdx, vDdy);
+                GetQuadPartialDerivatives(shaderRegister, vDdx, vDdy);
                 pDdx = &vDdx;
                 pDdy = &vDdy;
             }
@@ -148,7 +192,7 @@ namespace yw
         {
             // Get ddx and ddy for mipmap.
             Vector4 vDdx, vDdy;
-            GetPartialDerivatives(shaderRegister, vDdx, vDdy);
+            GetQuadPartialDerivatives(shaderRegister, vDdx, vDdy);
 
             // Sample the texture.
             Vector4 texColor;
@@ -175,7 +219,59 @@ namespace yw
             Vector4 vDdx, vDdy;
             if (s.w < 0.0f)
             {
-                GetPartialDerivatives(shaderRegister, vDdx, vDdy);
+                GetQuadPartialDerivatives(shaderRegister, vDdx, vDdy);
+                pDdx = &vDdx;
+                pDdy = &vDdy;
+            }
+
+            // Sample the texture.
+            Vector4 texColor;
+            SampleTexture(texColor, samplerNumber, s.x, s.y, s.z, s.w, pDdx, pDdy);
+
+            // Return sampled texture color.
+            return texColor;
+        }
+
+        // Sample texture array color.
+        // @param[in] shaderRegister texture binded shader register index.
+        // @param[in] samplerNumber texture binded texture sampler index.
+        // @param[in] s texture sample address.
+        //            s.xy Coordinates to perform the lookup.
+        //            s.z Layer index, rounded to the nearest layer.
+        // @return sampled texture color, return Pure-Black(0,0,0,0) if no texture found.
+        inline Vector4 tex2DArray(uint32_t shaderRegister, uint32_t samplerNumber, const Vector3& s)
+        {
+            // Get ddx and ddy for mipmap.
+            Vector4 vDdx, vDdy;
+            GetQuadPartialDerivatives(shaderRegister, vDdx, vDdy);
+
+            // Sample the texture.
+            Vector4 texColor;
+            SampleTexture(texColor, samplerNumber, s.x, s.y, s.z, -1.0f, &vDdx, &vDdy);
+
+            // Return sampled texture color.
+            return texColor;
+        }
+
+        // Sample texture array color with specified level of detail.
+        // @param[in] shaderRegister texture binded shader register index.
+        // @param[in] samplerNumber texture binded texture sampler index.
+        // @param[in] s texture sample address.
+        //            s.xy Coordinates to perform the lookup.
+        //            s.z Layer index, rounded to the nearest layer.
+        //            s.w Level of detail.
+        // @return sampled texture color, return Pure-Black(0,0,0,0) if no texture found.
+        inline Vector4 tex2DArraylod(uint32_t shaderRegister, uint32_t samplerNumber, const Vector4& s)
+        {
+            // Get ddx and ddy for mipmap only when lod is greater than 0.
+            Vector4* pDdx = nullptr;
+            Vector4* pDdy = nullptr;
+
+            // Prepare to get ddx and ddy.
+            Vector4 vDdx, vDdy;
+            if (s.w < 0.0f)
+            {
+                GetQuadPartialDerivatives(shaderRegister, vDdx, vDdy);
                 pDdx = &vDdx;
                 pDdy = &vDdy;
             }
@@ -198,7 +294,7 @@ namespace yw
         {
             // Get ddx and ddy for mipmap.
             Vector4 vDdx, vDdy;
-            GetPartialDerivatives(shaderRegister, vDdx, vDdy);
+            GetQuadPartialDerivatives(shaderRegister, vDdx, vDdy);
 
             // Sample the texture.
             Yw3dResult result = SampleTexture(color, samplerNumber, uv.x, uv.y, 0.0f, -1.0f, &vDdx, &vDdy);
@@ -208,11 +304,228 @@ namespace yw
         }
 
     private:
+        // Computes the partial derivatives of a shader register at a screen space position of the current triangle.
+        // @param[in] pixelX x-screen space coordinate.
+        // @param[in] pixelY y-screen space coordinate.
+        // @param[in] pixelW interpolated w at the position, the reciprocal of the interpolated 1/w.
+        void ComputePartialDerivatives(uint32_t shaderRegister, float pixelX, float pixelY, float pixelW, Vector4& ddx, Vector4& ddy) const;
+
+        // Starts caching the quads of another pair of rows or another triangle, invalidates all cached quads.
+        // @param[in] quadRow index of the pair of rows, the y-screen space coordinate divided by 2.
+        void BeginQuadRow(uint32_t quadRow);
+
+        // Computes the partial derivatives of a shader register for the quad of the current pixel and stores them in the quad cache.
+        // @param[in] quadColumn index of the quad in the pair of rows, the x-screen space coordinate divided by 2.
+        void UpdateQuadPartialDerivatives(uint32_t shaderRegister, uint32_t quadColumn);
+
+    private:
+        // Partial derivatives of a shader register cached for a pixel quad of the current pair of rows.
+        struct QuadDerivatives
+        {
+            uint32_t rowStamp;
+            Vector4 ddx;
+            Vector4 ddy;
+
+            QuadDerivatives() : rowStamp(0) {}
+        };
+
         // Register type info.
         const Yw3dShaderRegisterType* m_VsOutputs;
 
         // Gradient info about the triangle that is currently being drawn.
 	    const struct Yw3dTriangleInfo* m_TriangleInfo;
+
+        // Triangle and pair of rows whose quads are cached.
+        uint32_t m_QuadRowTriangleId;
+        uint32_t m_QuadRow;
+
+        // Stamp of the cached pair of rows, a quad is valid if its stamp matches. Changing it invalidates all quads without touching them.
+        uint32_t m_QuadRowStamp;
+
+        // Derivatives of each register by quad column, grown to the widest row shaded so far.
+        std::vector<QuadDerivatives> m_QuadDerivatives[YW3D_PIXEL_SHADER_REGISTERS];
+    };
+
+    inline void IYw3dPixelShader::GetQuadPartialDerivatives(uint32_t shaderRegister, Vector4& ddx, Vector4& ddy)
+    {
+        // Skip if invalid shader register.
+        if (shaderRegister >= YW3D_PIXEL_SHADER_REGISTERS)
+        {
+            ddx = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+            ddy = Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+            return;
+        }
+
+        // The rasterizer walks whole rows, the first row of a pair computes the derivatives of its quads and the second one reuses them.
+        const uint32_t quadRow = m_TriangleInfo->curPixelY >> 1;
+        if ((m_QuadRowTriangleId != m_TriangleInfo->triangleId) || (m_QuadRow != quadRow))
+        {
+            BeginQuadRow(quadRow);
+        }
+
+        // Only the first fetch of a quad computes the derivatives.
+        const uint32_t quadColumn = m_TriangleInfo->curPixelX >> 1;
+        std::vector<QuadDerivatives>& quads = m_QuadDerivatives[shaderRegister];
+        if ((quadColumn >= quads.size()) || (quads[quadColumn].rowStamp != m_QuadRowStamp))
+        {
+            UpdateQuadPartialDerivatives(shaderRegister, quadColumn);
+        }
+
+        const QuadDerivatives& quad = quads[quadColumn];
+        ddx = quad.ddx;
+        ddy = quad.ddy;
+    }
+
+    // Defines the compute shader interface: a kernel that is run over a grid of thread groups by Yw3dDevice::Dispatch(), without any rasterization.
+    // The thread groups are distributed over the worker threads of the device, the threads of a group run one after another on the same worker.
+    // @note Execute() is called concurrently from several threads, so it must not modify members of the shader and two invocations must not write the same surface pixel.
+    class IYw3dComputeShader : public IYw3dBaseShader
+    {
+        friend class Yw3dDevice;
+
+    protected:
+        // Accessible by Yw3dDevice which is the only class that may create.
+        IYw3dComputeShader();
+
+    protected:
+        // Accessible by Yw3dDevice. Returns the number of threads of a thread group in each dimension. Default: 8 x 8 x 1.
+        // @param[out] sizeX number of threads along x-axis.
+        // @param[out] sizeY number of threads along y-axis.
+        // @param[out] sizeZ number of threads along z-axis.
+        virtual void GetThreadGroupSize(uint32_t& sizeX, uint32_t& sizeY, uint32_t& sizeZ) { sizeX = 8; sizeY = 8; sizeZ = 1; }
+
+        // Accessible by Yw3dDevice.
+        // This is the core function of a compute shader: It is called once for each thread of each thread group of a dispatch.
+        // Reads textures bound to the samplers of the device and reads or writes the surfaces bound with Yw3dDevice::SetComputeSurface().
+        // @param[in] threadId indices of the invocation.
+        virtual void Execute(const Yw3dComputeThreadId& threadId) = 0;
+
+    protected:
+        // Returns the width of the surface bound to a slot, 0 if no surface is bound.
+        // @param[in] slot number of the surface slot.
+        inline uint32_t GetSurfaceWidth(uint32_t slot) const
+        {
+            return ((nullptr != m_Surfaces) && (slot < YW3D_MAX_COMPUTE_SURFACES)) ? m_Surfaces[slot].width : 0;
+        }
+
+        // Returns the height of the surface bound to a slot, 0 if no surface is bound.
+        // @param[in] slot number of the surface slot.
+        inline uint32_t GetSurfaceHeight(uint32_t slot) const
+        {
+            return ((nullptr != m_Surfaces) && (slot < YW3D_MAX_COMPUTE_SURFACES)) ? m_Surfaces[slot].height : 0;
+        }
+
+        // Reads a pixel of a bound surface, channels not stored by the surface format are returned as (0,0,0,1).
+        // @param[in] slot number of the surface slot.
+        // @param[in] x position along x-axis.
+        // @param[in] y position along y-axis.
+        // @return the pixel, (0,0,0,0) if the position is out of bounds or no surface is bound.
+        inline Vector4 LoadSurface(uint32_t slot, uint32_t x, uint32_t y) const
+        {
+            const Yw3dComputeSurface* surface = GetSurface(slot, x, y);
+            if (nullptr == surface)
+            {
+                return Vector4(0.0f, 0.0f, 0.0f, 0.0f);
+            }
+
+            const float* pixel = surface->data + (y * surface->width + x) * surface->floats;
+            Vector4 value(0.0f, 0.0f, 0.0f, 1.0f);
+            switch (surface->floats)
+            {
+            case 4:
+                value.a = pixel[3];
+            case 3:
+                value.b = pixel[2];
+            case 2:
+                value.g = pixel[1];
+            case 1:
+                value.r = pixel[0];
+            default:    // Can not happen.
+                break;
+            }
+
+            return value;
+        }
+
+        // Writes a pixel of a bound surface, only the channels stored by the surface format are written.
+        // @param[in] slot number of the surface slot.
+        // @param[in] x position along x-axis.
+        // @param[in] y position along y-axis.
+        // @param[in] value the new pixel, ignored if the position is out of bounds or no surface is bound.
+        inline void StoreSurface(uint32_t slot, uint32_t x, uint32_t y, const Vector4& value)
+        {
+            const Yw3dComputeSurface* surface = GetSurface(slot, x, y);
+            if (nullptr == surface)
+            {
+                return;
+            }
+
+            float* pixel = surface->data + (y * surface->width + x) * surface->floats;
+            switch (surface->floats)
+            {
+            case 4:
+                pixel[3] = value.a;
+            case 3:
+                pixel[2] = value.b;
+            case 2:
+                pixel[1] = value.g;
+            case 1:
+                pixel[0] = value.r;
+            default:    // Can not happen.
+                break;
+            }
+        }
+
+        // Sample texture color with specified level of detail, there are no partial derivatives without rasterization. Negative levels sample the most detailed mip-level.
+        // @param[in] samplerNumber texture binded texture sampler index.
+        // @param[in] s texture sample address.
+        //            s.xy Coordinates to perform the lookup.
+        //            s.w Level of detail.
+        // @return sampled texture color, return Pure-Black(0,0,0,0) if no texture found.
+        inline Vector4 tex2Dlod(uint32_t samplerNumber, const Vector4& s)
+        {
+            Vector4 texColor;
+            SampleTexture(texColor, samplerNumber, s.x, s.y, 0.0f, s.w);
+            return texColor;
+        }
+
+        // Sample cube texture color with specified level of detail, there are no partial derivatives without rasterization. Negative levels sample the most detailed mip-level.
+        // @param[in] samplerNumber texture binded texture sampler index.
+        // @param[in] s texture sample address.
+        //            s.xyz Coordinates to perform the lookup.
+        //            s.w Level of detail.
+        // @return sampled texture color, return Pure-Black(0,0,0,0) if no texture found.
+        inline Vector4 texCUBElod(uint32_t samplerNumber, const Vector4& s)
+        {
+            Vector4 texColor;
+            SampleTexture(texColor, samplerNumber, s.x, s.y, s.z, s.w);
+            return texColor;
+        }
+
+    private:
+        // Accessible by Yw3dDevice - Sets the surfaces locked for the running dispatch, nullptr when the dispatch has finished.
+        // @param[in] surfaces YW3D_MAX_COMPUTE_SURFACES surfaces, indexed by slot.
+        void SetSurfaces(const Yw3dComputeSurface* surfaces);
+
+        // Returns the surface bound to a slot if a position is inside of it.
+        // @param[in] slot number of the surface slot.
+        // @param[in] x position along x-axis.
+        // @param[in] y position along y-axis.
+        // @return the surface, nullptr if the position is out of bounds or no surface is bound.
+        inline const Yw3dComputeSurface* GetSurface(uint32_t slot, uint32_t x, uint32_t y) const
+        {
+            if ((nullptr == m_Surfaces) || (slot >= YW3D_MAX_COMPUTE_SURFACES))
+            {
+                return nullptr;
+            }
+
+            const Yw3dComputeSurface* surface = &m_Surfaces[slot];
+            return ((nullptr != surface->data) && (x < surface->width) && (y < surface->height)) ? surface : nullptr;
+        }
+
+    private:
+        // Surfaces of the running dispatch.
+        const Yw3dComputeSurface* m_Surfaces;
     };
 }
 
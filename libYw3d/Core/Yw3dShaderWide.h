@@ -0,0 +1,594 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d wide shading types.
+
+#ifndef __YW_3D_SHADER_WIDE_H__
+#define __YW_3D_SHADER_WIDE_H__
+
+#include "Yw3dBase.h"
+#include "Yw3dTypes.h"
+#include <cmath>
+#include <cstring>
+
+namespace yw
+{
+    // Number of lanes of the wide shading types, each lane holds the value of one vertex or pixel.
+    const uint32_t YW3D_WIDE_LANES = 8;
+
+    // ------------------------------------------------------------------
+    // SIMD registers backing the wide shading types, the lanes are held by one AVX register, two SSE2 registers or plain floats.
+    // Comparisons return masks with all bits of a lane set if the comparison is true.
+
+#if defined(YW3D_AVX)
+    typedef __m256 Yw3dWideRegister;
+    const uint32_t YW3D_WIDE_REGISTERS = 1;
+
+    inline Yw3dWideRegister WideSet(float f) { return _mm256_set1_ps(f); }
+    inline Yw3dWideRegister WideLoad(const float* p) { return _mm256_loadu_ps(p); }
+    inline void WideStore(float* p, Yw3dWideRegister a) { _mm256_storeu_ps(p, a); }
+    inline Yw3dWideRegister WideAdd(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_add_ps(a, b); }
+    inline Yw3dWideRegister WideSub(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_sub_ps(a, b); }
+    inline Yw3dWideRegister WideMul(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_mul_ps(a, b); }
+    inline Yw3dWideRegister WideDiv(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_div_ps(a, b); }
+    inline Yw3dWideRegister WideMin(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_min_ps(a, b); }
+    inline Yw3dWideRegister WideMax(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_max_ps(a, b); }
+    inline Yw3dWideRegister WideSqrt(Yw3dWideRegister a) { return _mm256_sqrt_ps(a); }
+    inline Yw3dWideRegister WideCmpLt(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    inline Yw3dWideRegister WideCmpLe(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    inline Yw3dWideRegister WideCmpEq(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    inline Yw3dWideRegister WideAnd(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_and_ps(a, b); }
+    inline Yw3dWideRegister WideAndNot(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_andnot_ps(a, b); }
+    inline Yw3dWideRegister WideOr(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm256_or_ps(a, b); }
+#elif defined(YW3D_SSE2)
+    typedef __m128 Yw3dWideRegister;
+    const uint32_t YW3D_WIDE_REGISTERS = 2;
+
+    inline Yw3dWideRegister WideSet(float f) { return _mm_set1_ps(f); }
+    inline Yw3dWideRegister WideLoad(const float* p) { return _mm_loadu_ps(p); }
+    inline void WideStore(float* p, Yw3dWideRegister a) { _mm_storeu_ps(p, a); }
+    inline Yw3dWideRegister WideAdd(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_add_ps(a, b); }
+    inline Yw3dWideRegister WideSub(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_sub_ps(a, b); }
+    inline Yw3dWideRegister WideMul(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_mul_ps(a, b); }
+    inline Yw3dWideRegister WideDiv(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_div_ps(a, b); }
+    inline Yw3dWideRegister WideMin(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_min_ps(a, b); }
+    inline Yw3dWideRegister WideMax(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_max_ps(a, b); }
+    inline Yw3dWideRegister WideSqrt(Yw3dWideRegister a) { return _mm_sqrt_ps(a); }
+    inline Yw3dWideRegister WideCmpLt(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_cmplt_ps(a, b); }
+    inline Yw3dWideRegister WideCmpLe(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_cmple_ps(a, b); }
+    inline Yw3dWideRegister WideCmpEq(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_cmpeq_ps(a, b); }
+    inline Yw3dWideRegister WideAnd(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_and_ps(a, b); }
+    inline Yw3dWideRegister WideAndNot(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_andnot_ps(a, b); }
+    inline Yw3dWideRegister WideOr(Yw3dWideRegister a, Yw3dWideRegister b) { return _mm_or_ps(a, b); }
+#else
+    typedef float Yw3dWideRegister;
+    const uint32_t YW3D_WIDE_REGISTERS = YW3D_WIDE_LANES;
+
+    inline uint32_t WideBits(float a) { uint32_t u; memcpy(&u, &a, sizeof(u)); return u; }
+    inline float WideFloat(uint32_t u) { float a; memcpy(&a, &u, sizeof(a)); return a; }
+    inline Yw3dWideRegister WideSet(float f) { return f; }
+    inline Yw3dWideRegister WideLoad(const float* p) { return *p; }
+    inline void WideStore(float* p, Yw3dWideRegister a) { *p = a; }
+    inline Yw3dWideRegister WideAdd(Yw3dWideRegister a, Yw3dWideRegister b) { return a + b; }
+    inline Yw3dWideRegister WideSub(Yw3dWideRegister a, Yw3dWideRegister b) { return a - b; }
+    inline Yw3dWideRegister WideMul(Yw3dWideRegister a, Yw3dWideRegister b) { return a * b; }
+    inline Yw3dWideRegister WideDiv(Yw3dWideRegister a, Yw3dWideRegister b) { return a / b; }
+    inline Yw3dWideRegister WideMin(Yw3dWideRegister a, Yw3dWideRegister b) { return (a < b) ? a : b; }
+    inline Yw3dWideRegister WideMax(Yw3dWideRegister a, Yw3dWideRegister b) { return (a > b) ? a : b; }
+    inline Yw3dWideRegister WideSqrt(Yw3dWideRegister a) { return sqrtf(a); }
+    inline Yw3dWideRegister WideCmpLt(Yw3dWideRegister a, Yw3dWideRegister b) { return WideFloat((a < b) ? 0xffffffff : 0); }
+    inline Yw3dWideRegister WideCmpLe(Yw3dWideRegister a, Yw3dWideRegister b) { return WideFloat((a <= b) ? 0xffffffff : 0); }
+    inline Yw3dWideRegister WideCmpEq(Yw3dWideRegister a, Yw3dWideRegister b) { return WideFloat((a == b) ? 0xffffffff : 0); }
+    inline Yw3dWideRegister WideAnd(Yw3dWideRegister a, Yw3dWideRegister b) { return WideFloat(WideBits(a) & WideBits(b)); }
+    inline Yw3dWideRegister WideAndNot(Yw3dWideRegister a, Yw3dWideRegister b) { return WideFloat(~WideBits(a) & WideBits(b)); }
+    inline Yw3dWideRegister WideOr(Yw3dWideRegister a, Yw3dWideRegister b) { return WideFloat(WideBits(a) | WideBits(b)); }
+#endif
+
+    // Number of lanes of a SIMD register.
+    const uint32_t YW3D_WIDE_REGISTER_LANES = YW3D_WIDE_LANES / YW3D_WIDE_REGISTERS;
+
+    // ------------------------------------------------------------------
+    // Wide shading types, the SoA counterparts of float, float2, float3 and float4 holding YW3D_WIDE_LANES values each.
+    // Batch shaders are written with these types like scalar shaders are written with float2, float3 and float4, see the wide overloads of IYw3dBaseShader.
+    // Lane-wise abs, sqrt and conditionals are floatxN::Abs(), floatxN::Sqrt() and floatxN::Select(), shader members of these names would hide the scalar ones.
+
+    // A float of each lane.
+    struct floatxN
+    {
+        Yw3dWideRegister r[YW3D_WIDE_REGISTERS];
+
+        floatxN() {}
+        explicit floatxN(float f) { for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { r[i] = WideSet(f); } }
+
+        // Loads YW3D_WIDE_LANES floats, lane i is taken from lanes[i].
+        explicit floatxN(const float* lanes) { for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { r[i] = WideLoad(lanes + i * YW3D_WIDE_REGISTER_LANES); } }
+
+        // Stores YW3D_WIDE_LANES floats, lane i is written to lanes[i].
+        void Store(float* lanes) const { for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { WideStore(lanes + i * YW3D_WIDE_REGISTER_LANES, r[i]); } }
+
+        // Returns or sets the value of a lane.
+        float GetLane(uint32_t lane) const { float lanes[YW3D_WIDE_LANES]; Store(lanes); return lanes[lane]; }
+        void SetLane(uint32_t lane, float f) { float lanes[YW3D_WIDE_LANES]; Store(lanes); lanes[lane] = f; *this = floatxN(lanes); }
+
+        floatxN& operator +=(const floatxN& a) { for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { r[i] = WideAdd(r[i], a.r[i]); } return *this; }
+        floatxN& operator -=(const floatxN& a) { for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { r[i] = WideSub(r[i], a.r[i]); } return *this; }
+        floatxN& operator *=(const floatxN& a) { for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { r[i] = WideMul(r[i], a.r[i]); } return *this; }
+        floatxN& operator /=(const floatxN& a) { for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { r[i] = WideDiv(r[i], a.r[i]); } return *this; }
+        floatxN& operator +=(float f) { return *this += floatxN(f); }
+        floatxN& operator -=(float f) { return *this -= floatxN(f); }
+        floatxN& operator *=(float f) { return *this *= floatxN(f); }
+        floatxN& operator /=(float f) { return *this /= floatxN(f); }
+
+        // Returns the lane-wise minimum, maximum, absolute value or square root.
+        static floatxN Min(const floatxN& a, const floatxN& b) { floatxN v; for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideMin(a.r[i], b.r[i]); } return v; }
+        static floatxN Max(const floatxN& a, const floatxN& b) { floatxN v; for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideMax(a.r[i], b.r[i]); } return v; }
+        static floatxN Abs(const floatxN& a) { floatxN v; const Yw3dWideRegister signMask = WideSet(-0.0f); for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideAndNot(signMask, a.r[i]); } return v; }
+        static floatxN Sqrt(const floatxN& a) { floatxN v; for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideSqrt(a.r[i]); } return v; }
+
+        // Returns a where a lane of the mask is set and b elsewhere, the mask is the result of a comparison.
+        static floatxN Select(const floatxN& mask, const floatxN& a, const floatxN& b) { floatxN v; for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideOr(WideAnd(mask.r[i], a.r[i]), WideAndNot(mask.r[i], b.r[i])); } return v; }
+
+        // Applies a scalar function to each lane, e.g. powf.
+        template <typename Function>
+        static floatxN Apply(const floatxN& a, const floatxN& b, Function function)
+        {
+            float lanesA[YW3D_WIDE_LANES];
+            float lanesB[YW3D_WIDE_LANES];
+            a.Store(lanesA);
+            b.Store(lanesB);
+            for (uint32_t lane = 0; lane < YW3D_WIDE_LANES; lane++)
+            {
+                lanesA[lane] = function(lanesA[lane], lanesB[lane]);
+            }
+
+            return floatxN(lanesA);
+        }
+    };
+
+    inline floatxN operator +(const floatxN& a, const floatxN& b) { floatxN v(a); return v += b; }
+    inline floatxN operator -(const floatxN& a, const floatxN& b) { floatxN v(a); return v -= b; }
+    inline floatxN operator *(const floatxN& a, const floatxN& b) { floatxN v(a); return v *= b; }
+    inline floatxN operator /(const floatxN& a, const floatxN& b) { floatxN v(a); return v /= b; }
+    inline floatxN operator +(const floatxN& a, float b) { return a + floatxN(b); }
+    inline floatxN operator -(const floatxN& a, float b) { return a - floatxN(b); }
+    inline floatxN operator *(const floatxN& a, float b) { return a * floatxN(b); }
+    inline floatxN operator /(const floatxN& a, float b) { return a / floatxN(b); }
+    inline floatxN operator +(float a, const floatxN& b) { return floatxN(a) + b; }
+    inline floatxN operator -(float a, const floatxN& b) { return floatxN(a) - b; }
+    inline floatxN operator *(float a, const floatxN& b) { return floatxN(a) * b; }
+    inline floatxN operator /(float a, const floatxN& b) { return floatxN(a) / b; }
+    inline floatxN operator -(const floatxN& a) { return floatxN(0.0f) - a; }
+
+    // Lane-wise comparisons, the results are masks for floatxN::Select().
+    inline floatxN operator <(const floatxN& a, const floatxN& b) { floatxN v; for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideCmpLt(a.r[i], b.r[i]); } return v; }
+    inline floatxN operator <=(const floatxN& a, const floatxN& b) { floatxN v; for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideCmpLe(a.r[i], b.r[i]); } return v; }
+    inline floatxN operator >(const floatxN& a, const floatxN& b) { return b < a; }
+    inline floatxN operator >=(const floatxN& a, const floatxN& b) { return b <= a; }
+    inline floatxN operator ==(const floatxN& a, const floatxN& b) { floatxN v; for (uint32_t i = 0; i < YW3D_WIDE_REGISTERS; i++) { v.r[i] = WideCmpEq(a.r[i], b.r[i]); } return v; }
+    inline floatxN operator <(const floatxN& a, float b) { return a < floatxN(b); }
+    inline floatxN operator <=(const floatxN& a, float b) { return a <= floatxN(b); }
+    inline floatxN operator >(const floatxN& a, float b) { return a > floatxN(b); }
+    inline floatxN operator >=(const floatxN& a, float b) { return a >= floatxN(b); }
+
+    // A float2 of each lane.
+    struct float2xN
+    {
+        floatxN x;
+        floatxN y;
+
+        float2xN() {}
+        float2xN(const floatxN& vx, const floatxN& vy) : x(vx), y(vy) {}
+        explicit float2xN(const Vector2& v) : x(v.x), y(v.y) {}
+        explicit float2xN(const struct float4xN& v);
+
+        // Returns or sets the value of a lane.
+        Vector2 GetLane(uint32_t lane) const { return Vector2(x.GetLane(lane), y.GetLane(lane)); }
+        void SetLane(uint32_t lane, const Vector2& v) { x.SetLane(lane, v.x); y.SetLane(lane, v.y); }
+
+        float2xN& operator +=(const float2xN& a) { x += a.x; y += a.y; return *this; }
+        float2xN& operator -=(const float2xN& a) { x -= a.x; y -= a.y; return *this; }
+        float2xN& operator *=(const float2xN& a) { x *= a.x; y *= a.y; return *this; }
+        float2xN& operator *=(const floatxN& a) { x *= a; y *= a; return *this; }
+        float2xN& operator *=(float f) { x *= f; y *= f; return *this; }
+    };
+
+    // A float3 of each lane.
+    struct float3xN
+    {
+        floatxN x;
+        floatxN y;
+        floatxN z;
+
+        float3xN() {}
+        float3xN(const floatxN& vx, const floatxN& vy, const floatxN& vz) : x(vx), y(vy), z(vz) {}
+        explicit float3xN(const Vector3& v) : x(v.x), y(v.y), z(v.z) {}
+        explicit float3xN(const Vector4& v) : x(v.x), y(v.y), z(v.z) {}
+        explicit float3xN(const struct float4xN& v);
+
+        // Returns or sets the value of a lane.
+        Vector3 GetLane(uint32_t lane) const { return Vector3(x.GetLane(lane), y.GetLane(lane), z.GetLane(lane)); }
+        void SetLane(uint32_t lane, const Vector3& v) { x.SetLane(lane, v.x); y.SetLane(lane, v.y); z.SetLane(lane, v.z); }
+
+        float3xN& operator +=(const float3xN& a) { x += a.x; y += a.y; z += a.z; return *this; }
+        float3xN& operator -=(const float3xN& a) { x -= a.x; y -= a.y; z -= a.z; return *this; }
+        float3xN& operator *=(const float3xN& a) { x *= a.x; y *= a.y; z *= a.z; return *this; }
+        float3xN& operator *=(const floatxN& a) { x *= a; y *= a; z *= a; return *this; }
+        float3xN& operator *=(float f) { x *= f; y *= f; z *= f; return *this; }
+    };
+
+    // A float4 of each lane.
+    struct float4xN
+    {
+        floatxN x;
+        floatxN y;
+        floatxN z;
+        floatxN w;
+
+        float4xN() {}
+        float4xN(const floatxN& vx, const floatxN& vy, const floatxN& vz, const floatxN& vw) : x(vx), y(vy), z(vz), w(vw) {}
+        float4xN(const float3xN& v, const floatxN& vw) : x(v.x), y(v.y), z(v.z), w(vw) {}
+        float4xN(const float3xN& v, float vw) : x(v.x), y(v.y), z(v.z), w(vw) {}
+        explicit float4xN(const Vector4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+        // Loads lanes [first, first + YW3D_WIDE_LANES) of a register of a vertex batch.
+        float4xN(const Yw3dShaderRegisterBatch& batch, uint32_t first) : x(batch.x + first), y(batch.y + first), z(batch.z + first), w(batch.w + first) {}
+
+        // Stores the lanes to [first, first + YW3D_WIDE_LANES) of a register of a vertex batch.
+        void Store(Yw3dShaderRegisterBatch& batch, uint32_t first) const { x.Store(batch.x + first); y.Store(batch.y + first); z.Store(batch.z + first); w.Store(batch.w + first); }
+
+        // Returns or sets the value of a lane.
+        Vector4 GetLane(uint32_t lane) const { return Vector4(x.GetLane(lane), y.GetLane(lane), z.GetLane(lane), w.GetLane(lane)); }
+        void SetLane(uint32_t lane, const Vector4& v) { x.SetLane(lane, v.x); y.SetLane(lane, v.y); z.SetLane(lane, v.z); w.SetLane(lane, v.w); }
+
+        float4xN& operator +=(const float4xN& a) { x += a.x; y += a.y; z += a.z; w += a.w; return *this; }
+        float4xN& operator -=(const float4xN& a) { x -= a.x; y -= a.y; z -= a.z; w -= a.w; return *this; }
+        float4xN& operator *=(const float4xN& a) { x *= a.x; y *= a.y; z *= a.z; w *= a.w; return *this; }
+        float4xN& operator *=(const floatxN& a) { x *= a; y *= a; z *= a; w *= a; return *this; }
+        float4xN& operator *=(float f) { x *= f; y *= f; z *= f; w *= f; return *this; }
+    };
+
+    inline float2xN::float2xN(const float4xN& v) : x(v.x), y(v.y) {}
+    inline float3xN::float3xN(const float4xN& v) : x(v.x), y(v.y), z(v.z) {}
+
+    // float2xN operators.
+
+    inline float2xN operator +(const float2xN& a, const float2xN& b)
+    {
+        return float2xN(a.x + b.x, a.y + b.y);
+    }
+
+    inline float2xN operator +(const float2xN& a, const floatxN& b)
+    {
+        return float2xN(a.x + b, a.y + b);
+    }
+
+    inline float2xN operator +(const floatxN& a, const float2xN& b)
+    {
+        return float2xN(a + b.x, a + b.y);
+    }
+
+    inline float2xN operator +(const float2xN& a, float b)
+    {
+        return a + floatxN(b);
+    }
+
+    inline float2xN operator +(float a, const float2xN& b)
+    {
+        return floatxN(a) + b;
+    }
+
+    inline float2xN operator -(const float2xN& a, const float2xN& b)
+    {
+        return float2xN(a.x - b.x, a.y - b.y);
+    }
+
+    inline float2xN operator -(const float2xN& a, const floatxN& b)
+    {
+        return float2xN(a.x - b, a.y - b);
+    }
+
+    inline float2xN operator -(const floatxN& a, const float2xN& b)
+    {
+        return float2xN(a - b.x, a - b.y);
+    }
+
+    inline float2xN operator -(const float2xN& a, float b)
+    {
+        return a - floatxN(b);
+    }
+
+    inline float2xN operator -(float a, const float2xN& b)
+    {
+        return floatxN(a) - b;
+    }
+
+    inline float2xN operator *(const float2xN& a, const float2xN& b)
+    {
+        return float2xN(a.x * b.x, a.y * b.y);
+    }
+
+    inline float2xN operator *(const float2xN& a, const floatxN& b)
+    {
+        return float2xN(a.x * b, a.y * b);
+    }
+
+    inline float2xN operator *(const floatxN& a, const float2xN& b)
+    {
+        return float2xN(a * b.x, a * b.y);
+    }
+
+    inline float2xN operator *(const float2xN& a, float b)
+    {
+        return a * floatxN(b);
+    }
+
+    inline float2xN operator *(float a, const float2xN& b)
+    {
+        return floatxN(a) * b;
+    }
+
+    inline float2xN operator /(const float2xN& a, const float2xN& b)
+    {
+        return float2xN(a.x / b.x, a.y / b.y);
+    }
+
+    inline float2xN operator /(const float2xN& a, const floatxN& b)
+    {
+        return float2xN(a.x / b, a.y / b);
+    }
+
+    inline float2xN operator /(const floatxN& a, const float2xN& b)
+    {
+        return float2xN(a / b.x, a / b.y);
+    }
+
+    inline float2xN operator /(const float2xN& a, float b)
+    {
+        return a / floatxN(b);
+    }
+
+    inline float2xN operator /(float a, const float2xN& b)
+    {
+        return floatxN(a) / b;
+    }
+
+    inline float2xN operator -(const float2xN& a)
+    {
+        return float2xN(-a.x, -a.y);
+    }
+
+    // float3xN operators.
+
+    inline float3xN operator +(const float3xN& a, const float3xN& b)
+    {
+        return float3xN(a.x + b.x, a.y + b.y, a.z + b.z);
+    }
+
+    inline float3xN operator +(const float3xN& a, const floatxN& b)
+    {
+        return float3xN(a.x + b, a.y + b, a.z + b);
+    }
+
+    inline float3xN operator +(const floatxN& a, const float3xN& b)
+    {
+        return float3xN(a + b.x, a + b.y, a + b.z);
+    }
+
+    inline float3xN operator +(const float3xN& a, float b)
+    {
+        return a + floatxN(b);
+    }
+
+    inline float3xN operator +(float a, const float3xN& b)
+    {
+        return floatxN(a) + b;
+    }
+
+    inline float3xN operator -(const float3xN& a, const float3xN& b)
+    {
+        return float3xN(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+
+    inline float3xN operator -(const float3xN& a, const floatxN& b)
+    {
+        return float3xN(a.x - b, a.y - b, a.z - b);
+    }
+
+    inline float3xN operator -(const floatxN& a, const float3xN& b)
+    {
+        return float3xN(a - b.x, a - b.y, a - b.z);
+    }
+
+    inline float3xN operator -(const float3xN& a, float b)
+    {
+        return a - floatxN(b);
+    }
+
+    inline float3xN operator -(float a, const float3xN& b)
+    {
+        return floatxN(a) - b;
+    }
+
+    inline float3xN operator *(const float3xN& a, const float3xN& b)
+    {
+        return float3xN(a.x * b.x, a.y * b.y, a.z * b.z);
+    }
+
+    inline float3xN operator *(const float3xN& a, const floatxN& b)
+    {
+        return float3xN(a.x * b, a.y * b, a.z * b);
+    }
+
+    inline float3xN operator *(const floatxN& a, const float3xN& b)
+    {
+        return float3xN(a * b.x, a * b.y, a * b.z);
+    }
+
+    inline float3xN operator *(const float3xN& a, float b)
+    {
+        return a * floatxN(b);
+    }
+
+    inline float3xN operator *(float a, const float3xN& b)
+    {
+        return floatxN(a) * b;
+    }
+
+    inline float3xN operator /(const float3xN& a, const float3xN& b)
+    {
+        return float3xN(a.x / b.x, a.y / b.y, a.z / b.z);
+    }
+
+    inline float3xN operator /(const float3xN& a, const floatxN& b)
+    {
+        return float3xN(a.x / b, a.y / b, a.z / b);
+    }
+
+    inline float3xN operator /(const floatxN& a, const float3xN& b)
+    {
+        return float3xN(a / b.x, a / b.y, a / b.z);
+    }
+
+    inline float3xN operator /(const float3xN& a, float b)
+    {
+        return a / floatxN(b);
+    }
+
+    inline float3xN operator /(float a, const float3xN& b)
+    {
+        return floatxN(a) / b;
+    }
+
+    inline float3xN operator -(const float3xN& a)
+    {
+        return float3xN(-a.x, -a.y, -a.z);
+    }
+
+    // float4xN operators.
+
+    inline float4xN operator +(const float4xN& a, const float4xN& b)
+    {
+        return float4xN(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+    }
+
+    inline float4xN operator +(const float4xN& a, const floatxN& b)
+    {
+        return float4xN(a.x + b, a.y + b, a.z + b, a.w + b);
+    }
+
+    inline float4xN operator +(const floatxN& a, const float4xN& b)
+    {
+        return float4xN(a + b.x, a + b.y, a + b.z, a + b.w);
+    }
+
+    inline float4xN operator +(const float4xN& a, float b)
+    {
+        return a + floatxN(b);
+    }
+
+    inline float4xN operator +(float a, const float4xN& b)
+    {
+        return floatxN(a) + b;
+    }
+
+    inline float4xN operator -(const float4xN& a, const float4xN& b)
+    {
+        return float4xN(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+    }
+
+    inline float4xN operator -(const float4xN& a, const floatxN& b)
+    {
+        return float4xN(a.x - b, a.y - b, a.z - b, a.w - b);
+    }
+
+    inline float4xN operator -(const floatxN& a, const float4xN& b)
+    {
+        return float4xN(a - b.x, a - b.y, a - b.z, a - b.w);
+    }
+
+    inline float4xN operator -(const float4xN& a, float b)
+    {
+        return a - floatxN(b);
+    }
+
+    inline float4xN operator -(float a, const float4xN& b)
+    {
+        return floatxN(a) - b;
+    }
+
+    inline float4xN operator *(const float4xN& a, const float4xN& b)
+    {
+        return float4xN(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w);
+    }
+
+    inline float4xN operator *(const float4xN& a, const floatxN& b)
+    {
+        return float4xN(a.x * b, a.y * b, a.z * b, a.w * b);
+    }
+
+    inline float4xN operator *(const floatxN& a, const float4xN& b)
+    {
+        return float4xN(a * b.x, a * b.y, a * b.z, a * b.w);
+    }
+
+    inline float4xN operator *(const float4xN& a, float b)
+    {
+        return a * floatxN(b);
+    }
+
+    inline float4xN operator *(float a, const float4xN& b)
+    {
+        return floatxN(a) * b;
+    }
+
+    inline float4xN operator /(const float4xN& a, const float4xN& b)
+    {
+        return float4xN(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w);
+    }
+
+    inline float4xN operator /(const float4xN& a, const floatxN& b)
+    {
+        return float4xN(a.x / b, a.y / b, a.z / b, a.w / b);
+    }
+
+    inline float4xN operator /(const floatxN& a, const float4xN& b)
+    {
+        return float4xN(a / b.x, a / b.y, a / b.z, a / b.w);
+    }
+
+    inline float4xN operator /(const float4xN& a, float b)
+    {
+        return a / floatxN(b);
+    }
+
+    inline float4xN operator /(float a, const float4xN& b)
+    {
+        return floatxN(a) / b;
+    }
+
+    inline float4xN operator -(const float4xN& a)
+    {
+        return float4xN(-a.x, -a.y, -a.z, -a.w);
+    }
+
+    // Transforms each lane by a matrix, like float3 * float33.
+    inline float3xN operator *(const float3xN& v, const Matrix33& m)
+    {
+        return float3xN(
+            v.x * m._11 + v.y * m._21 + v.z * m._31,
+            v.x * m._12 + v.y * m._22 + v.z * m._32,
+            v.x * m._13 + v.y * m._23 + v.z * m._33
+        );
+    }
+
+    // Transforms each lane by a matrix, like float4 * float44.
+    inline float4xN operator *(const float4xN& v, const Matrix44& m)
+    {
+        return float4xN(
+            v.x * m._11 + v.y * m._21 + v.z * m._31 + v.w * m._41,
+            v.x * m._12 + v.y * m._22 + v.z * m._32 + v.w * m._42,
+            v.x * m._13 + v.y * m._23 + v.z * m._33 + v.w * m._43,
+            v.x * m._14 + v.y * m._24 + v.z * m._34 + v.w * m._44
+        );
+    }
+}
+
+#endif // !__YW_3D_SHADER_WIDE_H__
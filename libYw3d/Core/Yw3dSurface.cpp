@@ -2,35 +2,121 @@
 // YW Soft Renderer 3d surface class.
 
 #include "Yw3dSurface.h"
+#include "Yw3dAllocator.h"
+#include "Yw3dCpu.h"
 #include "Yw3dDevice.h"
+#include "Yw3dWorkerPool.h"
+#include <type_traits>
 
 namespace yw
 {
+    // A channel of an sRGB format, color channels are sRGB encoded bytes and the alpha channel is a linear unsigned normalized byte.
+    struct Yw3dSRGBChannel
+    {
+        uint8_t value;
+    };
+
+    // Table from 8-bit sRGB values to linear floats.
+    struct Yw3dSRGBDecodeTable
+    {
+        float values[256];
+
+        Yw3dSRGBDecodeTable()
+        {
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                values[i] = DecodeSRGB(DecodeUnorm8((uint8_t)i));
+            }
+        }
+    };
+
+    // The sRGB decoding table, built before any surface is sampled so lookups don't need a guard.
+    static const Yw3dSRGBDecodeTable s_SRGBDecodeTable;
+
+    // Converts a channel of a compact format to float.
+    // @param[in] value the stored channel.
+    // @param[in] channel index of the channel, only used by sRGB formats to keep alpha linear.
+    static inline float UnpackChannel(const uint8_t value, const uint32_t /*channel*/)
+    {
+        return DecodeUnorm8(value);
+    }
+
+    static inline float UnpackChannel(const uint16_t value, const uint32_t /*channel*/)
+    {
+        return DecodeHalf(value);
+    }
+
+    static inline float UnpackChannel(const Yw3dSRGBChannel value, const uint32_t channel)
+    {
+        return (channel < 3) ? s_SRGBDecodeTable.values[value.value] : DecodeUnorm8(value.value);
+    }
+
+    // Converts a float to a channel of a compact format.
+    // @param[in] value the float value.
+    // @param[out] outValue receives the stored channel.
+    // @param[in] channel index of the channel, only used by sRGB formats to keep alpha linear.
+    static inline void PackChannel(const float value, uint8_t& outValue, const uint32_t /*channel*/)
+    {
+        outValue = EncodeUnorm8(value);
+    }
+
+    static inline void PackChannel(const float value, uint16_t& outValue, const uint32_t /*channel*/)
+    {
+        outValue = EncodeHalf(value);
+    }
+
+    static inline void PackChannel(const float value, Yw3dSRGBChannel& outValue, const uint32_t channel)
+    {
+        outValue.value = EncodeUnorm8((channel < 3) ? EncodeSRGB(value) : value);
+    }
+
     Yw3dSurface::Yw3dSurface(Yw3dDevice* device) :
         m_Device(device), 
+        m_SimdKernels(device->GetSimdKernels()), 
         m_Format(Yw3d_FMT_R32G32B32A32F), 
         m_Width(0), 
         m_Height(0), 
         m_WidthMin1(0), 
         m_HeightMin1(0), 
+        m_Layout(Yw3d_SL_Linear), 
+        m_TilesPerRow(0), 
+        m_FastClearTiles(nullptr), 
+        m_FastClearTilesPerRow(0), 
+        m_FastClearTileRows(0), 
+        m_FastClearPendingTiles(0), 
         m_LockedComplete(false), 
         m_PartialLockData(nullptr), 
-        m_Data(nullptr)
+        m_Data(nullptr), 
+        m_StorageSize(0), 
+        m_DataOwner(nullptr)
     {
         // Note: cannot add a reference to parent or the presenttarget will never be freed?
         m_Device->AddRef();
+
+        memset(m_FastClearValue, 0, sizeof(m_FastClearValue));
     }
 
     Yw3dSurface::~Yw3dSurface()
     {
-        YW_SAFE_DELETE_ARRAY(m_PartialLockData); // somebody might have forgotten to unlock the surface ;)
-        YW_SAFE_DELETE_ARRAY(m_Data);
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_PartialLockData); // somebody might have forgotten to unlock the surface ;)
+        YW_SAFE_DELETE_ARRAY(m_FastClearTiles);
+
+        // Data used in place belongs to its owner.
+        if (nullptr != m_DataOwner)
+        {
+            m_Data = nullptr;
+            YW_SAFE_RELEASE(m_DataOwner);
+        }
+        else
+        {
+            YW3D_SAFE_FREE(m_Device->GetAllocator(), m_Data);
+        }
 
         /// Note: see note in constructor.
         YW_SAFE_RELEASE(m_Device);
     }
 
-    Yw3dResult Yw3dSurface::Create(const uint32_t width, const uint32_t height, const Yw3dFormat format)
+    Yw3dResult Yw3dSurface::Create(const uint32_t width, const uint32_t height, const Yw3dFormat format, const Yw3dSurfaceLayout layout, void* data, const size_t dataSize, IBase* dataOwner)
     {
         if ((0 == width) || (0 == height))
         {
@@ -38,83 +124,210 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
-        uint32_t floatCount = 0;
+        uint32_t pixelBytes = 0;
         switch (format)
         {
         case Yw3d_FMT_R32F:
-            floatCount = 1;
+            pixelBytes = sizeof(float) * 1;
             break;
         case Yw3d_FMT_R32G32F:
-            floatCount = 2;
+            pixelBytes = sizeof(float) * 2;
             break;
         case Yw3d_FMT_R32G32B32F:
-            floatCount = 3;
+            pixelBytes = sizeof(float) * 3;
             break;
         case Yw3d_FMT_R32G32B32A32F:
-            floatCount = 4;
+            pixelBytes = sizeof(float) * 4;
+            break;
+        case Yw3d_FMT_D24S8:
+            pixelBytes = sizeof(uint32_t);
+            break;
+        case Yw3d_FMT_D16:
+            pixelBytes = sizeof(uint16_t);
+            break;
+        case Yw3d_FMT_BC1:
+        case Yw3d_FMT_BC3:
+        case Yw3d_FMT_BC5:
+        case Yw3d_FMT_BC6H:
+            // Bytes of a 4x4 block.
+            pixelBytes = GetCompressedBlockBytes(format);
+            break;
+        case Yw3d_FMT_R8:
+        case Yw3d_FMT_R8G8:
+        case Yw3d_FMT_R8G8B8:
+        case Yw3d_FMT_R8G8B8A8:
+            pixelBytes = sizeof(uint8_t) * (format - Yw3d_FMT_R8 + 1);
+            break;
+        case Yw3d_FMT_R16F:
+        case Yw3d_FMT_R16G16F:
+        case Yw3d_FMT_R16G16B16F:
+        case Yw3d_FMT_R16G16B16A16F:
+            pixelBytes = sizeof(uint16_t) * (format - Yw3d_FMT_R16F + 1);
+            break;
+        case Yw3d_FMT_R8G8B8_SRGB:
+        case Yw3d_FMT_R8G8B8A8_SRGB:
+            pixelBytes = sizeof(Yw3dSRGBChannel) * (format - Yw3d_FMT_R8G8B8_SRGB + 3);
             break;
         default:
             LOGE(_T("Yw3dSurface::Create: invalid format specified.\n"));
             return Yw3d_E_InvalidFormat;
         }
 
+        if ((Yw3d_SL_Linear != layout) && ((Yw3d_SL_Tiled4x4 != layout) || ((format > Yw3d_FMT_R32G32B32A32F) && !IsCompactFormat(format))))
+        {
+            LOGE(_T("Yw3dSurface::Create: invalid layout specified.\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
         m_Format = format;
         m_Width = width;
         m_Height = height;
         m_WidthMin1 = width - 1;
         m_HeightMin1 = height - 1;
+        m_Layout = layout;
+
+        // Tiled surfaces are padded to whole tiles.
+        uint32_t pixelCount = m_Width * m_Height;
+        if (Yw3d_SL_Tiled4x4 == m_Layout)
+        {
+            m_TilesPerRow = (m_Width + 3) >> 2;
+            pixelCount = m_TilesPerRow * ((m_Height + 3) >> 2) * 16;
+        }
+        else if (IsBlockCompressedFormat(m_Format))
+        {
+            // Block compressed surfaces are padded to whole blocks, pixelBytes are the bytes of a block.
+            m_TilesPerRow = (m_Width + 3) >> 2;
+            pixelCount = m_TilesPerRow * ((m_Height + 3) >> 2);
+        }
+
+        m_StorageSize = (size_t)pixelCount * pixelBytes;
+        if ((nullptr != data) && (dataSize != m_StorageSize))
+        {
+            LOGE(_T("Yw3dSurface::Create: size of initial data doesn't match the surface.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if ((nullptr != data) && (nullptr != dataOwner))
+        {
+            // Data used in place has to meet the alignment of allocated storage for SIMD access.
+            if (0 != ((size_t)data & (YW3D_ALLOCATION_ALIGNMENT - 1)))
+            {
+                LOGE(_T("Yw3dSurface::Create: data used in place is not aligned.\n"));
+                return Yw3d_E_InvalidParameters;
+            }
+
+            m_Data = (float*)data;
+            m_DataOwner = dataOwner;
+            m_DataOwner->AddRef();
+            return Yw3d_S_OK;
+        }
 
-        m_Data = new float[m_Width * m_Height * floatCount];
+        // Storage is aligned for SIMD access, surfaces of the same size reuse pooled storage.
+        m_Data = (float*)m_Device->GetAllocator()->Allocate(m_StorageSize);
         if (nullptr == m_Data)
         {
             LOGE(_T("Yw3dSurface::Create: out of memory, cannot create surface.\n"));
             return Yw3d_E_OutOfMemory;
         }
 
+        if (nullptr != data)
+        {
+            memcpy(m_Data, data, m_StorageSize);
+        }
+
         return Yw3d_S_OK;
     }
 
-    void Yw3dSurface::SamplePoint(Vector4& outColor, const float u, const float v)
+    void Yw3dSurface::SamplePoint(Vector4& outColor, const float u, const float v) const
     {
         const float fX = u * m_WidthMin1;
         const float fY = v * m_HeightMin1;
 
         const uint32_t pixelX = ftol(fX);
         const uint32_t pixelY = ftol(fY);
+        const uint32_t pixelIndex = GetPixelIndex(pixelX, pixelY);
 
         switch (m_Format)
         {
         case Yw3d_FMT_R32F:
             {
-                const float* pixel = &m_Data[(pixelY * m_Width + pixelX) * 1];
+                const float* pixel = &m_Data[pixelIndex * 1];
                 outColor.Set(*pixel, 0.0f, 0.0f, 1.0f);
             }
             break;
         case Yw3d_FMT_R32G32F:
             {
-                const Vector2* pixel = (const Vector2*)&m_Data[(pixelY * m_Width + pixelX) * 2];
+                const Vector2* pixel = (const Vector2*)&m_Data[pixelIndex * 2];
                 outColor.Set(pixel->x, pixel->y, 0.0f, 1.0f);
             }
             break;
         case Yw3d_FMT_R32G32B32F:
             {
-                const Vector3* pixel = (const Vector3*)&m_Data[(pixelY * m_Width + pixelX) * 3];
+                const Vector3* pixel = (const Vector3*)&m_Data[pixelIndex * 3];
                 outColor.Set(pixel->x, pixel->y, pixel->z, 1.0f);
             }
             break;
         case Yw3d_FMT_R32G32B32A32F:
             {
-                const Vector4* pixel = (const Vector4*)&m_Data[(pixelY * m_Width + pixelX) * 4];
+                const Vector4* pixel = (const Vector4*)&m_Data[pixelIndex * 4];
                 outColor = *pixel;
             }
             break;
+        case Yw3d_FMT_D24S8:
+            {
+                const uint32_t pixel = ((const uint32_t*)m_Data)[pixelIndex];
+                outColor.Set(DecodeDepth24(pixel), (float)(pixel & YW3D_D24S8_STENCIL_MASK), 0.0f, 1.0f);
+            }
+            break;
+        case Yw3d_FMT_D16:
+            {
+                const uint16_t pixel = ((const uint16_t*)m_Data)[pixelIndex];
+                outColor.Set(DecodeDepth16(pixel), 0.0f, 0.0f, 1.0f);
+            }
+            break;
+        case Yw3d_FMT_BC1:
+        case Yw3d_FMT_BC3:
+        case Yw3d_FMT_BC5:
+        case Yw3d_FMT_BC6H:
+            DecodePixel(pixelX, pixelY, outColor);
+            break;
+        case Yw3d_FMT_R8:
+            SamplePointCompact<uint8_t, 1>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R8G8:
+            SamplePointCompact<uint8_t, 2>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R8G8B8:
+            SamplePointCompact<uint8_t, 3>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R8G8B8A8:
+            SamplePointCompact<uint8_t, 4>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R16F:
+            SamplePointCompact<uint16_t, 1>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R16G16F:
+            SamplePointCompact<uint16_t, 2>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R16G16B16F:
+            SamplePointCompact<uint16_t, 3>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R16G16B16A16F:
+            SamplePointCompact<uint16_t, 4>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R8G8B8_SRGB:
+            SamplePointCompact<Yw3dSRGBChannel, 3>(outColor, pixelIndex);
+            break;
+        case Yw3d_FMT_R8G8B8A8_SRGB:
+            SamplePointCompact<Yw3dSRGBChannel, 4>(outColor, pixelIndex);
+            break;
         default:
             // This can not happen.
             break;
         }
     }
 
-    void Yw3dSurface::SampleLinear(Vector4& outColor, const float u, const float v)
+    void Yw3dSurface::SampleLinear(Vector4& outColor, const float u, const float v) const
     {
         const float fX = u * m_WidthMin1;
         const float fY = v * m_HeightMin1;
@@ -134,7 +347,23 @@ namespace yw
             pixelY2 = m_HeightMin1;
         }
 
-        const uint32_t pixelRows[2] = {pixelY * m_Width, pixelY2 * m_Width};
+        // Indices of the four pixels: top-left, top-right, bottom-left and bottom-right.
+        uint32_t pixelIndices[4];
+        if (Yw3d_SL_Linear == m_Layout)
+        {
+            const uint32_t pixelRows[2] = {pixelY * m_Width, pixelY2 * m_Width};
+            pixelIndices[0] = pixelRows[0] + pixelX;
+            pixelIndices[1] = pixelRows[0] + pixelX2;
+            pixelIndices[2] = pixelRows[1] + pixelX;
+            pixelIndices[3] = pixelRows[1] + pixelX2;
+        }
+        else
+        {
+            pixelIndices[0] = GetPixelIndex(pixelX, pixelY);
+            pixelIndices[1] = GetPixelIndex(pixelX2, pixelY);
+            pixelIndices[2] = GetPixelIndex(pixelX, pixelY2);
+            pixelIndices[3] = GetPixelIndex(pixelX2, pixelY2);
+        }
         const float pixelInterpoltaions[2] = {fX - pixelX, fY - pixelY};
 
         switch (m_Format)
@@ -142,8 +371,8 @@ namespace yw
         case Yw3d_FMT_R32F:
             {
                 float colorRows[2] = {0.0f, 0.0f};
-                colorRows[0] = Lerp(m_Data[pixelRows[0] + pixelX], m_Data[pixelRows[0] + pixelX2], pixelInterpoltaions[0]);
-                colorRows[1] = Lerp(m_Data[pixelRows[1] + pixelX], m_Data[pixelRows[1] + pixelX2], pixelInterpoltaions[0]);
+                colorRows[0] = Lerp(m_Data[pixelIndices[0]], m_Data[pixelIndices[1]], pixelInterpoltaions[0]);
+                colorRows[1] = Lerp(m_Data[pixelIndices[2]], m_Data[pixelIndices[3]], pixelInterpoltaions[0]);
 
                 const float finalColor = Lerp(colorRows[0], colorRows[1], pixelInterpoltaions[1]);
                 outColor.Set(finalColor, 0.0f, 0.0f, 1.0f);
@@ -154,8 +383,8 @@ namespace yw
                 const Vector2* pixelData = (const Vector2*)m_Data;
 
                 Vector2 colorRows[2];
-                Vector2Lerp(colorRows[0], pixelData[pixelRows[0] + pixelX], pixelData[pixelRows[0] + pixelX2], pixelInterpoltaions[0]);
-                Vector2Lerp(colorRows[1], pixelData[pixelRows[1] + pixelX], pixelData[pixelRows[1] + pixelX2], pixelInterpoltaions[0]);
+                Vector2Lerp(colorRows[0], pixelData[pixelIndices[0]], pixelData[pixelIndices[1]], pixelInterpoltaions[0]);
+                Vector2Lerp(colorRows[1], pixelData[pixelIndices[2]], pixelData[pixelIndices[3]], pixelInterpoltaions[0]);
 
                 Vector2 finalColor;
                 Vector2Lerp(finalColor, colorRows[0], colorRows[1], pixelInterpoltaions[1]);
@@ -167,8 +396,8 @@ namespace yw
                 const Vector3* pixelData = (const Vector3*)m_Data;
 
                 Vector3 colorRows[2];
-                Vector3Lerp(colorRows[0], pixelData[pixelRows[0] + pixelX], pixelData[pixelRows[0] + pixelX2], pixelInterpoltaions[0]);
-                Vector3Lerp(colorRows[1], pixelData[pixelRows[1] + pixelX], pixelData[pixelRows[1] + pixelX2], pixelInterpoltaions[0]);
+                Vector3Lerp(colorRows[0], pixelData[pixelIndices[0]], pixelData[pixelIndices[1]], pixelInterpoltaions[0]);
+                Vector3Lerp(colorRows[1], pixelData[pixelIndices[2]], pixelData[pixelIndices[3]], pixelInterpoltaions[0]);
 
                 Vector3 finalColor;
                 Vector3Lerp(finalColor, colorRows[0], colorRows[1], pixelInterpoltaions[1]);
@@ -177,22 +406,264 @@ namespace yw
             break;
         case Yw3d_FMT_R32G32B32A32F:
             {
-                const Vector4* pixelData = (const Vector4*)m_Data;
+                const float* pixels[4] = {m_Data + pixelIndices[0] * 4, m_Data + pixelIndices[1] * 4, m_Data + pixelIndices[2] * 4, m_Data + pixelIndices[3] * 4};
+                m_SimdKernels->filterBilinear4(&outColor.x, pixels, pixelInterpoltaions[0], pixelInterpoltaions[1]);
+            }
+            break;
+        case Yw3d_FMT_D24S8:
+            {
+                // Only depth is filtered, stencil is taken from the nearest pixel.
+                const uint32_t* pixelData = (const uint32_t*)m_Data;
+
+                float depthRows[2] = {0.0f, 0.0f};
+                depthRows[0] = Lerp(DecodeDepth24(pixelData[pixelIndices[0]]), DecodeDepth24(pixelData[pixelIndices[1]]), pixelInterpoltaions[0]);
+                depthRows[1] = Lerp(DecodeDepth24(pixelData[pixelIndices[2]]), DecodeDepth24(pixelData[pixelIndices[3]]), pixelInterpoltaions[0]);
+
+                const float finalDepth = Lerp(depthRows[0], depthRows[1], pixelInterpoltaions[1]);
+                outColor.Set(finalDepth, (float)(pixelData[pixelIndices[0]] & YW3D_D24S8_STENCIL_MASK), 0.0f, 1.0f);
+            }
+            break;
+        case Yw3d_FMT_D16:
+            {
+                const uint16_t* pixelData = (const uint16_t*)m_Data;
 
-                Vector4 colorRows[2];
-                Vector4Lerp(colorRows[0], pixelData[pixelRows[0] + pixelX], pixelData[pixelRows[0] + pixelX2], pixelInterpoltaions[0]);
-                Vector4Lerp(colorRows[1], pixelData[pixelRows[1] + pixelX], pixelData[pixelRows[1] + pixelX2], pixelInterpoltaions[0]);
-                Vector4Lerp(outColor, colorRows[0], colorRows[1], pixelInterpoltaions[1]);
+                float depthRows[2] = {0.0f, 0.0f};
+                depthRows[0] = Lerp(DecodeDepth16(pixelData[pixelIndices[0]]), DecodeDepth16(pixelData[pixelIndices[1]]), pixelInterpoltaions[0]);
+                depthRows[1] = Lerp(DecodeDepth16(pixelData[pixelIndices[2]]), DecodeDepth16(pixelData[pixelIndices[3]]), pixelInterpoltaions[0]);
+
+                const float finalDepth = Lerp(depthRows[0], depthRows[1], pixelInterpoltaions[1]);
+                outColor.Set(finalDepth, 0.0f, 0.0f, 1.0f);
+            }
+            break;
+        case Yw3d_FMT_BC1:
+        case Yw3d_FMT_BC3:
+        case Yw3d_FMT_BC5:
+        case Yw3d_FMT_BC6H:
+            {
+                // Decode the pixels, the indices above are not used by the block layout.
+                Vector4 pixels[4];
+                DecodePixel(pixelX, pixelY, pixels[0]);
+                DecodePixel(pixelX2, pixelY, pixels[1]);
+                DecodePixel(pixelX, pixelY2, pixels[2]);
+                DecodePixel(pixelX2, pixelY2, pixels[3]);
+
+                const float* pixelFloats[4] = {&pixels[0].x, &pixels[1].x, &pixels[2].x, &pixels[3].x};
+                m_SimdKernels->filterBilinear4(&outColor.x, pixelFloats, pixelInterpoltaions[0], pixelInterpoltaions[1]);
             }
             break;
+        case Yw3d_FMT_R8:
+            SampleLinearCompact<uint8_t, 1>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R8G8:
+            SampleLinearCompact<uint8_t, 2>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R8G8B8:
+            SampleLinearCompact<uint8_t, 3>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R8G8B8A8:
+            SampleLinearCompact<uint8_t, 4>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R16F:
+            SampleLinearCompact<uint16_t, 1>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R16G16F:
+            SampleLinearCompact<uint16_t, 2>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R16G16B16F:
+            SampleLinearCompact<uint16_t, 3>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R16G16B16A16F:
+            SampleLinearCompact<uint16_t, 4>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R8G8B8_SRGB:
+            SampleLinearCompact<Yw3dSRGBChannel, 3>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
+        case Yw3d_FMT_R8G8B8A8_SRGB:
+            SampleLinearCompact<Yw3dSRGBChannel, 4>(outColor, pixelIndices, pixelInterpoltaions);
+            break;
         default:
             // This can not happen.
             break;
         }
     }
 
+    template <class StorageType, uint32_t channels>
+    void Yw3dSurface::SamplePointCompact(Vector4& outColor, const uint32_t pixelIndex) const
+    {
+        const StorageType* pixel = (const StorageType*)m_Data + pixelIndex * channels;
+        float color[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+        for (uint32_t c = 0; c < channels; c++)
+        {
+            color[c] = UnpackChannel(pixel[c], c);
+        }
+
+        outColor.Set(color[0], color[1], color[2], color[3]);
+    }
+
+    template <class StorageType, uint32_t channels>
+    void Yw3dSurface::SampleLinearCompact(Vector4& outColor, const uint32_t* pixelIndices, const float* interpolations) const
+    {
+        const StorageType* pixelData = (const StorageType*)m_Data;
+        float color[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+
+    #ifdef YW3D_SSE2
+        if ((std::is_same<StorageType, uint8_t>::value || std::is_same<StorageType, Yw3dSRGBChannel>::value) && (4 == channels))
+        {
+            __m128 pixels[4];
+            if (std::is_same<StorageType, uint8_t>::value)
+            {
+                // Widen the bytes of each pixel to floats, the result is scaled to [0, 1] once after filtering.
+                const __m128i zero = _mm_setzero_si128();
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    int32_t pixelBits = 0;
+                    memcpy(&pixelBits, pixelData + pixelIndices[i] * 4, sizeof(int32_t));
+                    pixels[i] = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixelBits), zero), zero));
+                }
+            }
+            else
+            {
+                // Decode the color channels of each pixel to linear before filtering, alpha is scaled after filtering like above.
+                const float* decodeTable = s_SRGBDecodeTable.values;
+                for (uint32_t i = 0; i < 4; i++)
+                {
+                    const uint8_t* pixel = (const uint8_t*)(pixelData + pixelIndices[i] * 4);
+                    pixels[i] = _mm_setr_ps(decodeTable[pixel[0]], decodeTable[pixel[1]], decodeTable[pixel[2]], (float)pixel[3]);
+                }
+            }
+
+            const __m128 weightX = _mm_set1_ps(interpolations[0]);
+            const __m128 top = _mm_add_ps(pixels[0], _mm_mul_ps(_mm_sub_ps(pixels[1], pixels[0]), weightX));
+            const __m128 bottom = _mm_add_ps(pixels[2], _mm_mul_ps(_mm_sub_ps(pixels[3], pixels[2]), weightX));
+            const __m128 filtered = _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(interpolations[1])));
+            const __m128 scale = std::is_same<StorageType, uint8_t>::value ? _mm_set1_ps(1.0f / 255.0f) : _mm_setr_ps(1.0f, 1.0f, 1.0f, 1.0f / 255.0f);
+            _mm_storeu_ps(color, _mm_mul_ps(filtered, scale));
+            outColor.Set(color[0], color[1], color[2], color[3]);
+            return;
+        }
+    #endif
+
+        // The four pixels: top-left, top-right, bottom-left and bottom-right.
+        const StorageType* pixels[4] =
+        {
+            pixelData + pixelIndices[0] * channels, pixelData + pixelIndices[1] * channels,
+            pixelData + pixelIndices[2] * channels, pixelData + pixelIndices[3] * channels
+        };
+
+        for (uint32_t c = 0; c < channels; c++)
+        {
+            const float top = Lerp(UnpackChannel(pixels[0][c], c), UnpackChannel(pixels[1][c], c), interpolations[0]);
+            const float bottom = Lerp(UnpackChannel(pixels[2][c], c), UnpackChannel(pixels[3][c], c), interpolations[0]);
+            color[c] = Lerp(top, bottom, interpolations[1]);
+        }
+
+        outColor.Set(color[0], color[1], color[2], color[3]);
+    }
+
+    // Storage type and number of channels of the compact formats, used to instantiate SampleFormat().
+    template <Yw3dFormat format>
+    struct Yw3dCompactFormat;
+
+    #define YW3D_COMPACT_FORMAT(format, storageType, channelCount) \
+        template <> \
+        struct Yw3dCompactFormat<format> \
+        { \
+            typedef storageType StorageType; \
+            static const uint32_t channels = channelCount; \
+        };
+
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R8, uint8_t, 1)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R8G8, uint8_t, 2)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R8G8B8, uint8_t, 3)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R8G8B8A8, uint8_t, 4)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R16F, uint16_t, 1)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R16G16F, uint16_t, 2)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R16G16B16F, uint16_t, 3)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R16G16B16A16F, uint16_t, 4)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R8G8B8_SRGB, Yw3dSRGBChannel, 3)
+    YW3D_COMPACT_FORMAT(Yw3d_FMT_R8G8B8A8_SRGB, Yw3dSRGBChannel, 4)
+
+    #undef YW3D_COMPACT_FORMAT
+
+    template <Yw3dFormat format, bool linearFilter>
+    void Yw3dSurface::SampleFormat(Vector4& outColor, const float u, const float v, std::false_type) const
+    {
+        typedef typename Yw3dCompactFormat<format>::StorageType StorageType;
+        const uint32_t channels = Yw3dCompactFormat<format>::channels;
+
+        // u and v are in [0,1], so truncation is the same as floor.
+        const float fX = u * m_WidthMin1;
+        const float fY = v * m_HeightMin1;
+        const uint32_t pixelX = (uint32_t)fX;
+        const uint32_t pixelY = (uint32_t)fY;
+
+        if (!linearFilter)
+        {
+            SamplePointCompact<StorageType, channels>(outColor, GetPixelIndex(pixelX, pixelY));
+            return;
+        }
+
+        const uint32_t pixelX2 = (pixelX < m_WidthMin1) ? (pixelX + 1) : m_WidthMin1;
+        const uint32_t pixelY2 = (pixelY < m_HeightMin1) ? (pixelY + 1) : m_HeightMin1;
+
+        // Indices of the four pixels: top-left, top-right, bottom-left and bottom-right.
+        const uint32_t pixelIndices[4] = {GetPixelIndex(pixelX, pixelY), GetPixelIndex(pixelX2, pixelY), GetPixelIndex(pixelX, pixelY2), GetPixelIndex(pixelX2, pixelY2)};
+        const float pixelInterpoltaions[2] = {fX - (float)pixelX, fY - (float)pixelY};
+        SampleLinearCompact<StorageType, channels>(outColor, pixelIndices, pixelInterpoltaions);
+    }
+
+    #define YW3D_INSTANTIATE_SAMPLE_FORMAT(format) \
+        template void Yw3dSurface::SampleFormat<format, false>(Vector4&, const float, const float, std::false_type) const; \
+        template void Yw3dSurface::SampleFormat<format, true>(Vector4&, const float, const float, std::false_type) const;
+
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R8)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R8G8)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R8G8B8)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R8G8B8A8)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R16F)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R16G16F)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R16G16B16F)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R16G16B16A16F)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R8G8B8_SRGB)
+    YW3D_INSTANTIATE_SAMPLE_FORMAT(Yw3d_FMT_R8G8B8A8_SRGB)
+
+    #undef YW3D_INSTANTIATE_SAMPLE_FORMAT
+
+    void Yw3dSurface::PackPixel(const Vector4& color, void* outPixel) const
+    {
+        const float channels[4] = {color.r, color.g, color.b, color.a};
+        const uint32_t channelCount = GetFormatChannels();
+        for (uint32_t c = 0; c < channelCount; c++)
+        {
+            if (IsSRGBFormat(m_Format))
+            {
+                PackChannel(channels[c], ((Yw3dSRGBChannel*)outPixel)[c], c);
+            }
+            else if (m_Format < Yw3d_FMT_R16F)
+            {
+                PackChannel(channels[c], ((uint8_t*)outPixel)[c], c);
+            }
+            else
+            {
+                PackChannel(channels[c], ((uint16_t*)outPixel)[c], c);
+            }
+        }
+    }
+
     Yw3dResult Yw3dSurface::Clear(const Vector4& color, const Yw3dRect* rect)
     {
+        // Packed depth formats take depth from the red channel and stencil from the green channel.
+        if ((Yw3d_FMT_D24S8 == m_Format) || (Yw3d_FMT_D16 == m_Format))
+        {
+            return ClearDepthStencil(color.r, (uint32_t)color.g, true, Yw3d_FMT_D24S8 == m_Format, rect);
+        }
+
+        if (IsBlockCompressedFormat(m_Format))
+        {
+            LOGE(_T("Yw3dSurface::Clear: block compressed surfaces can't be cleared.\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
         Yw3dRect clearRect;
         if (nullptr != rect)
         {
@@ -220,6 +691,40 @@ namespace yw
             clearRect.bottom = m_Height;
         }
 
+        // The raw pixel value, compact formats hold the converted color.
+        float clearPixel[4] = {color.r, color.g, color.b, color.a};
+        if (IsCompactFormat(m_Format))
+        {
+            PackPixel(color, clearPixel);
+        }
+
+        // Tiled surfaces are cleared in place through the tiled address, a lock would work on a linear copy.
+        if (Yw3d_SL_Linear != m_Layout)
+        {
+            if (m_LockedComplete || (nullptr != m_PartialLockData))
+            {
+                LOGE(_T("Yw3dSurface::Clear: surface is locked.\n"));
+                return Yw3d_E_InvalidState;
+            }
+
+            const uint32_t pixelBytes = GetFormatBytes();
+            for (uint32_t y = clearRect.top; y < clearRect.bottom; y++)
+            {
+                for (uint32_t x = clearRect.left; x < clearRect.right; x++)
+                {
+                    memcpy((uint8_t*)m_Data + GetPixelIndex(x, y) * pixelBytes, clearPixel, pixelBytes);
+                }
+            }
+
+            return Yw3d_S_OK;
+        }
+
+        // Only mark the covered tiles as cleared if fast clears are enabled.
+        if (nullptr != m_FastClearTiles)
+        {
+            return FastClear(clearPixel, clearRect);
+        }
+
         // Lock surface buffer first.
         float* surfaceData = nullptr;
         Yw3dResult lockResult = LockRect((void**)&surfaceData, nullptr);
@@ -228,71 +733,425 @@ namespace yw
             return lockResult;
         }
 
+        // Clear surface data with specified color.
+        switch (m_Format)
+        {
+        case Yw3d_FMT_R32F:
+        case Yw3d_FMT_R32G32F:
+        case Yw3d_FMT_R32G32B32F:
+        case Yw3d_FMT_R32G32B32A32F:
+        case Yw3d_FMT_R8:
+        case Yw3d_FMT_R8G8:
+        case Yw3d_FMT_R8G8B8:
+        case Yw3d_FMT_R8G8B8A8:
+        case Yw3d_FMT_R16F:
+        case Yw3d_FMT_R16G16F:
+        case Yw3d_FMT_R16G16B16F:
+        case Yw3d_FMT_R16G16B16A16F:
+        case Yw3d_FMT_R8G8B8_SRGB:
+        case Yw3d_FMT_R8G8B8A8_SRGB:
+            for (uint32_t y = clearRect.top; y < clearRect.bottom; y++)
+            {
+                FillPixels(clearRect.left, y, clearRect.right - clearRect.left, clearPixel);
+            }
+            break;
+        default:
+            // This can not happen.
+            LOGE(_T("Yw3dSurface::Clear: invalid surface format.\n"));
+            UnlockRect();
+            return Yw3d_E_InvalidFormat;
+        }
+
+        // Unlock surface buffer.
+        UnlockRect();
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dSurface::ClearDepthStencil(const float depth, const uint32_t stencil, const bool clearDepth, const bool clearStencil, const Yw3dRect* rect)
+    {
+        Yw3dRect clearRect;
+        if (nullptr != rect)
+        {
+            // Check validation of rect.
+            if ((rect->right > m_Width) || (rect->bottom > m_Height) || (rect->left < 0) || (rect->top < 0))
+            {
+                LOGE(_T("Yw3dSurface::ClearDepthStencil: clear-rectangle exceeds surface's dimensions.\n"));
+                return Yw3d_E_InvalidParameters;
+            }
+
+            if ((rect->left >= rect->right) || (rect->top >= rect->bottom))
+            {
+                LOGE(_T("Yw3dSurface::ClearDepthStencil: invalid rectangle specified!\n"));
+                return Yw3d_E_InvalidParameters;
+            }
+
+            clearRect = *rect;
+        }
+        else
+        {
+            // Get the whole region.
+            clearRect.left = 0;
+            clearRect.top = 0;
+            clearRect.right = m_Width;
+            clearRect.bottom = m_Height;
+        }
+
+        if ((Yw3d_FMT_R32F == m_Format) && clearDepth && clearStencil)
+        {
+            LOGE(_T("Yw3dSurface::ClearDepthStencil: a Yw3d_FMT_R32F surface can not hold both depth and stencil.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        // Nothing to clear, a Yw3d_FMT_D16 surface has no stencil bits.
+        if ((!clearDepth && !clearStencil) || ((Yw3d_FMT_D16 == m_Format) && !clearDepth))
+        {
+            return Yw3d_S_OK;
+        }
+
+        // A fast clear needs the whole pixel value, a packed surface keeping one of its parts is cleared directly.
+        if ((nullptr != m_FastClearTiles) && ((Yw3d_FMT_D24S8 != m_Format) || (clearDepth && clearStencil)))
+        {
+            uint32_t pixel = 0;
+            switch (m_Format)
+            {
+            case Yw3d_FMT_R32F:
+                if (clearStencil)
+                {
+                    pixel = stencil;
+                }
+                else
+                {
+                    memcpy(&pixel, &depth, sizeof(uint32_t));
+                }
+                break;
+            case Yw3d_FMT_D24S8:
+                pixel = EncodeDepth24(depth) | (stencil & YW3D_D24S8_STENCIL_MASK);
+                break;
+            case Yw3d_FMT_D16:
+                {
+                    const uint16_t depth16 = EncodeDepth16(depth);
+                    memcpy(&pixel, &depth16, sizeof(uint16_t));
+                }
+                break;
+            default:
+                LOGE(_T("Yw3dSurface::ClearDepthStencil: surface is not a depth or stencil surface.\n"));
+                return Yw3d_E_InvalidFormat;
+            }
+
+            return FastClear(&pixel, clearRect);
+        }
+
+        // Lock surface buffer first.
+        void* surfaceData = nullptr;
+        Yw3dResult lockResult = LockRect(&surfaceData, nullptr);
+        if (YW3D_FAILED(lockResult))
+        {
+            return lockResult;
+        }
+
         // Calculate row stride.
         const uint32_t rowStride = (m_Width - clearRect.right) + clearRect.left;
 
-        // Clear surface data with specified color.
         switch (m_Format)
         {
         case Yw3d_FMT_R32F:
             {
-                float* curData = &m_Data[clearRect.top * m_Width + clearRect.left];
+                // Depth is stored as float, stencil as the raw bits of an uint32_t.
+                uint32_t value = stencil;
+                if (!clearStencil)
+                {
+                    memcpy(&value, &depth, sizeof(uint32_t));
+                }
+
+                uint32_t* curData = &((uint32_t*)m_Data)[clearRect.top * m_Width + clearRect.left];
                 for (uint32_t y = clearRect.top; y < clearRect.bottom; y++, curData += rowStride)
                 {
-                    for (uint32_t x = clearRect.left; x < clearRect.right; x++, curData++)
-                    {
-                        *curData = color.r;
-                    }
+                    for (uint32_t x = clearRect.left; x < clearRect.right; x++, curData++)
+                    {
+                        *curData = value;
+                    }
+                }
+            }
+            break;
+        case Yw3d_FMT_D24S8:
+            {
+                const uint32_t keepMask = (clearDepth ? 0 : ~YW3D_D24S8_STENCIL_MASK) | (clearStencil ? 0 : YW3D_D24S8_STENCIL_MASK);
+                const uint32_t value = (clearDepth ? EncodeDepth24(depth) : 0) | (clearStencil ? (stencil & YW3D_D24S8_STENCIL_MASK) : 0);
+
+                uint32_t* curData = &((uint32_t*)m_Data)[clearRect.top * m_Width + clearRect.left];
+                for (uint32_t y = clearRect.top; y < clearRect.bottom; y++, curData += rowStride)
+                {
+                    for (uint32_t x = clearRect.left; x < clearRect.right; x++, curData++)
+                    {
+                        *curData = (*curData & keepMask) | value;
+                    }
+                }
+            }
+            break;
+        case Yw3d_FMT_D16:
+            {
+                const uint16_t value = EncodeDepth16(depth);
+
+                uint16_t* curData = &((uint16_t*)m_Data)[clearRect.top * m_Width + clearRect.left];
+                for (uint32_t y = clearRect.top; y < clearRect.bottom; y++, curData += rowStride)
+                {
+                    for (uint32_t x = clearRect.left; x < clearRect.right; x++, curData++)
+                    {
+                        *curData = value;
+                    }
+                }
+            }
+            break;
+        default:
+            LOGE(_T("Yw3dSurface::ClearDepthStencil: surface is not a depth or stencil surface.\n"));
+            UnlockRect();
+            return Yw3d_E_InvalidFormat;
+        }
+
+        // Unlock surface buffer.
+        UnlockRect();
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dSurface::SetFastClear(const bool enable)
+    {
+        if (m_LockedComplete || (nullptr != m_PartialLockData))
+        {
+            LOGE(_T("Yw3dSurface::SetFastClear: surface is locked.\n"));
+            return Yw3d_E_InvalidState;
+        }
+
+        if (!enable)
+        {
+            // Write all pending tiles before the tile states are gone.
+            ResolveFastClear(nullptr);
+            YW_SAFE_DELETE_ARRAY(m_FastClearTiles);
+            m_FastClearTilesPerRow = 0;
+            m_FastClearTileRows = 0;
+
+            return Yw3d_S_OK;
+        }
+
+        if ((Yw3d_SL_Linear != m_Layout) || IsBlockCompressedFormat(m_Format))
+        {
+            LOGE(_T("Yw3dSurface::SetFastClear: fast clear is only supported by uncompressed surfaces of layout Yw3d_SL_Linear.\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
+        if (nullptr != m_FastClearTiles)
+        {
+            return Yw3d_S_OK;
+        }
+
+        const uint32_t tilesPerRow = (m_Width + YW3D_FAST_CLEAR_TILE_SIZE - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT;
+        const uint32_t tileRows = (m_Height + YW3D_FAST_CLEAR_TILE_SIZE - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT;
+        m_FastClearTiles = new uint8_t[tilesPerRow * tileRows];
+        if (nullptr == m_FastClearTiles)
+        {
+            LOGE(_T("Yw3dSurface::SetFastClear: out of memory, cannot create tile states.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        memset(m_FastClearTiles, 0, tilesPerRow * tileRows);
+        m_FastClearTilesPerRow = tilesPerRow;
+        m_FastClearTileRows = tileRows;
+        m_FastClearPendingTiles = 0;
+
+        return Yw3d_S_OK;
+    }
+
+    bool Yw3dSurface::GetFastClear() const
+    {
+        return nullptr != m_FastClearTiles;
+    }
+
+    void Yw3dSurface::ResolveFastClear(const Yw3dRect* rect)
+    {
+        if (0 == m_FastClearPendingTiles)
+        {
+            return;
+        }
+
+        if (nullptr == rect)
+        {
+            ResolveFastClearTiles(0, 0, m_FastClearTilesPerRow, m_FastClearTileRows);
+            return;
+        }
+
+        if ((rect->left >= rect->right) || (rect->top >= rect->bottom))
+        {
+            return;
+        }
+
+        ResolveFastClearTiles(rect->left >> YW3D_FAST_CLEAR_TILE_SHIFT, rect->top >> YW3D_FAST_CLEAR_TILE_SHIFT,
+            ((rect->right - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT) + 1, ((rect->bottom - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT) + 1);
+    }
+
+    Yw3dResult Yw3dSurface::FastClear(const void* pixel, const Yw3dRect& clearRect)
+    {
+        if (m_LockedComplete || (nullptr != m_PartialLockData))
+        {
+            LOGE(_T("Yw3dSurface::FastClear: surface is locked.\n"));
+            return Yw3d_E_InvalidState;
+        }
+
+        // Tiles completely covered by the clear-rectangle, tiles cut by the right or bottom edge of the surface count as covered.
+        uint32_t tileLeft = (clearRect.left + YW3D_FAST_CLEAR_TILE_SIZE - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT;
+        uint32_t tileTop = (clearRect.top + YW3D_FAST_CLEAR_TILE_SIZE - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT;
+        uint32_t tileRight = (clearRect.right == m_Width) ? m_FastClearTilesPerRow : (clearRect.right >> YW3D_FAST_CLEAR_TILE_SHIFT);
+        uint32_t tileBottom = (clearRect.bottom == m_Height) ? m_FastClearTileRows : (clearRect.bottom >> YW3D_FAST_CLEAR_TILE_SHIFT);
+        if ((tileLeft >= tileRight) || (tileTop >= tileBottom))
+        {
+            tileLeft = tileRight = tileTop = tileBottom = 0;
+        }
+
+        // Pending tiles of another value would be partially overwritten or lose their value, so write them first.
+        const uint32_t pixelBytes = GetFormatBytes();
+        if ((0 != m_FastClearPendingTiles) && (0 != memcmp(pixel, m_FastClearValue, pixelBytes)))
+        {
+            for (uint32_t tileY = 0; tileY < m_FastClearTileRows; tileY++)
+            {
+                for (uint32_t tileX = 0; tileX < m_FastClearTilesPerRow; tileX++)
+                {
+                    if ((tileX < tileLeft) || (tileX >= tileRight) || (tileY < tileTop) || (tileY >= tileBottom))
+                    {
+                        ResolveFastClearTiles(tileX, tileY, tileX + 1, tileY + 1);
+                    }
+                }
+            }
+        }
+
+        memcpy(m_FastClearValue, pixel, pixelBytes);
+
+        // Mark the covered tiles.
+        for (uint32_t tileY = tileTop; tileY < tileBottom; tileY++)
+        {
+            uint8_t* curTile = &m_FastClearTiles[tileY * m_FastClearTilesPerRow + tileLeft];
+            for (uint32_t tileX = tileLeft; tileX < tileRight; tileX++, curTile++)
+            {
+                if (0 == *curTile)
+                {
+                    *curTile = 1;
+                    m_FastClearPendingTiles++;
+                }
+            }
+        }
+
+        // Write the pixels outside of the covered tiles.
+        const uint32_t coveredLeft = tileLeft << YW3D_FAST_CLEAR_TILE_SHIFT;
+        const uint32_t coveredTop = tileTop << YW3D_FAST_CLEAR_TILE_SHIFT;
+        const uint32_t coveredRight = min(tileRight << YW3D_FAST_CLEAR_TILE_SHIFT, m_Width);
+        const uint32_t coveredBottom = min(tileBottom << YW3D_FAST_CLEAR_TILE_SHIFT, m_Height);
+        for (uint32_t y = clearRect.top; y < clearRect.bottom; y++)
+        {
+            if ((y < coveredTop) || (y >= coveredBottom))
+            {
+                FillPixels(clearRect.left, y, clearRect.right - clearRect.left, pixel);
+                continue;
+            }
+
+            if (clearRect.left < coveredLeft)
+            {
+                FillPixels(clearRect.left, y, coveredLeft - clearRect.left, pixel);
+            }
+
+            if (coveredRight < clearRect.right)
+            {
+                FillPixels(coveredRight, y, clearRect.right - coveredRight, pixel);
+            }
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    void Yw3dSurface::ResolveFastClearTiles(uint32_t tileLeft, uint32_t tileTop, uint32_t tileRight, uint32_t tileBottom)
+    {
+        tileRight = min(tileRight, m_FastClearTilesPerRow);
+        tileBottom = min(tileBottom, m_FastClearTileRows);
+
+        for (uint32_t tileY = tileTop; tileY < tileBottom; tileY++)
+        {
+            uint8_t* curTile = &m_FastClearTiles[tileY * m_FastClearTilesPerRow + tileLeft];
+            for (uint32_t tileX = tileLeft; tileX < tileRight; tileX++, curTile++)
+            {
+                if (0 == *curTile)
+                {
+                    continue;
+                }
+
+                *curTile = 0;
+                m_FastClearPendingTiles--;
+
+                // Tiles at the right and bottom edges may be cut by the surface.
+                const uint32_t pixelX = tileX << YW3D_FAST_CLEAR_TILE_SHIFT;
+                const uint32_t pixelY = tileY << YW3D_FAST_CLEAR_TILE_SHIFT;
+                const uint32_t pixelCount = min((uint32_t)YW3D_FAST_CLEAR_TILE_SIZE, m_Width - pixelX);
+                const uint32_t pixelBottom = min(pixelY + YW3D_FAST_CLEAR_TILE_SIZE, m_Height);
+                for (uint32_t y = pixelY; y < pixelBottom; y++)
+                {
+                    FillPixels(pixelX, y, pixelCount, m_FastClearValue);
                 }
             }
+        }
+    }
+
+    void Yw3dSurface::FillPixels(const uint32_t x, const uint32_t y, const uint32_t count, const void* pixel)
+    {
+        const uint32_t pixelBytes = GetFormatBytes();
+        switch (pixelBytes)
+        {
+        case sizeof(uint8_t):
+            memset((uint8_t*)m_Data + y * m_Width + x, *(const uint8_t*)pixel, count);
             break;
-        case Yw3d_FMT_R32G32F:
+        case sizeof(uint16_t):
             {
-                Vector2* curData = &((Vector2*)m_Data)[clearRect.top * m_Width + clearRect.left];
-                for (uint32_t y = clearRect.top; y < clearRect.bottom; y++, curData += rowStride)
+                const uint16_t value = *(const uint16_t*)pixel;
+                uint16_t* curData = &((uint16_t*)m_Data)[y * m_Width + x];
+                for (uint32_t i = 0; i < count; i++)
                 {
-                    for (uint32_t x = clearRect.left; x < clearRect.right; x++, curData++)
-                    {
-                        *curData = color;
-                    }
+                    curData[i] = value;
                 }
             }
             break;
-        case Yw3d_FMT_R32G32B32F:
+        case sizeof(uint32_t):
             {
-                Vector3* curData = &((Vector3*)m_Data)[clearRect.top * m_Width + clearRect.left];
-                for (uint32_t y = clearRect.top; y < clearRect.bottom; y++, curData += rowStride)
+                const uint32_t value = *(const uint32_t*)pixel;
+                uint32_t* curData = &((uint32_t*)m_Data)[y * m_Width + x];
+                for (uint32_t i = 0; i < count; i++)
                 {
-                    for (uint32_t x = clearRect.left; x < clearRect.right; x++, curData++)
-                    {
-                        *curData = color;
-                    }
+                    curData[i] = value;
                 }
             }
             break;
-        case Yw3d_FMT_R32G32B32A32F:
+        default:
+            if (0 != (pixelBytes % sizeof(float)))
             {
-                Vector4* curData = &((Vector4*)m_Data)[clearRect.top * m_Width + clearRect.left];
-                for (uint32_t y = clearRect.top; y < clearRect.bottom; y++, curData += rowStride)
+                // Three channel compact formats.
+                uint8_t* curData = (uint8_t*)m_Data + (y * m_Width + x) * pixelBytes;
+                for (uint32_t i = 0; i < count; i++, curData += pixelBytes)
                 {
-                    for (uint32_t x = clearRect.left; x < clearRect.right; x++, curData++)
-                    {
-                        *curData = color;
-                    }
+                    memcpy(curData, pixel, pixelBytes);
                 }
             }
+            else
+            {
+                const uint32_t floatCount = pixelBytes / sizeof(float);
+                m_Device->GetSimdKernels()->fillPixels(&m_Data[(y * m_Width + x) * floatCount], (const float*)pixel, floatCount, count);
+            }
             break;
-        default:
-            // This can not happen.
-            LOGE(_T("Yw3dSurface::Clear: invalid surface format.\n"));
-            UnlockRect();
-            return Yw3d_E_InvalidFormat;
         }
+    }
 
-        // Unlock surface buffer.
-        UnlockRect();
+    const uint8_t* Yw3dSurface::GetFastClearTiles() const
+    {
+        return (0 != m_FastClearPendingTiles) ? m_FastClearTiles : nullptr;
+    }
 
-        return Yw3d_S_OK;
+    const float* Yw3dSurface::GetFastClearValue() const
+    {
+        return m_FastClearValue;
     }
 
     Yw3dResult Yw3dSurface::CopyToSurface(const Yw3dRect* srcRect, Yw3dSurface* destSurface, const Yw3dRect* destRect, const Yw3dTextureFilter filter)
@@ -343,7 +1202,7 @@ namespace yw
         Yw3dRect curDestRect;
         if (nullptr != destRect)
         {
-            if ((destRect->right > m_Width) || (destRect->bottom > m_Height) || (destRect->left < 0) || (destRect->top < 0))
+            if ((destRect->right > destSurface->GetWidth()) || (destRect->bottom > destSurface->GetHeight()) || (destRect->left < 0) || (destRect->top < 0))
             {
                 LOGE(_T("Yw3dSurface::CopyToSurface: destination rectangle exceeds surface dimensions!\n"));
                 return Yw3d_E_InvalidParameters;
@@ -361,11 +1220,38 @@ namespace yw
         {
             curDestRect.left = 0;
             curDestRect.top = 0;
-            curDestRect.right = m_Width;
-            curDestRect.bottom = m_Height;
+            curDestRect.right = destSurface->GetWidth();
+            curDestRect.bottom = destSurface->GetHeight();
+        }
+
+        // Block compressed surfaces are decoded or encoded through a float surface.
+        if (IsBlockCompressedFormat(m_Format) || IsBlockCompressedFormat(destSurface->GetFormat()))
+        {
+            return CopyToSurfaceConverted(curSrcRect, destSurface, curDestRect, filter);
+        }
+
+        const uint32_t srcFloatCount = GetFormatFloats();
+        const uint32_t destFloatCount = destSurface->GetFormatFloats();
+        const uint32_t srcWidth = curSrcRect.right - curSrcRect.left;
+        const uint32_t srcHeight = curSrcRect.bottom - curSrcRect.top;
+        const uint32_t destWidth = curDestRect.right - curDestRect.left;
+        const uint32_t destHeight = curDestRect.bottom - curDestRect.top;
+        const bool directCopy = (destSurface->GetFormat() == m_Format) && (destWidth == srcWidth) && (destHeight == srcHeight);
+
+        // Compact surfaces are converted through a float surface, unless they are copied directly.
+        if (!directCopy && (IsCompactFormat(m_Format) || IsCompactFormat(destSurface->GetFormat())))
+        {
+            return CopyToSurfaceConverted(curSrcRect, destSurface, curDestRect, filter);
+        }
+
+        // Packed depth formats can only be copied directly.
+        if (!directCopy && ((0 == srcFloatCount) || (0 == destFloatCount)))
+        {
+            LOGE(_T("Yw3dSurface::CopyToSurface: packed depth surfaces can only be copied to a surface of the same format and size!\n"));
+            return Yw3d_E_InvalidFormat;
         }
 
-        // Lock dest surface data.
+        // Lock dest surface data, the locked data is always linear with the width of the dest rectangle.
         float* destData = nullptr;
         Yw3dResult lockResult = destSurface->LockRect((void**)&destData, destRect);
         if (YW3D_FAILED(lockResult))
@@ -374,64 +1260,381 @@ namespace yw
             return lockResult;
         }
 
-        // Dest info.
-        const uint32_t destFloatCount = destSurface->GetFormatFloats();
-        const uint32_t destWidth = curDestRect.right - curDestRect.left;
-        const uint32_t destHeight = curDestRect.bottom - curDestRect.top;
+        // The source is read directly below.
+        ResolveFastClear(&curSrcRect);
 
-        // Check if we can directly copy.
-        if ((nullptr == srcRect) && (nullptr == destRect) && (destFloatCount == GetFormatFloats()) && (destWidth == m_Width) && (destHeight == m_Height))
+        // Same size and format, copy the pixels.
+        if (directCopy)
         {
-            memcpy(destData, m_Data, sizeof(float) * destWidth * destHeight * destFloatCount);
+            const uint32_t pixelBytes = GetFormatBytes();
+            uint8_t* curDestData = (uint8_t*)destData;
+            for (uint32_t y = curSrcRect.top; y < curSrcRect.bottom; y++)
+            {
+                if (Yw3d_SL_Linear == m_Layout)
+                {
+                    memcpy(curDestData, (const uint8_t*)m_Data + (y * m_Width + curSrcRect.left) * pixelBytes, srcWidth * pixelBytes);
+                    curDestData += srcWidth * pixelBytes;
+                }
+                else
+                {
+                    for (uint32_t x = curSrcRect.left; x < curSrcRect.right; x++, curDestData += pixelBytes)
+                    {
+                        memcpy(curDestData, (const uint8_t*)m_Data + GetPixelIndex(x, y) * pixelBytes, pixelBytes);
+                    }
+                }
+            }
+
             destSurface->UnlockRect();
 
             return Yw3d_S_OK;
         }
 
-        // Get uv step from src surface.
-        const float stepU = 1.0f / m_WidthMin1;
-        const float stepV = 1.0f / m_HeightMin1;
+        // Blit functions specialized for each source and dest float count and filter.
+        typedef void (Yw3dSurface::*BlitRowsFunction)(float*, uint32_t, uint32_t, uint32_t, const Yw3dRect&, float, float) const;
+        static const BlitRowsFunction blitFunctions[4][4][2] =
+        {
+            {
+                {&Yw3dSurface::BlitRows<1, 1, false>, &Yw3dSurface::BlitRows<1, 1, true>}, {&Yw3dSurface::BlitRows<1, 2, false>, &Yw3dSurface::BlitRows<1, 2, true>},
+                {&Yw3dSurface::BlitRows<1, 3, false>, &Yw3dSurface::BlitRows<1, 3, true>}, {&Yw3dSurface::BlitRows<1, 4, false>, &Yw3dSurface::BlitRows<1, 4, true>}
+            },
+            {
+                {&Yw3dSurface::BlitRows<2, 1, false>, &Yw3dSurface::BlitRows<2, 1, true>}, {&Yw3dSurface::BlitRows<2, 2, false>, &Yw3dSurface::BlitRows<2, 2, true>},
+                {&Yw3dSurface::BlitRows<2, 3, false>, &Yw3dSurface::BlitRows<2, 3, true>}, {&Yw3dSurface::BlitRows<2, 4, false>, &Yw3dSurface::BlitRows<2, 4, true>}
+            },
+            {
+                {&Yw3dSurface::BlitRows<3, 1, false>, &Yw3dSurface::BlitRows<3, 1, true>}, {&Yw3dSurface::BlitRows<3, 2, false>, &Yw3dSurface::BlitRows<3, 2, true>},
+                {&Yw3dSurface::BlitRows<3, 3, false>, &Yw3dSurface::BlitRows<3, 3, true>}, {&Yw3dSurface::BlitRows<3, 4, false>, &Yw3dSurface::BlitRows<3, 4, true>}
+            },
+            {
+                {&Yw3dSurface::BlitRows<4, 1, false>, &Yw3dSurface::BlitRows<4, 1, true>}, {&Yw3dSurface::BlitRows<4, 2, false>, &Yw3dSurface::BlitRows<4, 2, true>},
+                {&Yw3dSurface::BlitRows<4, 3, false>, &Yw3dSurface::BlitRows<4, 3, true>}, {&Yw3dSurface::BlitRows<4, 4, false>, &Yw3dSurface::BlitRows<4, 4, true>}
+            }
+        };
+
+        const BlitRowsFunction blitFunction = blitFunctions[srcFloatCount - 1][destFloatCount - 1][(Yw3d_TF_Linear == filter) ? 1 : 0];
+        const float scaleX = (float)srcWidth / (float)destWidth;
+        const float scaleY = (float)srcHeight / (float)destHeight;
+
+        // Resample bands of rows in parallel, a band should be worth waking up a worker.
+        const uint32_t bandPixels = 4096;
+        const uint32_t rowsPerBand = max(1u, bandPixels / destWidth);
+        const uint32_t numBands = (destHeight + rowsPerBand - 1) / rowsPerBand;
+        m_Device->GetWorkerPool()->ParallelFor(numBands, [&](uint32_t band)
+        {
+            const uint32_t rowBegin = band * rowsPerBand;
+            const uint32_t rowEnd = min(rowBegin + rowsPerBand, destHeight);
+            (this->*blitFunction)(destData, destWidth, rowBegin, rowEnd, curSrcRect, scaleX, scaleY);
+        });
+
+        // Unlock dest surface buffer.
+        destSurface->UnlockRect();
+
+        return Yw3d_S_OK;
+    }
 
-        // Copy from src data into dest data.
-        float srcV = curSrcRect.top * stepV;
-        for (uint32_t y = 0; y < destHeight; y++, srcV += stepV)
+    template <uint32_t srcFloats, uint32_t destFloats, bool linearFilter>
+    void Yw3dSurface::BlitRows(float* destData, uint32_t destWidth, uint32_t rowBegin, uint32_t rowEnd, const Yw3dRect& srcRect, float scaleX, float scaleY) const
+    {
+        // Source positions are clamped to the source rectangle.
+        const float minX = (float)srcRect.left;
+        const float minY = (float)srcRect.top;
+        const float maxX = (float)(srcRect.right - 1);
+        const float maxY = (float)(srcRect.bottom - 1);
+
+        float* curDestData = destData + rowBegin * destWidth * destFloats;
+        for (uint32_t y = rowBegin; y < rowEnd; y++)
         {
-            float srcU = curSrcRect.left * stepU;
-            for (uint32_t x = 0; x < destWidth; x++, srcU += stepU, destData += destFloatCount)
+            // Map pixel centers of the dest rectangle to the source rectangle.
+            const float fY = Clamp(minY + ((float)y + 0.5f) * scaleY - 0.5f, minY, maxY);
+            const uint32_t pixelY = linearFilter ? (uint32_t)fY : (uint32_t)(fY + 0.5f);
+            const uint32_t pixelY2 = min(pixelY + 1, (uint32_t)srcRect.bottom - 1);
+            const float interpolationY = fY - (float)pixelY;
+
+            for (uint32_t x = 0; x < destWidth; x++, curDestData += destFloats)
             {
-                Vector4 srcColor;
-                if (Yw3d_TF_Linear == filter)
+                const float fX = Clamp(minX + ((float)x + 0.5f) * scaleX - 0.5f, minX, maxX);
+                float color[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+
+                if (!linearFilter)
                 {
-                    SampleLinear(srcColor, srcU, srcV);
+                    const float* pixel = m_Data + GetPixelIndex((uint32_t)(fX + 0.5f), pixelY) * srcFloats;
+                    for (uint32_t c = 0; c < srcFloats; c++)
+                    {
+                        color[c] = pixel[c];
+                    }
                 }
                 else
                 {
-                    SamplePoint(srcColor, srcU, srcV);
+                    const uint32_t pixelX = (uint32_t)fX;
+                    const uint32_t pixelX2 = min(pixelX + 1, (uint32_t)srcRect.right - 1);
+                    const float interpolationX = fX - (float)pixelX;
+
+                    // Top-left, top-right, bottom-left and bottom-right pixels.
+                    const float* pixels[4] =
+                    {
+                        m_Data + GetPixelIndex(pixelX, pixelY) * srcFloats, m_Data + GetPixelIndex(pixelX2, pixelY) * srcFloats,
+                        m_Data + GetPixelIndex(pixelX, pixelY2) * srcFloats, m_Data + GetPixelIndex(pixelX2, pixelY2) * srcFloats
+                    };
+
+                    if (4 == srcFloats)
+                    {
+                        m_SimdKernels->filterBilinear4(color, pixels, interpolationX, interpolationY);
+                    }
+                    else
+                    {
+                        for (uint32_t c = 0; c < srcFloats; c++)
+                        {
+                            const float top = Lerp(pixels[0][c], pixels[1][c], interpolationX);
+                            const float bottom = Lerp(pixels[2][c], pixels[3][c], interpolationX);
+                            color[c] = Lerp(top, bottom, interpolationY);
+                        }
+                    }
                 }
 
-                switch (m_Format)
+                // Missing channels are filled like a texture lookup does: (r, 0, 0, 1).
+                for (uint32_t c = 0; c < destFloats; c++)
                 {
-                case Yw3d_FMT_R32G32B32A32F: destData[3] = srcColor.a;
-                case Yw3d_FMT_R32G32B32F: destData[2] = srcColor.b;
-                case Yw3d_FMT_R32G32F: destData[1] = srcColor.g;
-                case Yw3d_FMT_R32F: destData[0] = srcColor.r;
-                    break;
-                case Yw3d_FMT_INDEX16:
-                case Yw3d_FMT_INDEX32:
-                default:
-                    LOGE(_T("Yw3dSurface::CopyToSurface: wrong format of source surface!\n"));
-                    break;
+                    curDestData[c] = color[c];
                 }
             }
         }
+    }
+
+    Yw3dResult Yw3dSurface::CopyToSurfaceConverted(const Yw3dRect& srcRect, Yw3dSurface* destSurface, const Yw3dRect& destRect, const Yw3dTextureFilter filter)
+    {
+        if ((0 == GetFormatChannels()) || (0 == destSurface->GetFormatChannels()))
+        {
+            LOGE(_T("Yw3dSurface::CopyToSurfaceConverted: packed depth surfaces can only be copied to a surface of the same format and size!\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
+        const uint32_t destWidth = destSurface->GetWidth();
+        const uint32_t destHeight = destSurface->GetHeight();
+        const bool srcEntire = (0 == srcRect.left) && (0 == srcRect.top) && (m_Width == srcRect.right) && (m_Height == srcRect.bottom);
+        const bool destEntire = (0 == destRect.left) && (0 == destRect.top) && (destWidth == destRect.right) && (destHeight == destRect.bottom);
+        if (IsBlockCompressedFormat(destSurface->GetFormat()) && !destEntire)
+        {
+            LOGE(_T("Yw3dSurface::CopyToSurfaceConverted: block compressed destination surfaces can only be written entirely!\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        // Same block compressed format and size, copy the blocks.
+        if (IsBlockCompressedFormat(m_Format) && (destSurface->GetFormat() == m_Format) && srcEntire && (destWidth == m_Width) && (destHeight == m_Height))
+        {
+            void* destData = nullptr;
+            Yw3dResult lockResult = destSurface->LockRect(&destData, nullptr);
+            if (YW3D_FAILED(lockResult))
+            {
+                LOGE(_T("Yw3dSurface::CopyToSurfaceConverted: couldn't lock destination surface!\n"));
+                return lockResult;
+            }
+
+            memcpy(destData, m_Data, m_TilesPerRow * ((m_Height + 3) >> 2) * GetCompressedBlockBytes(m_Format));
+            destSurface->UnlockRect();
+
+            return Yw3d_S_OK;
+        }
+
+        // Convert the source and copy from the converted pixels, which also converts a compact or block compressed destination.
+        if (0 == GetFormatFloats())
+        {
+            Yw3dSurface* floatSurface = nullptr;
+            Yw3dResult result = m_Device->CreateSurface(&floatSurface, m_Width, m_Height, GetFloatFormat());
+            if (YW3D_FAILED(result))
+            {
+                return result;
+            }
+
+            ResolveFastClear(nullptr);
+            UnpackPixels(floatSurface->m_Data);
+            result = floatSurface->CopyToSurface(&srcRect, destSurface, &destRect, filter);
+            YW_SAFE_RELEASE(floatSurface);
+
+            return result;
+        }
 
-        // Unlock dest surface buffer.
-        destSurface->UnlockRect();
+        // Resample the source to the size of the destination rectangle and convert the resampled pixels.
+        if (destSurface->m_LockedComplete || (nullptr != destSurface->m_PartialLockData))
+        {
+            LOGE(_T("Yw3dSurface::CopyToSurfaceConverted: destination surface is locked!\n"));
+            return Yw3d_E_InvalidState;
+        }
 
-        return Yw3d_S_OK;
+        Yw3dSurface* floatSurface = nullptr;
+        Yw3dResult result = m_Device->CreateSurface(&floatSurface, destRect.right - destRect.left, destRect.bottom - destRect.top, destSurface->GetFloatFormat());
+        if (YW3D_FAILED(result))
+        {
+            return result;
+        }
+
+        result = CopyToSurface(&srcRect, floatSurface, nullptr, filter);
+        if (YW3D_SUCCESSFUL(result))
+        {
+            destSurface->ResolveFastClear(&destRect);
+            destSurface->PackPixels(floatSurface->m_Data, destRect);
+        }
+
+        YW_SAFE_RELEASE(floatSurface);
+
+        return result;
+    }
+
+    void Yw3dSurface::UnpackPixels(float* destData) const
+    {
+        if (IsBlockCompressedFormat(m_Format))
+        {
+            DecodeBlocks(destData);
+            return;
+        }
+
+        // Conversion functions specialized for each compact format.
+        typedef void (Yw3dSurface::*UnpackRowsFunction)(float*, uint32_t, uint32_t) const;
+        static const UnpackRowsFunction unpackFunctions[Yw3d_FMT_R8G8B8A8_SRGB - Yw3d_FMT_R8 + 1] =
+        {
+            &Yw3dSurface::UnpackRows<uint8_t, 1>, &Yw3dSurface::UnpackRows<uint8_t, 2>, &Yw3dSurface::UnpackRows<uint8_t, 3>, &Yw3dSurface::UnpackRows<uint8_t, 4>,
+            &Yw3dSurface::UnpackRows<uint16_t, 1>, &Yw3dSurface::UnpackRows<uint16_t, 2>, &Yw3dSurface::UnpackRows<uint16_t, 3>, &Yw3dSurface::UnpackRows<uint16_t, 4>,
+            &Yw3dSurface::UnpackRows<Yw3dSRGBChannel, 3>, &Yw3dSurface::UnpackRows<Yw3dSRGBChannel, 4>
+        };
+
+        // Convert bands of rows in parallel, a band should be worth waking up a worker.
+        const UnpackRowsFunction unpackFunction = unpackFunctions[m_Format - Yw3d_FMT_R8];
+        const uint32_t bandPixels = 4096;
+        const uint32_t rowsPerBand = max(1u, bandPixels / m_Width);
+        const uint32_t numBands = (m_Height + rowsPerBand - 1) / rowsPerBand;
+        m_Device->GetWorkerPool()->ParallelFor(numBands, [&](uint32_t band)
+        {
+            const uint32_t rowBegin = band * rowsPerBand;
+            (this->*unpackFunction)(destData, rowBegin, min(rowBegin + rowsPerBand, m_Height));
+        });
+    }
+
+    void Yw3dSurface::PackPixels(const float* srcData, const Yw3dRect& rect)
+    {
+        if (IsBlockCompressedFormat(m_Format))
+        {
+            EncodeBlocks(srcData);
+            return;
+        }
+
+        // Conversion functions specialized for each compact format.
+        typedef void (Yw3dSurface::*PackRowsFunction)(const float*, const Yw3dRect&, uint32_t, uint32_t);
+        static const PackRowsFunction packFunctions[Yw3d_FMT_R8G8B8A8_SRGB - Yw3d_FMT_R8 + 1] =
+        {
+            &Yw3dSurface::PackRows<uint8_t, 1>, &Yw3dSurface::PackRows<uint8_t, 2>, &Yw3dSurface::PackRows<uint8_t, 3>, &Yw3dSurface::PackRows<uint8_t, 4>,
+            &Yw3dSurface::PackRows<uint16_t, 1>, &Yw3dSurface::PackRows<uint16_t, 2>, &Yw3dSurface::PackRows<uint16_t, 3>, &Yw3dSurface::PackRows<uint16_t, 4>,
+            &Yw3dSurface::PackRows<Yw3dSRGBChannel, 3>, &Yw3dSurface::PackRows<Yw3dSRGBChannel, 4>
+        };
+
+        // Convert bands of rows in parallel, a band should be worth waking up a worker.
+        const PackRowsFunction packFunction = packFunctions[m_Format - Yw3d_FMT_R8];
+        const uint32_t rectWidth = rect.right - rect.left;
+        const uint32_t rectHeight = rect.bottom - rect.top;
+        const uint32_t bandPixels = 4096;
+        const uint32_t rowsPerBand = max(1u, bandPixels / rectWidth);
+        const uint32_t numBands = (rectHeight + rowsPerBand - 1) / rowsPerBand;
+        m_Device->GetWorkerPool()->ParallelFor(numBands, [&](uint32_t band)
+        {
+            const uint32_t rowBegin = band * rowsPerBand;
+            (this->*packFunction)(srcData, rect, rowBegin, min(rowBegin + rowsPerBand, rectHeight));
+        });
+    }
+
+    template <class StorageType, uint32_t channels>
+    void Yw3dSurface::UnpackRows(float* destData, uint32_t rowBegin, uint32_t rowEnd) const
+    {
+        float* curDestData = destData + rowBegin * m_Width * channels;
+        for (uint32_t y = rowBegin; y < rowEnd; y++)
+        {
+            for (uint32_t x = 0; x < m_Width; x++, curDestData += channels)
+            {
+                const StorageType* pixel = (const StorageType*)m_Data + GetPixelIndex(x, y) * channels;
+                for (uint32_t c = 0; c < channels; c++)
+                {
+                    curDestData[c] = UnpackChannel(pixel[c], c);
+                }
+            }
+        }
+    }
+
+    template <class StorageType, uint32_t channels>
+    void Yw3dSurface::PackRows(const float* srcData, const Yw3dRect& rect, uint32_t rowBegin, uint32_t rowEnd)
+    {
+        const uint32_t rectWidth = rect.right - rect.left;
+        const float* curSrcData = srcData + rowBegin * rectWidth * channels;
+        for (uint32_t y = rect.top + rowBegin; y < rect.top + rowEnd; y++)
+        {
+            for (uint32_t x = rect.left; x < rect.right; x++, curSrcData += channels)
+            {
+                StorageType* pixel = (StorageType*)m_Data + GetPixelIndex(x, y) * channels;
+                for (uint32_t c = 0; c < channels; c++)
+                {
+                    PackChannel(curSrcData[c], pixel[c], c);
+                }
+            }
+        }
+    }
+
+    void Yw3dSurface::DecodeBlocks(float* destData) const
+    {
+        const uint32_t blockBytes = GetCompressedBlockBytes(m_Format);
+        const uint32_t floatCount = GetFormatChannels();
+        const uint32_t blockRows = (m_Height + 3) >> 2;
+        m_Device->GetWorkerPool()->ParallelFor(blockRows, [&](uint32_t blockY)
+        {
+            Vector4 pixels[16];
+            for (uint32_t blockX = 0; blockX < m_TilesPerRow; blockX++)
+            {
+                DecodeCompressedBlock(m_Format, (const uint8_t*)m_Data + (blockY * m_TilesPerRow + blockX) * blockBytes, pixels);
+
+                // Blocks at the right and bottom edges may be cut by the surface.
+                const uint32_t pixelX = blockX << 2;
+                const uint32_t pixelY = blockY << 2;
+                const uint32_t pixelRight = min(pixelX + 4, m_Width);
+                const uint32_t pixelBottom = min(pixelY + 4, m_Height);
+                for (uint32_t y = pixelY; y < pixelBottom; y++)
+                {
+                    for (uint32_t x = pixelX; x < pixelRight; x++)
+                    {
+                        const Vector4& pixel = pixels[((y & 3) << 2) | (x & 3)];
+                        const float color[4] = {pixel.r, pixel.g, pixel.b, pixel.a};
+                        memcpy(&destData[(y * m_Width + x) * floatCount], color, sizeof(float) * floatCount);
+                    }
+                }
+            }
+        });
+    }
+
+    void Yw3dSurface::EncodeBlocks(const float* srcData)
+    {
+        const uint32_t blockBytes = GetCompressedBlockBytes(m_Format);
+        const uint32_t floatCount = GetFormatChannels();
+        const uint32_t blockRows = (m_Height + 3) >> 2;
+        m_Device->GetWorkerPool()->ParallelFor(blockRows, [&](uint32_t blockY)
+        {
+            Vector4 pixels[16];
+            for (uint32_t blockX = 0; blockX < m_TilesPerRow; blockX++)
+            {
+                // Blocks at the right and bottom edges repeat the edge pixels.
+                for (uint32_t i = 0; i < 16; i++)
+                {
+                    const uint32_t x = min((blockX << 2) | (i & 3), m_WidthMin1);
+                    const uint32_t y = min((blockY << 2) | (i >> 2), m_HeightMin1);
+                    float color[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+                    memcpy(color, &srcData[(y * m_Width + x) * floatCount], sizeof(float) * floatCount);
+                    pixels[i].Set(color[0], color[1], color[2], color[3]);
+                }
+
+                EncodeCompressedBlock(m_Format, pixels, (uint8_t*)m_Data + (blockY * m_TilesPerRow + blockX) * blockBytes);
+            }
+        });
     }
 
     Yw3dResult Yw3dSurface::LockRect(void** lockedData, const Yw3dRect* lockRect)
+    {
+        return LockRect(lockedData, lockRect, true);
+    }
+
+    Yw3dResult Yw3dSurface::LockRect(void** lockedData, const Yw3dRect* lockRect, const bool resolveFastClear)
     {
         if (nullptr == lockedData)
         {
@@ -446,13 +1649,35 @@ namespace yw
             return Yw3d_E_InvalidState;
         }
 
+        if ((nullptr != lockRect) && IsBlockCompressedFormat(m_Format))
+        {
+            LOGE(_T("Yw3dSurface::LockRect: block compressed surfaces can only be locked entirely!\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
         // Entire region.
+        Yw3dRect entireRect;
         if (nullptr == lockRect)
         {
-            *lockedData = m_Data;
-            m_LockedComplete = true;
+            if (Yw3d_SL_Linear == m_Layout)
+            {
+                if (resolveFastClear)
+                {
+                    ResolveFastClear(nullptr);
+                }
 
-            return Yw3d_S_OK;
+                *lockedData = m_Data;
+                m_LockedComplete = true;
+
+                return Yw3d_S_OK;
+            }
+
+            // A tiled surface is locked through a linear lock-buffer.
+            entireRect.left = 0;
+            entireRect.top = 0;
+            entireRect.right = m_Width;
+            entireRect.bottom = m_Height;
+            lockRect = &entireRect;
         }
 
         if ((lockRect->right > m_Width) || (lockRect->bottom > m_Height) || (lockRect->left < 0) || (lockRect->top < 0))
@@ -469,13 +1694,17 @@ namespace yw
 
         // Get partial rect.
         m_PartialLockRect = *lockRect;
+        if (resolveFastClear)
+        {
+            ResolveFastClear(lockRect);
+        }
 
         // Create lock buffer.
         const uint32_t lockWidth = lockRect->right - lockRect->left;
         const uint32_t lockHeight = lockRect->bottom - lockRect->top;
-        const uint32_t surfaceFloatCount = GetFormatFloats();
+        const uint32_t surfacePixelBytes = GetFormatBytes();
 
-        m_PartialLockData = new float[lockWidth * lockHeight * surfaceFloatCount];
+        m_PartialLockData = (float*)m_Device->GetAllocator()->Allocate(lockWidth * lockHeight * surfacePixelBytes);
         if (nullptr == m_PartialLockData)
         {
             LOGE(_T("Yw3dSurface::LockRect: memory allocation failed!\n"));
@@ -483,12 +1712,22 @@ namespace yw
         }
 
         // Copy region data.
-        float* curLockedData = m_PartialLockData;
+        uint8_t* curLockedData = (uint8_t*)m_PartialLockData;
         for (uint32_t y = m_PartialLockRect.top; y < m_PartialLockRect.bottom; y++)
         {
-            const float* curSurfaceData = &m_Data[(y * m_Width + m_PartialLockRect.left) * surfaceFloatCount];
-            memcpy(curLockedData, curSurfaceData, sizeof(float) * lockWidth * surfaceFloatCount);
-            curLockedData += lockWidth * surfaceFloatCount;
+            if (Yw3d_SL_Linear == m_Layout)
+            {
+                const uint8_t* curSurfaceData = (const uint8_t*)m_Data + (y * m_Width + m_PartialLockRect.left) * surfacePixelBytes;
+                memcpy(curLockedData, curSurfaceData, lockWidth * surfacePixelBytes);
+                curLockedData += lockWidth * surfacePixelBytes;
+            }
+            else
+            {
+                for (uint32_t x = m_PartialLockRect.left; x < m_PartialLockRect.right; x++, curLockedData += surfacePixelBytes)
+                {
+                    memcpy(curLockedData, (const uint8_t*)m_Data + GetPixelIndex(x, y) * surfacePixelBytes, surfacePixelBytes);
+                }
+            }
         }
 
         // Fill out the locked partial data.
@@ -499,7 +1738,7 @@ namespace yw
 
     Yw3dResult Yw3dSurface::UnlockRect()
     {
-        if (!m_LockedComplete && (nullptr != m_PartialLockData))
+        if (!m_LockedComplete && (nullptr == m_PartialLockData))
         {
             LOGE(_T("Yw3dSurface::UnlockRect: cannot unlock mip-level because it isn't locked!\n"));
             return Yw3d_E_InvalidState;
@@ -513,18 +1752,28 @@ namespace yw
 
         // Update surface if partial locked.
         const uint32_t lockWidth = m_PartialLockRect.right - m_PartialLockRect.left;
-        const uint32_t surfaceFloatCount = GetFormatFloats();
+        const uint32_t surfacePixelBytes = GetFormatBytes();
 
-        float* curLockedData = m_PartialLockData;
+        const uint8_t* curLockedData = (const uint8_t*)m_PartialLockData;
         for (uint32_t y = m_PartialLockRect.top; y < m_PartialLockRect.bottom; y++)
         {
-            float* curSurfaceData = &m_Data[(y * m_Width + m_PartialLockRect.left) * surfaceFloatCount];
-            memcpy(curSurfaceData, curLockedData, sizeof(float) * lockWidth * surfaceFloatCount);
-            curLockedData += lockWidth * surfaceFloatCount;
+            if (Yw3d_SL_Linear == m_Layout)
+            {
+                uint8_t* curSurfaceData = (uint8_t*)m_Data + (y * m_Width + m_PartialLockRect.left) * surfacePixelBytes;
+                memcpy(curSurfaceData, curLockedData, lockWidth * surfacePixelBytes);
+                curLockedData += lockWidth * surfacePixelBytes;
+            }
+            else
+            {
+                for (uint32_t x = m_PartialLockRect.left; x < m_PartialLockRect.right; x++, curLockedData += surfacePixelBytes)
+                {
+                    memcpy((uint8_t*)m_Data + GetPixelIndex(x, y) * surfacePixelBytes, curLockedData, surfacePixelBytes);
+                }
+            }
         }
 
         // Release partial resource.
-        YW_SAFE_DELETE_ARRAY(m_PartialLockData);
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_PartialLockData);
 
         return Yw3d_S_OK;
     }
@@ -547,11 +1796,74 @@ namespace yw
         case Yw3d_FMT_R32G32B32A32F:
             return 4;
         default:
-            // Can not happen.
+            // Packed depth formats are not made of floats.
             return 0;
         }
     }
 
+    uint32_t Yw3dSurface::GetFormatBytes() const
+    {
+        switch (m_Format)
+        {
+        case Yw3d_FMT_D24S8:
+            return sizeof(uint32_t);
+        case Yw3d_FMT_D16:
+            return sizeof(uint16_t);
+        case Yw3d_FMT_R8:
+        case Yw3d_FMT_R8G8:
+        case Yw3d_FMT_R8G8B8:
+        case Yw3d_FMT_R8G8B8A8:
+            return sizeof(uint8_t) * GetFormatChannels();
+        case Yw3d_FMT_R16F:
+        case Yw3d_FMT_R16G16F:
+        case Yw3d_FMT_R16G16B16F:
+        case Yw3d_FMT_R16G16B16A16F:
+            return sizeof(uint16_t) * GetFormatChannels();
+        case Yw3d_FMT_R8G8B8_SRGB:
+        case Yw3d_FMT_R8G8B8A8_SRGB:
+            return sizeof(Yw3dSRGBChannel) * GetFormatChannels();
+        default:
+            return sizeof(float) * GetFormatFloats();
+        }
+    }
+
+    uint32_t Yw3dSurface::GetFormatChannels() const
+    {
+        if (IsSRGBFormat(m_Format))
+        {
+            return m_Format - Yw3d_FMT_R8G8B8_SRGB + 3;
+        }
+
+        if (IsCompactFormat(m_Format))
+        {
+            // Compact formats are ordered by channels, first the 8-bit then the half float formats.
+            return ((m_Format - Yw3d_FMT_R8) & 3) + 1;
+        }
+
+        if (IsBlockCompressedFormat(m_Format))
+        {
+            return GetCompressedBlockFloatFormat(m_Format) - Yw3d_FMT_R32F + 1;
+        }
+
+        return GetFormatFloats();
+    }
+
+    Yw3dFormat Yw3dSurface::GetFloatFormat() const
+    {
+        const uint32_t channels = GetFormatChannels();
+        if (0 == channels)
+        {
+            return Yw3d_FMT_NumFormats;
+        }
+
+        return (Yw3dFormat)(Yw3d_FMT_R32F + channels - 1);
+    }
+
+    Yw3dSurfaceLayout Yw3dSurface::GetLayout() const
+    {
+        return m_Layout;
+    }
+
     uint32_t Yw3dSurface::GetWidth() const
     {
         return m_Width;
@@ -562,6 +1874,27 @@ namespace yw
         return m_Height;
     }
 
+    const void* Yw3dSurface::GetStorage()
+    {
+        if (m_LockedComplete || (nullptr != m_PartialLockData))
+        {
+            LOGE(_T("Yw3dSurface::GetStorage: surface is locked.\n"));
+            return nullptr;
+        }
+
+        if (0 != m_FastClearPendingTiles)
+        {
+            ResolveFastClear(nullptr);
+        }
+
+        return m_Data;
+    }
+
+    size_t Yw3dSurface::GetStorageSize() const
+    {
+        return m_StorageSize;
+    }
+
     Yw3dDevice* Yw3dSurface::AcquireDevice()
     {
         if (nullptr != m_Device)
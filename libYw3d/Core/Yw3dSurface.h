@@ -6,9 +6,25 @@
 
 #include "Yw3dBase.h"
 #include "Yw3dTypes.h"
+#include "Yw3dBlockCompression.h"
+#include <type_traits>
 
 namespace yw
 {
+    // Returns true if a format stores its channels as 8-bit unsigned normalized integers, sRGB encoded bytes or half floats.
+    // @param[in] format member of the enumeration Yw3dFormat.
+    inline bool IsCompactFormat(const Yw3dFormat format)
+    {
+        return (format >= Yw3d_FMT_R8) && (format <= Yw3d_FMT_R8G8B8A8_SRGB);
+    }
+
+    // Returns true if a format stores its color channels sRGB encoded, they are decoded to linear when sampled and encoded when written.
+    // @param[in] format member of the enumeration Yw3dFormat.
+    inline bool IsSRGBFormat(const Yw3dFormat format)
+    {
+        return (Yw3d_FMT_R8G8B8_SRGB == format) || (Yw3d_FMT_R8G8B8A8_SRGB == format);
+    }
+
     // Yw3dSurface implements a 2-dimensional image.
     class Yw3dSurface : public IBase
     {
@@ -26,34 +42,97 @@ namespace yw
         // Accessible by Yw3dDevice which is the only class that may create a surface.
         // @param[in] width width of the surface to be created in pixels.
         // @param[in] height height of the surface to be created in pixels.
-        // @param[in] Yw3dFormat format of the surface to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // @param[in] Yw3dFormat format of the surface to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_D24S8, Yw3d_FMT_D16, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
+        // @param[in] layout memory layout of the surface pixels. Member of the enumeration Yw3dSurfaceLayout, Yw3d_SL_Tiled4x4 is only supported by float and compact formats, block compressed formats are stored in 4x4 blocks anyway.
+        // @param[in] data initial pixels in the memory layout of the surface, e.g. a mip-level of a texture file. (Pass 0 to leave the pixels undefined.)
+        // @param[in] dataSize number of bytes of data, has to match GetStorageSize() of the created surface.
+        // @param[in] dataOwner object keeping data alive, the surface uses data in place and holds a reference to its owner until it is destroyed. (Pass 0 to copy data into storage of the surface.)
         // @return Yw3d_S_OK if the function succeeds.
-        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid, e.g. data used in place isn't aligned to YW3D_ALLOCATION_ALIGNMENT bytes.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
-        Yw3dResult Create(const uint32_t width, const uint32_t height, const Yw3dFormat format);
+        Yw3dResult Create(const uint32_t width, const uint32_t height, const Yw3dFormat format, const Yw3dSurfaceLayout layout = Yw3d_SL_Linear, void* data = nullptr, const size_t dataSize = 0, IBase* dataOwner = nullptr);
 
     public:
         // Samples the surface using nearest point sampling.
         // @param[out] outColor receives the color of the pixel to be looked up.
         // @param[in] u u-component of the lookup-vector.
         // @param[in] v v-component of the lookup-vector.
-        void SamplePoint(Vector4& outColor, const float u, const float v);
+        // @note The samplers don't resolve pending fast cleared tiles, the device resolves them when the surface is bound as texture, see ResolveFastClear().
+        void SamplePoint(Vector4& outColor, const float u, const float v) const;
 
         // Samples the surface using bi-linear filtering.
         // @param[out] outColor receives the color of the pixel to be looked up.
         // @param[in] u u-component of the lookup-vector.
         // @param[in] v v-component of the lookup-vector.
-        void SampleLinear(Vector4& outColor, const float u, const float v);
+        void SampleLinear(Vector4& outColor, const float u, const float v) const;
+
+        // Samples a float surface without branching on its format, used by the precompiled sampling functions of textures.
+        // @param[out] outColor receives the color of the pixel to be looked up, missing channels are filled with (0, 0, 1).
+        // @param[in] u u-component of the lookup-vector, e [0,1].
+        // @param[in] v v-component of the lookup-vector, e [0,1].
+        // @note floats must match GetFormatFloats() of the surface.
+        template <uint32_t floats, bool linearFilter>
+        inline void SampleFloats(Vector4& outColor, const float u, const float v) const;
+
+        // Samples a float or compact surface without branching on its format, used by the precompiled sampling functions of textures.
+        // @param[out] outColor receives the color of the pixel to be looked up, missing channels are filled with (0, 0, 1).
+        // @param[in] u u-component of the lookup-vector, e [0,1].
+        // @param[in] v v-component of the lookup-vector, e [0,1].
+        // @note format must match GetFormat() of the surface, packed depth and block compressed formats are not supported.
+        template <Yw3dFormat format, bool linearFilter>
+        inline void SampleFormat(Vector4& outColor, const float u, const float v) const;
 
         // Clears the surface to a given color.
         // @param[in] color color to clear the surface to.
         // @param[in] rect rectangle to restrict clearing to.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if the clear-rectangle exceeds the surface's dimensions.
+        // @return Yw3d_E_InvalidFormat if the surface is block compressed.
         Yw3dResult Clear(const Vector4& color, const Yw3dRect* rect);
 
+        // Clears the depth and/or stencil part of a depth or stencil surface, the part not being cleared is kept for packed formats.
+        // Yw3d_FMT_R32F surfaces store depth as float or stencil as the raw bits of a uint32_t, depending on which part is cleared.
+        // @param[in] depth depth to clear the surface to.
+        // @param[in] stencil stencil to clear the surface to.
+        // @param[in] clearDepth true if the depth part should be cleared.
+        // @param[in] clearStencil true if the stencil part should be cleared.
+        // @param[in] rect rectangle to restrict clearing to.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if the clear-rectangle exceeds the surface's dimensions.
+        // @return Yw3d_E_InvalidFormat if the surface is not a depth or stencil surface.
+        Yw3dResult ClearDepthStencil(const float depth, const uint32_t stencil, const bool clearDepth, const bool clearStencil, const Yw3dRect* rect);
+
+        // Enables or disables fast clears. A fast clear only marks the tiles covered by the clear-rectangle as cleared, the pixels of a tile are written when it's accessed the first time.
+        // @param[in] enable true to enable fast clears, disabling writes all pending cleared tiles.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidFormat if the surface is not of layout Yw3d_SL_Linear or is block compressed.
+        // @return Yw3d_E_InvalidState if the surface is locked.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult SetFastClear(const bool enable);
+
+        //< Returns true if fast clears are enabled.
+        bool GetFastClear() const;
+
+        // Writes the pixels of all pending cleared tiles overlapping a rectangle.
+        // @param[in] rect rectangle of the pixels about to be accessed. (Pass 0 for the entire surface.)
+        void ResolveFastClear(const Yw3dRect* rect);
+
+        // Writes the pixels of all pending cleared tiles overlapping a part of a row, used by the rasterizer before it accesses the pixels directly.
+        // @param[in] y the row of the pixels.
+        // @param[in] x1 first pixel of the row (inclusive).
+        // @param[in] x2 last pixel of the row (exclusive).
+        inline void ResolveFastClearSpan(const uint32_t y, const uint32_t x1, const uint32_t x2)
+        {
+            if ((0 != m_FastClearPendingTiles) && (x1 < x2))
+            {
+                ResolveFastClearTiles(x1 >> YW3D_FAST_CLEAR_TILE_SHIFT, y >> YW3D_FAST_CLEAR_TILE_SHIFT, ((x2 - 1) >> YW3D_FAST_CLEAR_TILE_SHIFT) + 1, (y >> YW3D_FAST_CLEAR_TILE_SHIFT) + 1);
+            }
+        }
+
         // Copies the contents of the surface to another surface using the specified filtering method.
+        // Rectangles of the same size and format are copied directly, otherwise the source rectangle is resampled to the destination rectangle in parallel.
+        // A compact or block compressed source is converted to floats first, a compact or block compressed destination is converted from the resampled pixels. A block compressed destination must be written entirely.
         // @param[in] srcRect source rectangle to copy to the other surface. (Pass 0 to copy the entire surface.)
         // @param[in] destSurface destination surface.
         // @param[in] destRect destination-rectangle. (Pass 0 for the entire destination-surface.)
@@ -61,6 +140,8 @@ namespace yw
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one of the two rectangles is invalid or exceeds surface-dimensions.
         // @return Yw3d_E_InvalidState if the destination surface couldn't be locked.
+        // @return Yw3d_E_InvalidFormat if a packed depth surface should be resampled.
+        // @return Yw3d_E_OutOfMemory if memory allocation for the conversion failed.
         Yw3dResult CopyToSurface(const Yw3dRect* srcRect, Yw3dSurface* destSurface, const Yw3dRect* destRect, const Yw3dTextureFilter filter);
 
         // Returns a pointer to the contents of the surface.
@@ -71,6 +152,9 @@ namespace yw
         // @return Yw3d_E_InvalidState if the surface is already locked.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         // @note Locking the entire surface is a lot faster than locking a sub-region, because no lock-buffer has to be created and the application may write to the surface directly.
+        // @note The locked data is always linear. A Yw3d_SL_Tiled4x4 surface is converted into a lock-buffer on lock and back on unlock, even if the entire surface is locked.
+        // @note Pending fast cleared tiles of the locked area are written before the data is returned.
+        // @note A block compressed surface can only be locked entirely, the locked data are its 4x4 blocks row by row.
         Yw3dResult LockRect(void** lockedData, const Yw3dRect* lockRect);
 
         // Unlocks the surface; modifications to its contents will become active.
@@ -78,26 +162,164 @@ namespace yw
         // @return Yw3d_E_InvalidState if the surface is not locked.
         Yw3dResult UnlockRect();
 
-        // Returns the format of the surface. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // Returns the format of the surface. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_D24S8, Yw3d_FMT_D16, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
         Yw3dFormat GetFormat() const;
 
-        //< Returns the number of floats of the format, e [1,4].
+        //< Returns the number of floats of the format, e [1,4], 0 for packed depth, block compressed and compact formats.
         uint32_t GetFormatFloats() const;
 
+        //< Returns the number of bytes of one pixel of the format, 0 for block compressed formats.
+        uint32_t GetFormatBytes() const;
+
+        //< Returns the number of channels of the format, e [1,4], 0 for packed depth formats.
+        uint32_t GetFormatChannels() const;
+
+        //< Returns the float format holding all channels of the format, e.g. Yw3d_FMT_R32G32B32A32F for Yw3d_FMT_R8G8B8A8, Yw3d_FMT_NumFormats for packed depth formats.
+        Yw3dFormat GetFloatFormat() const;
+
+        //< Returns the memory layout of the surface pixels. Member of the enumeration Yw3dSurfaceLayout.
+        Yw3dSurfaceLayout GetLayout() const;
+
         //< Returns the width of the surface in pixels.
         uint32_t GetWidth() const;
 
         //< Returns the height of the surface in pixels.
         uint32_t GetHeight() const;
 
+        // Returns the pixels in the memory layout of the surface, e.g. to be saved to a file whose mip-levels are used in place later. Pending fast cleared tiles are written first.
+        // @return the pixels, GetStorageSize() bytes, or nullptr if the surface is locked.
+        const void* GetStorage();
+
+        //< Returns the number of bytes of the pixels in the memory layout of the surface, including the padding of tiles and blocks.
+        size_t GetStorageSize() const;
+
         // Returns a pointer to the associated device. Calling this function will increase the internal reference count of the device. Failure to call Release() when finished using the pointer will Yw3dResult in a memory leak.
         class Yw3dDevice* AcquireDevice();
 
+    private:
+        // Returns the index of a pixel in the surface data, depending on the memory layout.
+        // @param[in] x position of the pixel along x-axis.
+        // @param[in] y position of the pixel along y-axis.
+        inline uint32_t GetPixelIndex(const uint32_t x, const uint32_t y) const;
+
+        // Decodes a pixel of a block compressed surface.
+        // @param[in] x position of the pixel along x-axis.
+        // @param[in] y position of the pixel along y-axis.
+        // @param[out] outColor receives the color of the pixel.
+        inline void DecodePixel(const uint32_t x, const uint32_t y, Vector4& outColor) const;
+
+        // Samples a pixel of a compact surface.
+        // @param[out] outColor receives the color of the pixel, missing channels are filled with (0, 0, 1).
+        // @param[in] pixelIndex index of the pixel returned by GetPixelIndex().
+        template <class StorageType, uint32_t channels>
+        void SamplePointCompact(Vector4& outColor, const uint32_t pixelIndex) const;
+
+        // Samples four pixels of a compact surface using bi-linear filtering.
+        // @param[out] outColor receives the filtered color, missing channels are filled with (0, 0, 1).
+        // @param[in] pixelIndices indices of the top-left, top-right, bottom-left and bottom-right pixels.
+        // @param[in] interpolations interpolation weights along x-axis and y-axis.
+        template <class StorageType, uint32_t channels>
+        void SampleLinearCompact(Vector4& outColor, const uint32_t* pixelIndices, const float* interpolations) const;
+
+        // SampleFormat() of a float format, forwarded to SampleFloats().
+        template <Yw3dFormat format, bool linearFilter>
+        inline void SampleFormat(Vector4& outColor, const float u, const float v, std::true_type) const;
+
+        // SampleFormat() of a compact format, instantiated for the compact formats only.
+        template <Yw3dFormat format, bool linearFilter>
+        void SampleFormat(Vector4& outColor, const float u, const float v, std::false_type) const;
+
+        // Converts a color to the raw pixel value of a compact surface.
+        // @param[in] color the color.
+        // @param[out] outPixel receives GetFormatBytes() bytes.
+        void PackPixel(const Vector4& color, void* outPixel) const;
+
+        // Copies to or from a compact or block compressed surface by converting through a float surface.
+        // @param[in] srcRect validated source rectangle.
+        // @param[in] destSurface destination surface.
+        // @param[in] destRect validated destination rectangle.
+        // @param[in] filter texture filter.
+        Yw3dResult CopyToSurfaceConverted(const Yw3dRect& srcRect, Yw3dSurface* destSurface, const Yw3dRect& destRect, const Yw3dTextureFilter filter);
+
+        // Converts all pixels of a compact or block compressed surface to floats in parallel.
+        // @param[out] destData linear pixels of the format returned by GetFloatFormat().
+        void UnpackPixels(float* destData) const;
+
+        // Converts floats to the pixels of a rectangle of a compact or block compressed surface in parallel.
+        // @param[in] srcData linear pixels of the rectangle of the format returned by GetFloatFormat().
+        // @param[in] rect validated rectangle to be written, the entire surface for block compressed formats.
+        void PackPixels(const float* srcData, const Yw3dRect& rect);
+
+        // Converts rows of a compact surface to floats.
+        // @param[out] destData linear pixels of the entire surface.
+        // @param[in] rowBegin first row to be converted (inclusive).
+        // @param[in] rowEnd last row to be converted (exclusive).
+        template <class StorageType, uint32_t channels>
+        void UnpackRows(float* destData, uint32_t rowBegin, uint32_t rowEnd) const;
+
+        // Converts floats to rows of a rectangle of a compact surface.
+        // @param[in] srcData linear pixels of the rectangle.
+        // @param[in] rect the rectangle.
+        // @param[in] rowBegin first row of the rectangle to be converted (inclusive).
+        // @param[in] rowEnd last row of the rectangle to be converted (exclusive).
+        template <class StorageType, uint32_t channels>
+        void PackRows(const float* srcData, const Yw3dRect& rect, uint32_t rowBegin, uint32_t rowEnd);
+
+        // Decodes all blocks of a block compressed surface in parallel.
+        // @param[out] destData linear pixels of the format returned by GetCompressedBlockFloatFormat().
+        void DecodeBlocks(float* destData) const;
+
+        // Encodes all blocks of a block compressed surface in parallel.
+        // @param[in] srcData linear pixels of the format returned by GetCompressedBlockFloatFormat().
+        void EncodeBlocks(const float* srcData);
+
+        // Locks the surface, accessible by Yw3dDevice to lock render-target buffers without writing pending fast cleared tiles.
+        // @param[in] resolveFastClear true if pending fast cleared tiles of the locked area should be written.
+        Yw3dResult LockRect(void** lockedData, const Yw3dRect* lockRect, const bool resolveFastClear);
+
+        // Resamples rows of the dest rectangle from the source rectangle, specialized for each source and dest float count and filter.
+        // @param[out] destData locked data of the dest rectangle.
+        // @param[in] destWidth width of the dest rectangle.
+        // @param[in] rowBegin first row to be resampled (inclusive).
+        // @param[in] rowEnd last row to be resampled (exclusive).
+        // @param[in] srcRect the source rectangle.
+        // @param[in] scaleX, scaleY size of the source rectangle divided by the size of the dest rectangle.
+        template <uint32_t srcFloats, uint32_t destFloats, bool linearFilter>
+        void BlitRows(float* destData, uint32_t destWidth, uint32_t rowBegin, uint32_t rowEnd, const Yw3dRect& srcRect, float scaleX, float scaleY) const;
+
+        // Fast clears the surface to a pixel value, the pixels outside of completely covered tiles are written directly.
+        // @param[in] pixel the raw pixel value of GetFormatBytes() bytes.
+        // @param[in] clearRect validated rectangle to restrict clearing to.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidState if the surface is locked.
+        Yw3dResult FastClear(const void* pixel, const Yw3dRect& clearRect);
+
+        // Writes the pixels of pending cleared tiles in a range of tiles, bounds are clamped to the tile grid.
+        // @param[in] tileLeft, tileTop first tile (inclusive).
+        // @param[in] tileRight, tileBottom last tile (exclusive).
+        void ResolveFastClearTiles(uint32_t tileLeft, uint32_t tileTop, uint32_t tileRight, uint32_t tileBottom);
+
+        // Writes a raw pixel value to a part of a row.
+        // @param[in] x first pixel to be written.
+        // @param[in] y the row of the pixels.
+        // @param[in] count number of pixels to be written.
+        // @param[in] pixel the raw pixel value of GetFormatBytes() bytes.
+        void FillPixels(const uint32_t x, const uint32_t y, const uint32_t count, const void* pixel);
+
+        // Returns the pending state of each fast clear tile, nullptr if there are no pending tiles. Used by Yw3dDevice to present untouched tiles from the clear value.
+        const uint8_t* GetFastClearTiles() const;
+
+        //< Returns the raw pixel value of pending fast cleared tiles.
+        const float* GetFastClearValue() const;
+
     private:
         // Pointer to parent.
         class Yw3dDevice* m_Device;
 
-        // Format of the surface. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // SIMD kernels of the parent, see Yw3dDevice::GetSimdKernels().
+        const struct Yw3dSimdKernels* m_SimdKernels;
+
+        // Format of the surface. Member of the enumeration Yw3dFormat.
         Yw3dFormat m_Format;
 
         // Width of the surface in pixels.
@@ -112,6 +334,27 @@ namespace yw
         // Height - 1 of the surface in pixels.
         uint32_t m_HeightMin1;
 
+        // Memory layout of the surface pixels.
+        Yw3dSurfaceLayout m_Layout;
+
+        // Number of 4x4 tiles in a row of a tiled surface, or blocks in a row of a block compressed surface.
+        uint32_t m_TilesPerRow;
+
+        // Pending state of each fast clear tile, row by row. nullptr if fast clears are disabled.
+        uint8_t* m_FastClearTiles;
+
+        // Number of fast clear tiles in a row.
+        uint32_t m_FastClearTilesPerRow;
+
+        // Number of fast clear tile rows.
+        uint32_t m_FastClearTileRows;
+
+        // Number of tiles still waiting to be written with the fast clear value.
+        uint32_t m_FastClearPendingTiles;
+
+        // Raw pixel value of pending fast cleared tiles.
+        float m_FastClearValue[4];
+
         // True if the whole surface has been locked.
         bool m_LockedComplete;
 
@@ -121,9 +364,106 @@ namespace yw
         // Not null if a sub-rectangle of the surface has been locked.
         float* m_PartialLockData;
 
-        // Pointer to surface data.
+        // Pointer to surface data, packed depth, block compressed and compact formats are reinterpreted as their storage type.
         float* m_Data;
+
+        // Number of bytes of surface data.
+        size_t m_StorageSize;
+
+        // Object keeping the surface data alive if the data is used in place, nullptr if the data is allocated by the surface.
+        IBase* m_DataOwner;
     };
+
+    inline uint32_t Yw3dSurface::GetPixelIndex(const uint32_t x, const uint32_t y) const
+    {
+        if (Yw3d_SL_Tiled4x4 == m_Layout)
+        {
+            // Tile offset plus the offset inside the 4x4 tile.
+            return ((((y >> 2) * m_TilesPerRow + (x >> 2)) << 4) | ((y & 3) << 2) | (x & 3));
+        }
+
+        return y * m_Width + x;
+    }
+
+    inline void Yw3dSurface::DecodePixel(const uint32_t x, const uint32_t y, Vector4& outColor) const
+    {
+        const uint8_t* block = (const uint8_t*)m_Data + ((y >> 2) * m_TilesPerRow + (x >> 2)) * GetCompressedBlockBytes(m_Format);
+        DecodeCompressedPixel(m_Format, block, x & 3, y & 3, outColor);
+    }
+
+    template <uint32_t floats, bool linearFilter>
+    inline void Yw3dSurface::SampleFloats(Vector4& outColor, const float u, const float v) const
+    {
+        // u and v are in [0,1], so truncation is the same as floor.
+        const float fX = u * m_WidthMin1;
+        const float fY = v * m_HeightMin1;
+        const uint32_t pixelX = (uint32_t)fX;
+        const uint32_t pixelY = (uint32_t)fY;
+
+        float color[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+        if (!linearFilter)
+        {
+            const float* pixel = &m_Data[GetPixelIndex(pixelX, pixelY) * floats];
+            for (uint32_t c = 0; c < floats; c++)
+            {
+                color[c] = pixel[c];
+            }
+
+            outColor.Set(color[0], color[1], color[2], color[3]);
+            return;
+        }
+
+        const uint32_t pixelX2 = (pixelX < m_WidthMin1) ? (pixelX + 1) : m_WidthMin1;
+        const uint32_t pixelY2 = (pixelY < m_HeightMin1) ? (pixelY + 1) : m_HeightMin1;
+
+        // The four pixels: top-left, top-right, bottom-left and bottom-right.
+        const float* pixels[4] =
+        {
+            &m_Data[GetPixelIndex(pixelX, pixelY) * floats],
+            &m_Data[GetPixelIndex(pixelX2, pixelY) * floats],
+            &m_Data[GetPixelIndex(pixelX, pixelY2) * floats],
+            &m_Data[GetPixelIndex(pixelX2, pixelY2) * floats]
+        };
+
+        const float interpolationX = fX - (float)pixelX;
+        const float interpolationY = fY - (float)pixelY;
+
+    #ifdef YW3D_SSE2
+        if (4 == floats)
+        {
+            const __m128 weightX = _mm_set1_ps(interpolationX);
+            const __m128 topLeft = _mm_loadu_ps(pixels[0]);
+            const __m128 bottomLeft = _mm_loadu_ps(pixels[2]);
+            const __m128 top = _mm_add_ps(topLeft, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pixels[1]), topLeft), weightX));
+            const __m128 bottom = _mm_add_ps(bottomLeft, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(pixels[3]), bottomLeft), weightX));
+            _mm_storeu_ps(color, _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), _mm_set1_ps(interpolationY))));
+            outColor.Set(color[0], color[1], color[2], color[3]);
+            return;
+        }
+    #endif
+
+        for (uint32_t c = 0; c < floats; c++)
+        {
+            const float top = Lerp(pixels[0][c], pixels[1][c], interpolationX);
+            const float bottom = Lerp(pixels[2][c], pixels[3][c], interpolationX);
+            color[c] = Lerp(top, bottom, interpolationY);
+        }
+
+        outColor.Set(color[0], color[1], color[2], color[3]);
+    }
+
+    template <Yw3dFormat format, bool linearFilter>
+    inline void Yw3dSurface::SampleFormat(Vector4& outColor, const float u, const float v) const
+    {
+        // The float formats are the first enumerators, one per number of floats.
+        SampleFormat<format, linearFilter>(outColor, u, v, std::integral_constant<bool, (format <= Yw3d_FMT_R32G32B32A32F)>());
+    }
+
+    template <Yw3dFormat format, bool linearFilter>
+    inline void Yw3dSurface::SampleFormat(Vector4& outColor, const float u, const float v, std::true_type) const
+    {
+        SampleFloats<(uint32_t)format + 1, linearFilter>(outColor, u, v);
+    }
 }
 
 #endif // !__YW_3D_SURFACE_H__
@@ -4,6 +4,7 @@
 #include "Yw3dTexture.h"
 #include "Yw3dDevice.h"
 #include "Yw3dSurface.h"
+#include "Yw3dWorkerPool.h"
 
 namespace yw
 {
@@ -12,7 +13,8 @@ namespace yw
         m_MipLevels(0),
         m_SquaredWidth(0),
         m_SquaredHeight(0),
-        m_MipLevelsData(nullptr)
+        m_MipLevelsData(nullptr),
+        m_MostDetailedMipLevel(0)
     {
 
     }
@@ -27,7 +29,7 @@ namespace yw
         YW_SAFE_DELETE_ARRAY(m_MipLevelsData);
     }
 
-    Yw3dResult Yw3dTexture::Create(uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format)
+    Yw3dResult Yw3dTexture::Create(uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout, void* const* mipLevelsData, const size_t* mipLevelsDataSize, IBase* dataOwner)
     {
         if ((0 == width) || (0 == height))
         {
@@ -35,12 +37,18 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
-        if ((format < Yw3d_FMT_R32F) || (format > Yw3d_FMT_R32G32B32A32F))
+        if (((format < Yw3d_FMT_R32F) || (format > Yw3d_FMT_R32G32B32A32F)) && !IsBlockCompressedFormat(format) && !IsCompactFormat(format))
         {
             LOGE(_T("Yw3dTexture::Create: invalid format specified.\n"));
             return Yw3d_E_InvalidFormat;
         }
 
+        if ((nullptr != mipLevelsData) && ((0 == mipLevels) || (nullptr == mipLevelsDataSize)))
+        {
+            LOGE(_T("Yw3dTexture::Create: initial data requires the number of mip-levels and their sizes.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
         m_SquaredWidth = (float)(width * width);
         m_SquaredHeight = (float)(height * height);
 
@@ -65,7 +73,16 @@ namespace yw
         Yw3dSurface** curMipLevelData = m_MipLevelsData;
         while ((0 != width) && (0 != height))
         {
-            Yw3dResult resMipLevel = m_Device->CreateSurface(curMipLevelData, width, height, format);
+            Yw3dResult resMipLevel = Yw3d_S_OK;
+            if (nullptr != mipLevelsData)
+            {
+                resMipLevel = m_Device->CreateSurfaceFromMemory(curMipLevelData, width, height, format, layout, mipLevelsData[m_MipLevels], mipLevelsDataSize[m_MipLevels], dataOwner);
+            }
+            else
+            {
+                resMipLevel = m_Device->CreateSurface(curMipLevelData, width, height, format, layout);
+            }
+
             if (YW3D_FAILED(resMipLevel))
             {
                 // Destructor will perform cleanup.
@@ -131,28 +148,24 @@ namespace yw
         if ((nullptr != xGradient) && (nullptr != yGradient) && (texMipLevel < 0.0f))
         {
             // Compute the mip-level and determine the texture filter type.
-            const float lenXGrad = xGradient->x * xGradient->x * m_SquaredWidth + xGradient->y * xGradient->y * m_SquaredHeight;
-            const float lenYGrad = yGradient->x * yGradient->x * m_SquaredWidth + yGradient->y * yGradient->y * m_SquaredHeight;
-            const float texelsPerScreenPixel = max(lenXGrad, lenYGrad); // Old: sqrtf(lenXGrad > lenYGrad ? lenXGrad : lenYGrad);
-
-            if (texelsPerScreenPixel <= 1.0f)
+            texMipLevel = SelectMipLevel(*xGradient, *yGradient, m_SquaredWidth, m_SquaredHeight);
+            if (texMipLevel < 0.0f)
             {
-                // If texelsPerScreenPixel < 1.0f -> magnification, no mipmapping needed.
+                // Magnification, no mipmapping needed.
                 texMipLevel = 0.0f;
                 texFilter = samplerStates[Yw3d_TSS_MagFilter];
             }
             else
             {
                 // Minification, need mipmapping.
-                static const float invLog2 = 1.0f / logf(2.0f); // Calculate log2.
-                texMipLevel = 0.5f * logf(texelsPerScreenPixel) * invLog2; // Old: logf(texelsPerScreenPixel) * invLog2; because: "logf(sprtf(texelsPerScreenPixel)) = 0.5 * logf(texelsPerScreenPixel)", so we get better performance.
                 texFilter = samplerStates[Yw3d_TSS_MinFilter];
             }
         }
 
         const float mipLodBias = *(float*)&samplerStates[Yw3d_TSS_MipLodBias];
         const float maxMipLevel = *(float*)&samplerStates[Yw3d_TSS_MaxMipLevel];
-        texMipLevel = Clamp(texMipLevel + mipLodBias, 0.0f, maxMipLevel);
+        const float mostDetailedMipLevel = (float)m_MostDetailedMipLevel.load(std::memory_order_relaxed);
+        texMipLevel = max(Clamp(texMipLevel + mipLodBias, 0.0f, maxMipLevel), mostDetailedMipLevel);
 
         if (Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MipFilter])
         {
@@ -209,8 +222,82 @@ namespace yw
         return Yw3d_S_OK;
     }
 
+    void Yw3dTexture::ResolveFastClear()
+    {
+        for (uint32_t mipLevel = 0; mipLevel < m_MipLevels; mipLevel++)
+        {
+            m_MipLevelsData[mipLevel]->ResolveFastClear(nullptr);
+        }
+    }
+
+    Yw3dSampleFunction Yw3dTexture::GetSampleFunction(const uint32_t* samplerStates) const
+    {
+        const uint32_t addressU = samplerStates[Yw3d_TSS_AddressU];
+        const uint32_t addressV = samplerStates[Yw3d_TSS_AddressV];
+        if ((addressU >= Yw3d_TA_TextureAddresses) || (addressV >= Yw3d_TA_TextureAddresses))
+        {
+            // Let the generic function report the invalid state when sampling.
+            return IYw3dBaseTexture::GetSampleFunction(samplerStates);
+        }
+
+        // Sampling functions by format, mip-filter, minification-filter, magnification-filter, address-u and address-v.
+        #define YW3D_SAMPLE_FUNCTIONS_ADDRESS(format, mip, min, mag) \
+            { \
+                { &Yw3dTexture::SampleTextureSpecialized<format, mip, min, mag, false, false>, &Yw3dTexture::SampleTextureSpecialized<format, mip, min, mag, false, true> }, \
+                { &Yw3dTexture::SampleTextureSpecialized<format, mip, min, mag, true, false>, &Yw3dTexture::SampleTextureSpecialized<format, mip, min, mag, true, true> } \
+            }
+        #define YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, min) { YW3D_SAMPLE_FUNCTIONS_ADDRESS(format, mip, min, false), YW3D_SAMPLE_FUNCTIONS_ADDRESS(format, mip, min, true) }
+        #define YW3D_SAMPLE_FUNCTIONS_MIN(format, mip) { YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, false), YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, true) }
+        #define YW3D_SAMPLE_FUNCTIONS_MIP(format) { YW3D_SAMPLE_FUNCTIONS_MIN(format, false), YW3D_SAMPLE_FUNCTIONS_MIN(format, true) }
+
+        static const Yw3dSampleFunction sampleFunctions[Yw3d_FMT_NumFormats][2][2][2][2][2] =
+        {
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32B32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32B32A32F),
+            {}, {}, {}, {}, {}, {}, {}, {}, // Index, packed depth and block compressed formats.
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8A8),
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16B16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16B16A16F),
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8_SRGB), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8A8_SRGB)
+        };
+
+        #undef YW3D_SAMPLE_FUNCTIONS_MIP
+        #undef YW3D_SAMPLE_FUNCTIONS_MIN
+        #undef YW3D_SAMPLE_FUNCTIONS_MAG
+        #undef YW3D_SAMPLE_FUNCTIONS_ADDRESS
+
+        const Yw3dSampleFunction sampleFunction = sampleFunctions[GetFormat()]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MipFilter]) ? 1 : 0]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MinFilter]) ? 1 : 0]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MagFilter]) ? 1 : 0]
+            [(Yw3d_TA_Wrap == addressU) ? 1 : 0]
+            [(Yw3d_TA_Wrap == addressV) ? 1 : 0];
+
+        // Packed depth and block compressed textures are sampled by the generic function.
+        return (nullptr != sampleFunction) ? sampleFunction : IYw3dBaseTexture::GetSampleFunction(samplerStates);
+    }
+
+    template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag, bool wrapU, bool wrapV>
+    Yw3dResult Yw3dTexture::SampleTextureSpecialized(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float /*w*/, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
+    {
+        // Wrap without calling floor(), the conversion truncates towards zero.
+        if (wrapU)
+        {
+            u -= (float)(int32_t)u;
+            u = (u < 0.0f) ? (u + 1.0f) : u;
+        }
+
+        if (wrapV)
+        {
+            v -= (float)(int32_t)v;
+            v = (v < 0.0f) ? (v + 1.0f) : v;
+        }
+
+        ((Yw3dTexture*)texture)->SampleMipLevels<format, linearMip, linearMin, linearMag>(color, Saturate(u), Saturate(v), lod, xGradient, yGradient, samplerStates);
+
+        return Yw3d_S_OK;
+    }
+
     // From: <<Non-Power-of-Two Mipmapping>> https://www.nvidia.com/en-us/drivers/np2-mipmapping/.
-    Yw3dResult Yw3dTexture::GenerateMipSubLevels(uint32_t srcLevel)
+    Yw3dResult Yw3dTexture::GenerateMipSubLevels(uint32_t srcLevel, Yw3dMipFilter filter)
     {
         if ((srcLevel + 1) > m_MipLevels)
         {
@@ -218,314 +305,28 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
-        // Generate by each mip level.
-        for (uint32_t level = srcLevel + 1; level < m_MipLevels; level++)
+        if ((filter < Yw3d_MF_Box) || (filter >= Yw3d_MF_NumMipFilters))
         {
-            // Lock mip surface data on source data.
-            const float* srcData = nullptr;
-            Yw3dResult resLock = LockRect(level - 1, (void**)&srcData, nullptr);
-            if (YW3D_FAILED(resLock))
-            {
-                return resLock;
-            }
+            LOGE(_T("Yw3dTexture::GenerateMipSubLevels: invalid mip filter specified.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (0 == GetFormatFloats())
+        {
+            return GenerateMipSubLevelsConverted(srcLevel, filter);
+        }
 
-            // Lock mip surface data on dest data.
-            float* destData = nullptr;
-            resLock = LockRect(level, (void**)&destData, nullptr);
+        // Generate by each mip level, the rows of a level are downsampled in parallel.
+        for (uint32_t level = srcLevel + 1; level < m_MipLevels; level++)
+        {
+            Yw3dMipLevelData levelData;
+            Yw3dResult resLock = LockMipLevelData(level, levelData);
             if (YW3D_FAILED(resLock))
             {
-                UnlockRect(level - 1);
                 return resLock;
             }
 
-            // Get original width and height from source mip level.
-            const uint32_t srcWidth = GetWidth(level - 1);
-            const uint32_t srcHeight = GetHeight(level - 1);
-            const uint32_t dstWidth = GetWidth(level);
-            const uint32_t dstHeight = GetHeight(level);
-
-            switch (GetFormat())
-            {
-            case Yw3d_FMT_R32F:
-                {
-                    for (uint32_t idxY = 0; idxY < dstHeight; idxY++)
-                    {
-                        if (DetermineIfTimesOf2(srcHeight))
-                        {
-                            const uint32_t indexRows[2] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth };
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData++)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const float srcPixels[4] =
-                                    {
-                                        srcData[indexRows[0] + (2 * idxX)],
-                                        srcData[indexRows[0] + (2 * idxX + 1)],
-                                        srcData[indexRows[1] + (2 * idxX)],
-                                        srcData[indexRows[1] + (2 * idxX + 1)]
-                                    };
-
-                                    *destData = (srcPixels[0] + srcPixels[1] + srcPixels[2] + srcPixels[3]) * 0.25f;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const float row0 = w0 * srcData[indexRows[0] + (2 * idxX)] + w1 * srcData[indexRows[0] + (2 * idxX + 1)] + w2 * srcData[indexRows[0] + (2 * idxX + 2)];
-                                    const float row1 = w0 * srcData[indexRows[1] + (2 * idxX)] + w1 * srcData[indexRows[1] + (2 * idxX + 1)] + w2 * srcData[indexRows[1] + (2 * idxX + 2)];
-
-                                    *destData = (row0 + row1) * 0.5f;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            const float h0 = (float)(dstHeight - idxY) / (float)(2 * dstHeight + 1);
-                            const float h1 = (float)dstHeight / (2 * dstHeight + 1);
-                            const float h2 = (float)(1 + idxY) / (2 * dstHeight + 1);
-
-                            const uint32_t indexRows[3] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth, (2 * idxY + 2) * srcWidth };
-
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData++)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const float row0 = (srcData[indexRows[0] + (2 * idxX)] + srcData[indexRows[0] + (2 * idxX + 1)]) * 0.5f;
-                                    const float row1 = (srcData[indexRows[1] + (2 * idxX)] + srcData[indexRows[1] + (2 * idxX + 1)]) * 0.5f;
-                                    const float row2 = (srcData[indexRows[2] + (2 * idxX)] + srcData[indexRows[2] + (2 * idxX + 1)]) * 0.5f;
-
-                                    *destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const float row0 = w0 * srcData[indexRows[0] + (2 * idxX)] + w1 * srcData[indexRows[0] + (2 * idxX + 1)] + w2 * srcData[indexRows[0] + (2 * idxX + 2)];
-                                    const float row1 = w0 * srcData[indexRows[1] + (2 * idxX)] + w1 * srcData[indexRows[1] + (2 * idxX + 1)] + w2 * srcData[indexRows[1] + (2 * idxX + 2)];
-                                    const float row2 = w0 * srcData[indexRows[2] + (2 * idxX)] + w1 * srcData[indexRows[2] + (2 * idxX + 1)] + w2 * srcData[indexRows[2] + (2 * idxX + 2)];
-
-                                    *destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                            }
-                        }
-                    }
-                }
-                break;
-            case Yw3d_FMT_R32G32F:
-                {
-                    for (uint32_t idxY = 0; idxY < dstHeight; idxY++)
-                    {
-                        if (DetermineIfTimesOf2(srcHeight))
-                        {
-                            const uint32_t indexRows[2] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth };
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData += 2)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const Vector2* srcPixels[4] =
-                                    {
-                                        &((Vector2*)srcData)[indexRows[0] + (2 * idxX)],
-                                        &((Vector2*)srcData)[indexRows[0] + (2 * idxX + 1)],
-                                        &((Vector2*)srcData)[indexRows[1] + (2 * idxX)],
-                                        &((Vector2*)srcData)[indexRows[1] + (2 * idxX + 1)]
-                                    };
-
-                                    *(Vector2*)destData = (*srcPixels[0] + *srcPixels[1] + *srcPixels[2] + *srcPixels[3]) * 0.25f;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const Vector2 row0 = w0 * ((Vector2*)srcData)[indexRows[0] + (2 * idxX)] + w1 * ((Vector2*)srcData)[indexRows[0] + (2 * idxX + 1)] + w2 * ((Vector2*)srcData)[indexRows[0] + (2 * idxX + 2)];
-                                    const Vector2 row1 = w0 * ((Vector2*)srcData)[indexRows[1] + (2 * idxX)] + w1 * ((Vector2*)srcData)[indexRows[1] + (2 * idxX + 1)] + w2 * ((Vector2*)srcData)[indexRows[1] + (2 * idxX + 2)];
-
-                                    *(Vector2*)destData = (row0 + row1) * 0.5f;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            const float h0 = (float)(dstHeight - idxY) / (float)(2 * dstHeight + 1);
-                            const float h1 = (float)dstHeight / (2 * dstHeight + 1);
-                            const float h2 = (float)(1 + idxY) / (2 * dstHeight + 1);
-
-                            const uint32_t indexRows[3] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth, (2 * idxY + 2) * srcWidth };
-
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData += 2)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const Vector2 row0 = (((Vector2*)srcData)[indexRows[0] + (2 * idxX)] + ((Vector2*)srcData)[indexRows[0] + (2 * idxX + 1)]) * 0.5f;
-                                    const Vector2 row1 = (((Vector2*)srcData)[indexRows[1] + (2 * idxX)] + ((Vector2*)srcData)[indexRows[1] + (2 * idxX + 1)]) * 0.5f;
-                                    const Vector2 row2 = (((Vector2*)srcData)[indexRows[2] + (2 * idxX)] + ((Vector2*)srcData)[indexRows[2] + (2 * idxX + 1)]) * 0.5f;
-
-                                    *(Vector2*)destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const Vector2 row0 = w0 * ((Vector2*)srcData)[indexRows[0] + (2 * idxX)] + w1 * ((Vector2*)srcData)[indexRows[0] + (2 * idxX + 1)] + w2 * ((Vector2*)srcData)[indexRows[0] + (2 * idxX + 2)];
-                                    const Vector2 row1 = w0 * ((Vector2*)srcData)[indexRows[1] + (2 * idxX)] + w1 * ((Vector2*)srcData)[indexRows[1] + (2 * idxX + 1)] + w2 * ((Vector2*)srcData)[indexRows[1] + (2 * idxX + 2)];
-                                    const Vector2 row2 = w0 * ((Vector2*)srcData)[indexRows[2] + (2 * idxX)] + w1 * ((Vector2*)srcData)[indexRows[2] + (2 * idxX + 1)] + w2 * ((Vector2*)srcData)[indexRows[2] + (2 * idxX + 2)];
-
-                                    *(Vector2*)destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                            }
-                        }
-                    }
-                }
-                break;
-            case Yw3d_FMT_R32G32B32F:
-                {
-                    for (uint32_t idxY = 0; idxY < dstHeight; idxY++)
-                    {
-                        if (DetermineIfTimesOf2(srcHeight))
-                        {
-                            const uint32_t indexRows[2] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth };
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData += 3)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const Vector3* srcPixels[4] =
-                                    {
-                                        &((Vector3*)srcData)[indexRows[0] + (2 * idxX)],
-                                        &((Vector3*)srcData)[indexRows[0] + (2 * idxX + 1)],
-                                        &((Vector3*)srcData)[indexRows[1] + (2 * idxX)],
-                                        &((Vector3*)srcData)[indexRows[1] + (2 * idxX + 1)]
-                                    };
-
-                                    *(Vector3*)destData = (*srcPixels[0] + *srcPixels[1] + *srcPixels[2] + *srcPixels[3]) * 0.25f;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const Vector3 row0 = w0 * ((Vector3*)srcData)[indexRows[0] + (2 * idxX)] + w1 * ((Vector3*)srcData)[indexRows[0] + (2 * idxX + 1)] + w2 * ((Vector3*)srcData)[indexRows[0] + (2 * idxX + 2)];
-                                    const Vector3 row1 = w0 * ((Vector3*)srcData)[indexRows[1] + (2 * idxX)] + w1 * ((Vector3*)srcData)[indexRows[1] + (2 * idxX + 1)] + w2 * ((Vector3*)srcData)[indexRows[1] + (2 * idxX + 2)];
-
-                                    *(Vector3*)destData = (row0 + row1) * 0.5f;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            const float h0 = (float)(dstHeight - idxY) / (float)(2 * dstHeight + 1);
-                            const float h1 = (float)dstHeight / (2 * dstHeight + 1);
-                            const float h2 = (float)(1 + idxY) / (2 * dstHeight + 1);
-
-                            const uint32_t indexRows[3] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth, (2 * idxY + 2) * srcWidth };
-
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData += 3)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const Vector3 row0 = (((Vector3*)srcData)[indexRows[0] + (2 * idxX)] + ((Vector3*)srcData)[indexRows[0] + (2 * idxX + 1)]) * 0.5f;
-                                    const Vector3 row1 = (((Vector3*)srcData)[indexRows[1] + (2 * idxX)] + ((Vector3*)srcData)[indexRows[1] + (2 * idxX + 1)]) * 0.5f;
-                                    const Vector3 row2 = (((Vector3*)srcData)[indexRows[2] + (2 * idxX)] + ((Vector3*)srcData)[indexRows[2] + (2 * idxX + 1)]) * 0.5f;
-
-                                    *(Vector3*)destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const Vector3 row0 = w0 * ((Vector3*)srcData)[indexRows[0] + (2 * idxX)] + w1 * ((Vector3*)srcData)[indexRows[0] + (2 * idxX + 1)] + w2 * ((Vector3*)srcData)[indexRows[0] + (2 * idxX + 2)];
-                                    const Vector3 row1 = w0 * ((Vector3*)srcData)[indexRows[1] + (2 * idxX)] + w1 * ((Vector3*)srcData)[indexRows[1] + (2 * idxX + 1)] + w2 * ((Vector3*)srcData)[indexRows[1] + (2 * idxX + 2)];
-                                    const Vector3 row2 = w0 * ((Vector3*)srcData)[indexRows[2] + (2 * idxX)] + w1 * ((Vector3*)srcData)[indexRows[2] + (2 * idxX + 1)] + w2 * ((Vector3*)srcData)[indexRows[2] + (2 * idxX + 2)];
-
-                                    *(Vector3*)destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                            }
-                        }
-                    }
-                }
-                break;
-            case Yw3d_FMT_R32G32B32A32F:
-                {
-                    for (uint32_t idxY = 0; idxY < dstHeight; idxY++)
-                    {
-                        if (DetermineIfTimesOf2(srcHeight))
-                        {
-                            const uint32_t indexRows[2] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth};
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData += 4)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const Vector4* srcPixels[4] =
-                                    {
-                                        &((Vector4*)srcData)[indexRows[0] + (2 * idxX)],
-                                        &((Vector4*)srcData)[indexRows[0] + (2 * idxX + 1)],
-                                        &((Vector4*)srcData)[indexRows[1] + (2 * idxX)],
-                                        &((Vector4*)srcData)[indexRows[1] + (2 * idxX + 1)]
-                                    };
-
-                                    *(Vector4*)destData = (*srcPixels[0] + *srcPixels[1] + *srcPixels[2] + *srcPixels[3]) * 0.25f;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const Vector4 row0 = w0 * ((Vector4*)srcData)[indexRows[0] + (2 * idxX)] + w1 * ((Vector4*)srcData)[indexRows[0] + (2 * idxX + 1)] + w2 * ((Vector4*)srcData)[indexRows[0] + (2 * idxX + 2)];
-                                    const Vector4 row1 = w0 * ((Vector4*)srcData)[indexRows[1] + (2 * idxX)] + w1 * ((Vector4*)srcData)[indexRows[1] + (2 * idxX + 1)] + w2 * ((Vector4*)srcData)[indexRows[1] + (2 * idxX + 2)];
-
-                                    *(Vector4*)destData = (row0 + row1) * 0.5f;
-                                }
-                            }
-                        }
-                        else
-                        {
-                            const float h0 = (float)(dstHeight - idxY) / (float)(2 * dstHeight + 1);
-                            const float h1 = (float)dstHeight / (2 * dstHeight + 1);
-                            const float h2 = (float)(1 + idxY) / (2 * dstHeight + 1);
-
-                            const uint32_t indexRows[3] = { 2 * idxY * srcWidth, (2 * idxY + 1) * srcWidth, (2 * idxY + 2) * srcWidth };
-
-                            for (uint32_t idxX = 0; idxX < dstWidth; idxX++, destData += 4)
-                            {
-                                if (DetermineIfTimesOf2(srcWidth))
-                                {
-                                    const Vector4 row0 = (((Vector4*)srcData)[indexRows[0] + (2 * idxX)] + ((Vector4*)srcData)[indexRows[0] + (2 * idxX + 1)]) * 0.5f;
-                                    const Vector4 row1 = (((Vector4*)srcData)[indexRows[1] + (2 * idxX)] + ((Vector4*)srcData)[indexRows[1] + (2 * idxX + 1)]) * 0.5f;
-                                    const Vector4 row2 = (((Vector4*)srcData)[indexRows[2] + (2 * idxX)] + ((Vector4*)srcData)[indexRows[2] + (2 * idxX + 1)]) * 0.5f;
-
-                                    *(Vector4*)destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                                else
-                                {
-                                    const float w0 = (float)(dstWidth - idxX) / (float)(2.0f * dstWidth + 1.0f);
-                                    const float w1 = (float)dstWidth / (2.0f * dstWidth + 1.0f);
-                                    const float w2 = (float)(1 + idxX) / (2.0f * dstWidth + 1.0f);
-
-                                    const Vector4 row0 = w0 * ((Vector4*)srcData)[indexRows[0] + (2 * idxX)] + w1 * ((Vector4*)srcData)[indexRows[0] + (2 * idxX + 1)] + w2 * ((Vector4*)srcData)[indexRows[0] + (2 * idxX + 2)];
-                                    const Vector4 row1 = w0 * ((Vector4*)srcData)[indexRows[1] + (2 * idxX)] + w1 * ((Vector4*)srcData)[indexRows[1] + (2 * idxX + 1)] + w2 * ((Vector4*)srcData)[indexRows[1] + (2 * idxX + 2)];
-                                    const Vector4 row2 = w0 * ((Vector4*)srcData)[indexRows[2] + (2 * idxX)] + w1 * ((Vector4*)srcData)[indexRows[2] + (2 * idxX + 1)] + w2 * ((Vector4*)srcData)[indexRows[2] + (2 * idxX + 2)];
-
-                                    *(Vector4*)destData = h0 * row0 + h1 * row1 + h2 * row2;
-                                }
-                            }
-                        }
-                    }
-                }
-                break;
-            default:
-                // This can not happen.
-                break;
-            }
+            GenerateMipLevels(m_Device->GetWorkerPool(), m_Device->GetSimdKernels(), &levelData, 1, GetFormatFloats(), filter);
 
             // Unlock data.
             UnlockRect(level);
@@ -535,6 +336,61 @@ namespace yw
         return Yw3d_S_OK;
     }
 
+    Yw3dResult Yw3dTexture::LockMipLevelData(uint32_t level, Yw3dMipLevelData& outLevelData)
+    {
+        // Lock mip surface data on source data.
+        Yw3dResult resLock = LockRect(level - 1, (void**)&outLevelData.srcData, nullptr);
+        if (YW3D_FAILED(resLock))
+        {
+            return resLock;
+        }
+
+        // Lock mip surface data on dest data.
+        resLock = LockRect(level, (void**)&outLevelData.destData, nullptr);
+        if (YW3D_FAILED(resLock))
+        {
+            UnlockRect(level - 1);
+            return resLock;
+        }
+
+        outLevelData.srcWidth = GetWidth(level - 1);
+        outLevelData.srcHeight = GetHeight(level - 1);
+        outLevelData.srcDepth = 1;
+        outLevelData.destWidth = GetWidth(level);
+        outLevelData.destHeight = GetHeight(level);
+        outLevelData.destDepth = 1;
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dTexture::GenerateMipSubLevelsConverted(uint32_t srcLevel, Yw3dMipFilter filter)
+    {
+        // The float texture has the same mip-chain.
+        Yw3dTexture* floatTexture = nullptr;
+        Yw3dResult result = m_Device->CreateTexture(&floatTexture, GetWidth(), GetHeight(), m_MipLevels, m_MipLevelsData[0]->GetFloatFormat());
+        if (YW3D_FAILED(result))
+        {
+            LOGE(_T("Yw3dTexture::GenerateMipSubLevelsConverted: creation of float texture failed.\n"));
+            return result;
+        }
+
+        // Convert the source level, downsample in float and convert the sub levels back.
+        result = m_MipLevelsData[srcLevel]->CopyToSurface(nullptr, floatTexture->m_MipLevelsData[srcLevel], nullptr, Yw3d_TF_Point);
+        if (YW3D_SUCCESSFUL(result))
+        {
+            result = floatTexture->GenerateMipSubLevels(srcLevel, filter);
+        }
+
+        for (uint32_t level = srcLevel + 1; YW3D_SUCCESSFUL(result) && (level < m_MipLevels); level++)
+        {
+            result = floatTexture->m_MipLevelsData[level]->CopyToSurface(nullptr, m_MipLevelsData[level], nullptr, Yw3d_TF_Point);
+        }
+
+        YW_SAFE_RELEASE(floatTexture);
+
+        return result;
+    }
+
     Yw3dResult Yw3dTexture::Clear(uint32_t mipLevel, const Vector4& color, const Yw3dRect* rect)
     {
         if (mipLevel >= m_MipLevels)
@@ -616,4 +472,15 @@ namespace yw
 
         return m_MipLevelsData[mipLevel]->GetHeight();
     }
+
+    void Yw3dTexture::SetMostDetailedMipLevel(uint32_t mipLevel)
+    {
+        mipLevel = (mipLevel >= m_MipLevels) ? (m_MipLevels - 1) : mipLevel;
+        m_MostDetailedMipLevel.store(mipLevel, std::memory_order_release);
+    }
+
+    uint32_t Yw3dTexture::GetMostDetailedMipLevel() const
+    {
+        return m_MostDetailedMipLevel.load(std::memory_order_acquire);
+    }
 }
@@ -7,6 +7,9 @@
 #include "Yw3dBase.h"
 #include "Yw3dTypes.h"
 #include "Yw3dBaseTexture.h"
+#include "Yw3dMipmap.h"
+#include "Yw3dSurface.h"
+#include <atomic>
 
 namespace yw
 {
@@ -15,6 +18,7 @@ namespace yw
     {
         friend class Yw3dDevice;
         friend class Yw3dCubeTexture;
+        friend class Yw3dTextureArray;
 
     protected:
         // Accessible by Yw3dDevice which is the only class that may create a texture.
@@ -29,12 +33,16 @@ namespace yw
         // @param[in] width width of the texture to be created in pixels.
         // @param[in] height height of the texture to be created in pixels.
         // @param[in] mipLevels number of mip-levels to be created. Specify 0 to create a full mip-chain.
-        // @param[in] format format of the texture to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // @param[in] format format of the texture to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
+        // @param[in] layout memory layout of the mip-levels. Member of the enumeration Yw3dSurfaceLayout.
+        // @param[in] mipLevelsData initial pixels of each mip-level in the memory layout of its surface, see Yw3dSurface::Create(). (Pass 0 to leave the pixels undefined.)
+        // @param[in] mipLevelsDataSize number of bytes of the initial pixels of each mip-level.
+        // @param[in] dataOwner object keeping the initial pixels alive if they are used in place. (Pass 0 to copy the pixels.)
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
-        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format);
+        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout = Yw3d_SL_Linear, void* const* mipLevelsData = nullptr, const size_t* mipLevelsDataSize = nullptr, IBase* dataOwner = nullptr);
 
         // Sampling this texture requires 2 floating point coordinates.
         Yw3dTextureSampleInput GetTextureSampleInput() const;
@@ -52,15 +60,39 @@ namespace yw
         // @return Yw3d_S_OK if the function succeeds.
         Yw3dResult SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
 
+        // Returns a sampling function specialized for the format of the texture and the address, filter and mip states.
+        // Falls back to SampleTextureGeneric() if a state is invalid.
+        // @param[in] samplerStates texture sampler states.
+        Yw3dSampleFunction GetSampleFunction(const uint32_t* samplerStates) const;
+
+        // Writes the pending fast cleared tiles of all mip-levels.
+        void ResolveFastClear();
+
+        // Accessible by Yw3dCubeTexture and Yw3dTextureArray.
+        // Selects the mip-levels and filter as SampleTexture() does and samples them, specialized for the format and the filter states.
+        // @param[in] u u-component of the lookup-vector, e [0,1].
+        // @param[in] v v-component of the lookup-vector, e [0,1].
+        template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag>
+        inline void SampleMipLevels(Vector4& color, float u, float v, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
+    private:
+        // Sampling function specialized for the format, the filter states and the address states of u and v.
+        template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag, bool wrapU, bool wrapV>
+        static Yw3dResult SampleTextureSpecialized(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
     public:
-        // Generates mip-sublevels through downsampling (using a box-filter) a given source mip-level with POT or NPOT.
+        // Generates mip-sublevels through downsampling (using a box-filter by default) a given source mip-level with POT or NPOT.
+        // The rows of each level are downsampled in parallel by the worker pool of the device.
         // For more information, please visit:
         //     https://www.nvidia.com/en-us/drivers/np2-mipmapping/ <<Non-Power-of-Two Mipmapping>> or
         //     https://download.nvidia.com/developer/Papers/2005/NP2_Mipmapping/NP2_Mipmap_Creation.pdf <<Non-Power-of-Two Mipmap Creation>>.
         // @param[in] srcLevel the mip-level which will be taken as the starting point.
+        // @param[in] filter member of the enumeration Yw3dMipFilter.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
-        Yw3dResult GenerateMipSubLevels(uint32_t srcLevel);
+        // @return Yw3d_E_OutOfMemory if memory allocation for the conversion of a compact or block compressed texture failed.
+        // @note Compact and block compressed textures are downsampled in a float texture and converted back.
+        Yw3dResult GenerateMipSubLevels(uint32_t srcLevel, Yw3dMipFilter filter = Yw3d_MF_Box);
 
         // Clears the texture to a given color.
         // @param[in] mipLevel the mip-level to be cleared.
@@ -92,10 +124,10 @@ namespace yw
         // @param[in] mipLevel mip-level, 0 being the largest mip-level.
         class Yw3dSurface* AcquireMipLevel(uint32_t mipLevel);
 
-        // Returns the format of the texture. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // Returns the format of the texture. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
         Yw3dFormat GetFormat() const;
 
-        // Returns the number of floats of the format, e [1,4].
+        // Returns the number of floats of the format, e [1,4], 0 for block compressed and compact formats.
         uint32_t GetFormatFloats() const;
 
         // Returns the number of mip-levels this texture consists of.
@@ -109,6 +141,26 @@ namespace yw
         // @param[in] mipLevel the mip-level whose height is requested.
         uint32_t GetHeight(uint32_t mipLevel = 0) const;
 
+        // Sets the most detailed mip-level which may be sampled, finer mip-levels are skipped by sampling as if the lod was clamped.
+        // Used by progressive loading: a texture becomes usable from its coarse mip-levels and the finer ones are swapped in while they arrive.
+        // @param[in] mipLevel the most detailed mip-level, clamped to the last mip-level.
+        void SetMostDetailedMipLevel(uint32_t mipLevel);
+
+        //< Returns the most detailed mip-level which may be sampled.
+        uint32_t GetMostDetailedMipLevel() const;
+
+    private:
+        // Generates mip-sublevels of a compact or block compressed texture in a float texture and converts them back.
+        // @param[in] srcLevel the validated mip-level which will be taken as the starting point.
+        // @param[in] filter the validated mip filter.
+        Yw3dResult GenerateMipSubLevelsConverted(uint32_t srcLevel, Yw3dMipFilter filter);
+
+        // Locks a float mip-level and the one above it for downsampling, both have to be unlocked by the caller.
+        // @param[in] level the destination mip-level, e [1, GetMipLevels()).
+        // @param[out] outLevelData receives the data and dimensions of both levels.
+        // @return Yw3d_S_OK if the function succeeds.
+        Yw3dResult LockMipLevelData(uint32_t level, Yw3dMipLevelData& outLevelData);
+
     private:
         // Number of mip-levels.
         uint32_t m_MipLevels;
@@ -119,7 +171,64 @@ namespace yw
 
         // Pointer to the mip-level data.
         class Yw3dSurface** m_MipLevelsData;
+
+        // The most detailed mip-level which may be sampled.
+        std::atomic<uint32_t> m_MostDetailedMipLevel;
     };
+
+    template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag>
+    inline void Yw3dTexture::SampleMipLevels(Vector4& color, float u, float v, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
+    {
+        bool linearFilter = linearMin;
+        float texMipLevel = lod;
+
+        // Choose proper mip level and filter, see SampleTexture().
+        if ((nullptr != xGradient) && (nullptr != yGradient) && (texMipLevel < 0.0f))
+        {
+            texMipLevel = SelectMipLevel(*xGradient, *yGradient, m_SquaredWidth, m_SquaredHeight);
+            if (texMipLevel < 0.0f)
+            {
+                texMipLevel = 0.0f;
+                linearFilter = linearMag;
+            }
+        }
+
+        const float mipLodBias = *(const float*)&samplerStates[Yw3d_TSS_MipLodBias];
+        const float maxMipLevel = *(const float*)&samplerStates[Yw3d_TSS_MaxMipLevel];
+        const float mostDetailedMipLevel = (float)m_MostDetailedMipLevel.load(std::memory_order_relaxed);
+        texMipLevel = max(Clamp(texMipLevel + mipLodBias, 0.0f, maxMipLevel), mostDetailedMipLevel);
+
+        // The mip-level is not negative, so truncation is the same as floor.
+        uint32_t mipLevelA = (uint32_t)texMipLevel;
+        mipLevelA = (mipLevelA >= m_MipLevels) ? (m_MipLevels - 1) : mipLevelA;
+        if (linearMip && (mipLevelA + 1 < m_MipLevels))
+        {
+            Vector4 colorA;
+            Vector4 colorB;
+            if (linearFilter)
+            {
+                m_MipLevelsData[mipLevelA]->SampleFormat<format, true>(colorA, u, v);
+                m_MipLevelsData[mipLevelA + 1]->SampleFormat<format, true>(colorB, u, v);
+            }
+            else
+            {
+                m_MipLevelsData[mipLevelA]->SampleFormat<format, false>(colorA, u, v);
+                m_MipLevelsData[mipLevelA + 1]->SampleFormat<format, false>(colorB, u, v);
+            }
+
+            Vector4Lerp(color, colorA, colorB, texMipLevel - (float)mipLevelA);
+            return;
+        }
+
+        if (linearFilter)
+        {
+            m_MipLevelsData[mipLevelA]->SampleFormat<format, true>(color, u, v);
+        }
+        else
+        {
+            m_MipLevelsData[mipLevelA]->SampleFormat<format, false>(color, u, v);
+        }
+    }
 }
 
 #endif // !__YW_3D_TEXTURE_H__
\ No newline at end of file
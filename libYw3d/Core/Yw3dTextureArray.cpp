@@ -0,0 +1,292 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer texture array class.
+
+#include "Yw3dTextureArray.h"
+#include "Yw3dDevice.h"
+#include "Yw3dTexture.h"
+#include "Yw3dWorkerPool.h"
+
+namespace yw
+{
+    Yw3dTextureArray::Yw3dTextureArray(Yw3dDevice* device) :
+        IYw3dBaseTexture(device),
+        m_NumLayers(0),
+        m_Layers(nullptr),
+        m_MaxLayer(0.0f)
+    {
+    }
+
+    // Accessible by IBase. The destructor is called when the reference count reaches zero.
+    Yw3dTextureArray::~Yw3dTextureArray()
+    {
+        if (nullptr != m_Layers)
+        {
+            for (uint32_t layer = 0; layer < m_NumLayers; layer++)
+            {
+                YW_SAFE_RELEASE(m_Layers[layer]);
+            }
+
+            YW_SAFE_DELETE_ARRAY(m_Layers);
+        }
+    }
+
+    Yw3dResult Yw3dTextureArray::Create(uint32_t width, uint32_t height, uint32_t layers, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout)
+    {
+        if ((0 == width) || (0 == height) || (0 == layers))
+        {
+            LOGE(_T("Yw3dTextureArray::Create: texture dimensions or number of layers are invalid.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if (((format < Yw3d_FMT_R32F) || (format > Yw3d_FMT_R32G32B32A32F)) && !IsBlockCompressedFormat(format) && !IsCompactFormat(format))
+        {
+            LOGE(_T("Yw3dTextureArray::Create: invalid format specified.\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
+        m_Layers = new Yw3dTexture*[layers];
+        if (nullptr == m_Layers)
+        {
+            LOGE(_T("Yw3dTextureArray::Create: out of memory, cannot create layers.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        memset(m_Layers, 0, sizeof(Yw3dTexture*) * layers);
+        m_NumLayers = layers;
+        m_MaxLayer = (float)(layers - 1);
+
+        for (uint32_t layer = 0; layer < m_NumLayers; layer++)
+        {
+            // Destructor will perform cleanup.
+            Yw3dResult resCreate = m_Device->CreateTexture(&m_Layers[layer], width, height, mipLevels, format, layout);
+            if (YW3D_FAILED(resCreate))
+            {
+                return resCreate;
+            }
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dTextureSampleInput Yw3dTextureArray::GetTextureSampleInput() const
+    {
+        return Yw3d_TSI_2CoordsLayer;
+    }
+
+    inline Yw3dTexture* Yw3dTextureArray::GetLayerForSample(float w) const
+    {
+        // Round to the nearest layer, the conversion truncates towards zero.
+        w = (w > 0.0f) ? ((w < m_MaxLayer) ? w : m_MaxLayer) : 0.0f;
+        return m_Layers[(uint32_t)(w + 0.5f)];
+    }
+
+    Yw3dResult Yw3dTextureArray::SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
+    {
+        return GetLayerForSample(w)->SampleTexture(color, u, v, 0.0f, lod, xGradient, yGradient, samplerStates);
+    }
+
+    void Yw3dTextureArray::ResolveFastClear()
+    {
+        for (uint32_t layer = 0; layer < m_NumLayers; layer++)
+        {
+            m_Layers[layer]->ResolveFastClear();
+        }
+    }
+
+    Yw3dSampleFunction Yw3dTextureArray::GetSampleFunction(const uint32_t* samplerStates) const
+    {
+        const uint32_t addressU = samplerStates[Yw3d_TSS_AddressU];
+        const uint32_t addressV = samplerStates[Yw3d_TSS_AddressV];
+        if ((addressU >= Yw3d_TA_TextureAddresses) || (addressV >= Yw3d_TA_TextureAddresses))
+        {
+            // Let the generic function report the invalid state when sampling.
+            return IYw3dBaseTexture::GetSampleFunction(samplerStates);
+        }
+
+        // Sampling functions by format, mip-filter, minification-filter, magnification-filter, address-u and address-v.
+        #define YW3D_SAMPLE_FUNCTIONS_ADDRESS(format, mip, min, mag) \
+            { \
+                { &Yw3dTextureArray::SampleTextureSpecialized<format, mip, min, mag, false, false>, &Yw3dTextureArray::SampleTextureSpecialized<format, mip, min, mag, false, true> }, \
+                { &Yw3dTextureArray::SampleTextureSpecialized<format, mip, min, mag, true, false>, &Yw3dTextureArray::SampleTextureSpecialized<format, mip, min, mag, true, true> } \
+            }
+        #define YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, min) { YW3D_SAMPLE_FUNCTIONS_ADDRESS(format, mip, min, false), YW3D_SAMPLE_FUNCTIONS_ADDRESS(format, mip, min, true) }
+        #define YW3D_SAMPLE_FUNCTIONS_MIN(format, mip) { YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, false), YW3D_SAMPLE_FUNCTIONS_MAG(format, mip, true) }
+        #define YW3D_SAMPLE_FUNCTIONS_MIP(format) { YW3D_SAMPLE_FUNCTIONS_MIN(format, false), YW3D_SAMPLE_FUNCTIONS_MIN(format, true) }
+
+        static const Yw3dSampleFunction sampleFunctions[Yw3d_FMT_NumFormats][2][2][2][2][2] =
+        {
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32B32F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R32G32B32A32F),
+            {}, {}, {}, {}, {}, {}, {}, {}, // Index, packed depth and block compressed formats.
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8A8),
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16B16F), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R16G16B16A16F),
+            YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8_SRGB), YW3D_SAMPLE_FUNCTIONS_MIP(Yw3d_FMT_R8G8B8A8_SRGB)
+        };
+
+        #undef YW3D_SAMPLE_FUNCTIONS_MIP
+        #undef YW3D_SAMPLE_FUNCTIONS_MIN
+        #undef YW3D_SAMPLE_FUNCTIONS_MAG
+        #undef YW3D_SAMPLE_FUNCTIONS_ADDRESS
+
+        const Yw3dSampleFunction sampleFunction = sampleFunctions[GetFormat()]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MipFilter]) ? 1 : 0]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MinFilter]) ? 1 : 0]
+            [(Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MagFilter]) ? 1 : 0]
+            [(Yw3d_TA_Wrap == addressU) ? 1 : 0]
+            [(Yw3d_TA_Wrap == addressV) ? 1 : 0];
+
+        // Packed depth and block compressed textures are sampled by the generic function.
+        return (nullptr != sampleFunction) ? sampleFunction : IYw3dBaseTexture::GetSampleFunction(samplerStates);
+    }
+
+    template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag, bool wrapU, bool wrapV>
+    Yw3dResult Yw3dTextureArray::SampleTextureSpecialized(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
+    {
+        // Wrap without calling floor(), the conversion truncates towards zero.
+        if (wrapU)
+        {
+            u -= (float)(int32_t)u;
+            u = (u < 0.0f) ? (u + 1.0f) : u;
+        }
+
+        if (wrapV)
+        {
+            v -= (float)(int32_t)v;
+            v = (v < 0.0f) ? (v + 1.0f) : v;
+        }
+
+        ((Yw3dTextureArray*)texture)->GetLayerForSample(w)->SampleMipLevels<format, linearMip, linearMin, linearMag>(color, Saturate(u), Saturate(v), lod, xGradient, yGradient, samplerStates);
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dTextureArray::GenerateMipSubLevels(uint32_t srcLevel, Yw3dMipFilter filter)
+    {
+        if ((srcLevel + 1) > GetMipLevels())
+        {
+            LOGE(_T("Yw3dTextureArray::GenerateMipSubLevels: srcLevel refers either to last mip-level or is larger than the number of mip-levels.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        // Compact and block compressed layers are converted through float textures layer by layer.
+        if (0 == GetFormatFloats())
+        {
+            for (uint32_t layer = 0; layer < m_NumLayers; layer++)
+            {
+                Yw3dResult resLayer = m_Layers[layer]->GenerateMipSubLevels(srcLevel, filter);
+                if (YW3D_FAILED(resLayer))
+                {
+                    return resLayer;
+                }
+            }
+
+            return Yw3d_S_OK;
+        }
+
+        if ((filter < Yw3d_MF_Box) || (filter >= Yw3d_MF_NumMipFilters))
+        {
+            LOGE(_T("Yw3dTextureArray::GenerateMipSubLevels: invalid mip filter specified.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        Yw3dMipLevelData* levelData = new Yw3dMipLevelData[m_NumLayers];
+        if (nullptr == levelData)
+        {
+            LOGE(_T("Yw3dTextureArray::GenerateMipSubLevels: out of memory, cannot create level data.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        // Generate by each mip level, the rows of all layers are downsampled concurrently.
+        Yw3dResult resLock = Yw3d_S_OK;
+        for (uint32_t level = srcLevel + 1; (level < GetMipLevels()) && YW3D_SUCCESSFUL(resLock); level++)
+        {
+            uint32_t lockedLayers = 0;
+            for (; lockedLayers < m_NumLayers; lockedLayers++)
+            {
+                resLock = m_Layers[lockedLayers]->LockMipLevelData(level, levelData[lockedLayers]);
+                if (YW3D_FAILED(resLock))
+                {
+                    break;
+                }
+            }
+
+            if (YW3D_SUCCESSFUL(resLock))
+            {
+                GenerateMipLevels(m_Device->GetWorkerPool(), m_Device->GetSimdKernels(), levelData, lockedLayers, GetFormatFloats(), filter);
+            }
+
+            // Unlock data.
+            for (uint32_t layer = 0; layer < lockedLayers; layer++)
+            {
+                m_Layers[layer]->UnlockRect(level);
+                m_Layers[layer]->UnlockRect(level - 1);
+            }
+        }
+
+        YW_SAFE_DELETE_ARRAY(levelData);
+        return resLock;
+    }
+
+    Yw3dResult Yw3dTextureArray::LockRect(uint32_t layer, uint32_t mipLevel, void** data, const Yw3dRect* rect)
+    {
+        if (layer >= m_NumLayers)
+        {
+            LOGE(_T("Yw3dTextureArray::LockRect: invalid layer requested.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        return m_Layers[layer]->LockRect(mipLevel, data, rect);
+    }
+
+    Yw3dResult Yw3dTextureArray::UnlockRect(uint32_t layer, uint32_t mipLevel)
+    {
+        if (layer >= m_NumLayers)
+        {
+            LOGE(_T("Yw3dTextureArray::UnlockRect: invalid layer specified.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        return m_Layers[layer]->UnlockRect(mipLevel);
+    }
+
+    Yw3dFormat Yw3dTextureArray::GetFormat() const
+    {
+        return m_Layers[0]->GetFormat();
+    }
+
+    uint32_t Yw3dTextureArray::GetFormatFloats() const
+    {
+        return m_Layers[0]->GetFormatFloats();
+    }
+
+    uint32_t Yw3dTextureArray::GetLayers() const
+    {
+        return m_NumLayers;
+    }
+
+    uint32_t Yw3dTextureArray::GetMipLevels() const
+    {
+        return m_Layers[0]->GetMipLevels();
+    }
+
+    uint32_t Yw3dTextureArray::GetWidth(uint32_t mipLevel) const
+    {
+        return m_Layers[0]->GetWidth(mipLevel);
+    }
+
+    uint32_t Yw3dTextureArray::GetHeight(uint32_t mipLevel) const
+    {
+        return m_Layers[0]->GetHeight(mipLevel);
+    }
+
+    Yw3dTexture* Yw3dTextureArray::AcquireLayer(uint32_t layer)
+    {
+        if (layer >= m_NumLayers)
+        {
+            LOGE(_T("Yw3dTextureArray::AcquireLayer: invalid layer requested.\n"));
+            return nullptr;
+        }
+
+        m_Layers[layer]->AddRef();
+        return m_Layers[layer];
+    }
+}
@@ -0,0 +1,139 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer texture array class.
+
+#ifndef __YW_3D_TEXTURE_ARRAY_H__
+#define __YW_3D_TEXTURE_ARRAY_H__
+
+#include "Yw3dBase.h"
+#include "Yw3dTypes.h"
+#include "Yw3dBaseTexture.h"
+
+namespace yw
+{
+    // Yw3dTextureArray implements an array of 2-dimensional textures of the same size, format and number of mip-levels.
+    // A layer is selected by the w-coordinate, so the textures of many materials are bound to one sampler and drawn in one batch.
+    class Yw3dTextureArray : public IYw3dBaseTexture
+    {
+        friend class Yw3dDevice;
+
+    protected:
+        // Accessible by Yw3dDevice which is the only class that may create a texture array.
+        // @param[in] device a pointer to the parent Yw3dDevice-object.
+        Yw3dTextureArray(class Yw3dDevice* device);
+
+        // Accessible by IBase. The destructor is called when the reference count reaches zero.
+        ~Yw3dTextureArray();
+
+    protected:
+        // Accessible by Yw3dDevice which is the only class that may create a texture array.
+        // @param[in] width width of the layers to be created in pixels.
+        // @param[in] height height of the layers to be created in pixels.
+        // @param[in] layers number of layers to be created.
+        // @param[in] mipLevels number of mip-levels of each layer. Specify 0 to create a full mip-chain.
+        // @param[in] format format of the texture to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
+        // @param[in] layout memory layout of the mip-levels of each layer. Member of the enumeration Yw3dSurfaceLayout.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
+        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t layers, uint32_t mipLevels, Yw3dFormat format, Yw3dSurfaceLayout layout = Yw3d_SL_Linear);
+
+        // Sampling this texture requires 2 floating point coordinates and a layer index.
+        Yw3dTextureSampleInput GetTextureSampleInput() const;
+
+        // Accessible by Yw3dDevice.
+        // Samples a layer of the texture and returns the looked-up color.
+        // @param[out] color receives the color of the pixel to be looked up.
+        // @param[in] u u-component of the lookup-vector.
+        // @param[in] v v-component of the lookup-vector.
+        // @param[in] w layer index, rounded to the nearest layer and clamped to the layers of the texture.
+        // @param[in] lod level of detail.
+        // @param[in] xGradient partial derivatives of the texture coordinates with respect to the screen-space x coordinate. If 0 the base mip-level will be chosen and the minification filter will be used for texture sampling.
+        // @param[in] yGradient partial derivatives of the texture coordinates with respect to the screen-space y coordinate. If 0 the base mip-level will be chosen and the minification filter will be used for texture sampling.
+        // @param[in] samplerStates texture sampler states.
+        // @return Yw3d_S_OK if the function succeeds.
+        Yw3dResult SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
+        // Returns a sampling function specialized for the format of the texture and the address, filter and mip states.
+        // Falls back to SampleTextureGeneric() if a state is invalid.
+        // @param[in] samplerStates texture sampler states.
+        Yw3dSampleFunction GetSampleFunction(const uint32_t* samplerStates) const;
+
+        // Writes the pending fast cleared tiles of all mip-levels of all layers.
+        void ResolveFastClear();
+
+    private:
+        // Returns the layer a layer index selects, rounded to the nearest layer and clamped to the layers of the texture.
+        // @param[in] w layer index.
+        inline class Yw3dTexture* GetLayerForSample(float w) const;
+
+        // Sampling function specialized for the format, the filter states and the address states of u and v.
+        template <Yw3dFormat format, bool linearMip, bool linearMin, bool linearMag, bool wrapU, bool wrapV>
+        static Yw3dResult SampleTextureSpecialized(IYw3dBaseTexture* texture, Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
+    public:
+        // Generates mip-sublevels through downsampling (using a box-filter by default) a given source mip-level of all layers.
+        // The rows of all layers are downsampled concurrently by the worker pool of the device.
+        // @param[in] srcLevel the mip-level which will be taken as the starting point.
+        // @param[in] filter member of the enumeration Yw3dMipFilter.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult GenerateMipSubLevels(uint32_t srcLevel, Yw3dMipFilter filter = Yw3d_MF_Box);
+
+        // Returns a pointer to the contents of a given mip-level of a layer.
+        // @param[in] layer layer that is requested.
+        // @param[in] mipLevel mip-level that is requested, 0 being the largest mip-level.
+        // @param[out] data receives the pointer to the texture-data.
+        // @param[in] rect area that will be locked and accessible. (Pass in 0 to lock entire mip-level.)
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_InvalidState if the mip-level is already locked.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        Yw3dResult LockRect(uint32_t layer, uint32_t mipLevel, void** data, const Yw3dRect* rect);
+
+        // Unlocks the given mip-level of a layer; modifications to the texture will become active.
+        // @param[in] layer layer of the mip-level.
+        // @param[in] mipLevel mip-level, 0 being the largest mip-level.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        Yw3dResult UnlockRect(uint32_t layer, uint32_t mipLevel);
+
+        // Returns the format of the texture. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F, Yw3d_FMT_R32G32B32A32F, Yw3d_FMT_BC1, Yw3d_FMT_BC3, Yw3d_FMT_BC5, Yw3d_FMT_BC6H or one of the compact formats Yw3d_FMT_R8 to Yw3d_FMT_R8G8B8A8_SRGB.
+        Yw3dFormat GetFormat() const;
+
+        // Returns the number of floats of the format, e [1,4], 0 for block compressed and compact formats.
+        uint32_t GetFormatFloats() const;
+
+        //< Returns the number of layers of the texture.
+        uint32_t GetLayers() const;
+
+        // Returns the number of mip-levels each layer consists of.
+        uint32_t GetMipLevels() const;
+
+        // Returns the width of the given mip-level in pixels.
+        // @param[in] mipLevel the mip-level whose width is requested.
+        uint32_t GetWidth(uint32_t mipLevel = 0) const;
+
+        // Returns the height of the given mip-level in pixels.
+        // @param[in] mipLevel the mip-level whose height is requested.
+        uint32_t GetHeight(uint32_t mipLevel = 0) const;
+
+        // Returns a pointer to a layer which can then be accessed like a normal 2d texture, e.g. to be rendered to or to copy a loaded texture into it.
+        // Calling this function will increase the internal reference count of the texture. Failure to call Release() when finished using the pointer will result in a memory leak.
+        // @param[in] layer the layer that is requested.
+        class Yw3dTexture* AcquireLayer(uint32_t layer);
+
+    private:
+        // Number of layers.
+        uint32_t m_NumLayers;
+
+        // Pointer to the layers.
+        class Yw3dTexture** m_Layers;
+
+        // Index of the last layer as float, used to clamp layer indices.
+        float m_MaxLayer;
+    };
+}
+
+#endif // !__YW_3D_TEXTURE_ARRAY_H__
@@ -2,6 +2,7 @@
 // YW Soft Renderer vertex buffer class.
 
 #include "Yw3dVertexBuffer.h"
+#include "Yw3dAllocator.h"
 #include "Yw3dDevice.h"
 
 namespace yw
@@ -16,7 +17,7 @@ namespace yw
 
     Yw3dVertexBuffer::~Yw3dVertexBuffer()
     {
-        YW_SAFE_DELETE_ARRAY(m_Data);
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_Data);
         YW_SAFE_RELEASE(m_Device);
     }
 
@@ -32,7 +33,7 @@ namespace yw
         m_Length = length;
 
         // Create buffer by length.
-        m_Data = new uint8_t[m_Length];
+        m_Data = (uint8_t*)m_Device->GetAllocator()->Allocate(m_Length);
         if (nullptr == m_Data)
         {
             LOGE(_T("Yw3dVertexBuffer::Create: out of memory, cannot create vertex buffer.\n"));
@@ -0,0 +1,589 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer virtual texture class.
+
+#include "Yw3dVirtualTexture.h"
+#include "Yw3dDevice.h"
+#include "Yw3dAllocator.h"
+
+namespace yw
+{
+    Yw3dVirtualTexture::Yw3dVirtualTexture(Yw3dDevice* device) :
+        IYw3dBaseTexture(device),
+        m_Format(Yw3d_FMT_R32F),
+        m_FormatFloats(0),
+        m_MipLevels(0),
+        m_MipLevelInfos(nullptr),
+        m_SquaredWidth(0),
+        m_SquaredHeight(0),
+        m_PageSize(0),
+        m_PageShift(0),
+        m_PageBytes(0),
+        m_NumPages(0),
+        m_PageTable(nullptr),
+        m_PageRequests(nullptr),
+        m_NumPageRequests(0),
+        m_MaxPageSlots(0),
+        m_NumPageSlots(0),
+        m_NumResidentPages(0),
+        m_PageSlots(nullptr),
+        m_LruHead(YW3D_VIRTUAL_PAGE_NOT_RESIDENT),
+        m_LruTail(YW3D_VIRTUAL_PAGE_NOT_RESIDENT),
+        m_FreeSlot(YW3D_VIRTUAL_PAGE_NOT_RESIDENT),
+        m_PageSlotUsage(nullptr),
+        m_FeedbackPeriod(1)
+    {
+
+    }
+
+    Yw3dVirtualTexture::~Yw3dVirtualTexture()
+    {
+        for (uint32_t i = 0; i < m_NumPageSlots; i++)
+        {
+            YW3D_SAFE_FREE(m_Device->GetAllocator(), m_PageSlots[i].data);
+        }
+
+        YW_SAFE_DELETE_ARRAY(m_PageSlotUsage);
+        YW_SAFE_DELETE_ARRAY(m_PageSlots);
+        YW_SAFE_DELETE_ARRAY(m_PageRequests);
+        YW_SAFE_DELETE_ARRAY(m_PageTable);
+        YW_SAFE_DELETE_ARRAY(m_MipLevelInfos);
+    }
+
+    Yw3dResult Yw3dVirtualTexture::Create(uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, uint32_t pageSize, size_t memoryBudget)
+    {
+        if ((0 == width) || (0 == height))
+        {
+            LOGE(_T("Yw3dVirtualTexture::Create: texture dimensions are invalid.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if ((pageSize < 4) || (0 != (pageSize & (pageSize - 1))))
+        {
+            LOGE(_T("Yw3dVirtualTexture::Create: page size has to be a power of two of at least 4.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        if ((format < Yw3d_FMT_R32F) || (format > Yw3d_FMT_R32G32B32A32F))
+        {
+            LOGE(_T("Yw3dVirtualTexture::Create: invalid format specified.\n"));
+            return Yw3d_E_InvalidFormat;
+        }
+
+        m_Format = format;
+        m_FormatFloats = format - Yw3d_FMT_R32F + 1;
+        m_SquaredWidth = (float)width * (float)width;
+        m_SquaredHeight = (float)height * (float)height;
+
+        m_PageSize = pageSize;
+        m_PageBytes = pageSize * pageSize * m_FormatFloats * sizeof(float);
+        while ((1u << m_PageShift) < pageSize)
+        {
+            ++m_PageShift;
+        }
+
+        // Same mip-chain as Yw3dTexture: halve the dimensions until one of them reaches 0.
+        const uint32_t maxMipLevels = (uint32_t)floor(log2(max(width, height))) + 1;
+        mipLevels = ((0 == mipLevels) || (mipLevels > maxMipLevels)) ? maxMipLevels : mipLevels;
+
+        m_MipLevelInfos = new MipLevelInfo[mipLevels];
+        if (nullptr == m_MipLevelInfos)
+        {
+            LOGE(_T("Yw3dVirtualTexture::Create: out of memory, cannot create mip-levels.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        uint32_t numPinnedPages = 0;
+        while ((0 != width) && (0 != height) && (m_MipLevels < mipLevels))
+        {
+            MipLevelInfo& levelInfo = m_MipLevelInfos[m_MipLevels++];
+            levelInfo.width = width;
+            levelInfo.height = height;
+            levelInfo.pagesX = (width + pageSize - 1) >> m_PageShift;
+            levelInfo.pagesY = (height + pageSize - 1) >> m_PageShift;
+            levelInfo.firstPage = m_NumPages;
+            levelInfo.widthMin1 = (float)(width - 1);
+            levelInfo.heightMin1 = (float)(height - 1);
+
+            m_NumPages += levelInfo.pagesX * levelInfo.pagesY;
+            if ((1 == levelInfo.pagesX) && (1 == levelInfo.pagesY))
+            {
+                ++numPinnedPages;
+            }
+
+            width >>= 1;
+            height >>= 1;
+        }
+
+        // The budget has to hold the pinned pages and at least one page of a finer mip-level.
+        const size_t maxPageSlots = memoryBudget / m_PageBytes;
+        if (maxPageSlots < (size_t)min(numPinnedPages + 1, m_NumPages))
+        {
+            LOGE(_T("Yw3dVirtualTexture::Create: memory budget is too small for the page size.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        m_MaxPageSlots = (uint32_t)min(maxPageSlots, (size_t)m_NumPages);
+
+        m_PageTable = new uint32_t[m_NumPages];
+        m_PageRequests = new std::atomic<uint8_t>[m_NumPages];
+        m_PageSlots = new PageSlot[m_MaxPageSlots];
+        m_PageSlotUsage = new std::atomic<uint32_t>[m_MaxPageSlots];
+        if ((nullptr == m_PageTable) || (nullptr == m_PageRequests) || (nullptr == m_PageSlots) || (nullptr == m_PageSlotUsage))
+        {
+            LOGE(_T("Yw3dVirtualTexture::Create: out of memory, cannot create page table.\n"));
+            return Yw3d_E_OutOfMemory;
+        }
+
+        for (uint32_t i = 0; i < m_NumPages; i++)
+        {
+            m_PageTable[i] = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+            m_PageRequests[i].store(0, std::memory_order_relaxed);
+        }
+
+        for (uint32_t i = 0; i < m_MaxPageSlots; i++)
+        {
+            m_PageSlotUsage[i].store(0, std::memory_order_relaxed);
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    Yw3dTextureSampleInput Yw3dVirtualTexture::GetTextureSampleInput() const
+    {
+        return Yw3d_TSI_2Coords;
+    }
+
+    Yw3dResult Yw3dVirtualTexture::SampleTexture(Vector4& color, float u, float v, float /*w*/, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates)
+    {
+        uint32_t texFilter = samplerStates[Yw3d_TSS_MinFilter];
+        float texMipLevel = lod;
+
+        // Choose proper mip level and filter, see Yw3dTexture::SampleTexture().
+        if ((nullptr != xGradient) && (nullptr != yGradient) && (texMipLevel < 0.0f))
+        {
+            const float lenXGrad = xGradient->x * xGradient->x * m_SquaredWidth + xGradient->y * xGradient->y * m_SquaredHeight;
+            const float lenYGrad = yGradient->x * yGradient->x * m_SquaredWidth + yGradient->y * yGradient->y * m_SquaredHeight;
+            const float texelsPerScreenPixel = max(lenXGrad, lenYGrad);
+
+            if (texelsPerScreenPixel <= 1.0f)
+            {
+                texMipLevel = 0.0f;
+                texFilter = samplerStates[Yw3d_TSS_MagFilter];
+            }
+            else
+            {
+                texMipLevel = 0.5f * FastLog2(texelsPerScreenPixel);
+            }
+        }
+
+        const float mipLodBias = *(const float*)&samplerStates[Yw3d_TSS_MipLodBias];
+        const float maxMipLevel = *(const float*)&samplerStates[Yw3d_TSS_MaxMipLevel];
+        texMipLevel = Clamp(texMipLevel + mipLodBias, 0.0f, maxMipLevel);
+
+        const bool linearFilter = (Yw3d_TF_Linear == texFilter);
+        uint32_t mipLevelA = (uint32_t)texMipLevel;
+        mipLevelA = (mipLevelA >= m_MipLevels) ? (m_MipLevels - 1) : mipLevelA;
+        if ((Yw3d_TF_Linear == samplerStates[Yw3d_TSS_MipFilter]) && (mipLevelA + 1 < m_MipLevels))
+        {
+            Vector4 colorA;
+            Vector4 colorB;
+            SampleMipLevel(colorA, mipLevelA, u, v, linearFilter);
+            SampleMipLevel(colorB, mipLevelA + 1, u, v, linearFilter);
+            Vector4Lerp(color, colorA, colorB, texMipLevel - (float)mipLevelA);
+        }
+        else
+        {
+            SampleMipLevel(color, mipLevelA, u, v, linearFilter);
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    inline void Yw3dVirtualTexture::FetchPixel(float* color, uint32_t mipLevel, uint32_t x, uint32_t y)
+    {
+        for (;;)
+        {
+            const uint32_t pageIndex = GetPageIndex(mipLevel, x >> m_PageShift, y >> m_PageShift);
+            const uint32_t slot = m_PageTable[pageIndex];
+            if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT != slot)
+            {
+                // Only write the usage of a slot once per feedback period, the slots are shared by all sampling threads.
+                if (m_PageSlotUsage[slot].load(std::memory_order_relaxed) != m_FeedbackPeriod)
+                {
+                    m_PageSlotUsage[slot].store(m_FeedbackPeriod, std::memory_order_relaxed);
+                }
+
+                const uint32_t pageMask = m_PageSize - 1;
+                const float* pixel = &m_PageSlots[slot].data[(((y & pageMask) << m_PageShift) + (x & pageMask)) * m_FormatFloats];
+                for (uint32_t c = 0; c < m_FormatFloats; c++)
+                {
+                    color[c] = pixel[c];
+                }
+
+                return;
+            }
+
+            // Record the missing page, the coarser ones are recorded as well if they are missing too.
+            if ((0 == m_PageRequests[pageIndex].load(std::memory_order_relaxed)) && (0 == m_PageRequests[pageIndex].exchange(1, std::memory_order_relaxed)))
+            {
+                m_NumPageRequests.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            if (++mipLevel >= m_MipLevels)
+            {
+                return;
+            }
+
+            const MipLevelInfo& levelInfo = m_MipLevelInfos[mipLevel];
+            x = min(x >> 1, levelInfo.width - 1);
+            y = min(y >> 1, levelInfo.height - 1);
+        }
+    }
+
+    void Yw3dVirtualTexture::SampleMipLevel(Vector4& color, uint32_t mipLevel, float u, float v, bool linearFilter)
+    {
+        const MipLevelInfo& levelInfo = m_MipLevelInfos[mipLevel];
+
+        // u and v are in [0,1], so truncation is the same as floor.
+        const float fX = u * levelInfo.widthMin1;
+        const float fY = v * levelInfo.heightMin1;
+        const uint32_t pixelX = (uint32_t)fX;
+        const uint32_t pixelY = (uint32_t)fY;
+
+        if (!linearFilter)
+        {
+            float pixel[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+            FetchPixel(pixel, mipLevel, pixelX, pixelY);
+            color.Set(pixel[0], pixel[1], pixel[2], pixel[3]);
+            return;
+        }
+
+        const uint32_t pixelX2 = (pixelX + 1 < levelInfo.width) ? (pixelX + 1) : pixelX;
+        const uint32_t pixelY2 = (pixelY + 1 < levelInfo.height) ? (pixelY + 1) : pixelY;
+
+        // The four pixels: top-left, top-right, bottom-left and bottom-right.
+        float pixels[4][4] =
+        {
+            {0.0f, 0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 0.0f, 1.0f},
+            {0.0f, 0.0f, 0.0f, 1.0f}
+        };
+
+        FetchPixel(pixels[0], mipLevel, pixelX, pixelY);
+        FetchPixel(pixels[1], mipLevel, pixelX2, pixelY);
+        FetchPixel(pixels[2], mipLevel, pixelX, pixelY2);
+        FetchPixel(pixels[3], mipLevel, pixelX2, pixelY2);
+
+        const float interpolationX = fX - (float)pixelX;
+        const float interpolationY = fY - (float)pixelY;
+
+        float result[4];
+        for (uint32_t c = 0; c < 4; c++)
+        {
+            const float top = pixels[0][c] + (pixels[1][c] - pixels[0][c]) * interpolationX;
+            const float bottom = pixels[2][c] + (pixels[3][c] - pixels[2][c]) * interpolationX;
+            result[c] = top + (bottom - top) * interpolationY;
+        }
+
+        color.Set(result[0], result[1], result[2], result[3]);
+    }
+
+    Yw3dResult Yw3dVirtualTexture::UploadPage(const Yw3dVirtualPage& page, const void* data)
+    {
+        if (!IsPageValid(page) || (nullptr == data))
+        {
+            LOGE(_T("Yw3dVirtualTexture::UploadPage: invalid page or data.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        const uint32_t pageIndex = GetPageIndex(page.mipLevel, page.pageX, page.pageY);
+        uint32_t slot = m_PageTable[pageIndex];
+        if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT == slot)
+        {
+            slot = AcquirePageSlot();
+            if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT == slot)
+            {
+                return Yw3d_E_OutOfMemory;
+            }
+
+            const MipLevelInfo& levelInfo = m_MipLevelInfos[page.mipLevel];
+            PageSlot& pageSlot = m_PageSlots[slot];
+            pageSlot.pageIndex = pageIndex;
+            pageSlot.pinned = (1 == levelInfo.pagesX) && (1 == levelInfo.pagesY);
+            m_PageSlotUsage[slot].store(m_FeedbackPeriod, std::memory_order_relaxed);
+            if (!pageSlot.pinned)
+            {
+                LinkPageSlot(slot);
+            }
+
+            m_PageTable[pageIndex] = slot;
+            ++m_NumResidentPages;
+        }
+
+        memcpy(m_PageSlots[slot].data, data, m_PageBytes);
+        return Yw3d_S_OK;
+    }
+
+    Yw3dResult Yw3dVirtualTexture::EvictPage(const Yw3dVirtualPage& page)
+    {
+        if (!IsPageValid(page))
+        {
+            LOGE(_T("Yw3dVirtualTexture::EvictPage: invalid page.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
+        const uint32_t pageIndex = GetPageIndex(page.mipLevel, page.pageX, page.pageY);
+        const uint32_t slot = m_PageTable[pageIndex];
+        if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT == slot)
+        {
+            return Yw3d_S_OK;
+        }
+
+        PageSlot& pageSlot = m_PageSlots[slot];
+        if (!pageSlot.pinned)
+        {
+            UnlinkPageSlot(slot);
+        }
+
+        // Keep the memory of the slot for the next upload.
+        pageSlot.pageIndex = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+        pageSlot.lruNext = m_FreeSlot;
+        m_FreeSlot = slot;
+
+        m_PageTable[pageIndex] = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+        --m_NumResidentPages;
+
+        return Yw3d_S_OK;
+    }
+
+    uint32_t Yw3dVirtualTexture::ResolveFeedback(std::vector<Yw3dVirtualPage>& requestedPages)
+    {
+        requestedPages.clear();
+
+        // Refresh the LRU order: the slots sampled during this period become the most recently used ones.
+        const uint32_t lastSlot = m_LruTail;
+        uint32_t slot = m_LruHead;
+        while (YW3D_VIRTUAL_PAGE_NOT_RESIDENT != slot)
+        {
+            const uint32_t nextSlot = m_PageSlots[slot].lruNext;
+            if (m_PageSlotUsage[slot].load(std::memory_order_relaxed) == m_FeedbackPeriod)
+            {
+                UnlinkPageSlot(slot);
+                LinkPageSlot(slot);
+            }
+
+            if (lastSlot == slot)
+            {
+                break;
+            }
+
+            slot = nextSlot;
+        }
+
+        if (m_NumPageRequests.exchange(0, std::memory_order_relaxed) > 0)
+        {
+            // Walk the mip-levels from the coarsest to the finest one.
+            for (int32_t level = (int32_t)m_MipLevels - 1; level >= 0; level--)
+            {
+                const MipLevelInfo& levelInfo = m_MipLevelInfos[level];
+                for (uint32_t pageY = 0; pageY < levelInfo.pagesY; pageY++)
+                {
+                    for (uint32_t pageX = 0; pageX < levelInfo.pagesX; pageX++)
+                    {
+                        const uint32_t pageIndex = levelInfo.firstPage + pageY * levelInfo.pagesX + pageX;
+                        if ((0 != m_PageRequests[pageIndex].load(std::memory_order_relaxed)) && (0 != m_PageRequests[pageIndex].exchange(0, std::memory_order_relaxed)))
+                        {
+                            if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT == m_PageTable[pageIndex])
+                            {
+                                requestedPages.push_back(Yw3dVirtualPage((uint32_t)level, pageX, pageY));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        ++m_FeedbackPeriod;
+        return (uint32_t)requestedPages.size();
+    }
+
+    bool Yw3dVirtualTexture::IsPageResident(const Yw3dVirtualPage& page) const
+    {
+        if (!IsPageValid(page))
+        {
+            return false;
+        }
+
+        return YW3D_VIRTUAL_PAGE_NOT_RESIDENT != m_PageTable[GetPageIndex(page.mipLevel, page.pageX, page.pageY)];
+    }
+
+    bool Yw3dVirtualTexture::IsPageValid(const Yw3dVirtualPage& page) const
+    {
+        if (page.mipLevel >= m_MipLevels)
+        {
+            return false;
+        }
+
+        const MipLevelInfo& levelInfo = m_MipLevelInfos[page.mipLevel];
+        return (page.pageX < levelInfo.pagesX) && (page.pageY < levelInfo.pagesY);
+    }
+
+    uint32_t Yw3dVirtualTexture::AcquirePageSlot()
+    {
+        // Reuse the slot of an evicted page.
+        if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT != m_FreeSlot)
+        {
+            const uint32_t slot = m_FreeSlot;
+            m_FreeSlot = m_PageSlots[slot].lruNext;
+            return slot;
+        }
+
+        // Allocate a new slot within the budget.
+        if (m_NumPageSlots < m_MaxPageSlots)
+        {
+            PageSlot& pageSlot = m_PageSlots[m_NumPageSlots];
+            pageSlot.data = (float*)m_Device->GetAllocator()->Allocate(m_PageBytes);
+            if (nullptr == pageSlot.data)
+            {
+                LOGE(_T("Yw3dVirtualTexture::AcquirePageSlot: out of memory, cannot allocate page.\n"));
+                return YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+            }
+
+            pageSlot.pageIndex = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+            pageSlot.lruPrev = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+            pageSlot.lruNext = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+            pageSlot.pinned = false;
+            return m_NumPageSlots++;
+        }
+
+        // Evict the least recently used page, unless it has been sampled since the last resolved feedback, then all pages are in use.
+        const uint32_t slot = m_LruHead;
+        if ((YW3D_VIRTUAL_PAGE_NOT_RESIDENT == slot) || (m_PageSlotUsage[slot].load(std::memory_order_relaxed) + 1 >= m_FeedbackPeriod))
+        {
+            return YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+        }
+
+        UnlinkPageSlot(slot);
+        m_PageTable[m_PageSlots[slot].pageIndex] = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+        m_PageSlots[slot].pageIndex = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+        --m_NumResidentPages;
+
+        return slot;
+    }
+
+    void Yw3dVirtualTexture::LinkPageSlot(uint32_t slot)
+    {
+        PageSlot& pageSlot = m_PageSlots[slot];
+        pageSlot.lruPrev = m_LruTail;
+        pageSlot.lruNext = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+
+        if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT != m_LruTail)
+        {
+            m_PageSlots[m_LruTail].lruNext = slot;
+        }
+        else
+        {
+            m_LruHead = slot;
+        }
+
+        m_LruTail = slot;
+    }
+
+    void Yw3dVirtualTexture::UnlinkPageSlot(uint32_t slot)
+    {
+        PageSlot& pageSlot = m_PageSlots[slot];
+        if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT != pageSlot.lruPrev)
+        {
+            m_PageSlots[pageSlot.lruPrev].lruNext = pageSlot.lruNext;
+        }
+        else
+        {
+            m_LruHead = pageSlot.lruNext;
+        }
+
+        if (YW3D_VIRTUAL_PAGE_NOT_RESIDENT != pageSlot.lruNext)
+        {
+            m_PageSlots[pageSlot.lruNext].lruPrev = pageSlot.lruPrev;
+        }
+        else
+        {
+            m_LruTail = pageSlot.lruPrev;
+        }
+
+        pageSlot.lruPrev = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+        pageSlot.lruNext = YW3D_VIRTUAL_PAGE_NOT_RESIDENT;
+    }
+
+    Yw3dFormat Yw3dVirtualTexture::GetFormat() const
+    {
+        return m_Format;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetFormatFloats() const
+    {
+        return m_FormatFloats;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetMipLevels() const
+    {
+        return m_MipLevels;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetWidth(uint32_t mipLevel) const
+    {
+        if (mipLevel >= m_MipLevels)
+        {
+            LOGE(_T("Yw3dVirtualTexture::GetWidth: parameter mipLevel exceeds number of mip-levels.\n"));
+            return 0;
+        }
+
+        return m_MipLevelInfos[mipLevel].width;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetHeight(uint32_t mipLevel) const
+    {
+        if (mipLevel >= m_MipLevels)
+        {
+            LOGE(_T("Yw3dVirtualTexture::GetHeight: parameter mipLevel exceeds number of mip-levels.\n"));
+            return 0;
+        }
+
+        return m_MipLevelInfos[mipLevel].height;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetPageSize() const
+    {
+        return m_PageSize;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetPageBytes() const
+    {
+        return m_PageBytes;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetPagesX(uint32_t mipLevel) const
+    {
+        return (mipLevel < m_MipLevels) ? m_MipLevelInfos[mipLevel].pagesX : 0;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetPagesY(uint32_t mipLevel) const
+    {
+        return (mipLevel < m_MipLevels) ? m_MipLevelInfos[mipLevel].pagesY : 0;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetNumPages() const
+    {
+        return m_NumPages;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetMaxResidentPages() const
+    {
+        return m_MaxPageSlots;
+    }
+
+    uint32_t Yw3dVirtualTexture::GetNumResidentPages() const
+    {
+        return m_NumResidentPages;
+    }
+}
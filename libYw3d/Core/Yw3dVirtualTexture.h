@@ -0,0 +1,235 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer virtual texture class.
+
+#ifndef __YW_3D_VIRTUAL_TEXTURE_H__
+#define __YW_3D_VIRTUAL_TEXTURE_H__
+
+#include "Yw3dBase.h"
+#include "Yw3dTypes.h"
+#include "Yw3dBaseTexture.h"
+#include <atomic>
+
+// Page table entry of a page which is not resident.
+#define YW3D_VIRTUAL_PAGE_NOT_RESIDENT 0xffffffff
+
+namespace yw
+{
+    // A page of a virtual texture, addressed by its mip-level and its position in pages.
+    struct Yw3dVirtualPage
+    {
+        uint32_t mipLevel;
+        uint32_t pageX;
+        uint32_t pageY;
+
+        Yw3dVirtualPage() : mipLevel(0), pageX(0), pageY(0) {}
+        Yw3dVirtualPage(uint32_t level, uint32_t x, uint32_t y) : mipLevel(level), pageX(x), pageY(y) {}
+    };
+
+    // Yw3dVirtualTexture implements a 2-dimensional texture whose mip-levels are split into square pages of a fixed size,
+    // only the pages being sampled are kept resident in a page cache with a memory budget.
+    // Sampling a page which is not resident falls back to the coarser mip-levels and records the page in a feedback buffer,
+    // the application resolves the feedback once per frame and uploads the requested pages, e.g. streamed from a paged file on disk.
+    // Pages are evicted in least recently used order, pages of the mip-levels fitting into a single page are never evicted.
+    class Yw3dVirtualTexture : public IYw3dBaseTexture
+    {
+        friend class Yw3dDevice;
+
+    protected:
+        // Accessible by Yw3dDevice which is the only class that may create a virtual texture.
+        // @param[in] device a pointer to the parent Yw3dDevice-object.
+        Yw3dVirtualTexture(class Yw3dDevice* device);
+
+        // Accessible by IBase. The destructor is called when the reference count reaches zero.
+        ~Yw3dVirtualTexture();
+
+    protected:
+        // Accessible by Yw3dDevice which is the only class that may create a virtual texture. No page is resident after creation.
+        // @param[in] width width of the texture to be created in pixels.
+        // @param[in] height height of the texture to be created in pixels.
+        // @param[in] mipLevels number of mip-levels to be created. Specify 0 to create a full mip-chain.
+        // @param[in] format format of the texture to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // @param[in] pageSize width and height of a page in pixels, a power of two.
+        // @param[in] memoryBudget maximum number of bytes of the resident pages.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid, e.g. the budget cannot hold the pages which are never evicted.
+        // @return Yw3d_E_OutOfMemory if memory allocation failed.
+        // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
+        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t mipLevels, Yw3dFormat format, uint32_t pageSize, size_t memoryBudget);
+
+        // Sampling this texture requires 2 floating point coordinates.
+        Yw3dTextureSampleInput GetTextureSampleInput() const;
+
+        // Accessible by Yw3dDevice.
+        // Samples the texture and returns the looked-up color, the mip-level is chosen as Yw3dTexture does.
+        // Pixels of pages which are not resident are taken from the nearest coarser resident mip-level and the missing pages are recorded for ResolveFeedback().
+        // @param[out] color receives the color of the pixel to be looked up.
+        // @param[in] u u-component of the lookup-vector.
+        // @param[in] v v-component of the lookup-vector.
+        // @param[in] w w-component of the lookup-vector.
+        // @param[in] lod level of detail, automatic select lod level when less than 0.
+        // @param[in] xGradient partial derivatives of the texture coordinates with respect to the screen-space x coordinate. If 0 the base mip-level will be chosen and the minification filter will be used for texture sampling.
+        // @param[in] yGradient partial derivatives of the texture coordinates with respect to the screen-space y coordinate. If 0 the base mip-level will be chosen and the minification filter will be used for texture sampling.
+        // @param[in] samplerStates texture sampler states.
+        // @return Yw3d_S_OK if the function succeeds.
+        Yw3dResult SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
+
+    public:
+        // Copies the pixels of a page into the page cache and makes it resident. The least recently used page is evicted if the budget is exhausted.
+        // Must not be called while the device is drawing.
+        // @param[in] page the page to be uploaded.
+        // @param[in] data pixels of the page, GetPageSize() rows of GetPageSize() pixels. Pixels of pages at the right and bottom border outside the mip-level are ignored.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
+        // @return Yw3d_E_OutOfMemory if all resident pages have been sampled since the last resolved feedback or memory allocation failed.
+        Yw3dResult UploadPage(const Yw3dVirtualPage& page, const void* data);
+
+        // Evicts a resident page from the page cache. Must not be called while the device is drawing.
+        // @param[in] page the page to be evicted.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidParameters if the page is invalid.
+        Yw3dResult EvictPage(const Yw3dVirtualPage& page);
+
+        // Returns the pages requested by sampling since the last call and starts a new feedback period, called once per frame after drawing.
+        // The pages are ordered from the coarsest to the finest mip-level, so uploading them in order refines the texture progressively.
+        // @param[out] requestedPages receives the requested pages which are not resident.
+        // @return the number of requested pages.
+        uint32_t ResolveFeedback(std::vector<Yw3dVirtualPage>& requestedPages);
+
+        // Returns true if the given page is resident.
+        // @param[in] page the page to be checked.
+        bool IsPageResident(const Yw3dVirtualPage& page) const;
+
+        // Returns the format of the texture. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        Yw3dFormat GetFormat() const;
+
+        // Returns the number of floats of the format, e [1,4].
+        uint32_t GetFormatFloats() const;
+
+        // Returns the number of mip-levels this texture consists of.
+        uint32_t GetMipLevels() const;
+
+        // Returns the width of the given mip-level in pixels.
+        // @param[in] mipLevel the mip-level whose width is requested.
+        uint32_t GetWidth(uint32_t mipLevel = 0) const;
+
+        // Returns the height of the given mip-level in pixels.
+        // @param[in] mipLevel the mip-level whose height is requested.
+        uint32_t GetHeight(uint32_t mipLevel = 0) const;
+
+        //< Returns the width and height of a page in pixels.
+        uint32_t GetPageSize() const;
+
+        //< Returns the number of bytes of a page.
+        uint32_t GetPageBytes() const;
+
+        // Returns the number of pages of the given mip-level in x direction.
+        // @param[in] mipLevel the mip-level whose pages are requested.
+        uint32_t GetPagesX(uint32_t mipLevel) const;
+
+        // Returns the number of pages of the given mip-level in y direction.
+        // @param[in] mipLevel the mip-level whose pages are requested.
+        uint32_t GetPagesY(uint32_t mipLevel) const;
+
+        //< Returns the number of pages of all mip-levels.
+        uint32_t GetNumPages() const;
+
+        //< Returns the maximum number of resident pages allowed by the memory budget.
+        uint32_t GetMaxResidentPages() const;
+
+        //< Returns the number of resident pages.
+        uint32_t GetNumResidentPages() const;
+
+    private:
+        // Returns the index of a page in the page table, the page has to be valid.
+        inline uint32_t GetPageIndex(uint32_t mipLevel, uint32_t pageX, uint32_t pageY) const;
+
+        // Returns true if the page is valid.
+        bool IsPageValid(const Yw3dVirtualPage& page) const;
+
+        // Fetches a pixel of a mip-level, or of the nearest coarser mip-level whose page is resident. Missing pages are recorded in the feedback buffer.
+        // @param[out] color receives the color of the pixel, black if no page is resident.
+        inline void FetchPixel(float* color, uint32_t mipLevel, uint32_t x, uint32_t y);
+
+        // Samples a single mip-level.
+        // @param[in] u u-component of the lookup-vector, e [0,1].
+        // @param[in] v v-component of the lookup-vector, e [0,1].
+        void SampleMipLevel(Vector4& color, uint32_t mipLevel, float u, float v, bool linearFilter);
+
+        // Returns a free page slot, evicting the least recently used page if the budget is exhausted.
+        // @return the slot, YW3D_VIRTUAL_PAGE_NOT_RESIDENT if no slot is available.
+        uint32_t AcquirePageSlot();
+
+        // Moves a page slot to the most recently used end of the LRU list, or removes it from the list.
+        void LinkPageSlot(uint32_t slot);
+        void UnlinkPageSlot(uint32_t slot);
+
+    private:
+        // Dimensions and pages of a mip-level.
+        struct MipLevelInfo
+        {
+            uint32_t width;
+            uint32_t height;
+            uint32_t pagesX;
+            uint32_t pagesY;
+            uint32_t firstPage;
+            float widthMin1;
+            float heightMin1;
+        };
+
+        // A slot of the page cache.
+        struct PageSlot
+        {
+            float* data;
+            uint32_t pageIndex;
+            uint32_t lruPrev;
+            uint32_t lruNext;
+            bool pinned;
+        };
+
+        // Format of the texture.
+        Yw3dFormat m_Format;
+        uint32_t m_FormatFloats;
+
+        // Number of mip-levels.
+        uint32_t m_MipLevels;
+        MipLevelInfo* m_MipLevelInfos;
+
+        // Squared dimensions of the base mip-level, used for mip-calculations.
+        float m_SquaredWidth;
+        float m_SquaredHeight;
+
+        // Page dimensions.
+        uint32_t m_PageSize;
+        uint32_t m_PageShift;
+        uint32_t m_PageBytes;
+
+        // Page table, the slot of each page of all mip-levels or YW3D_VIRTUAL_PAGE_NOT_RESIDENT.
+        uint32_t m_NumPages;
+        uint32_t* m_PageTable;
+
+        // Feedback buffer, a request flag of each page set by sampling threads.
+        std::atomic<uint8_t>* m_PageRequests;
+        std::atomic<uint32_t> m_NumPageRequests;
+
+        // Page cache. Slots are allocated on demand up to the budget, the LRU list links the slots of all pages which may be evicted.
+        uint32_t m_MaxPageSlots;
+        uint32_t m_NumPageSlots;
+        uint32_t m_NumResidentPages;
+        PageSlot* m_PageSlots;
+        uint32_t m_LruHead;
+        uint32_t m_LruTail;
+        uint32_t m_FreeSlot;
+
+        // Feedback period each slot was sampled in the last time, and the current period.
+        std::atomic<uint32_t>* m_PageSlotUsage;
+        uint32_t m_FeedbackPeriod;
+    };
+
+    inline uint32_t Yw3dVirtualTexture::GetPageIndex(uint32_t mipLevel, uint32_t pageX, uint32_t pageY) const
+    {
+        const MipLevelInfo& levelInfo = m_MipLevelInfos[mipLevel];
+        return levelInfo.firstPage + pageY * levelInfo.pagesX + pageX;
+    }
+}
+
+#endif // !__YW_3D_VIRTUAL_TEXTURE_H__
@@ -2,6 +2,7 @@
 // YW Soft Renderer 3-dimensional image class.
 
 #include "Yw3dVolume.h"
+#include "Yw3dAllocator.h"
 #include "Yw3dDevice.h"
 
 namespace yw
@@ -15,19 +16,25 @@ namespace yw
         m_WidthMin1(0),
         m_HeightMin1(0),
         m_DepthMin1(0),
+        m_Layout(Yw3d_VL_Linear),
+        m_BricksPerRow(0),
+        m_BricksPerSlice(0),
         m_LockedComplete(false),
         m_PartialLockData(nullptr),
         m_Data(nullptr)
     {
+        // The volume data is owned by the allocator of the device.
+        m_Device->AddRef();
     }
 
     Yw3dVolume::~Yw3dVolume()
     {
-        YW_SAFE_DELETE_ARRAY(m_PartialLockData);
-        YW_SAFE_DELETE_ARRAY(m_Data);
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_PartialLockData);
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_Data);
+        YW_SAFE_RELEASE(m_Device);
     }
 
-    Yw3dResult Yw3dVolume::Create(uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format)
+    Yw3dResult Yw3dVolume::Create(uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format, Yw3dVolumeLayout layout)
     {
         if ((0 == width) || (0 == height))
         {
@@ -55,6 +62,12 @@ namespace yw
                 return Yw3d_E_InvalidFormat;
         }
 
+        if ((Yw3d_VL_Linear != layout) && (Yw3d_VL_Bricked8x8x8 != layout))
+        {
+            LOGE(_T( "Yw3dVolume::Create: invalid layout specified.\n"));
+            return Yw3d_E_InvalidParameters;
+        }
+
         m_Format = format;
         m_Width = width;
         m_Height = height;
@@ -62,9 +75,19 @@ namespace yw
         m_WidthMin1 = m_Width - 1;
         m_HeightMin1 = m_Height - 1;
         m_DepthMin1 = m_Depth - 1;
+        m_Layout = layout;
+
+        // Bricked volumes are padded to whole bricks.
+        uint32_t voxelCount = m_Width * m_Height * m_Depth;
+        if (Yw3d_VL_Bricked8x8x8 == m_Layout)
+        {
+            m_BricksPerRow = (m_Width + 7) >> 3;
+            m_BricksPerSlice = m_BricksPerRow * ((m_Height + 7) >> 3);
+            voxelCount = m_BricksPerSlice * ((m_Depth + 7) >> 3) * 512;
+        }
 
-        // Alloc data.
-        m_Data = new float[m_Width * m_Height * m_Depth * fmtFloats];
+        // Alloc aligned data.
+        m_Data = (float*)m_Device->GetAllocator()->Allocate(voxelCount * fmtFloats * sizeof(float));
         if (nullptr == m_Data)
         {
             LOGE(_T( "Yw3dVolume::Create: out of memory, cannot create volume.\n"));
@@ -83,30 +106,31 @@ namespace yw
         const uint32_t pixelX = ftol(fX);
         const uint32_t pixelY = ftol(fY);
         const uint32_t pixelZ = ftol(fZ);
+        const uint32_t index = GetVoxelIndex(pixelX, pixelY, pixelZ);
 
         switch (m_Format)
         {
             case Yw3d_FMT_R32F:
                 {
-                    const float* pixel = &m_Data[pixelX + pixelY * m_Width + pixelZ * m_Width * m_Height];
+                    const float* pixel = &m_Data[index];
                     color = Vector4(pixel[0], 0.0f, 0.0f, 1.0f);
                 }
                 break;
             case Yw3d_FMT_R32G32F:
                 {
-                    const Vector2* pixel = (const Vector2*)&m_Data[2 * (pixelX + pixelY * m_Width + pixelZ * m_Width * m_Height)];
+                    const Vector2* pixel = (const Vector2*)&m_Data[2 * index];
                     color = Vector4(pixel->x, pixel->y, 0.0f, 1.0f);
                 }
                 break;
             case Yw3d_FMT_R32G32B32F:
                 {
-                    const Vector3* pixel = (const Vector3*)&m_Data[3 * (pixelX + pixelY * m_Width + pixelZ * m_Width * m_Height)];
+                    const Vector3* pixel = (const Vector3*)&m_Data[3 * index];
                     color = Vector4(pixel->x, pixel->y, pixel->z, 1.0f);
                 }
                 break;
             case Yw3d_FMT_R32G32B32A32F:
                 {
-                    const Vector4* pixel = (const Vector4*)&m_Data[4 * (pixelX + pixelY * m_Width + pixelZ * m_Width * m_Height)];
+                    const Vector4* pixel = (const Vector4*)&m_Data[4 * index];
                     color = *pixel;
                 }
                 break;
@@ -133,88 +157,57 @@ namespace yw
         pixelY2 = (pixelY2 >= m_Height) ? m_HeightMin1 : pixelY2;
         pixelZ2 = (pixelZ2 >= m_Depth) ? m_DepthMin1 : pixelZ2;
 
-        const uint32_t indexRows[2] = { pixelY * m_Width, pixelY2 * m_Width };
-        const uint32_t indexSlices[2] = { pixelZ * m_Width * m_Height, pixelZ2 * m_Width * m_Height };
+        // The 8 voxels: top-left, top-right, bottom-left and bottom-right of the front slice, then of the back slice.
+        uint32_t indices[8];
+        if (Yw3d_VL_Linear == m_Layout)
+        {
+            const uint32_t indexRows[2] = { pixelY * m_Width, pixelY2 * m_Width };
+            const uint32_t indexSlices[2] = { pixelZ * m_Width * m_Height, pixelZ2 * m_Width * m_Height };
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                indices[i] = ((i & 1) ? pixelX2 : pixelX) + indexRows[(i >> 1) & 1] + indexSlices[i >> 2];
+            }
+        }
+        else if (((pixelX & 7) != 7) && ((pixelY & 7) != 7) && ((pixelZ & 7) != 7))
+        {
+            // All voxels are inside one brick, the neighbours are at fixed offsets, or at the same voxel if clamped at the border.
+            const uint32_t index = GetVoxelIndex(pixelX, pixelY, pixelZ);
+            const uint32_t offsetX = pixelX2 - pixelX;
+            const uint32_t offsetY = (pixelY2 - pixelY) << 3;
+            const uint32_t offsetZ = (pixelZ2 - pixelZ) << 6;
+            indices[0] = index;
+            indices[1] = index + offsetX;
+            indices[2] = index + offsetY;
+            indices[3] = index + offsetY + offsetX;
+            indices[4] = index + offsetZ;
+            indices[5] = index + offsetZ + offsetX;
+            indices[6] = index + offsetZ + offsetY;
+            indices[7] = index + offsetZ + offsetY + offsetX;
+        }
+        else
+        {
+            // The voxels cross a brick border.
+            for (uint32_t i = 0; i < 8; i++)
+            {
+                indices[i] = GetVoxelIndex((i & 1) ? pixelX2 : pixelX, (i & 2) ? pixelY2 : pixelY, (i & 4) ? pixelZ2 : pixelZ);
+            }
+        }
+
         const float interpolation[3] = { fX - pixelX, fY - pixelY, fZ - pixelZ };
 
         switch (m_Format)
         {
             case Yw3d_FMT_R32F:
-                {
-                    float colorSlices[2] = { 0.0f, 0.0f };
-                    float colorRows[2] = { 0.0f, 0.0f };
-
-                    colorRows[0] = Lerp(m_Data[pixelX + indexRows[0] + indexSlices[0]], m_Data[pixelX2 + indexRows[0] + indexSlices[0]], interpolation[0]);
-                    colorRows[1] = Lerp(m_Data[pixelX + indexRows[1] + indexSlices[0]], m_Data[pixelX2 + indexRows[1] + indexSlices[0]], interpolation[0]);
-                    colorSlices[0] = Lerp(colorRows[0], colorRows[1], interpolation[1]);
-
-                    colorRows[0] = Lerp(m_Data[pixelX + indexRows[0] + indexSlices[1]], m_Data[pixelX2 + indexRows[0] + indexSlices[1]], interpolation[0]);
-                    colorRows[1] = Lerp(m_Data[pixelX + indexRows[1] + indexSlices[1]], m_Data[pixelX2 + indexRows[1] + indexSlices[1]], interpolation[0]);
-                    colorSlices[1] = Lerp(colorRows[0], colorRows[1], interpolation[1]);
-
-                    const float finalColor = Lerp(colorSlices[0], colorSlices[1], interpolation[2]);
-                    color = Vector4(finalColor, 0.0f, 0.0f, 1.0f);
-                }
+                FilterVoxels<1>(color, indices, interpolation);
                 break;
             case Yw3d_FMT_R32G32F:
-                {
-                    const Vector2* pixelData = (const Vector2*)m_Data;
-
-                    static Vector2 colorSlices[2];
-                    static Vector2 colorRows[2];
-
-                    Vector2Lerp(colorRows[0], pixelData[pixelX + indexRows[0] + indexSlices[0]], pixelData[pixelX2 + indexRows[0] + indexSlices[0]], interpolation[0]);
-                    Vector2Lerp(colorRows[1], pixelData[pixelX + indexRows[1] + indexSlices[0]], pixelData[pixelX2 + indexRows[1] + indexSlices[0]], interpolation[0]);
-                    Vector2Lerp(colorSlices[0], colorRows[0], colorRows[1], interpolation[1]);
-
-                    Vector2Lerp(colorRows[0], pixelData[pixelX + indexRows[0] + indexSlices[1]], pixelData[pixelX2 + indexRows[0] + indexSlices[1]], interpolation[0]);
-                    Vector2Lerp(colorRows[1], pixelData[pixelX + indexRows[1] + indexSlices[1]], pixelData[pixelX2 + indexRows[1] + indexSlices[1]], interpolation[0]);
-                    Vector2Lerp(colorSlices[1], colorRows[0], colorRows[1], interpolation[1]);
-
-                    static Vector2 finalColor;
-                    Vector2Lerp(finalColor, colorSlices[0], colorSlices[1], interpolation[2]);
-
-                    color = Vector4(finalColor.x, finalColor.y, 0.0f, 1.0f);
-                }
+                FilterVoxels<2>(color, indices, interpolation);
                 break;
             case Yw3d_FMT_R32G32B32F:
-                {
-                    const Vector3* pixelData = (const Vector3*)m_Data;
-
-                    static Vector3 colorSlices[2];
-                    static Vector3 colorRows[2];
-
-                    Vector3Lerp(colorRows[0], pixelData[pixelX + indexRows[0] + indexSlices[0]], pixelData[pixelX2 + indexRows[0] + indexSlices[0]], interpolation[0]);
-                    Vector3Lerp(colorRows[1], pixelData[pixelX + indexRows[1] + indexSlices[0]], pixelData[pixelX2 + indexRows[1] + indexSlices[0]], interpolation[0]);
-                    Vector3Lerp(colorSlices[0], colorRows[0], colorRows[1], interpolation[1]);
-
-                    Vector3Lerp(colorRows[0], pixelData[pixelX + indexRows[0] + indexSlices[1]], pixelData[pixelX2 + indexRows[0] + indexSlices[1]], interpolation[0]);
-                    Vector3Lerp(colorRows[1], pixelData[pixelX + indexRows[1] + indexSlices[1]], pixelData[pixelX2 + indexRows[1] + indexSlices[1]], interpolation[0]);
-                    Vector3Lerp(colorSlices[1], colorRows[0], colorRows[1], interpolation[1]);
-
-                    static Vector3 finalColor;
-                    Vector3Lerp(finalColor, colorSlices[0], colorSlices[1], interpolation[2]);
-
-                    color = Vector4(finalColor.x, finalColor.y, finalColor.z, 1.0f);
-                }
+                FilterVoxels<3>(color, indices, interpolation);
                 break;
             case Yw3d_FMT_R32G32B32A32F:
-                {
-                    const Vector4* pixelData = (const Vector4*)m_Data;
-
-                    static Vector4 colorSlices[2];
-                    static Vector4 colorRows[2];
-
-                    Vector4Lerp(colorRows[0], pixelData[pixelX + indexRows[0] + indexSlices[0]], pixelData[pixelX2 + indexRows[0] + indexSlices[0]], interpolation[0]);
-                    Vector4Lerp(colorRows[1], pixelData[pixelX + indexRows[1] + indexSlices[0]], pixelData[pixelX2 + indexRows[1] + indexSlices[0]], interpolation[0]);
-                    Vector4Lerp(colorSlices[0], colorRows[0], colorRows[1], interpolation[1]);
-
-                    Vector4Lerp(colorRows[0], pixelData[pixelX + indexRows[0] + indexSlices[1]], pixelData[pixelX2 + indexRows[0] + indexSlices[1]], interpolation[0]);
-                    Vector4Lerp(colorRows[1], pixelData[pixelX + indexRows[1] + indexSlices[1]], pixelData[pixelX2 + indexRows[1] + indexSlices[1]], interpolation[0]);
-                    Vector4Lerp(colorSlices[1], colorRows[0], colorRows[1], interpolation[1]);
-
-                    Vector4Lerp(color, colorSlices[0], colorSlices[1], interpolation[2]);
-                }
+                FilterVoxels<4>(color, indices, interpolation);
                 break;
             default: /* This cannot happen. */
                 break;
@@ -250,87 +243,30 @@ namespace yw
             clearBox.back = m_Depth;
         }
 
-        // Start to lock data to clear.
-        float* lockData = nullptr;
-        Yw3dResult lockResult = LockBox((void**)&lockData, nullptr);
-        if (YW3D_FAILED(lockResult))
+        if (m_LockedComplete || (nullptr != m_PartialLockData))
         {
-            return lockResult;
+            LOGE(_T("Yw3dVolume::Clear: volume is locked!\n"));
+            return Yw3d_E_InvalidState;
         }
 
-        switch (m_Format)
+        // Clear the voxels in place, addressed through the layout.
+        const uint32_t volumeFloats = GetFormatFloats();
+        const float clearColor[4] = { color.x, color.y, color.z, color.w };
+        for (uint32_t zIdx = clearBox.front; zIdx < clearBox.back; zIdx++)
         {
-        case Yw3d_FMT_R32F:
-            {
-                for (uint32_t zIdx = clearBox.front; zIdx < clearBox.back; zIdx++)
-                {
-                    float* sliceData = &m_Data[zIdx * m_Width * m_Height];
-                    for (uint32_t yIdx = clearBox.top; yIdx < clearBox.bottom; yIdx++)
-                    {
-                        float* curData = &sliceData[yIdx * m_Width + clearBox.left];
-                        for (uint32_t xIdx = clearBox.left; xIdx < clearBox.right; xIdx++, curData++)
-                        {
-                            *curData = color.x;
-                        }
-                    }
-                }
-            }
-            break;
-        case Yw3d_FMT_R32G32F:
-            {
-                for (uint32_t zIdx = clearBox.front; zIdx < clearBox.back; zIdx++)
-                {
-                    Vector2* sliceData = &((Vector2*)m_Data)[zIdx * m_Width * m_Height];
-                    for (uint32_t yIdx = clearBox.top; yIdx < clearBox.bottom; yIdx++)
-                    {
-                        Vector2* curData = &sliceData[yIdx * m_Width + clearBox.left];
-                        for (uint32_t xIdx = clearBox.left; xIdx < clearBox.right; xIdx++, curData++)
-                        {
-                            *curData = color;
-                        }
-                    }
-                }
-            }
-            break;
-        case Yw3d_FMT_R32G32B32F:
-            {
-                for (uint32_t zIdx = clearBox.front; zIdx < clearBox.back; zIdx++)
-                {
-                    Vector3* sliceData = &((Vector3*)m_Data)[zIdx * m_Width * m_Height];
-                    for (uint32_t yIdx = clearBox.top; yIdx < clearBox.bottom; yIdx++)
-                    {
-                        Vector3* curData = &sliceData[yIdx * m_Width + clearBox.left];
-                        for (uint32_t xIdx = clearBox.left; xIdx < clearBox.right; xIdx++, curData++)
-                        {
-                            *curData = color;
-                        }
-                    }
-                }
-            }
-            break;
-        case Yw3d_FMT_R32G32B32A32F:
+            for (uint32_t yIdx = clearBox.top; yIdx < clearBox.bottom; yIdx++)
             {
-                for (uint32_t zIdx = clearBox.front; zIdx < clearBox.back; zIdx++)
+                for (uint32_t xIdx = clearBox.left; xIdx < clearBox.right; xIdx++)
                 {
-                    Vector4* sliceData = &((Vector4*)m_Data)[zIdx * m_Width * m_Height];
-                    for (uint32_t yIdx = clearBox.top; yIdx < clearBox.bottom; yIdx++)
+                    float* curData = &m_Data[GetVoxelIndex(xIdx, yIdx, zIdx) * volumeFloats];
+                    for (uint32_t c = 0; c < volumeFloats; c++)
                     {
-                        Vector4* curData = &sliceData[yIdx * m_Width + clearBox.left];
-                        for (uint32_t xIdx = clearBox.left; xIdx < clearBox.right; xIdx++, curData++)
-                        {
-                            *curData = color;
-                        }
+                        curData[c] = clearColor[c];
                     }
                 }
             }
-            break;
-        default: /* This cannot happen. */
-            LOGE(_T("Yw3dVolume::Clear: invalid volume format.\n"));
-            UnlockBox();
-            return Yw3d_E_InvalidFormat;
         }
 
-        UnlockBox();
         return Yw3d_S_OK;
     }
 
@@ -418,8 +354,8 @@ namespace yw
         const uint32_t destHeight = usedDestBox.bottom - usedDestBox.top;
         const uint32_t destDepth = usedDestBox.back - usedDestBox.front;
 
-        // Directly copy possible?
-        if ((nullptr == srcBox) && (nullptr == destBox) && (destFloat == GetFormatFloats()) && (destWidth == m_Width) && (destHeight == m_Height) && (destDepth == m_Depth))
+        // Directly copy possible? The locked destination data is always linear.
+        if ((Yw3d_VL_Linear == m_Layout) && (nullptr == srcBox) && (nullptr == destBox) && (destFloat == GetFormatFloats()) && (destWidth == m_Width) && (destHeight == m_Height) && (destDepth == m_Depth))
         {
             memcpy(destData, m_Data, sizeof(float) * destFloat * destWidth * destHeight * destDepth);
             destVolume->UnlockBox();
@@ -474,18 +410,31 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
-        if (m_LockedComplete || (nullptr == m_PartialLockData))
+        if (m_LockedComplete || (nullptr != m_PartialLockData))
         {
-            LOGE(_T( "Yw3dVolume::LockBox: data points to null.\n"));
-            return Yw3d_E_InvalidParameters;
+            LOGE(_T( "Yw3dVolume::LockBox: volume is already locked!\n"));
+            return Yw3d_E_InvalidState;
         }
 
+        Yw3dBox entireBox;
         if (nullptr == box)
         {
-            *data = m_Data;
-            m_LockedComplete = true;
+            if (Yw3d_VL_Linear == m_Layout)
+            {
+                *data = m_Data;
+                m_LockedComplete = true;
 
-            return Yw3d_S_OK;
+                return Yw3d_S_OK;
+            }
+
+            // A bricked volume is locked through a linear lock-buffer.
+            entireBox.left = 0;
+            entireBox.top = 0;
+            entireBox.front = 0;
+            entireBox.right = m_Width;
+            entireBox.bottom = m_Height;
+            entireBox.back = m_Depth;
+            box = &entireBox;
         }
 
         if ((box->right > m_Width) || (box->bottom > m_Height) || (box->back > m_Depth))
@@ -508,7 +457,7 @@ namespace yw
         const uint32_t lockDepth = m_PartialLockBox.back - m_PartialLockBox.front;
         const uint32_t volumeFloats = GetFormatFloats();
 
-        m_PartialLockData = new float[lockWidth * lockHeight * lockDepth * volumeFloats];
+        m_PartialLockData = (float*)m_Device->GetAllocator()->Allocate(lockWidth * lockHeight * lockDepth * volumeFloats * sizeof(float));
         if (nullptr == m_PartialLockData)
         {
             LOGE(_T( "Yw3dVolume::LockBox: memory allocation failed!\n"));
@@ -518,12 +467,21 @@ namespace yw
         float* curLockData = m_PartialLockData;
         for (uint32_t zIdx = m_PartialLockBox.front; zIdx < m_PartialLockBox.back; zIdx++)
         {
-            const float* curVolumeData2 = &m_Data[(zIdx * m_Width * m_Height) * volumeFloats];
             for (uint32_t yIdx = m_PartialLockBox.top; yIdx < m_PartialLockBox.bottom; yIdx++)
             {
-                const float* curVolumeData = &curVolumeData2[(yIdx * m_Width + m_PartialLockBox.left) * volumeFloats];
-                memcpy(curLockData, curVolumeData, sizeof(float) * volumeFloats * lockWidth);
-                curLockData += volumeFloats * lockWidth;
+                if (Yw3d_VL_Linear == m_Layout)
+                {
+                    const float* curVolumeData = &m_Data[GetVoxelIndex(m_PartialLockBox.left, yIdx, zIdx) * volumeFloats];
+                    memcpy(curLockData, curVolumeData, sizeof(float) * volumeFloats * lockWidth);
+                    curLockData += volumeFloats * lockWidth;
+                }
+                else
+                {
+                    for (uint32_t xIdx = m_PartialLockBox.left; xIdx < m_PartialLockBox.right; xIdx++, curLockData += volumeFloats)
+                    {
+                        memcpy(curLockData, &m_Data[GetVoxelIndex(xIdx, yIdx, zIdx) * volumeFloats], sizeof(float) * volumeFloats);
+                    }
+                }
             }
         }
         
@@ -552,16 +510,25 @@ namespace yw
         const float* curLockData = m_PartialLockData;
         for (uint32_t zIdx = m_PartialLockBox.front; zIdx < m_PartialLockBox.back; zIdx++)
         {
-            float* curVolumeData2 = &m_Data[(zIdx * m_Width * m_Height) * volumeFloats];
             for (uint32_t yIdx = m_PartialLockBox.top; yIdx < m_PartialLockBox.bottom; yIdx++)
             {
-                float* curVolumeData = &curVolumeData2[(yIdx * m_Width + m_PartialLockBox.left) * volumeFloats];
-                memcpy(curVolumeData, curLockData, sizeof(float) * volumeFloats * lockWidth);
-                curLockData += volumeFloats * lockWidth;
+                if (Yw3d_VL_Linear == m_Layout)
+                {
+                    float* curVolumeData = &m_Data[GetVoxelIndex(m_PartialLockBox.left, yIdx, zIdx) * volumeFloats];
+                    memcpy(curVolumeData, curLockData, sizeof(float) * volumeFloats * lockWidth);
+                    curLockData += volumeFloats * lockWidth;
+                }
+                else
+                {
+                    for (uint32_t xIdx = m_PartialLockBox.left; xIdx < m_PartialLockBox.right; xIdx++, curLockData += volumeFloats)
+                    {
+                        memcpy(&m_Data[GetVoxelIndex(xIdx, yIdx, zIdx) * volumeFloats], curLockData, sizeof(float) * volumeFloats);
+                    }
+                }
             }
         }
 
-        YW_SAFE_DELETE_ARRAY(m_PartialLockData);
+        YW3D_SAFE_FREE(m_Device->GetAllocator(), m_PartialLockData);
         return Yw3d_S_OK;
     }
 
@@ -587,6 +554,11 @@ namespace yw
         }
     }
     
+    Yw3dVolumeLayout Yw3dVolume::GetLayout() const
+    {
+        return m_Layout;
+    }
+
     uint32_t Yw3dVolume::GetWidth() const
     {
         return m_Width;
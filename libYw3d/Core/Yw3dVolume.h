@@ -28,11 +28,12 @@ namespace yw
         // @param[in] height height of the volume to be created in pixels.
         // @param[in] depth depth of the volume to be created in pixels.
         // @param[in] format format of the volume to be created. Member of the enumeration m3dformat; m3dfmt_r32f, m3dfmt_r32g32f, m3dfmt_r32g32b32f or m3dfmt_r32g32b32a32f.
+        // @param[in] layout memory layout of the volume voxels. Member of the enumeration Yw3dVolumeLayout.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
-        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format);
+        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t depth, Yw3dFormat format, Yw3dVolumeLayout layout = Yw3d_VL_Linear);
 
     public:
         // Samples the volume using nearest point sampling.
@@ -74,6 +75,7 @@ namespace yw
         // @return Yw3d_E_InvalidState if the volume is already locked.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         // @note Locking the entire volume is a lot faster than locking a sub-region, because no lock-buffer has to be created and the application may write to the volume directly.
+        // @note The locked data is always linear. A Yw3d_VL_Bricked8x8x8 volume is converted into a lock-buffer on lock and back on unlock, even if the entire volume is locked.
         Yw3dResult LockBox(void** data, const Yw3dBox* box);
 
         // Unlocks the volume; modifications to its contents will become active.
@@ -86,6 +88,9 @@ namespace yw
 
         // Returns the number of floats of the format, e [1,4].
         uint32_t GetFormatFloats() const;
+
+        //< Returns the memory layout of the volume voxels. Member of the enumeration Yw3dVolumeLayout.
+        Yw3dVolumeLayout GetLayout() const;
         
         // Returns the width of the volume in pixels.
         uint32_t GetWidth() const;
@@ -100,6 +105,20 @@ namespace yw
         // Failure to call Release() when finished using the pointer will result in a memory leak.
         class Yw3dDevice* AcquireDevice();
 
+    private:
+        // Returns the index of a voxel in the volume data, depending on the memory layout.
+        // @param[in] x position of the voxel along x-axis.
+        // @param[in] y position of the voxel along y-axis.
+        // @param[in] z position of the voxel along z-axis.
+        inline uint32_t GetVoxelIndex(uint32_t x, uint32_t y, uint32_t z) const;
+
+        // Tri-linearly filters 8 voxels of a float format.
+        // @param[out] color receives the filtered color, missing channels are filled with (0, 0, 1).
+        // @param[in] indices indices of the top-left, top-right, bottom-left and bottom-right voxels of the front slice, followed by those of the back slice.
+        // @param[in] interpolation interpolation weights along x-axis, y-axis and z-axis.
+        template <uint32_t floats>
+        inline void FilterVoxels(Vector4& color, const uint32_t* indices, const float* interpolation) const;
+
     private:
         // Pointer to parent.
         class Yw3dDevice* m_Device;
@@ -125,6 +144,13 @@ namespace yw
         // Depth - 1 of the volume in pixels.
         uint32_t m_DepthMin1;
 
+        // Memory layout of the volume voxels.
+        Yw3dVolumeLayout m_Layout;
+
+        // Number of bricks in a row and in a slice of a bricked volume.
+        uint32_t m_BricksPerRow;
+        uint32_t m_BricksPerSlice;
+
         // True if the whole volume has been locked.
         bool m_LockedComplete;
 
@@ -137,6 +163,31 @@ namespace yw
         // Pointer to volume data.
         float* m_Data;
     };
+
+    inline uint32_t Yw3dVolume::GetVoxelIndex(uint32_t x, uint32_t y, uint32_t z) const
+    {
+        if (Yw3d_VL_Bricked8x8x8 == m_Layout)
+        {
+            // Brick offset plus the offset inside the 8x8x8 brick.
+            return ((((z >> 3) * m_BricksPerSlice + (y >> 3) * m_BricksPerRow + (x >> 3)) << 9) | ((z & 7) << 6) | ((y & 7) << 3) | (x & 7));
+        }
+
+        return (z * m_Height + y) * m_Width + x;
+    }
+
+    template <uint32_t floats>
+    inline void Yw3dVolume::FilterVoxels(Vector4& color, const uint32_t* indices, const float* interpolation) const
+    {
+        float result[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+        for (uint32_t c = 0; c < floats; c++)
+        {
+            const float front = Lerp(Lerp(m_Data[indices[0] * floats + c], m_Data[indices[1] * floats + c], interpolation[0]), Lerp(m_Data[indices[2] * floats + c], m_Data[indices[3] * floats + c], interpolation[0]), interpolation[1]);
+            const float back = Lerp(Lerp(m_Data[indices[4] * floats + c], m_Data[indices[5] * floats + c], interpolation[0]), Lerp(m_Data[indices[6] * floats + c], m_Data[indices[7] * floats + c], interpolation[0]), interpolation[1]);
+            result[c] = Lerp(front, back, interpolation[2]);
+        }
+
+        color.Set(result[0], result[1], result[2], result[3]);
+    }
 }
 
 #endif // !__YW_3D_VOLUME_H__
@@ -3,7 +3,9 @@
 
 #include "Yw3dVolumeTexture.h"
 #include "Yw3dDevice.h"
+#include "Yw3dMipmap.h"
 #include "Yw3dVolume.h"
+#include "Yw3dWorkerPool.h"
 
 namespace yw
 {
@@ -28,7 +30,7 @@ namespace yw
         YW_SAFE_DELETE_ARRAY(m_MipLevelsData);
     }
 
-    Yw3dResult Yw3dVolumeTexture::Create(uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format)
+    Yw3dResult Yw3dVolumeTexture::Create(uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format, Yw3dVolumeLayout layout)
     {
         if ((0 == width) || (0 == height) || (0 == depth))
         {
@@ -76,7 +78,7 @@ namespace yw
         Yw3dVolume** curMipLevelData = m_MipLevelsData;
         do 
         {
-            Yw3dResult resMipLevel = m_Device->CreateVolume(curMipLevelData, width, height, depth, format);
+            Yw3dResult resMipLevel = m_Device->CreateVolume(curMipLevelData, width, height, depth, format, layout);
             if (YW3D_FAILED(resMipLevel))
             {
                 // Destructor will perform cleanup.
@@ -116,7 +118,7 @@ namespace yw
         {
             const float lenXGrad = xGradient->x * xGradient->x * m_SquaredWidth + xGradient->y * xGradient->y * m_SquaredHeight + xGradient->z * xGradient->z * m_SquaredDepth;
             const float lenYGrad = yGradient->x * yGradient->x * m_SquaredWidth + yGradient->y * yGradient->y * m_SquaredHeight + yGradient->z * yGradient->z * m_SquaredDepth;
-            const float texelsPerScreenPixel = sqrtf(lenXGrad > lenYGrad ? lenXGrad : lenYGrad);
+            const float texelsPerScreenPixel = lenXGrad > lenYGrad ? lenXGrad : lenYGrad; // Squared, the square root is folded into the logarithm.
 
             if (texelsPerScreenPixel <= 1.0f)
             {
@@ -127,8 +129,7 @@ namespace yw
             else
             {
                 // Minification, need mipmapping.
-                static const float invLog2 = 1.0f / logf(2.0f); // Calculate log2.
-                texMipLevel = logf(texelsPerScreenPixel) * invLog2;
+                texMipLevel = 0.5f * FastLog2(texelsPerScreenPixel);
                 texFilter = samplerStates[Yw3d_TSS_MinFilter];
             }
         }
@@ -182,153 +183,33 @@ namespace yw
             return Yw3d_E_InvalidParameters;
         }
 
-        // Generate by each mip level.
+        // Generate by each mip level, the rows of all slices of a level are downsampled in parallel.
         for (uint32_t level = srcLevel + 1; level < m_MipLevels; level++)
         {
-            // Lock mip surface data on source data.
-            const float* srcData = nullptr;
-            Yw3dResult resLock = LockBox(level - 1, (void**)&srcData, nullptr);
+            // Lock mip volume data on source data.
+            Yw3dMipLevelData levelData;
+            Yw3dResult resLock = LockBox(level - 1, (void**)&levelData.srcData, nullptr);
             if (YW3D_FAILED(resLock))
             {
                 return resLock;
             }
 
-            // Lock mip surface data on dest data.
-            float* destData = nullptr;
-            resLock = LockBox(level, (void**)&destData, nullptr);
+            // Lock mip volume data on dest data.
+            resLock = LockBox(level, (void**)&levelData.destData, nullptr);
             if (YW3D_FAILED(resLock))
             {
                 UnlockBox(level - 1);
                 return resLock;
             }
 
-            // Get original width, height and depth from source mip level.
-            const uint32_t srcWidth = GetWidth(level - 1);
-            const uint32_t srcHeight = GetHeight(level - 1);
-            const uint32_t srcDepth = GetDepth(level - 1);
+            levelData.srcWidth = GetWidth(level - 1);
+            levelData.srcHeight = GetHeight(level - 1);
+            levelData.srcDepth = GetDepth(level - 1);
+            levelData.destWidth = GetWidth(level);
+            levelData.destHeight = GetHeight(level);
+            levelData.destDepth = GetDepth(level);
 
-            switch (GetFormat())
-            {
-            case Yw3d_FMT_R32F:
-                {
-                    for (uint32_t idxZ = 0; idxZ < srcDepth; idxZ += 2)
-                    {
-                        const uint32_t indexSlices[2] = { idxZ * srcWidth * srcHeight, (idxZ + 1) * srcWidth * srcHeight };
-                        for (uint32_t idxY = 0; idxY < srcHeight; idxY += 2)
-                        {
-                            const uint32_t indexRows[2] = { idxY * srcWidth, (idxY + 1) * srcWidth };
-                            for (uint32_t idxX = 0; idxX < srcWidth; idxX += 2, destData++)
-                            {
-                                const float srcPixels[8] = 
-                                {
-                                    srcData[indexSlices[0] + indexRows[0] + idxX],
-                                    srcData[indexSlices[0] + indexRows[0] + idxX + 1],
-                                    srcData[indexSlices[0] + indexRows[1] + idxX],
-                                    srcData[indexSlices[0] + indexRows[1] + idxX + 1],
-                                    srcData[indexSlices[1] + indexRows[0] + idxX],
-                                    srcData[indexSlices[1] + indexRows[0] + idxX + 1],
-                                    srcData[indexSlices[1] + indexRows[1] + idxX],
-                                    srcData[indexSlices[1] + indexRows[1] + idxX + 1]
-                                };
-
-                                *destData = (srcPixels[0] + srcPixels[1] + srcPixels[2] + srcPixels[3] + 
-                                    srcPixels[4] + srcPixels[5] + srcPixels[6] + srcPixels[7]) * 0.125f;
-                            }
-                        }
-                    }
-                }
-                break;
-            case Yw3d_FMT_R32G32F:
-                {
-                    for (uint32_t idxZ = 0; idxZ < srcDepth; idxZ += 2)
-                    {
-                        const uint32_t indexSlices[2] = { idxZ * srcWidth * srcHeight, (idxZ + 1) * srcWidth * srcHeight };
-                        for (uint32_t idxY = 0; idxY < srcHeight; idxY += 2)
-                        {
-                            const uint32_t indexRows[2] = { idxY * srcWidth, (idxY + 1) * srcWidth };
-                            for (uint32_t idxX = 0; idxX < srcWidth; idxX += 2, destData += 2)
-                            {
-                                const Vector2* srcPixels[8] =
-                                {
-                                    &((Vector2*)srcData)[indexSlices[0] + indexRows[0] + idxX],
-                                    &((Vector2*)srcData)[indexSlices[0] + indexRows[0] + idxX + 1],
-                                    &((Vector2*)srcData)[indexSlices[0] + indexRows[1] + idxX],
-                                    &((Vector2*)srcData)[indexSlices[0] + indexRows[1] + idxX + 1],
-                                    &((Vector2*)srcData)[indexSlices[1] + indexRows[0] + idxX],
-                                    &((Vector2*)srcData)[indexSlices[1] + indexRows[0] + idxX + 1],
-                                    &((Vector2*)srcData)[indexSlices[1] + indexRows[1] + idxX],
-                                    &((Vector2*)srcData)[indexSlices[1] + indexRows[1] + idxX + 1]
-                                };
-
-                                *(Vector2*)destData = (*srcPixels[0] + *srcPixels[1] + *srcPixels[2] + *srcPixels[3] +
-                                    *srcPixels[4] + *srcPixels[5] + *srcPixels[6] + *srcPixels[7]) * 0.125f;
-                            }
-                        }
-                    }
-                }
-                break;
-            case Yw3d_FMT_R32G32B32F:
-                {
-                    for (uint32_t idxZ = 0; idxZ < srcDepth; idxZ += 2)
-                    {
-                        const uint32_t indexSlices[2] = { idxZ * srcWidth * srcHeight, (idxZ + 1) * srcWidth * srcHeight };
-                        for (uint32_t idxY = 0; idxY < srcHeight; idxY += 2)
-                        {
-                            const uint32_t indexRows[2] = { idxY * srcWidth, (idxY + 1) * srcWidth };
-                            for (uint32_t idxX = 0; idxX < srcWidth; idxX += 2, destData += 3)
-                            {
-                                const Vector3* srcPixels[8] =
-                                {
-                                    &((Vector3*)srcData)[indexSlices[0] + indexRows[0] + idxX],
-                                    &((Vector3*)srcData)[indexSlices[0] + indexRows[0] + idxX + 1],
-                                    &((Vector3*)srcData)[indexSlices[0] + indexRows[1] + idxX],
-                                    &((Vector3*)srcData)[indexSlices[0] + indexRows[1] + idxX + 1],
-                                    &((Vector3*)srcData)[indexSlices[1] + indexRows[0] + idxX],
-                                    &((Vector3*)srcData)[indexSlices[1] + indexRows[0] + idxX + 1],
-                                    &((Vector3*)srcData)[indexSlices[1] + indexRows[1] + idxX],
-                                    &((Vector3*)srcData)[indexSlices[1] + indexRows[1] + idxX + 1]
-                                };
-
-                                *(Vector3*)destData = (*srcPixels[0] + *srcPixels[1] + *srcPixels[2] + *srcPixels[3] +
-                                    *srcPixels[4] + *srcPixels[5] + *srcPixels[6] + *srcPixels[7]) * 0.125f;
-                            }
-                        }
-                    }
-                }
-                break;
-            case Yw3d_FMT_R32G32B32A32F:
-                {
-                    for (uint32_t idxZ = 0; idxZ < srcDepth; idxZ += 2)
-                    {
-                        const uint32_t indexSlices[2] = { idxZ * srcWidth * srcHeight, (idxZ + 1) * srcWidth * srcHeight };
-                        for (uint32_t idxY = 0; idxY < srcHeight; idxY += 2)
-                        {
-                            const uint32_t indexRows[2] = { idxY * srcWidth, (idxY + 1) * srcWidth };
-                            for (uint32_t idxX = 0; idxX < srcWidth; idxX += 2, destData += 4)
-                            {
-                                const Vector4* srcPixels[8] =
-                                {
-                                    &((Vector4*)srcData)[indexSlices[0] + indexRows[0] + idxX],
-                                    &((Vector4*)srcData)[indexSlices[0] + indexRows[0] + idxX + 1],
-                                    &((Vector4*)srcData)[indexSlices[0] + indexRows[1] + idxX],
-                                    &((Vector4*)srcData)[indexSlices[0] + indexRows[1] + idxX + 1],
-                                    &((Vector4*)srcData)[indexSlices[1] + indexRows[0] + idxX],
-                                    &((Vector4*)srcData)[indexSlices[1] + indexRows[0] + idxX + 1],
-                                    &((Vector4*)srcData)[indexSlices[1] + indexRows[1] + idxX],
-                                    &((Vector4*)srcData)[indexSlices[1] + indexRows[1] + idxX + 1]
-                                };
-
-                                *(Vector4*)destData = (*srcPixels[0] + *srcPixels[1] + *srcPixels[2] + *srcPixels[3] +
-                                    *srcPixels[4] + *srcPixels[5] + *srcPixels[6] + *srcPixels[7]) * 0.125f;
-                            }
-                        }
-                    }
-                }
-                break;
-            default:
-                // This can not happen.
-                break;
-            }
+            GenerateMipLevels(m_Device->GetWorkerPool(), m_Device->GetSimdKernels(), &levelData, 1, GetFormatFloats(), Yw3d_MF_Box);
 
             // Unlock data.
             UnlockBox(level);
@@ -30,11 +30,12 @@ namespace yw
         // @param[in] depth depth of the texture to be created in pixels.
         // @param[in] mipLevels number of mip-levels to be created. Specify 0 to create a full mip-chain.
         // @param[in] format format of the texture to be created. Member of the enumeration Yw3dFormat; Yw3d_FMT_R32F, Yw3d_FMT_R32G32F, Yw3d_FMT_R32G32B32F or Yw3d_FMT_R32G32B32A32F.
+        // @param[in] layout memory layout of the mip-level voxels. Member of the enumeration Yw3dVolumeLayout.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
         // @return Yw3d_E_OutOfMemory if memory allocation failed.
         // @return Yw3d_E_InvalidFormat if an invalid format was encountered.
-        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format);
+        Yw3dResult Create(uint32_t width, uint32_t height, uint32_t depth, uint32_t mipLevels, Yw3dFormat format, Yw3dVolumeLayout layout);
 
         // Sampling this texture requires 3 floating point coordinates.
         Yw3dTextureSampleInput GetTextureSampleInput() const;
@@ -53,7 +54,8 @@ namespace yw
         Yw3dResult SampleTexture(Vector4& color, float u, float v, float w, float lod, const Vector4* xGradient, const Vector4* yGradient, const uint32_t* samplerStates);
 
     public:
-        // Generates mip-sublevels through downsampling (using a box-filter) a given source mip-level.
+        // Generates mip-sublevels through downsampling (using a 2x2x2 box-filter) a given source mip-level.
+        // The rows of all slices are downsampled in parallel by the worker pool of the device, odd dimensions use a polyphase box filter.
         // @param[in] srcLevel the mip-level which will be taken as the starting point.
         // @return Yw3d_S_OK if the function succeeds.
         // @return Yw3d_E_InvalidParameters if one or more parameters were invalid.
@@ -0,0 +1,138 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d worker pool class.
+
+#include "Yw3dWorkerPool.h"
+
+namespace yw
+{
+    Yw3dWorkerPool::Yw3dWorkerPool() :
+        m_Job(nullptr),
+        m_JobCount(0),
+        m_NextItem(0),
+        m_JobGeneration(0),
+        m_BusyWorkers(0),
+        m_Exit(false)
+    {
+    }
+
+    Yw3dWorkerPool::~Yw3dWorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_Exit = true;
+        }
+
+        m_JobCondition.notify_all();
+        for (size_t workerIdx = 0; workerIdx < m_Workers.size(); workerIdx++)
+        {
+            m_Workers[workerIdx].join();
+        }
+    }
+
+    Yw3dResult Yw3dWorkerPool::Create(uint32_t numThreads)
+    {
+        if (!m_Workers.empty())
+        {
+            LOGE(_T("Yw3dWorkerPool::Create: worker pool has already been created.\n"));
+            return Yw3d_E_InvalidState;
+        }
+
+        if (0 == numThreads)
+        {
+            // The dispatching thread is working too.
+            const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            numThreads = (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+        }
+
+        m_Workers.reserve(numThreads);
+        for (uint32_t threadIdx = 0; threadIdx < numThreads; threadIdx++)
+        {
+            m_Workers.push_back(std::thread(&Yw3dWorkerPool::WorkerMain, this));
+        }
+
+        return Yw3d_S_OK;
+    }
+
+    void Yw3dWorkerPool::ParallelFor(uint32_t count, const Job& job)
+    {
+        if (0 == count)
+        {
+            return;
+        }
+
+        // Not worth waking up the workers.
+        if (m_Workers.empty() || (1 == count))
+        {
+            for (uint32_t item = 0; item < count; item++)
+            {
+                job(item);
+            }
+
+            return;
+        }
+
+        std::lock_guard<std::mutex> dispatchLock(m_DispatchMutex);
+
+        {
+            std::lock_guard<std::mutex> lock(m_JobMutex);
+            m_Job = &job;
+            m_JobCount = count;
+            m_NextItem = 0;
+            m_BusyWorkers = (uint32_t)m_Workers.size();
+            m_JobGeneration++;
+        }
+
+        m_JobCondition.notify_all();
+
+        // Work on the job with the calling thread as well.
+        RunItems();
+
+        // Wait for the workers, the job object must be valid until the last one has left.
+        std::unique_lock<std::mutex> lock(m_JobMutex);
+        m_DoneCondition.wait(lock, [this]() { return 0 == m_BusyWorkers; });
+        m_Job = nullptr;
+    }
+
+    uint32_t Yw3dWorkerPool::GetConcurrency() const
+    {
+        return (uint32_t)m_Workers.size() + 1;
+    }
+
+    void Yw3dWorkerPool::WorkerMain()
+    {
+        uint32_t lastGeneration = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_JobMutex);
+                m_JobCondition.wait(lock, [this, lastGeneration]() { return m_Exit || (lastGeneration != m_JobGeneration); });
+                if (m_Exit)
+                {
+                    return;
+                }
+
+                lastGeneration = m_JobGeneration;
+            }
+
+            RunItems();
+
+            {
+                std::lock_guard<std::mutex> lock(m_JobMutex);
+                if (0 == --m_BusyWorkers)
+                {
+                    m_DoneCondition.notify_one();
+                }
+            }
+        }
+    }
+
+    void Yw3dWorkerPool::RunItems()
+    {
+        const Job& job = *m_Job;
+        const uint32_t count = m_JobCount;
+        for (uint32_t item = m_NextItem++; item < count; item = m_NextItem++)
+        {
+            job(item);
+        }
+    }
+}
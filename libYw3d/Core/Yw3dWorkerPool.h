@@ -0,0 +1,90 @@
+// Add by Yaukey at 2026-10-19.
+// YW Soft Renderer 3d worker pool class.
+
+#ifndef __YW_3D_WORKER_POOL_H__
+#define __YW_3D_WORKER_POOL_H__
+
+#include "Yw3dBase.h"
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace yw
+{
+    // Yw3dWorkerPool keeps a set of worker threads to split data-parallel work like converting rows of an image.
+    // The pool is owned by Yw3dDevice, a job is run by ParallelFor() which returns when all of its items have been processed.
+    class Yw3dWorkerPool
+    {
+    public:
+        // Job function, called once for every item index.
+        typedef std::function<void(uint32_t)> Job;
+
+    public:
+        // Constructor, no threads are started before Create() is called.
+        Yw3dWorkerPool();
+
+        // Destructor, stops and joins all worker threads.
+        ~Yw3dWorkerPool();
+
+    public:
+        // Starts the worker threads.
+        // @param[in] numThreads number of worker threads, the thread calling ParallelFor() is working too. Pass 0 for the number of hardware threads - 1.
+        // @return Yw3d_S_OK if the function succeeds.
+        // @return Yw3d_E_InvalidState if the pool has already been created.
+        Yw3dResult Create(uint32_t numThreads);
+
+        // Runs a job for every item index in [0, count) and waits for all items to be finished. Calls from different threads are serialized.
+        // @param[in] count number of items.
+        // @param[in] job the job function to be called for each item.
+        // @note A job must not call ParallelFor() of the same pool.
+        void ParallelFor(uint32_t count, const Job& job);
+
+        //< Returns the number of threads working on a job, including the calling thread.
+        uint32_t GetConcurrency() const;
+
+    private:
+        // Entry of the worker threads.
+        void WorkerMain();
+
+        // Processes items of the current job until all items are taken.
+        void RunItems();
+
+    private:
+        // The worker threads.
+        std::vector<std::thread> m_Workers;
+
+        // Serializes calls of ParallelFor().
+        std::mutex m_DispatchMutex;
+
+        // Guards the job state below.
+        std::mutex m_JobMutex;
+
+        // Signals the workers that a new job is available or the pool is shutting down.
+        std::condition_variable m_JobCondition;
+
+        // Signals the dispatching thread that all workers have left the current job.
+        std::condition_variable m_DoneCondition;
+
+        // The current job, nullptr if there is no job.
+        const Job* m_Job;
+
+        // Number of items of the current job.
+        uint32_t m_JobCount;
+
+        // Index of the next item to be processed.
+        std::atomic<uint32_t> m_NextItem;
+
+        // Incremented for each job so sleeping workers can tell a new job from a spurious wakeup.
+        uint32_t m_JobGeneration;
+
+        // Number of workers still working on the current job.
+        uint32_t m_BusyWorkers;
+
+        // True if the worker threads should exit.
+        bool m_Exit;
+    };
+}
+
+#endif // !__YW_3D_WORKER_POOL_H__
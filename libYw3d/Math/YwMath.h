@@ -10,5 +10,6 @@
 #include "YwMathMatrix.h"
 #include "YwMathPlane.h"
 #include "YwMathUtility.h"
+#include "YwMathFast.h"
 
 #endif // !__YW_MATH_H__
@@ -6,6 +6,20 @@
 
 #include <math.h>
 
+// SIMD support, define YW_MATH_NO_SIMD to use the scalar code only.
+// SSE is always available on x64 and enabled by the compiler on x86 if the target supports it, AVX if the target supports it, e.g. /arch:AVX or -mavx.
+#if !defined(YW_MATH_NO_SIMD)
+    #if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1)) || defined(__SSE__)
+        #define YW_MATH_SSE 1
+        #include <xmmintrin.h>
+    #endif
+
+    #if defined(YW_MATH_SSE) && defined(__AVX__)
+        #define YW_MATH_AVX 1
+        #include <immintrin.h>
+    #endif
+#endif
+
 namespace yw
 {
     // Float compare precision.
@@ -28,6 +42,29 @@ namespace yw
     #define YW_INV_FOUR_PI 0.07957747155f
     #define YW_HALF_PI 1.57079632679f
     #define YW_INV_HALF_PI 0.636619772367f
+
+#if defined(YW_MATH_SSE)
+    // Multiplies the row vector v by the row-major 4x4 matrix m. The data need not be aligned.
+    // The products are summed in the same order as the scalar code, so the results are bit-identical to it.
+    inline __m128 MathTransformRowSSE(const float* v, const float* m)
+    {
+        __m128 result = _mm_mul_ps(_mm_set1_ps(v[0]), _mm_loadu_ps(m));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[1]), _mm_loadu_ps(m + 4)));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[2]), _mm_loadu_ps(m + 8)));
+        return _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(v[3]), _mm_loadu_ps(m + 12)));
+    }
+#endif
+
+#if defined(YW_MATH_AVX)
+    // Multiplies the two consecutive row vectors v[0..3] and v[4..7] by the row-major 4x4 matrix m, like MathTransformRowSSE() for each.
+    inline __m256 MathTransformRowsAVX(const float* v, const float* m)
+    {
+        __m256 result = _mm256_mul_ps(_mm256_setr_ps(v[0], v[0], v[0], v[0], v[4], v[4], v[4], v[4]), _mm256_broadcast_ps((const __m128*)m));
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_setr_ps(v[1], v[1], v[1], v[1], v[5], v[5], v[5], v[5]), _mm256_broadcast_ps((const __m128*)(m + 4))));
+        result = _mm256_add_ps(result, _mm256_mul_ps(_mm256_setr_ps(v[2], v[2], v[2], v[2], v[6], v[6], v[6], v[6]), _mm256_broadcast_ps((const __m128*)(m + 8))));
+        return _mm256_add_ps(result, _mm256_mul_ps(_mm256_setr_ps(v[3], v[3], v[3], v[3], v[7], v[7], v[7], v[7]), _mm256_broadcast_ps((const __m128*)(m + 12))));
+    }
+#endif
 }
 
 #endif // !__YW_MATH_BASE_DEFINE_H__
@@ -0,0 +1,222 @@
+// Add by yaukey at 2026-10-19.
+// Fast approximations of math functions, mainly for shaders.
+
+#ifndef __YW_MATH_FAST_H__
+#define __YW_MATH_FAST_H__
+
+#include "YwMathBaseDefine.h"
+#include <stdint.h>
+
+// Precision levels of the fast approximations.
+#define YW_MATH_PRECISION_EXACT 0 // Calls the C runtime functions.
+#define YW_MATH_PRECISION_HIGH 1  // Approximations with errors far below the precision of 8-bit colors.
+#define YW_MATH_PRECISION_LOW 2   // Cheapest approximations, errors may become visible in smooth gradients.
+
+// Global precision of the fast approximations, define it in the build settings to trade accuracy for speed per deployment.
+// Default: YW_MATH_PRECISION_HIGH.
+#ifndef YW_MATH_FAST_PRECISION
+    #define YW_MATH_FAST_PRECISION YW_MATH_PRECISION_HIGH
+#endif
+
+namespace yw
+{
+    // The approximations use no tables and no branches besides selects, mostly multiplications, additions, comparisons and bit operations.
+    // The exceptions are a division in FastLog2 (HIGH) and FastAtan2 and a square root in FastAcos, which are single instructions as well,
+    // so the compiler is able to vectorize loops calling them. The error bounds below are measured over the whole valid input range.
+
+    /**
+     * @brief Bit casts between a float and its IEEE-754 representation.
+     */
+    union FastFloatBits
+    {
+        float f;
+        uint32_t i;
+    };
+
+    /**
+     * @brief Approximates 1 / x.
+     * Max relative error: HIGH 2.0e-7 (rcpss and a Newton-Raphson step), LOW 3.0e-4 (rcpss), exact division without SSE.
+     * @param[in] x a non-zero number.
+     * @return the reciprocal of x.
+     */
+    inline float FastRcp(float x)
+    {
+    #if (YW_MATH_FAST_PRECISION != YW_MATH_PRECISION_EXACT) && defined(YW_MATH_SSE)
+        const float estimate = _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x)));
+        #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_HIGH
+            return estimate * (2.0f - x * estimate);
+        #else
+            return estimate;
+        #endif
+    #else
+        return 1.0f / x;
+    #endif
+    }
+
+    /**
+     * @brief Approximates 1 / sqrt(x).
+     * Max relative error: HIGH 2.7e-7 with SSE (rsqrtss and a Newton-Raphson step) or 4.7e-6 without (bit trick and two steps),
+     * LOW 3.3e-4 with SSE (rsqrtss) or 1.8e-3 without (bit trick and one step).
+     * @param[in] x a positive number.
+     * @return the reciprocal square root of x.
+     */
+    inline float FastRsqrt(float x)
+    {
+    #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_EXACT
+        return 1.0f / sqrtf(x);
+    #elif defined(YW_MATH_SSE)
+        const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+        #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_HIGH
+            return estimate * (1.5f - 0.5f * x * estimate * estimate);
+        #else
+            return estimate;
+        #endif
+    #else
+        FastFloatBits bits;
+        bits.f = x;
+        bits.i = 0x5f375a86 - (bits.i >> 1);
+        float estimate = bits.f * (1.5f - 0.5f * x * bits.f * bits.f);
+        #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_HIGH
+            estimate = estimate * (1.5f - 0.5f * x * estimate * estimate);
+        #endif
+        return estimate;
+    #endif
+    }
+
+    /**
+     * @brief Approximates 2^x. The integer part of x is stored into the exponent bits, 2^fraction is approximated by a minimax polynomial.
+     * Max relative error: HIGH 1.6e-7 (degree 5), LOW 7.5e-5 (degree 3).
+     * @param[in] x the exponent, clamped to [-126,128), so the result is never 0 or infinite.
+     * @return 2 raised to the power of x.
+     */
+    inline float FastExp2(float x)
+    {
+    #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_EXACT
+        return exp2f(x);
+    #else
+        x = (x < -126.0f) ? -126.0f : ((x > 127.99999f) ? 127.99999f : x);
+
+        // Floor of x, the cast truncates towards 0.
+        int32_t integer = (int32_t)x;
+        integer -= (x < (float)integer) ? 1 : 0;
+        const float fraction = x - (float)integer;
+
+        #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_HIGH
+            const float polynomial = ((((1.8775767e-3f * fraction + 8.9893397e-3f) * fraction + 5.5826318e-2f) * fraction + 2.4015361e-1f) * fraction + 6.9315308e-1f) * fraction + 9.9999994e-1f;
+        #else
+            const float polynomial = ((7.8024521e-2f * fraction + 2.2606716e-1f) * fraction + 6.9583356e-1f) * fraction + 9.9992520e-1f;
+        #endif
+
+        FastFloatBits bits;
+        bits.i = (uint32_t)(integer + 127) << 23;
+        return bits.f * polynomial;
+    #endif
+    }
+
+    /**
+     * @brief Approximates log2(x). The exponent bits are the integer part, log2 of the mantissa is approximated by a polynomial.
+     * Max absolute error: HIGH 3.9e-6 (atanh series of degree 7, the error is the float rounding of large results), LOW 5.0e-3 (quadratic polynomial).
+     * Also used by the mip-level selection of the texture samplers, where logf() costs about as much as a texel fetch.
+     * @param[in] x a positive normalized number.
+     * @return the base-2 logarithm of x.
+     */
+    inline float FastLog2(float x)
+    {
+    #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_EXACT
+        return log2f(x);
+    #else
+        FastFloatBits bits;
+        bits.f = x;
+        float exponent = (float)((int32_t)((bits.i >> 23) & 0xff) - 127);
+        bits.i = (bits.i & 0x007fffff) | 0x3f800000;
+        float mantissa = bits.f;
+
+        #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_HIGH
+            // Center the mantissa around 1, log2(m) = 2 / ln(2) * atanh((m - 1) / (m + 1)) converges fast for |(m - 1) / (m + 1)| < 0.172.
+            exponent += (mantissa > 1.41421356f) ? 1.0f : 0.0f;
+            mantissa *= (mantissa > 1.41421356f) ? 0.5f : 1.0f;
+            const float s = (mantissa - 1.0f) / (mantissa + 1.0f);
+            const float squaredS = s * s;
+            const float polynomial = (((0.4121985831f * squaredS + 0.5770780164f) * squaredS + 0.9617966939f) * squaredS + 2.8853900818f) * s;
+        #else
+            const float polynomial = (-0.34484843f * mantissa + 2.02466578f) * mantissa - 1.67487759f;
+        #endif
+
+        return exponent + polynomial;
+    #endif
+    }
+
+    /**
+     * @brief Approximates pow(x, p) as 2^(p * log2(x)).
+     * The relative error grows with |p * log2(x)|, max relative error for x in [0.001,1]: HIGH 3.1e-6 for p = 5 and 1.3e-5 for p = 256,
+     * LOW 0.017 for p = 5 and 0.12 for p = 32, so the LOW level does not suit sharp specular highlights.
+     * @param[in] x a non-negative base, pow(0, p) returns about 1e-38 for p > 0.
+     * @param[in] p the exponent.
+     * @return x raised to the power of p.
+     */
+    inline float FastPow(float x, float p)
+    {
+    #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_EXACT
+        return powf(x, p);
+    #else
+        return FastExp2(p * FastLog2(x));
+    #endif
+    }
+
+    /**
+     * @brief Approximates acos(x) as sqrt(1 - |x|) times a polynomial, <<Handbook of Mathematical Functions>> 4.4.45 and 4.4.46.
+     * Max absolute error: HIGH 4.4e-7 (degree 7), LOW 6.8e-5 (degree 3).
+     * @param[in] x the cosine, clamped to [-1,1].
+     * @return the angle in [0,PI].
+     */
+    inline float FastAcos(float x)
+    {
+    #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_EXACT
+        return acosf((x < -1.0f) ? -1.0f : ((x > 1.0f) ? 1.0f : x));
+    #else
+        const float a = (x < 0.0f) ? ((x < -1.0f) ? 1.0f : -x) : ((x > 1.0f) ? 1.0f : x);
+
+        #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_HIGH
+            const float polynomial = ((((((-0.0012624911f * a + 0.0066700901f) * a - 0.0170881256f) * a + 0.0308918810f) * a - 0.0501743046f) * a + 0.0889789874f) * a - 0.2145988016f) * a + 1.5707963050f;
+        #else
+            const float polynomial = ((-0.0187293f * a + 0.0742610f) * a - 0.2121144f) * a + 1.5707288f;
+        #endif
+
+        const float angle = sqrtf(1.0f - a) * polynomial;
+        return (x < 0.0f) ? (YW_PI - angle) : angle;
+    #endif
+    }
+
+    /**
+     * @brief Approximates atan2(y, x), atan of the ratio of the smaller and the larger magnitude in [0,1] is approximated by a polynomial and moved into the quadrant.
+     * Max absolute error: HIGH 2.0e-6 (odd degree 11), LOW 3.8e-3 (PI/4 * a + 0.273 * a * (1 - a)).
+     * @param[in] y the y-coordinate.
+     * @param[in] x the x-coordinate.
+     * @return the angle in [-PI,PI], 0 if both coordinates are 0.
+     */
+    inline float FastAtan2(float y, float x)
+    {
+    #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_EXACT
+        return atan2f(y, x);
+    #else
+        const float absX = fabsf(x);
+        const float absY = fabsf(y);
+        const float maxXY = (absX > absY) ? absX : absY;
+        const float minXY = (absX > absY) ? absY : absX;
+        const float a = (maxXY > 0.0f) ? (minXY / maxXY) : 0.0f;
+
+        #if YW_MATH_FAST_PRECISION == YW_MATH_PRECISION_HIGH
+            const float squaredA = a * a;
+            float angle = (((((-0.01172120f * squaredA + 0.05265332f) * squaredA - 0.11643287f) * squaredA + 0.19354346f) * squaredA - 0.33262347f) * squaredA + 0.99997726f) * a;
+        #else
+            float angle = (0.25f * YW_PI + 0.273f * (1.0f - a)) * a;
+        #endif
+
+        angle = (absY > absX) ? (YW_HALF_PI - angle) : angle;
+        angle = (x < 0.0f) ? (YW_PI - angle) : angle;
+        return (y < 0.0f) ? -angle : angle;
+    #endif
+    }
+}
+
+#endif // !__YW_MATH_FAST_H__
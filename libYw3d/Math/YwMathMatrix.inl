@@ -446,6 +446,19 @@ namespace yw
 
     inline Matrix44 Matrix44::operator *(const Matrix44 &m) const
     {
+    #if defined(YW_MATH_AVX)
+        Matrix44 value;
+        _mm256_storeu_ps(value.m, MathTransformRowsAVX(this->m, m.m));
+        _mm256_storeu_ps(value.m + 8, MathTransformRowsAVX(this->m + 8, m.m));
+        return value;
+    #elif defined(YW_MATH_SSE)
+        Matrix44 value;
+        _mm_storeu_ps(value.m, MathTransformRowSSE(this->m, m.m));
+        _mm_storeu_ps(value.m + 4, MathTransformRowSSE(this->m + 4, m.m));
+        _mm_storeu_ps(value.m + 8, MathTransformRowSSE(this->m + 8, m.m));
+        _mm_storeu_ps(value.m + 12, MathTransformRowSSE(this->m + 12, m.m));
+        return value;
+    #else
         Matrix44 value(
             _11 * m._11 + _12 * m._21 + _13 * m._31 + _14 * m._41,
             _11 * m._12 + _12 * m._22 + _13 * m._32 + _14 * m._42,
@@ -468,6 +481,7 @@ namespace yw
             _41 * m._14 + _42 * m._24 + _43 * m._34 + _44 * m._44
         );
         return value;
+    #endif
     }
 
     inline Matrix44 Matrix44::operator *(const float n) const
@@ -516,6 +530,21 @@ namespace yw
 
     inline Matrix44& Matrix44::operator *=(const Matrix44& m)
     {
+    #if defined(YW_MATH_AVX)
+        const __m256 rows12 = MathTransformRowsAVX(this->m, m.m);
+        const __m256 rows34 = MathTransformRowsAVX(this->m + 8, m.m);
+        _mm256_storeu_ps(this->m, rows12);
+        _mm256_storeu_ps(this->m + 8, rows34);
+    #elif defined(YW_MATH_SSE)
+        const __m128 row1 = MathTransformRowSSE(this->m, m.m);
+        const __m128 row2 = MathTransformRowSSE(this->m + 4, m.m);
+        const __m128 row3 = MathTransformRowSSE(this->m + 8, m.m);
+        const __m128 row4 = MathTransformRowSSE(this->m + 12, m.m);
+        _mm_storeu_ps(this->m, row1);
+        _mm_storeu_ps(this->m + 4, row2);
+        _mm_storeu_ps(this->m + 8, row3);
+        _mm_storeu_ps(this->m + 12, row4);
+    #else
         const float f11 = _11 * m._11 + _12 * m._21 + _13 * m._31 + _14 * m._41;
         const float f12 = _11 * m._12 + _12 * m._22 + _13 * m._32 + _14 * m._42;
         const float f13 = _11 * m._13 + _12 * m._23 + _13 * m._33 + _14 * m._43;
@@ -540,6 +569,7 @@ namespace yw
         _21 = f21; _22 = f22; _23 = f23; _24 = f24;
         _31 = f31; _32 = f32; _33 = f33; _34 = f34;
         _41 = f41; _42 = f42; _43 = f43; _44 = f44;
+    #endif
 
         return *this;
     }
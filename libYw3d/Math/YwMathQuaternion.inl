@@ -76,10 +76,20 @@ namespace yw
         // We want a * b * c give us a combination of rotation a, b and c.
         // So, we do a litter trick here.
         // Check <<3D Math Primer for Graphics and Game Development>> Character 10.4.8 "Quaternion Multiplication (Cross Product)" for more details.
+    #if defined(YW_MATH_SSE)
+        // The same sums term by term, subtracted terms are added with a negated factor which gives identical results.
+        const __m128 qv = _mm_loadu_ps(&q.x);
+        __m128 result = _mm_mul_ps(_mm_set1_ps(w), qv);
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_setr_ps(x, x, -x, -x), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(0, 1, 2, 3))));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_setr_ps(z, y, y, -y), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(1, 0, 3, 1))));
+        result = _mm_add_ps(result, _mm_mul_ps(_mm_setr_ps(-y, -z, z, -z), _mm_shuffle_ps(qv, qv, _MM_SHUFFLE(2, 3, 0, 2))));
+        _mm_storeu_ps(&value.x, result);
+    #else
         value.x = w * q.x + x * q.w + z * q.y - y * q.z;
         value.y = w * q.y + x * q.z + y * q.w - z * q.x;
         value.z = w * q.z - x * q.y + y * q.x + z * q.w;
         value.w = w * q.w - x * q.x - y * q.y - z * q.z;
+    #endif
 
         return value;
     }
@@ -972,30 +972,59 @@ namespace yw
 
     inline Vector4 Vector4::operator +(const Vector4& v) const
     {
+    #if defined(YW_MATH_SSE)
+        Vector4 value;
+        _mm_storeu_ps(value.m, _mm_add_ps(_mm_loadu_ps(m), _mm_loadu_ps(v.m)));
+        return value;
+    #else
         Vector4 value(x + v.x, y + v.y, z + v.z, w + v.w);
         return value;
+    #endif
     }
 
     inline Vector4 Vector4::operator -(const Vector4& v) const
     {
+    #if defined(YW_MATH_SSE)
+        Vector4 value;
+        _mm_storeu_ps(value.m, _mm_sub_ps(_mm_loadu_ps(m), _mm_loadu_ps(v.m)));
+        return value;
+    #else
         Vector4 value(x - v.x, y - v.y, z - v.z, w - v.w);
         return value;
+    #endif
     }
 
     inline Vector4 Vector4::operator *(const Vector4& v) const
     {
+    #if defined(YW_MATH_SSE)
+        Vector4 value;
+        _mm_storeu_ps(value.m, _mm_mul_ps(_mm_loadu_ps(m), _mm_loadu_ps(v.m)));
+        return value;
+    #else
         Vector4 value(x * v.x, y * v.y, z * v.z, w * v.w);
         return value;
+    #endif
     }
 
     inline Vector4 Vector4::operator *(const float n) const
     {
+    #if defined(YW_MATH_SSE)
+        Vector4 value;
+        _mm_storeu_ps(value.m, _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(n)));
+        return value;
+    #else
         Vector4 value(x * n, y * n, z * n, w * n);
         return value;
+    #endif
     }
 
     inline Vector4 Vector4::operator *(const Matrix44& m) const
     {
+    #if defined(YW_MATH_SSE)
+        Vector4 value;
+        _mm_storeu_ps(value.m, MathTransformRowSSE(this->m, m.m));
+        return value;
+    #else
         Vector4 value(
             x * m._11 + y * m._21 + z * m._31 + w * m._41,
             x * m._12 + y * m._22 + z * m._32 + w * m._42,
@@ -1003,6 +1032,7 @@ namespace yw
             x * m._14 + y * m._24 + z * m._34 + w * m._44
         );
         return value;
+    #endif
     }
 
     inline Vector4 Vector4::operator /(const float n) const
@@ -1021,40 +1051,56 @@ namespace yw
 
     inline Vector4& Vector4::operator +=(const Vector4& v)
     {
+    #if defined(YW_MATH_SSE)
+        _mm_storeu_ps(m, _mm_add_ps(_mm_loadu_ps(m), _mm_loadu_ps(v.m)));
+    #else
         x += v.x;
         y += v.y;
         z += v.z;
         w += v.w;
+    #endif
 
         return *this;
     }
 
     inline Vector4& Vector4::operator -=(const Vector4& v)
     {
+    #if defined(YW_MATH_SSE)
+        _mm_storeu_ps(m, _mm_sub_ps(_mm_loadu_ps(m), _mm_loadu_ps(v.m)));
+    #else
         x -= v.x;
         y -= v.y;
         z -= v.z;
         w -= v.w;
+    #endif
 
         return *this;
     }
 
     inline Vector4& Vector4::operator *=(const Vector4& v)
     {
+    #if defined(YW_MATH_SSE)
+        _mm_storeu_ps(m, _mm_mul_ps(_mm_loadu_ps(m), _mm_loadu_ps(v.m)));
+    #else
         x *= v.x;
         y *= v.y;
         z *= v.z;
         w *= v.w;
+    #endif
 
         return *this;
     }
 
     inline Vector4& Vector4::operator *=(const float n)
     {
+    #if defined(YW_MATH_SSE)
+        _mm_storeu_ps(m, _mm_mul_ps(_mm_loadu_ps(m), _mm_set1_ps(n)));
+    #else
         x *= n;
         y *= n;
         z *= n;
         w *= n;
+    #endif
 
         return *this;
     }
@@ -1082,6 +1128,11 @@ namespace yw
 
     inline Vector4& Vector4::operator *=(const Matrix44& m)
     {
+    #if defined(YW_MATH_SSE)
+        _mm_storeu_ps(this->m, MathTransformRowSSE(this->m, m.m));
+
+        return *this;
+    #else
         float nx = x * m._11 + y * m._21 + z * m._31 + w * m._41;
         float ny = x * m._12 + y * m._22 + z * m._32 + w * m._42;
         float nz = x * m._13 + y * m._23 + z * m._33 + w * m._43;
@@ -1093,6 +1144,7 @@ namespace yw
         w = nw;
 
         return *this;
+    #endif
     }
 
     inline Vector4::operator Vector2()
@@ -5,6 +5,22 @@
 #define __YW_3D_BASE_H__
 
 #include "YwBase.h"
+#include <atomic>
+
+// ------------------------------------------------------------------
+// SIMD support.
+
+// SSE2 is always available on x64 and enabled by the compiler on x86 if the target supports it.
+#if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)) || defined(__SSE2__)
+    #define YW3D_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+// AVX is enabled by the compiler if the target supports it, e.g. /arch:AVX or -mavx.
+#if defined(__AVX__)
+    #define YW3D_AVX 1
+    #include <immintrin.h>
+#endif
 
 namespace yw
 {
@@ -50,7 +66,7 @@ namespace yw
         IBase(const IBase &) {}
 
     public:
-        // AddRef() increases the reference count.
+        // AddRef() increases the reference count. The reference count is atomic, resources may be created and released by a loading thread.
         inline void AddRef() 
         { 
             ++m_RefCount; 
@@ -73,7 +89,7 @@ namespace yw
         }	
 
     private:
-        uint32_t m_RefCount;
+        std::atomic<uint32_t> m_RefCount;
     };
 
     // ------------------------------------------------------------------
@@ -212,23 +228,207 @@ namespace yw
     #endif
     }
 
+    // ------------------------------------------------------------------
+    // Packed depth and stencil helpers.
+
+    // Max values of the unsigned normalized depth formats.
+    #define YW3D_DEPTH24_MAX 0x00ffffff
+    #define YW3D_DEPTH16_MAX 0x0000ffff
+
+    // Stencil bits of a Yw3d_FMT_D24S8 pixel.
+    #define YW3D_D24S8_STENCIL_MASK 0x000000ff
+
+    // Converts a depth value in [0, 1] to 24-bit unsigned normalized depth, placed in the upper bits of a Yw3d_FMT_D24S8 pixel.
+    // @param[in] depth the depth value, will be clamped to [0, 1].
+    // @return the depth bits of a Yw3d_FMT_D24S8 pixel, stencil bits are zero.
+    inline uint32_t EncodeDepth24(float depth)
+    {
+        depth = (depth < 0.0f) ? 0.0f : ((depth > 1.0f) ? 1.0f : depth);
+        // Note: use double here, float can not hold the rounding bias of a 24-bit value.
+        return ((uint32_t)((double)depth * (double)YW3D_DEPTH24_MAX + 0.5)) << 8;
+    }
+
+    // Converts the depth bits of a Yw3d_FMT_D24S8 pixel back to a float depth value.
+    // @param[in] packed the Yw3d_FMT_D24S8 pixel, stencil bits are ignored.
+    // @return depth value in [0, 1].
+    inline float DecodeDepth24(uint32_t packed)
+    {
+        return (float)(packed >> 8) * (1.0f / (float)YW3D_DEPTH24_MAX);
+    }
+
+    // Converts a depth value in [0, 1] to a Yw3d_FMT_D16 pixel.
+    // @param[in] depth the depth value, will be clamped to [0, 1].
+    // @return the Yw3d_FMT_D16 pixel.
+    inline uint16_t EncodeDepth16(float depth)
+    {
+        depth = (depth < 0.0f) ? 0.0f : ((depth > 1.0f) ? 1.0f : depth);
+        return (uint16_t)(depth * (float)YW3D_DEPTH16_MAX + 0.5f);
+    }
+
+    // Converts a Yw3d_FMT_D16 pixel back to a float depth value.
+    // @param[in] packed the Yw3d_FMT_D16 pixel.
+    // @return depth value in [0, 1].
+    inline float DecodeDepth16(uint16_t packed)
+    {
+        return (float)packed * (1.0f / (float)YW3D_DEPTH16_MAX);
+    }
+
+    // ------------------------------------------------------------------
+    // Half float helpers.
+
+    // Float and its bits.
+    union FloatBits
+    {
+        float f;
+        uint32_t u;
+    };
+
+    // Converts a float to a 16-bit half float, rounds to nearest even.
+    // @param[in] value the float value, values out of the half range become infinity.
+    // @return the bits of the half float.
+    inline uint16_t EncodeHalf(float value)
+    {
+        FloatBits bits;
+        bits.f = value;
+
+        const uint32_t sign = (bits.u >> 16) & 0x8000;
+        const uint32_t absBits = bits.u & 0x7fffffff;
+
+        // Infinity and NaN.
+        if (absBits >= 0x7f800000)
+        {
+            return (uint16_t)(sign | 0x7c00 | ((absBits > 0x7f800000) ? 0x0200 : 0));
+        }
+
+        // Overflow, 65520 and above round to infinity.
+        if (absBits >= 0x477ff000)
+        {
+            return (uint16_t)(sign | 0x7c00);
+        }
+
+        // Denormal half, less than 2^-14.
+        if (absBits < 0x38800000)
+        {
+            if (absBits < 0x33000000)
+            {
+                return (uint16_t)sign;
+            }
+
+            const uint32_t shift = 126 - (absBits >> 23);
+            const uint32_t mantissa = (absBits & 0x007fffff) | 0x00800000;
+            const uint32_t remainder = mantissa & ((1 << shift) - 1);
+            const uint32_t halfway = 1 << (shift - 1);
+
+            uint32_t denormal = mantissa >> shift;
+            if ((remainder > halfway) || ((remainder == halfway) && (0 != (denormal & 1))))
+            {
+                denormal++;
+            }
+
+            return (uint16_t)(sign | denormal);
+        }
+
+        // Normal half, rebias the exponent and round the mantissa.
+        return (uint16_t)(sign | ((absBits - 0x38000000 + 0x0fff + ((absBits >> 13) & 1)) >> 13));
+    }
+
+    // Converts a 16-bit half float to a float.
+    // @param[in] value the bits of the half float.
+    // @return the float value.
+    inline float DecodeHalf(uint16_t value)
+    {
+        const uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1f;
+        const uint32_t mantissa = value & 0x03ff;
+
+        FloatBits bits;
+        if (0 == exponent)
+        {
+            // Zero or denormal.
+            bits.f = (float)mantissa * (1.0f / 16777216.0f);
+            bits.u |= sign;
+        }
+        else if (0x1f == exponent)
+        {
+            // Infinity and NaN.
+            bits.u = sign | 0x7f800000 | (mantissa << 13);
+        }
+        else
+        {
+            bits.u = sign | ((exponent + 112) << 23) | (mantissa << 13);
+        }
+
+        return bits.f;
+    }
+
+    // Largest finite half float, larger values are clamped to it by loaders instead of becoming infinity.
+    #define YW3D_HALF_MAX 65504.0f
+
+    // ------------------------------------------------------------------
+    // Unsigned normalized 8-bit helpers.
+
+    // Converts a float to an 8-bit unsigned normalized value.
+    // @param[in] value the float value, will be clamped to [0, 1].
+    // @return the 8-bit value.
+    inline uint8_t EncodeUnorm8(float value)
+    {
+        value = (value < 0.0f) ? 0.0f : ((value > 1.0f) ? 1.0f : value);
+        return (uint8_t)(value * 255.0f + 0.5f);
+    }
+
+    // Converts an 8-bit unsigned normalized value to a float.
+    // @param[in] value the 8-bit value.
+    // @return the float value in [0, 1].
+    inline float DecodeUnorm8(uint8_t value)
+    {
+        return (float)value * (1.0f / 255.0f);
+    }
+
+    // ------------------------------------------------------------------
+    // sRGB helpers.
+
+    // Converts a linear color channel to sRGB.
+    // @param[in] value the linear value, will be clamped to [0, 1].
+    // @return the sRGB encoded value in [0, 1].
+    inline float EncodeSRGB(float value)
+    {
+        value = (value < 0.0f) ? 0.0f : ((value > 1.0f) ? 1.0f : value);
+        return (value <= 0.0031308f) ? (value * 12.92f) : (1.055f * powf(value, 1.0f / 2.4f) - 0.055f);
+    }
+
+    // Converts an sRGB encoded color channel to linear.
+    // @param[in] value the sRGB encoded value in [0, 1].
+    // @return the linear value in [0, 1].
+    inline float DecodeSRGB(float value)
+    {
+        return (value <= 0.04045f) ? (value * (1.0f / 12.92f)) : powf((value + 0.055f) * (1.0f / 1.055f), 2.4f);
+    }
+
+    // ------------------------------------------------------------------
+    // Fast clear helpers.
+
+    // Fast clears are tracked per square tile of surface pixels, this is the edge length of a tile as power of two.
+    #define YW3D_FAST_CLEAR_TILE_SHIFT 3
+    #define YW3D_FAST_CLEAR_TILE_SIZE (1 << YW3D_FAST_CLEAR_TILE_SHIFT)
+
     // ------------------------------------------------------------------
     // Internal helper macro.
 
     // Stencil test helper macro.
+    // Only the bits in renderInfo.stencilBitsMask are touched, so a packed depth-stencil pixel keeps its depth bits.
 
     // Stencil Pass an Z-Test Pass.
     #define YW3D_STENCIL_UPDATE_IF_PASS(flag, dataPtr, renderInfo) \
         if ((flag)) \
         { \
-            *(dataPtr) = CalculatePixelStencilValue(*(dataPtr), (renderInfo).stencilReference, (renderInfo).stencilWriteMask, (renderInfo).stencilOperatonPass); \
+            *(dataPtr) = (*(dataPtr) & ~(renderInfo).stencilBitsMask) | (CalculatePixelStencilValue(*(dataPtr) & (renderInfo).stencilBitsMask, (renderInfo).stencilReference, (renderInfo).stencilWriteMask, (renderInfo).stencilOperatonPass) & (renderInfo).stencilBitsMask); \
         }
 
     // Stencil Pass and Z-Test Fail.
     #define YW3D_STENCIL_UPDATE_IF_ZFAIL(flag, dataPtr, renderInfo) \
         if ((flag)) \
         { \
-            *(dataPtr) = CalculatePixelStencilValue(*(dataPtr), (renderInfo).stencilReference, (renderInfo).stencilWriteMask, (renderInfo).stencilOperatonZFail); \
+            *(dataPtr) = (*(dataPtr) & ~(renderInfo).stencilBitsMask) | (CalculatePixelStencilValue(*(dataPtr) & (renderInfo).stencilBitsMask, (renderInfo).stencilReference, (renderInfo).stencilWriteMask, (renderInfo).stencilOperatonZFail) & (renderInfo).stencilBitsMask); \
         }
 
     // Depth test and stencil update helper macro, continue if depth test failed.
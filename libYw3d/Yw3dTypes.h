@@ -41,9 +41,13 @@ typedef struct Window* windowhandle; // Define window-handle for the AmigaOS-pla
 const uint32_t YW3D_VERTEX_CACHE_SIZE = 32;      // Specifies the size of the vertex cache. Minimum is 3!
 const uint32_t YW3D_VERTEX_SHADER_REGISTERS = 8; // Specifies the amount of available vertex shader input registers.
 const uint32_t YW3D_PIXEL_SHADER_REGISTERS = 8;  // Specifies the amount of available vertex shader output registers, which are simulateously used as pixel shader input registers.
+const uint32_t YW3D_MAX_VERTEX_BATCH_SIZE = 16;  // Specifies the maximum amount of vertices a vertex shader may process at once in SoA layout.
 const uint32_t YW3D_NUM_SHADER_CONSTANTS = 32;   // Specifies the amount of available shader constants-registers for both vertex and pixel shaders.
 const uint32_t YW3D_MAX_VERTEX_STREAMS = 8;      // Specifies the amount of available vertex streams.
 const uint32_t YW3D_MAX_TEXTURE_SAMPLERS = 16;   // Specifies the amount of available texture samplers.
+const uint32_t YW3D_MAX_CONSTANT_BUFFERS = 8;    // Specifies the amount of available constant buffer slots, shared by vertex, triangle and pixel shaders.
+const uint32_t YW3D_MAX_COLOR_BUFFERS = 4;       // Specifies the amount of colorbuffer attachments of a rendertarget, written at once by Yw3d_PSO_MultipleColors pixel shaders.
+const uint32_t YW3D_MAX_COMPUTE_SURFACES = 8;    // Specifies the amount of surface slots a compute shader may read and write.
 const uint32_t YW3D_CLIP_VERTEX_CACHE_SIZE = 20; // Specifies the amount of clipping vertex cache size.
 
 // ------------------------------------------------------------------
@@ -230,6 +234,15 @@ enum Yw3dTextureFilter
     Yw3d_TF_NumTextureFilters
 };
 
+// Defines the supported filters of mip-level generation.
+enum Yw3dMipFilter
+{
+    Yw3d_MF_Box,     // Specifies a 2x2 (2x2x2 for volumes) box filter, NPOT dimensions are downsampled with a 3-tap polyphase box filter.
+    Yw3d_MF_Lanczos, // Specifies a separable Lanczos filter with two lobes, sharper than the box filter. Volumes fall back to the box filter.
+
+    Yw3d_MF_NumMipFilters
+};
+
 // Specifies the supported subdivision modes.
 enum Yw3dSubdivision
 {
@@ -256,9 +269,49 @@ enum Yw3dFormat
     Yw3d_FMT_INDEX16, // 16-bit index buffer format, indices are shorts.
     Yw3d_FMT_INDEX32, // 32-bit index buffer format, indices are integers.
 
+    // Depth and stencil buffer formats.
+    Yw3d_FMT_D24S8, // 32-bit packed depth-stencil format, 24-bit unsigned normalized depth in the upper bits and 8-bit stencil in the lower bits.
+    Yw3d_FMT_D16,   // 16-bit depth format, one unsigned normalized short per pixel, no stencil.
+
+    // Block compressed texture formats, pixels are stored in blocks of 4x4 and decoded when sampled.
+    Yw3d_FMT_BC1,   // 64-bit blocks, two RGB565 endpoints with 2-bit indices mapped to the three color channel plus 1-bit alpha.
+    Yw3d_FMT_BC3,   // 128-bit blocks, BC1 color plus two 8-bit alpha endpoints with 3-bit indices mapped to the alpha channel.
+    Yw3d_FMT_BC5,   // 128-bit blocks, two 8-bit endpoints with 3-bit indices each for the red and green channel, e.g. for tangent space normals.
+    Yw3d_FMT_BC6H,  // 128-bit blocks, unsigned half float RGB for high dynamic range. Only the single region mode with 10-bit endpoints is used.
+
+    // Compact texture formats, channels are stored as 8-bit unsigned normalized integers or half floats and converted to float when sampled.
+    Yw3d_FMT_R8,            // 8-bit texture format, one unsigned normalized byte mapped to the red channel.
+    Yw3d_FMT_R8G8,          // 16-bit texture format, two unsigned normalized bytes mapped to the red and green channel.
+    Yw3d_FMT_R8G8B8,        // 24-bit texture format, three unsigned normalized bytes mapped to the three color channel.
+    Yw3d_FMT_R8G8B8A8,      // 32-bit texture format, four unsigned normalized bytes mapped to the three color channel plus the alpha channel.
+    Yw3d_FMT_R16F,          // 16-bit texture format, one half float mapped to the red channel.
+    Yw3d_FMT_R16G16F,       // 32-bit texture format, two half floats mapped to the red and green channel.
+    Yw3d_FMT_R16G16B16F,    // 48-bit texture format, three half floats mapped to the three color channel.
+    Yw3d_FMT_R16G16B16A16F, // 64-bit texture format, four half floats mapped to the three color channel plus the alpha channel.
+    Yw3d_FMT_R8G8B8_SRGB,   // 24-bit texture format, three sRGB encoded bytes mapped to the three color channel, decoded to linear when sampled.
+    Yw3d_FMT_R8G8B8A8_SRGB, // 32-bit texture format, three sRGB encoded bytes mapped to the three color channel plus a linear unsigned normalized byte mapped to the alpha channel.
+
     Yw3d_FMT_NumFormats
 };
 
+// Defines the supported memory layouts of surface pixels.
+enum Yw3dSurfaceLayout
+{
+    Yw3d_SL_Linear,     // Pixels are stored row by row.
+    Yw3d_SL_Tiled4x4,   // Pixels are stored in 4x4 tiles, tiles are stored row by row. Keeps bilinear and rotated texture fetches inside few cache lines.
+
+    Yw3d_SL_NumSurfaceLayouts
+};
+
+// Defines the supported memory layouts of volume voxels.
+enum Yw3dVolumeLayout
+{
+    Yw3d_VL_Linear,         // Voxels are stored row by row and slice by slice.
+    Yw3d_VL_Bricked8x8x8,   // Voxels are stored in 8x8x8 bricks, bricks are stored row by row and slice by slice. Keeps the 8 voxels of a tri-linear fetch inside one brick most of the time.
+
+    Yw3d_VL_NumVolumeLayouts
+};
+
 // Defines the supported primitive types.
 enum Yw3dPrimitiveType
 {
@@ -286,6 +339,7 @@ enum Yw3dTextureSampleInput
 	Yw3d_TSI_2Coords, // 2 floating point coordinates used for standard 2d texture-sampling.
 	Yw3d_TSI_3Coords, // 3 floating point coordinates used for volume texture-sampling.
 	Yw3d_TSI_Vector,  // 3-dimensional vector used for cubemap-sampling.
+	Yw3d_TSI_2CoordsLayer, // 2 floating point coordinates and a layer index used for texture array-sampling.
 
     Yw3d_TSI_NumTextureSampleInputs
 };
@@ -308,6 +362,7 @@ enum Yw3dPixelShaderOutput
 {
 	Yw3d_PSO_ColorOnly,  // Specifies that a given pixel shader only outputs color (default). A pixel's depth values will be automatically computed by the rasterizer through interpolation of depth values of a triangle's vertices. Stencil buffer test is also supported.
 	Yw3d_PSO_ColorDepth, // Specifies that a given pixel shader outputs both color and depth. If you want to output only depth use renderstate Yw3d_RS_ColorWriteEnable to disable writing color. Stencil buffer test is not supported.
+	Yw3d_PSO_MultipleColors, // Specifies that a given pixel shader outputs a color for each colorbuffer attachment of the rendertarget through IYw3dPixelShader::ExecuteMultipleColors(). Depth is interpolated like Yw3d_PSO_ColorOnly, stencil buffer test and pixel-killing are supported.
     
     Yw3d_PSO_PixelShaderOutputs
 };
@@ -346,6 +401,28 @@ enum Yw3dClippingPlanes
 	Yw3d_CP_NumPlanes
 };
 
+// Defines the CPU features the SIMD kernels can be dispatched to, combined as flags.
+enum Yw3dCpuFeature
+{
+    Yw3d_CPU_SSE2    = 1 << 0, // SSE2, always present on x64.
+    Yw3d_CPU_SSE41   = 1 << 1, // SSE4.1.
+    Yw3d_CPU_AVX     = 1 << 2, // AVX, only reported if the OS saves the YMM registers.
+    Yw3d_CPU_AVX2    = 1 << 3, // AVX2.
+    Yw3d_CPU_FMA     = 1 << 4, // FMA3.
+    Yw3d_CPU_AVX512F = 1 << 5, // AVX-512 foundation, only reported if the OS saves the ZMM registers.
+};
+
+// Defines the instruction set levels of the SIMD kernels, selected by the device at creation time.
+enum Yw3dSimdLevel
+{
+    Yw3d_SIMD_Scalar, // Portable C++ kernels.
+    Yw3d_SIMD_SSE2,   // SSE2 kernels.
+    Yw3d_SIMD_AVX2,   // AVX2 and FMA kernels.
+    Yw3d_SIMD_AVX512, // AVX-512 foundation kernels, kernels without a wider version use the AVX2 one.
+
+    Yw3d_SIMD_NumLevels
+};
+
 // ------------------------------------------------------------------
 // Structures.
 
@@ -393,9 +470,18 @@ namespace yw
         // Height of dimension of the backbuffer in Pixels.
         uint32_t backBufferHeight;
 
+        // True if the colorbuffer holds linear colors which are encoded to sRGB when presented.
+        bool presentSRGB;
+
+        // True if large resources should be backed by huge pages, the system may not grant them.
+        bool useHugePages;
+
+        // Highest SIMD level the device may use, member of the enumeration Yw3dSimdLevel. The device uses the best level supported by the CPU up to it.
+        Yw3dSimdLevel maxSimdLevel;
+
         // Constructor.
-        Yw3dDeviceParameters() : deviceWindow(nullptr), windowed(false), fullScreenColorBits(32), backBufferWidth(0), backBufferHeight(0) {}
-        Yw3dDeviceParameters(WindowHandle windowHandle, bool useWindowed, uint32_t colorBits, uint32_t width, uint32_t height) : deviceWindow(windowHandle), windowed(useWindowed), fullScreenColorBits(colorBits), backBufferWidth(width), backBufferHeight(height) {}
+        Yw3dDeviceParameters() : deviceWindow(nullptr), windowed(false), fullScreenColorBits(32), backBufferWidth(0), backBufferHeight(0), presentSRGB(false), useHugePages(false), maxSimdLevel(Yw3d_SIMD_AVX512) {}
+        Yw3dDeviceParameters(WindowHandle windowHandle, bool useWindowed, uint32_t colorBits, uint32_t width, uint32_t height, bool useSRGB = false, bool hugePages = false, Yw3dSimdLevel simdLevel = Yw3d_SIMD_AVX512) : deviceWindow(windowHandle), windowed(useWindowed), fullScreenColorBits(colorBits), backBufferWidth(width), backBufferHeight(height), presentSRGB(useSRGB), useHugePages(hugePages), maxSimdLevel(simdLevel) {}
     };
 
     // Describes a vertex element.
@@ -474,6 +560,34 @@ namespace yw
         Yw3dVSOutput() {}
     };
 
+    // A shader register of a batch of vertices in SoA layout, each component holds the values of all vertices of the batch.
+    struct Yw3dShaderRegisterBatch
+    {
+        float x[YW3D_MAX_VERTEX_BATCH_SIZE];
+        float y[YW3D_MAX_VERTEX_BATCH_SIZE];
+        float z[YW3D_MAX_VERTEX_BATCH_SIZE];
+        float w[YW3D_MAX_VERTEX_BATCH_SIZE];
+    };
+
+    // Describes the vertex shader input of a batch of vertices.
+    // @note This structure is used internally by devices.
+    struct Yw3dVSInputBatch
+    {
+        // Vertex shader input registers.
+        Yw3dShaderRegisterBatch shaderInputs[YW3D_VERTEX_SHADER_REGISTERS];
+    };
+
+    // Describes the vertex shader output of a batch of vertices.
+    // @note This structure is used internally by devices.
+    struct Yw3dVSOutputBatch
+    {
+        // Positions of the vertices in homogeneous clipping space.
+        Yw3dShaderRegisterBatch position;
+
+        // Vertex shader output registers.
+        Yw3dShaderRegisterBatch shaderOutputs[YW3D_PIXEL_SHADER_REGISTERS];
+    };
+
     // Describes a structure that is used for triangle gradient storage.
     // @note This structure is used internally by devices.
     struct Yw3dTriangleInfo
@@ -484,6 +598,9 @@ namespace yw
         // Base vertex for gradient computations.
         const Yw3dVSOutput* baseVertex;
 
+        // Serial number of the triangle being drawn, changes with each triangle; identifies the partial derivatives cached per pixel quad by the pixel shader.
+        uint32_t triangleId;
+
         // z partial derivatives with respect to the screen-space x- and y-coordinates.
 	    float zDdx;
         float zDdy;
@@ -505,7 +622,7 @@ namespace yw
         // 1.0f / w of the current pixel; needed by pixel shader for computation of partial derivatives.
         float curPixelInvW;
 
-        Yw3dTriangleInfo() : /*commonGradient(0.0f),*/ baseVertex(nullptr), zDdx(0.0f), zDdy(0.0f), wDdx(0.0f), wDdy(0.0f), curPixelX(0), curPixelY(0), curPixelInvW(1.0f) {}
+        Yw3dTriangleInfo() : /*commonGradient(0.0f),*/ baseVertex(nullptr), triangleId(0), zDdx(0.0f), zDdy(0.0f), wDdx(0.0f), wDdy(0.0f), curPixelX(0), curPixelY(0), curPixelInvW(1.0f) {}
     };
 
     // Describes a structure that is used for vertex caching.
@@ -523,6 +640,44 @@ namespace yw
 
         Yw3dVertexCacheEntry() : vertexIndex(0), fetchTime(0) {}
     };
+
+    // Identifies an invocation of a compute shader within a dispatch, see Yw3dDevice::Dispatch().
+    struct Yw3dComputeThreadId
+    {
+        // Index of the thread group in the dispatch grid.
+        uint32_t groupX;
+        uint32_t groupY;
+        uint32_t groupZ;
+
+        // Index of the thread in its thread group.
+        uint32_t threadX;
+        uint32_t threadY;
+        uint32_t threadZ;
+
+        // Index of the thread in the whole dispatch: group index * thread group size + thread index.
+        uint32_t dispatchX;
+        uint32_t dispatchY;
+        uint32_t dispatchZ;
+
+        Yw3dComputeThreadId() : groupX(0), groupY(0), groupZ(0), threadX(0), threadY(0), threadZ(0), dispatchX(0), dispatchY(0), dispatchZ(0) {}
+    };
+
+    // Describes a surface locked for the compute shader while a dispatch is running.
+    // @note This structure is used internally by devices.
+    struct Yw3dComputeSurface
+    {
+        // Pixel data of the surface, nullptr if no surface is bound to the slot.
+        float* data;
+
+        // Dimensions of the surface.
+        uint32_t width;
+        uint32_t height;
+
+        // Number of floats of a pixel.
+        uint32_t floats;
+
+        Yw3dComputeSurface() : data(nullptr), width(0), height(0), floats(0) {}
+    };
 }
 
 #endif // !__YW_3D_TYPES_H__
@@ -5,6 +5,7 @@
 #include "YwInput.h"
 #include "YwGraphics.h"
 #include "YwScene.h"
+#include "YwResourceManager.h"
 
 // ------------------------------------------------------------------
 // Platform-dependent code.
@@ -157,6 +158,10 @@ namespace yw
 
     void Application::EndFrame()
     {
+        // Stream the virtual texture pages sampled in this frame, and publish the mip-levels of the progressively loaded textures.
+        m_ResourceManager->StreamVirtualTextures();
+        m_ResourceManager->UpdateProgressiveTextures();
+
         LARGE_INTEGER currentTime;
         QueryPerformanceCounter(&currentTime);
 
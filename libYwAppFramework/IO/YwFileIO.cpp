@@ -3,8 +3,60 @@
 
 #include "YwFileIO.h"
 
+#if defined(_WIN32) || defined(WIN32)
+    #include <windows.h>
+#elif !(defined(__amigaos4__) || (_AMIGAOS4))
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
 namespace yw
 {
+    MappedFile::MappedFile() :
+        m_Data(nullptr),
+        m_Size(0)
+#if defined(_WIN32) || defined(WIN32)
+        , m_Mapping(nullptr)
+#elif defined(__amigaos4__) || (_AMIGAOS4)
+        , m_Buffer(nullptr)
+#endif
+    {
+    }
+
+    MappedFile::~MappedFile()
+    {
+#if defined(_WIN32) || defined(WIN32)
+        if (nullptr != m_Data)
+        {
+            UnmapViewOfFile(m_Data);
+        }
+
+        if (nullptr != m_Mapping)
+        {
+            CloseHandle(m_Mapping);
+        }
+#elif defined(__amigaos4__) || (_AMIGAOS4)
+        YW_SAFE_DELETE_ARRAY(m_Buffer);
+#else
+        if (nullptr != m_Data)
+        {
+            munmap(m_Data, (size_t)m_Size);
+        }
+#endif
+    }
+
+    uint8_t* MappedFile::GetData() const
+    {
+        return m_Data;
+    }
+
+    uint64_t MappedFile::GetSize() const
+    {
+        return m_Size;
+    }
+
     FileIO::FileIO()
     {
     }
@@ -126,6 +178,90 @@ namespace yw
         return fileSize;
     }
 
+    MappedFile* FileIO::MapFile(const StringA& filename)
+    {
+        MappedFile* mappedFile = new MappedFile();
+        StringA filePath = GetFilePath(filename);
+
+#if defined(_WIN32) || defined(WIN32)
+        // Open the file and map a copy-on-write view of it, the file may be closed after mapping.
+        HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (INVALID_HANDLE_VALUE == file)
+        {
+            YW_SAFE_RELEASE(mappedFile);
+            return nullptr;
+        }
+
+        LARGE_INTEGER fileSize;
+        if (GetFileSizeEx(file, &fileSize) && (fileSize.QuadPart > 0))
+        {
+            mappedFile->m_Size = (uint64_t)fileSize.QuadPart;
+            mappedFile->m_Mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+            if (nullptr != mappedFile->m_Mapping)
+            {
+                mappedFile->m_Data = (uint8_t*)MapViewOfFile(mappedFile->m_Mapping, FILE_MAP_COPY, 0, 0, 0);
+            }
+        }
+
+        CloseHandle(file);
+#elif defined(__amigaos4__) || (_AMIGAOS4)
+        // Read the file into an aligned buffer instead.
+        FILE* file = fopen(filePath.c_str(), "rb");
+        if (nullptr == file)
+        {
+            YW_SAFE_RELEASE(mappedFile);
+            return nullptr;
+        }
+
+        fseek(file, 0, SEEK_END);
+        long fileSize = ftell(file);
+        rewind(file);
+
+        if (fileSize > 0)
+        {
+            const size_t alignment = 4096;
+            mappedFile->m_Buffer = new uint8_t[fileSize + alignment];
+            uint8_t* data = (uint8_t*)(((size_t)mappedFile->m_Buffer + alignment - 1) & ~(alignment - 1));
+            if (fread(data, 1, (size_t)fileSize, file) == (size_t)fileSize)
+            {
+                mappedFile->m_Data = data;
+                mappedFile->m_Size = (uint64_t)fileSize;
+            }
+        }
+
+        fclose(file);
+#else
+        // Open the file and map it private and writable, so pages are copied on write. The file may be closed after mapping.
+        int file = open(filePath.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            YW_SAFE_RELEASE(mappedFile);
+            return nullptr;
+        }
+
+        struct stat fileStat;
+        if ((0 == fstat(file, &fileStat)) && (fileStat.st_size > 0))
+        {
+            void* data = mmap(nullptr, (size_t)fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+            if (MAP_FAILED != data)
+            {
+                mappedFile->m_Data = (uint8_t*)data;
+                mappedFile->m_Size = (uint64_t)fileStat.st_size;
+            }
+        }
+
+        close(file);
+#endif
+
+        if (nullptr == mappedFile->m_Data)
+        {
+            YW_SAFE_RELEASE(mappedFile);
+            return nullptr;
+        }
+
+        return mappedFile;
+    }
+
     uint32_t FileIO::WriteFile(const StringA& filename, uint8_t* data, uint32_t dataSize, bool text)
     {
         // Get file path and file mode.
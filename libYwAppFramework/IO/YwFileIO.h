@@ -5,9 +5,44 @@
 #define __YW_FILE_IO_H__
 
 #include "YwBase.h"
+#include "Yw3dBase.h"
 
 namespace yw
 {
+    // A file mapped into memory copy-on-write, pages are read from disk on first access and writes to the data never reach the file.
+    // Resources using the file data in place hold a reference, the file is unmapped when the last reference is released.
+    class MappedFile : public IBase
+    {
+        friend class FileIO;
+
+    protected:
+        // Accessible by FileIO which is the only class that may map a file.
+        MappedFile();
+
+        // Accessible by IBase. The destructor is called when the reference count reaches zero.
+        ~MappedFile();
+
+    public:
+        //< Returns the mapped data, the beginning of the file is aligned to a memory page.
+        uint8_t* GetData() const;
+
+        //< Returns the size of the mapped file in bytes.
+        uint64_t GetSize() const;
+
+    private:
+        // Mapped data and its size.
+        uint8_t* m_Data;
+        uint64_t m_Size;
+
+#if defined(_WIN32) || defined(WIN32)
+        // File mapping object of the mapped view.
+        HANDLE m_Mapping;
+#elif defined(__amigaos4__) || (_AMIGAOS4)
+        // Allocated buffer holding the file, memory mapping is not available.
+        uint8_t* m_Buffer;
+#endif
+    };
+
     class FileIO
     {
     public:
@@ -24,6 +59,9 @@ namespace yw
         // Reading file and filling by already allocated data, with text or binary.
         uint32_t ReadFile(const StringA& filename, uint8_t* data, uint32_t dataSize, bool text = false);
 
+        // Mapping file into memory copy-on-write, returns nullptr if the file cannot be mapped. Call Release() when finished using the mapped file.
+        MappedFile* MapFile(const StringA& filename);
+
         // Writing file with provided data.
         uint32_t WriteFile(const StringA& filename, uint8_t* data, uint32_t dataSize, bool text = false);
 
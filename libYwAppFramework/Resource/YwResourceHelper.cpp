@@ -47,14 +47,14 @@ namespace yw
 
     // Resource helper class.
     
-    ResourceWrapper* ResourceHelper::LoadResource(ResourceManager* resourceManager, const StringA& resourcePath)
+    ResourceWrapper* ResourceHelper::LoadResource(ResourceManager* resourceManager, const StringA& resourcePath, bool srgb)
     {
         if ((nullptr == resourceManager) || resourcePath.empty())
         {
             return nullptr;
         }
         
-        HRESOURCE hResourceHandle = resourceManager->LoadResource(resourcePath);
+        HRESOURCE hResourceHandle = resourceManager->LoadResource(resourcePath, srgb);
         if (0 == hResourceHandle)
         {
             StringA errorMsg = "ResourceHelper.LoadResource: Load resource \"";
@@ -35,7 +35,7 @@ namespace yw
     class ResourceHelper
     {
     public:
-        static ResourceWrapper* LoadResource(ResourceManager* resourceManager, const StringA& resourcePath);
+        static ResourceWrapper* LoadResource(ResourceManager* resourceManager, const StringA& resourcePath, bool srgb = false);
     };
 }
 
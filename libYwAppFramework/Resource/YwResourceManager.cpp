@@ -11,13 +11,31 @@
 #include "YwTextureLoaderTGA.h"
 #include "YwTextureLoaderRGBE.h"
 #include "YwTextureLoaderCube.h"
+#include "YwTextureLoaderArray.h"
 #include "YwTextureLoaderYWT.h"
+#include "YwFileIO.h"
+#include "ywt.h"
+#include <algorithm>
 
 namespace yw
 {
+    // Seek a position of a file which may be larger than 2GB.
+    static bool SeekFile(FILE* file, uint64_t offset)
+    {
+#if defined(_WIN32) || defined(WIN32)
+        return 0 == _fseeki64(file, (__int64)offset, SEEK_SET);
+#else
+        return 0 == fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+    }
+
     ResourceManager::ResourceManager(IApplication* application) :
         m_Application(application),
-        m_NumberLoadedResources(0)
+        m_NumberLoadedResources(0),
+        m_VirtualTextureBudget(64 * 1024 * 1024),
+        m_ProgressiveTextureLoading(false),
+        m_LoadingTexture(nullptr),
+        m_ExitLoading(false)
     {
     }
 
@@ -28,6 +46,24 @@ namespace yw
             UnloadResource(m_ManagedResources.begin()->second.resourceHandle);
         }
 
+        // Stop the loading thread, all progressively loaded textures have been cancelled by unloading.
+        if (m_LoadingThread.joinable())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_LoadingMutex);
+                m_ExitLoading = true;
+            }
+
+            m_LoadingCondition.notify_one();
+            m_LoadingThread.join();
+        }
+
+        while (m_ProgressiveTextures.size() > 0)
+        {
+            DestroyProgressiveTexture(m_ProgressiveTextures.front());
+            m_ProgressiveTextures.pop_front();
+        }
+
         m_RegisteredEntityExtensionsLoad.clear();
         m_RegisteredEntityExtensionsUnload.clear();
     }
@@ -43,19 +79,21 @@ namespace yw
         RegisterResourceExtension("rgbe", LoadTexture_HDR, UnloadTexture_HDR);
         RegisterResourceExtension("xyze", LoadTexture_HDR, UnloadTexture_HDR);
         RegisterResourceExtension("cube", LoadTexture_Cube, UnloadTexture_Cube);
+        RegisterResourceExtension("texarray", LoadTexture_Array, UnloadTexture_Array);
         RegisterResourceExtension("anim", LoadTexture_Animated, UnloadTexture_Animated);
         RegisterResourceExtension("ywt", LoadTexture_YWT, UnloadTexture_YWT);
+        RegisterResourceExtension("ywvt", LoadTexture_YWVT, UnloadTexture_YWVT);
 
         return true;
     }
 
-    HRESOURCE ResourceManager::LoadResource(const StringA& fileName)
+    HRESOURCE ResourceManager::LoadResource(const StringA& fileName, bool srgb)
     {
-        // Find the exist resource.
+        // Find the exist resource, a texture loaded as sRGB and as linear are different resources.
         std::map<HRESOURCE, ManagedResource>::iterator resItr = m_ManagedResources.begin();
         for (; resItr != m_ManagedResources.end(); ++resItr)
         {
-            if (resItr->second.fileName == fileName)
+            if ((resItr->second.fileName == fileName) && (resItr->second.srgb == srgb))
             {
                 ++(resItr->second.references);
                 return resItr->second.resourceHandle;
@@ -81,7 +119,7 @@ namespace yw
 
         // Load and create a resource.
         ManagedResource newResource;
-        newResource.resource = loadFunc(this, filePath);
+        newResource.resource = loadFunc(this, filePath, srgb);
         if (nullptr == newResource.resource)
         {
             return 0;
@@ -91,6 +129,7 @@ namespace yw
         newResource.references = 1;
         newResource.fileName = fileName;
         newResource.extension = extension;
+        newResource.srgb = srgb;
         m_ManagedResources.insert(std::pair<HRESOURCE, ManagedResource>(newResource.resourceHandle, newResource));
 
         return newResource.resourceHandle;
@@ -138,6 +177,258 @@ namespace yw
         return itr->second.resource;
     }
 
+    void ResourceManager::StreamVirtualTextures(uint32_t maxPagesPerFrame)
+    {
+        std::vector<Yw3dVirtualPage> requestedPages;
+        std::map<Yw3dVirtualTexture*, StreamedVirtualTexture>::iterator itr = m_StreamedVirtualTextures.begin();
+        for (; itr != m_StreamedVirtualTextures.end(); ++itr)
+        {
+            Yw3dVirtualTexture* virtualTexture = itr->first;
+            const uint32_t numRequestedPages = virtualTexture->ResolveFeedback(requestedPages);
+            for (uint32_t i = 0; (i < numRequestedPages) && (i < maxPagesPerFrame); i++)
+            {
+                // Stop when all resident pages are in use, the remaining pages will be requested again.
+                const Yw3dVirtualPage& page = requestedPages[i];
+                if (!StreamVirtualTexturePage(virtualTexture, itr->second.file, itr->second.mipOffsets[page.mipLevel], page.mipLevel, page.pageX, page.pageY))
+                {
+                    break;
+                }
+            }
+        }
+    }
+
+    bool ResourceManager::StreamVirtualTexturePage(Yw3dVirtualTexture* virtualTexture, FILE* file, uint64_t mipOffset, uint32_t mipLevel, uint32_t pageX, uint32_t pageY)
+    {
+        const uint32_t pageBytes = virtualTexture->GetPageBytes();
+        const uint64_t pageOffset = mipOffset + ((uint64_t)pageY * virtualTexture->GetPagesX(mipLevel) + pageX) * pageBytes;
+
+        m_PageData.resize(pageBytes);
+        if (!SeekFile(file, pageOffset) || (1 != fread(m_PageData.data(), pageBytes, 1, file)))
+        {
+            LOGE(_T("ResourceManager.StreamVirtualTexturePage: Cannot read page from file."));
+            return false;
+        }
+
+        return YW3D_SUCCESSFUL(virtualTexture->UploadPage(Yw3dVirtualPage(mipLevel, pageX, pageY), m_PageData.data()));
+    }
+
+    void ResourceManager::UpdateProgressiveTextures(uint32_t maxPixelsPerFrame)
+    {
+        uint32_t copiedPixels = 0;
+        std::list<ProgressiveTexture*>::iterator itr = m_ProgressiveTextures.begin();
+        while (itr != m_ProgressiveTextures.end())
+        {
+            ProgressiveTexture* progressiveTexture = *itr;
+            {
+                std::lock_guard<std::mutex> lock(m_LoadingMutex);
+                if (!progressiveTexture->loaded)
+                {
+                    ++itr;
+                    continue;
+                }
+            }
+
+            Yw3dTexture* texture = progressiveTexture->texture;
+            Yw3dTexture* loadedTexture = progressiveTexture->loadedTexture;
+            if ((nullptr != loadedTexture) && ((loadedTexture->GetFormat() != texture->GetFormat()) || (loadedTexture->GetMipLevels() != texture->GetMipLevels()) || (loadedTexture->GetWidth() != texture->GetWidth()) || (loadedTexture->GetHeight() != texture->GetHeight())))
+            {
+                LOGE(_T("ResourceManager.UpdateProgressiveTextures: Decoded texture is not match."));
+                loadedTexture = nullptr;
+            }
+
+            // Copy from the coarsest remaining mip-level, the texture samples a mip-level only after it's complete.
+            bool copied = false;
+            while ((nullptr != loadedTexture) && (progressiveTexture->remainingMipLevels > 0))
+            {
+                const uint32_t mipLevel = progressiveTexture->remainingMipLevels - 1;
+                const uint32_t mipPixels = texture->GetWidth(mipLevel) * texture->GetHeight(mipLevel);
+                if (copied && (copiedPixels + mipPixels > maxPixelsPerFrame))
+                {
+                    break;
+                }
+
+                Yw3dSurface* srcSurface = loadedTexture->AcquireMipLevel(mipLevel);
+                Yw3dSurface* destSurface = texture->AcquireMipLevel(mipLevel);
+                Yw3dResult resCopy = srcSurface->CopyToSurface(nullptr, destSurface, nullptr, Yw3d_TF_Point);
+                YW_SAFE_RELEASE(srcSurface);
+                YW_SAFE_RELEASE(destSurface);
+                if (YW3D_FAILED(resCopy))
+                {
+                    LOGE(_T("ResourceManager.UpdateProgressiveTextures: Cannot copy decoded mip-level."));
+                    loadedTexture = nullptr;
+                    break;
+                }
+
+                texture->SetMostDetailedMipLevel(mipLevel);
+                progressiveTexture->remainingMipLevels--;
+                copiedPixels += mipPixels;
+                copied = true;
+            }
+
+            // A texture failed to load keeps its coarsest mip-level.
+            if ((nullptr == loadedTexture) || (0 == progressiveTexture->remainingMipLevels))
+            {
+                DestroyProgressiveTexture(progressiveTexture);
+                itr = m_ProgressiveTextures.erase(itr);
+            }
+            else
+            {
+                ++itr;
+            }
+        }
+    }
+
+    Yw3dTexture* ResourceManager::LoadTexture(ITextureLoader* texLoader, const StringA& fileName, bool srgb)
+    {
+        // Define a texture.
+        Yw3dTexture* texture = nullptr;
+        Yw3dDevice* device = GetApplication()->GetGraphics()->GetYw3dDevice();
+
+        if (!m_ProgressiveTextureLoading)
+        {
+            // Load texture data by loader.
+            if (!texLoader->Load(fileName, device, (IYw3dBaseTexture**)(&texture), true, srgb))
+            {
+                YW_SAFE_RELEASE(texture);
+            }
+
+            YW_SAFE_DELETE(texLoader);
+            return texture;
+        }
+
+        // Read the file at once, it's decoded by the loading thread.
+        FileIO file;
+        uint8_t* fileData = nullptr;
+        uint32_t fileSize = file.ReadFile(fileName, &fileData, false);
+        if ((0 == fileSize) || (nullptr == fileData))
+        {
+            YW_SAFE_DELETE_ARRAY(fileData);
+            YW_SAFE_DELETE(texLoader);
+            return nullptr;
+        }
+
+        // Load at once if the loader cannot describe the texture before decoding it.
+        TextureLoadInfo loadInfo;
+        if (!texLoader->LoadInfo(fileData, fileSize, srgb, loadInfo) || YW3D_FAILED(device->CreateTexture(&texture, loadInfo.width, loadInfo.height, loadInfo.mipLevels, loadInfo.format, loadInfo.layout)))
+        {
+            YW_SAFE_RELEASE(texture);
+            if (!texLoader->LoadFromMemory(fileName, fileData, fileSize, device, (IYw3dBaseTexture**)(&texture), true, srgb))
+            {
+                YW_SAFE_RELEASE(texture);
+            }
+
+            YW_SAFE_DELETE_ARRAY(fileData);
+            YW_SAFE_DELETE(texLoader);
+            return texture;
+        }
+
+        // Show a neutral color until the decoded mip-levels arrive, the default normal if the texture is a linear normal map.
+        const uint32_t lastMipLevel = texture->GetMipLevels() - 1;
+        texture->Clear(lastMipLevel, srgb ? Vector4(0.5f, 0.5f, 0.5f, 1.0f) : Vector4(0.5f, 0.5f, 1.0f, 1.0f), nullptr);
+        texture->SetMostDetailedMipLevel(lastMipLevel);
+
+        ProgressiveTexture* progressiveTexture = new ProgressiveTexture();
+        progressiveTexture->loader = texLoader;
+        progressiveTexture->fileName = fileName;
+        progressiveTexture->fileData = fileData;
+        progressiveTexture->fileDataLength = fileSize;
+        progressiveTexture->srgb = srgb;
+        progressiveTexture->device = device;
+        progressiveTexture->texture = texture;
+        progressiveTexture->remainingMipLevels = texture->GetMipLevels();
+        m_ProgressiveTextures.push_back(progressiveTexture);
+
+        // Queue it to the loading thread, which is started by the first progressively loaded texture.
+        {
+            std::lock_guard<std::mutex> lock(m_LoadingMutex);
+            m_LoadingQueue.push_back(progressiveTexture);
+        }
+
+        if (!m_LoadingThread.joinable())
+        {
+            m_LoadingThread = std::thread(&ResourceManager::LoadingThreadProc, this);
+        }
+
+        m_LoadingCondition.notify_one();
+
+        return texture;
+    }
+
+    void ResourceManager::CancelProgressiveTexture(Yw3dTexture* texture)
+    {
+        std::list<ProgressiveTexture*>::iterator itr = m_ProgressiveTextures.begin();
+        for (; itr != m_ProgressiveTextures.end(); ++itr)
+        {
+            if ((*itr)->texture == texture)
+            {
+                break;
+            }
+        }
+
+        if (m_ProgressiveTextures.end() == itr)
+        {
+            return;
+        }
+
+        ProgressiveTexture* progressiveTexture = *itr;
+        {
+            // Remove it from the queue, or wait until the loading thread has decoded it.
+            std::unique_lock<std::mutex> lock(m_LoadingMutex);
+            std::deque<ProgressiveTexture*>::iterator queueItr = std::find(m_LoadingQueue.begin(), m_LoadingQueue.end(), progressiveTexture);
+            if (m_LoadingQueue.end() != queueItr)
+            {
+                m_LoadingQueue.erase(queueItr);
+            }
+
+            m_LoadedCondition.wait(lock, [this, progressiveTexture]() { return m_LoadingTexture != progressiveTexture; });
+        }
+
+        DestroyProgressiveTexture(progressiveTexture);
+        m_ProgressiveTextures.erase(itr);
+    }
+
+    void ResourceManager::DestroyProgressiveTexture(ProgressiveTexture* progressiveTexture)
+    {
+        YW_SAFE_RELEASE(progressiveTexture->loadedTexture);
+        YW_SAFE_DELETE_ARRAY(progressiveTexture->fileData);
+        YW_SAFE_DELETE(progressiveTexture->loader);
+        YW_SAFE_DELETE(progressiveTexture);
+    }
+
+    void ResourceManager::LoadingThreadProc()
+    {
+        std::unique_lock<std::mutex> lock(m_LoadingMutex);
+        for (;;)
+        {
+            m_LoadingCondition.wait(lock, [this]() { return m_ExitLoading || (m_LoadingQueue.size() > 0); });
+            if (m_ExitLoading)
+            {
+                break;
+            }
+
+            ProgressiveTexture* progressiveTexture = m_LoadingQueue.front();
+            m_LoadingQueue.pop_front();
+            m_LoadingTexture = progressiveTexture;
+            lock.unlock();
+
+            // Decode and generate the mip-levels without holding the lock, the job is kept alive by m_LoadingTexture.
+            Yw3dTexture* loadedTexture = nullptr;
+            if (!progressiveTexture->loader->LoadFromMemory(progressiveTexture->fileName, progressiveTexture->fileData, progressiveTexture->fileDataLength, progressiveTexture->device, (IYw3dBaseTexture**)(&loadedTexture), true, progressiveTexture->srgb))
+            {
+                LOGE(_T("ResourceManager.LoadingThreadProc: Cannot load texture."));
+                YW_SAFE_RELEASE(loadedTexture);
+            }
+
+            YW_SAFE_DELETE_ARRAY(progressiveTexture->fileData);
+
+            lock.lock();
+            progressiveTexture->loadedTexture = loadedTexture;
+            progressiveTexture->loaded = true;
+            m_LoadingTexture = nullptr;
+            m_LoadedCondition.notify_all();
+        }
+    }
+
     // Register a load/unload function for a resource extension.
     void ResourceManager::RegisterResourceExtension(const StringA& extension, RESOURCELOADFUNCTION loadFunction, RESOURCEUNLOADFUNCTION unloadFunction)
     {
@@ -169,7 +460,7 @@ namespace yw
         return unloadFunc;
     }
 
-    void* ResourceManager::LoadModel(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadModel(ResourceManager* resourceManager, const StringA& fileName, bool /*srgb*/)
     {
         // Define a model.
         Model* model = nullptr;
@@ -190,58 +481,50 @@ namespace yw
         YW_SAFE_DELETE(resource);
     }
 
-    void* ResourceManager::LoadTexture_BMP(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadTexture_BMP(ResourceManager* resourceManager, const StringA& fileName, bool srgb)
     {
-        // Define a texture.
-        Yw3dTexture* texture = nullptr;
-
-        // Load texture data by loader.
-        TextureLoaderBMP texLoader;
-        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true))
-        {
-            YW_SAFE_RELEASE(texture);
-            return nullptr;
-        }
-
-        return texture;
+        return resourceManager->LoadTexture(new TextureLoaderBMP(), fileName, srgb);
     }
 
     void ResourceManager::UnloadTexture_BMP(ResourceManager* resourceManager, void* resource)
     {
         Yw3dTexture* texture = (Yw3dTexture*)resource;
+        resourceManager->CancelProgressiveTexture(texture);
         YW_SAFE_RELEASE(texture);
     }
 
-    void* ResourceManager::LoadTexture_PNG(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadTexture_PNG(ResourceManager* resourceManager, const StringA& fileName, bool srgb)
     {
-        // Define a texture.
-        Yw3dTexture* texture = nullptr;
+        return resourceManager->LoadTexture(new TextureLoaderPNG(), fileName, srgb);
+    }
 
-        // Load texture data by loader.
-        TextureLoaderPNG texLoader;
-        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true))
-        {
-            YW_SAFE_RELEASE(texture);
-            return nullptr;
-        }
+    void ResourceManager::UnloadTexture_PNG(ResourceManager* resourceManager, void* resource)
+    {
+        Yw3dTexture* texture = (Yw3dTexture*)resource;
+        resourceManager->CancelProgressiveTexture(texture);
+        YW_SAFE_RELEASE(texture);
+    }
 
-        return texture;
+    void* ResourceManager::LoadTexture_TGA(ResourceManager* resourceManager, const StringA& fileName, bool srgb)
+    {
+        return resourceManager->LoadTexture(new TextureLoaderTGA(), fileName, srgb);
     }
 
-    void ResourceManager::UnloadTexture_PNG(ResourceManager* resourceManager, void* resource)
+    void ResourceManager::UnloadTexture_TGA(ResourceManager* resourceManager, void* resource)
     {
         Yw3dTexture* texture = (Yw3dTexture*)resource;
+        resourceManager->CancelProgressiveTexture(texture);
         YW_SAFE_RELEASE(texture);
     }
 
-    void* ResourceManager::LoadTexture_TGA(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadTexture_HDR(ResourceManager* resourceManager, const StringA& fileName, bool srgb)
     {
         // Define a texture.
         Yw3dTexture* texture = nullptr;
 
         // Load texture data by loader.
-        TextureLoaderTGA texLoader;
-        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true))
+        TextureLoaderRGBE texLoader;
+        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true, srgb))
         {
             YW_SAFE_RELEASE(texture);
             return nullptr;
@@ -250,20 +533,20 @@ namespace yw
         return texture;
     }
 
-    void ResourceManager::UnloadTexture_TGA(ResourceManager* resourceManager, void* resource)
+    void ResourceManager::UnloadTexture_HDR(ResourceManager* resourceManager, void* resource)
     {
         Yw3dTexture* texture = (Yw3dTexture*)resource;
         YW_SAFE_RELEASE(texture);
     }
 
-    void* ResourceManager::LoadTexture_HDR(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadTexture_Cube(ResourceManager* resourceManager, const StringA& fileName, bool srgb)
     {
         // Define a texture.
         Yw3dTexture* texture = nullptr;
 
         // Load texture data by loader.
-        TextureLoaderRGBE texLoader;
-        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true))
+        TextureLoaderCube texLoader;
+        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true, srgb))
         {
             YW_SAFE_RELEASE(texture);
             return nullptr;
@@ -272,20 +555,20 @@ namespace yw
         return texture;
     }
 
-    void ResourceManager::UnloadTexture_HDR(ResourceManager* resourceManager, void* resource)
+    void ResourceManager::UnloadTexture_Cube(ResourceManager* resourceManager, void* resource)
     {
-        Yw3dTexture* texture = (Yw3dTexture*)resource;
+        Yw3dCubeTexture* texture = (Yw3dCubeTexture*)resource;
         YW_SAFE_RELEASE(texture);
     }
 
-    void* ResourceManager::LoadTexture_Cube(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadTexture_Array(ResourceManager* resourceManager, const StringA& fileName, bool srgb)
     {
         // Define a texture.
-        Yw3dTexture* texture = nullptr;
+        Yw3dTextureArray* texture = nullptr;
 
         // Load texture data by loader.
-        TextureLoaderCube texLoader;
-        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true))
+        TextureLoaderArray texLoader;
+        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true, srgb))
         {
             YW_SAFE_RELEASE(texture);
             return nullptr;
@@ -294,13 +577,13 @@ namespace yw
         return texture;
     }
 
-    void ResourceManager::UnloadTexture_Cube(ResourceManager* resourceManager, void* resource)
+    void ResourceManager::UnloadTexture_Array(ResourceManager* resourceManager, void* resource)
     {
-        Yw3dCubeTexture* texture = (Yw3dCubeTexture*)resource;
+        Yw3dTextureArray* texture = (Yw3dTextureArray*)resource;
         YW_SAFE_RELEASE(texture);
     }
 
-    void* ResourceManager::LoadTexture_Animated(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadTexture_Animated(ResourceManager* resourceManager, const StringA& fileName, bool /*srgb*/)
     {
         assert(nullptr && _T("LoadTexture_Animated is currently not supported!"));
         return nullptr;
@@ -311,26 +594,92 @@ namespace yw
         YW_SAFE_DELETE(resource);
     }
 
-    void* ResourceManager::LoadTexture_YWT(ResourceManager* resourceManager, const StringA& fileName)
+    void* ResourceManager::LoadTexture_YWT(ResourceManager* resourceManager, const StringA& fileName, bool srgb)
     {
-        // Define a texture.
-        Yw3dTexture* texture = nullptr;
+        return resourceManager->LoadTexture(new TextureLoaderYWT(), fileName, srgb);
+    }
 
-        // Load texture data by loader.
-        TextureLoaderYWT texLoader;
-        if (!texLoader.Load(fileName, resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice(), (IYw3dBaseTexture**)(&texture), true))
+    void ResourceManager::UnloadTexture_YWT(ResourceManager* resourceManager, void* resource)
+    {
+        Yw3dTexture* texture = (Yw3dTexture*)resource;
+        resourceManager->CancelProgressiveTexture(texture);
+        YW_SAFE_RELEASE(texture);
+    }
+
+    void* ResourceManager::LoadTexture_YWVT(ResourceManager* resourceManager, const StringA& fileName, bool /*srgb*/)
+    {
+        // Only the header is read at load time, the pages are streamed on demand.
+        FILE* file = fopen(fileName.c_str(), "rb");
+        if (nullptr == file)
         {
-            YW_SAFE_RELEASE(texture);
             return nullptr;
         }
 
-        return texture;
+        YwVirtualTextureFileHeader header;
+        if ((1 != fread(&header, sizeof(YwVirtualTextureFileHeader), 1, file)) || !IsYwVirtualTextureHeaderValid(header))
+        {
+            fclose(file);
+            return nullptr;
+        }
+
+        Yw3dFormat textureFormat = (Yw3dFormat)header.format;
+        if ((textureFormat < Yw3d_FMT_R32F) || (textureFormat > Yw3d_FMT_R32G32B32A32F))
+        {
+            fclose(file);
+            return nullptr;
+        }
+
+        // Create virtual texture from device.
+        Yw3dVirtualTexture* virtualTexture = nullptr;
+        Yw3dDevice* device = resourceManager->GetApplication()->GetGraphics()->GetYw3dDevice();
+        if (YW3D_FAILED(device->CreateVirtualTexture(&virtualTexture, header.width, header.height, header.mipsCount, textureFormat, header.pageSize, resourceManager->m_VirtualTextureBudget)))
+        {
+            fclose(file);
+            return nullptr;
+        }
+
+        if ((virtualTexture->GetMipLevels() != header.mipsCount) || (virtualTexture->GetPageBytes() != header.pageDataSize))
+        {
+            LOGE(_T("ResourceManager.LoadTexture_YWVT: Virtual texture pages are not match."));
+            YW_SAFE_RELEASE(virtualTexture);
+            fclose(file);
+            return nullptr;
+        }
+
+        StreamedVirtualTexture streamedTexture;
+        streamedTexture.file = file;
+        for (uint32_t i = 0; i < header.mipsCount; i++)
+        {
+            streamedTexture.mipOffsets.push_back(GetYwVirtualTexturePageOffset(header, i, 0, 0));
+        }
+
+        // The mip-levels of a single page are never evicted, read them now so that sampling always has a fallback.
+        for (uint32_t i = 0; i < header.mipsCount; i++)
+        {
+            if ((1 == virtualTexture->GetPagesX(i)) && (1 == virtualTexture->GetPagesY(i)) && !resourceManager->StreamVirtualTexturePage(virtualTexture, file, streamedTexture.mipOffsets[i], i, 0, 0))
+            {
+                YW_SAFE_RELEASE(virtualTexture);
+                fclose(file);
+                return nullptr;
+            }
+        }
+
+        resourceManager->m_StreamedVirtualTextures[virtualTexture] = streamedTexture;
+        return virtualTexture;
     }
 
-    void ResourceManager::UnloadTexture_YWT(ResourceManager* resourceManager, void* resource)
+    void ResourceManager::UnloadTexture_YWVT(ResourceManager* resourceManager, void* resource)
     {
-        Yw3dTexture* texture = (Yw3dTexture*)resource;
-        YW_SAFE_RELEASE(texture);
+        Yw3dVirtualTexture* virtualTexture = (Yw3dVirtualTexture*)resource;
+
+        std::map<Yw3dVirtualTexture*, StreamedVirtualTexture>::iterator itr = resourceManager->m_StreamedVirtualTextures.find(virtualTexture);
+        if (resourceManager->m_StreamedVirtualTextures.end() != itr)
+        {
+            fclose(itr->second.file);
+            resourceManager->m_StreamedVirtualTextures.erase(itr);
+        }
+
+        YW_SAFE_RELEASE(virtualTexture);
     }
 
     StringA ResourceManager::GetDiskFilePath(const StringA& fileName) const
@@ -6,6 +6,12 @@
 
 #include "YwBase.h"
 #include <map>
+#include <list>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <stdio.h>
 
 namespace yw
 {
@@ -13,7 +19,7 @@ namespace yw
     typedef uint32_t HRESOURCE;
 
     // Resources load and unload function types.
-    typedef void* (*RESOURCELOADFUNCTION)(class ResourceManager* resourceManager, const StringA& filename);
+    typedef void* (*RESOURCELOADFUNCTION)(class ResourceManager* resourceManager, const StringA& filename, bool srgb);
     typedef void (*RESOURCEUNLOADFUNCTION)(class ResourceManager* resourceManager, void* resource);
 
     // Resource manager class.
@@ -35,7 +41,9 @@ namespace yw
 
     public:
         // Load a resource from file.
-        HRESOURCE LoadResource(const StringA& fileName);
+        // @param[in] fileName the file path relative to the data path.
+        // @param[in] srgb true if a texture holds sRGB encoded colors, e.g. albedo maps, ignored by other resources.
+        HRESOURCE LoadResource(const StringA& fileName, bool srgb = false);
 
         // Unload a loaded resource.
         void UnloadResource(HRESOURCE hResource);
@@ -43,6 +51,27 @@ namespace yw
         // Get a loaded resource.
         void* GetResource(HRESOURCE hResource) const;
 
+        // Stream the pages requested by sampling the loaded virtual textures from their paged files, called once per frame after rendering.
+        // @param[in] maxPagesPerFrame the maximum number of pages read for each virtual texture, the coarsest requested pages are read first.
+        void StreamVirtualTextures(uint32_t maxPagesPerFrame = 16);
+
+        // Set the memory budget in bytes of the resident pages of each virtual texture loaded afterwards.
+        inline void SetVirtualTextureBudget(size_t memoryBudget)
+        {
+            m_VirtualTextureBudget = memoryBudget;
+        }
+
+        // Publish the mip-levels decoded by the loading thread to the progressively loaded textures, from the coarsest to the finest, called once per frame after rendering.
+        // @param[in] maxPixelsPerFrame the maximum number of pixels copied in a frame, at least one mip-level of each decoded texture is copied.
+        void UpdateProgressiveTextures(uint32_t maxPixelsPerFrame = 1024 * 1024);
+
+        // Enable or disable progressive loading of the textures loaded afterwards. A progressively loaded texture is returned at once showing its coarsest mip-level,
+        // it is decoded by a loading thread and gets its finer mip-levels from UpdateProgressiveTextures(). Disabled by default.
+        inline void SetProgressiveTextureLoading(bool progressive)
+        {
+            m_ProgressiveTextureLoading = progressive;
+        }
+
     public:
         // Get resource load function by file extension.
         RESOURCELOADFUNCTION GetResourceLoaderByFileExtension(const StringA& extension);
@@ -64,36 +93,62 @@ namespace yw
         void RegisterResourceExtension(const StringA& extension, RESOURCELOADFUNCTION loadFunction, RESOURCEUNLOADFUNCTION unloadFunction);
 
         // Load and unload model file.
-        static void* LoadModel(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadModel(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadModel(ResourceManager* resourceManager, void* resource);
 
         // Load and unload "bmp" texture file.
-        static void* LoadTexture_BMP(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadTexture_BMP(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadTexture_BMP(ResourceManager* resourceManager, void* resource);
 
         // Load and unload "png" texture file.
-        static void* LoadTexture_PNG(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadTexture_PNG(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadTexture_PNG(ResourceManager* resourceManager, void* resource);
 
         // Load and unload "tga" texture file.
-        static void* LoadTexture_TGA(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadTexture_TGA(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadTexture_TGA(ResourceManager* resourceManager, void* resource);
 
-        static void* LoadTexture_HDR(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadTexture_HDR(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadTexture_HDR(ResourceManager* resourceManager, void* resource);
 
         // Load and unload "cube" texture file.
-        static void* LoadTexture_Cube(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadTexture_Cube(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadTexture_Cube(ResourceManager* resourceManager, void* resource);
 
+        // Load and unload "texarray" texture file, a list of the texture files of the layers.
+        static void* LoadTexture_Array(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
+        static void UnloadTexture_Array(ResourceManager* resourceManager, void* resource);
+
         // Load and unload "animated" texture file.
-        static void* LoadTexture_Animated(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadTexture_Animated(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadTexture_Animated(ResourceManager* resourceManager, void* resource);
 
         // Load and unload "ywt" texture file.
-        static void* LoadTexture_YWT(ResourceManager* resourceManager, const StringA& fileName);
+        static void* LoadTexture_YWT(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
         static void UnloadTexture_YWT(ResourceManager* resourceManager, void* resource);
 
+        // Load and unload "ywvt" paged virtual texture file, the file is kept open for streaming.
+        static void* LoadTexture_YWVT(ResourceManager* resourceManager, const StringA& fileName, bool srgb);
+        static void UnloadTexture_YWVT(ResourceManager* resourceManager, void* resource);
+
+        // Read a page of a streamed virtual texture from its file and upload it.
+        bool StreamVirtualTexturePage(class Yw3dVirtualTexture* virtualTexture, FILE* file, uint64_t mipOffset, uint32_t mipLevel, uint32_t pageX, uint32_t pageY);
+
+        // A progressively loaded texture.
+        struct ProgressiveTexture;
+
+        // Load a texture by a loader, progressively if enabled and supported by the loader. The loader is deleted when loading is done.
+        class Yw3dTexture* LoadTexture(class ITextureLoader* texLoader, const StringA& fileName, bool srgb);
+
+        // Stop loading a progressively loaded texture which is being unloaded, waits if the loading thread is decoding it.
+        void CancelProgressiveTexture(class Yw3dTexture* texture);
+
+        // Release the loader, data and decoded texture of a progressively loaded texture.
+        void DestroyProgressiveTexture(ProgressiveTexture* progressiveTexture);
+
+        // Decode the queued progressively loaded textures.
+        void LoadingThreadProc();
+
     public:
         // Get parent application.
         inline class IApplication* GetApplication()
@@ -116,14 +171,61 @@ namespace yw
             uint32_t references;
             StringA fileName;
             StringA extension;
+            bool srgb;
             void* resource;
 
-            ManagedResource() : resourceHandle(0), references(0), resource(nullptr) {}
+            ManagedResource() : resourceHandle(0), references(0), srgb(false), resource(nullptr) {}
         };
 
         // All loaded managed resources.
         std::map<HRESOURCE, ManagedResource> m_ManagedResources;
         uint32_t m_NumberLoadedResources;
+
+        // Streamed virtual texture, the paged file and the file offset of the first page of each mip-level.
+        struct StreamedVirtualTexture
+        {
+            FILE* file;
+            std::vector<uint64_t> mipOffsets;
+
+            StreamedVirtualTexture() : file(nullptr) {}
+        };
+
+        // All loaded virtual textures and the memory budget of each one.
+        std::map<class Yw3dVirtualTexture*, StreamedVirtualTexture> m_StreamedVirtualTextures;
+        size_t m_VirtualTextureBudget;
+
+        // Buffer of a page read from a paged file.
+        std::vector<uint8_t> m_PageData;
+
+        // A progressively loaded texture, decoded to a separate texture by the loading thread and copied to the returned texture a few mip-levels per frame.
+        struct ProgressiveTexture
+        {
+            class ITextureLoader* loader;
+            StringA fileName;
+            uint8_t* fileData;
+            uint32_t fileDataLength;
+            bool srgb;
+            class Yw3dDevice* device;
+            class Yw3dTexture* texture;
+            class Yw3dTexture* loadedTexture;
+            bool loaded;
+            uint32_t remainingMipLevels;
+
+            ProgressiveTexture() : loader(nullptr), fileData(nullptr), fileDataLength(0), srgb(false), device(nullptr), texture(nullptr), loadedTexture(nullptr), loaded(false), remainingMipLevels(0) {}
+        };
+
+        // All progressively loaded textures which are not complete, only accessed by the main thread.
+        std::list<ProgressiveTexture*> m_ProgressiveTextures;
+        bool m_ProgressiveTextureLoading;
+
+        // Textures waiting for and being decoded by the loading thread, and "loaded" of all progressive textures, guarded by the loading mutex.
+        std::deque<ProgressiveTexture*> m_LoadingQueue;
+        ProgressiveTexture* m_LoadingTexture;
+        bool m_ExitLoading;
+        std::mutex m_LoadingMutex;
+        std::condition_variable m_LoadingCondition;
+        std::condition_variable m_LoadedCondition;
+        std::thread m_LoadingThread;
     };
 }
 
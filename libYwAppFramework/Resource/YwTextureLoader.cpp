@@ -8,13 +8,44 @@
 
 namespace yw
 {
-    bool ITextureLoader::Load(const StringA& fileName, Yw3dDevice* device, IYw3dBaseTexture** texture, bool generateMipmap)
+    bool ITextureLoader::Load(const StringA& fileName, Yw3dDevice* device, IYw3dBaseTexture** texture, bool generateMipmap, bool srgb)
     {
         if ((0 == fileName.length()) || (nullptr == device) || (nullptr == texture))
         {
             return false;
         }
 
+        m_SRGB = srgb;
+
+        // Load texture from file.
+        if (!LoadFromFile(fileName, device, texture))
+        {
+            return false;
+        }
+
+        return CompleteLoading(texture, generateMipmap);
+    }
+
+    bool ITextureLoader::LoadFromMemory(const StringA& fileName, const uint8_t* data, uint32_t dataLength, Yw3dDevice* device, IYw3dBaseTexture** texture, bool generateMipmap, bool srgb)
+    {
+        if ((nullptr == data) || (0 == dataLength) || (nullptr == device) || (nullptr == texture))
+        {
+            return false;
+        }
+
+        m_SRGB = srgb;
+
+        // Load texture from data.
+        if (!LoadFromData(fileName, data, dataLength, device, texture))
+        {
+            return false;
+        }
+
+        return CompleteLoading(texture, generateMipmap);
+    }
+
+    bool ITextureLoader::LoadFromFile(const StringA& fileName, Yw3dDevice* device, IYw3dBaseTexture** texture)
+    {
         // Use file io.
         FileIO file;
         uint8_t* textureData = nullptr;
@@ -27,15 +58,15 @@ namespace yw
 
         // Load texture from data.
         bool res = LoadFromData(fileName, textureData, fileSize, device, texture);
-        if (!res)
-        {
-            YW_SAFE_DELETE_ARRAY(textureData);
-            return false;
-        }
 
         // Release texture data.
         YW_SAFE_DELETE_ARRAY(textureData);
 
+        return res;
+    }
+
+    bool ITextureLoader::CompleteLoading(IYw3dBaseTexture** texture, bool generateMipmap)
+    {
         // Check loaded texture.
         if (nullptr == *texture)
         {
@@ -53,6 +84,12 @@ namespace yw
         return true;
     }
 
+    bool ITextureLoader::LoadInfo(const uint8_t* /*data*/, uint32_t /*dataLength*/, bool /*srgb*/, TextureLoadInfo& /*info*/)
+    {
+        // Not supported by default, the texture is loaded at once.
+        return false;
+    }
+
     bool ITextureLoader::GenerateTextureMipmap(IYw3dBaseTexture* texture)
     {
         Yw3dTexture* inputTexture = dynamic_cast<Yw3dTexture*>(texture);
@@ -6,15 +6,28 @@
 
 #include "YwBase.h"
 #include "YwMath.h"
+#include "Yw3dTypes.h"
 
 namespace yw
 {
+    // Description of the texture a file is loaded into, read without decoding the pixels.
+    struct TextureLoadInfo
+    {
+        uint32_t width;
+        uint32_t height;
+        uint32_t mipLevels; // 0 for a full mip-chain.
+        Yw3dFormat format;
+        Yw3dSurfaceLayout layout;
+
+        TextureLoadInfo() : width(0), height(0), mipLevels(0), format(Yw3d_FMT_R32G32B32A32F), layout(Yw3d_SL_Linear) {}
+    };
+
     // Base texture loader class.
     class ITextureLoader
     {
     public:
         // Constructor.
-        ITextureLoader() {}
+        ITextureLoader() : m_SRGB(false) {}
 
         // Destructor.
         virtual ~ITextureLoader() {}
@@ -25,10 +38,36 @@ namespace yw
         // @param[in] device used to create texture.
         // @param[out] texture the loaded data to fill.
         // @param[in] generateMipmap generate mipmap or not. NOTE: only textures whose size is pow of 2 are supported, or it will not generate mipmap even generateMipmap is set to true.
+        // @param[in] srgb true if the texture holds sRGB encoded colors, e.g. albedo maps. 8-bit images are kept in the sRGB formats and decoded to linear when sampled, 16-bit images are decoded when loaded and float images ignore it.
+        // @return true if the texture loading ok, false if loading failed.
+        bool Load(const StringA& fileName, class Yw3dDevice* device, class IYw3dBaseTexture** texture, bool generateMipmap = true, bool srgb = false);
+
+        // Load texture data from the data of a file already read, may be called by a loading thread.
+        // @param[in] fileName the full path of the texture file.
+        // @param[in] data raw file data.
+        // @param[in] dataLength length in bytes of data.
+        // @param[in] device used to create texture.
+        // @param[out] texture the loaded data to fill.
+        // @param[in] generateMipmap generate mipmap or not.
+        // @param[in] srgb true if the texture holds sRGB encoded colors.
         // @return true if the texture loading ok, false if loading failed.
-        bool Load(const StringA& fileName, class Yw3dDevice* device, class IYw3dBaseTexture** texture, bool generateMipmap = true);
+        bool LoadFromMemory(const StringA& fileName, const uint8_t* data, uint32_t dataLength, class Yw3dDevice* device, class IYw3dBaseTexture** texture, bool generateMipmap = true, bool srgb = false);
+
+        // Read the dimensions and format of the texture the file data is loaded into, without decoding the pixels. Used by progressive loading to create the texture before it's decoded.
+        // @param[in] data raw file data.
+        // @param[in] dataLength length in bytes of data.
+        // @param[in] srgb true if the texture holds sRGB encoded colors.
+        // @param[out] info receives the description of the texture.
+        // @return true if the description was read, false if the data is invalid or the loader doesn't support it.
+        virtual bool LoadInfo(const uint8_t* data, uint32_t dataLength, bool srgb, TextureLoadInfo& info);
 
     private:
+        // Load texture from a file, the default reads the whole file and loads it from its data. Loaders using the file data in place map the file instead.
+        // @param[in] fileName the full path of the texture file.
+        // @param[in] device used to create texture.
+        // @param[out] texture the loaded data to fill.
+        virtual bool LoadFromFile(const StringA& fileName, class Yw3dDevice* device, class IYw3dBaseTexture** texture);
+
         // Load texture from kinds of data.
         // @param[in] fileName the full path of the texture file.
         // @param[in] data raw file data.
@@ -41,12 +80,21 @@ namespace yw
         // @param[out] texture the loaded data to fill.
         virtual bool GenerateMipmap(class IYw3dBaseTexture* texture) = 0;
 
+        // Check the loaded texture and generate its mipmap, releases the texture on failure.
+        // @param[out] texture the loaded data to fill.
+        // @param[in] generateMipmap generate mipmap or not.
+        bool CompleteLoading(class IYw3dBaseTexture** texture, bool generateMipmap);
+
     protected:
         // Generate mipmap for Yw3dTexture.
         bool GenerateTextureMipmap(class IYw3dBaseTexture* texture);
 
         // Generate mipmap for Yw3dCubeTexture.
         bool GenerateCubeTextureMipmap(class IYw3dBaseTexture* texture);
+
+    protected:
+        // True if the texture being loaded holds sRGB encoded colors.
+        bool m_SRGB;
     };
 }
 
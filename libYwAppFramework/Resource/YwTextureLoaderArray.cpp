@@ -0,0 +1,173 @@
+// Add by Yaukey at 2026-10-19.
+// YW texture loader for texture array class.
+
+#include "YwTextureLoaderArray.h"
+#include "YwTextureLoaderBMP.h"
+#include "YwTextureLoaderPNG.h"
+#include "YwTextureLoaderTGA.h"
+#include "YwTextureLoaderRGBE.h"
+#include "YwTextureLoaderYWT.h"
+#include "YwPaths.h"
+#include <sstream>
+#include "Yw3d.h"
+
+namespace yw
+{
+    TextureLoaderArray::TextureLoaderArray() :
+        ITextureLoader(),
+        m_GenerateMipmap(true)
+    {
+
+    }
+
+    TextureLoaderArray::~TextureLoaderArray()
+    {
+
+    }
+
+    bool TextureLoaderArray::LoadFromData(const StringA& fileName, const uint8_t* data, uint32_t dataLength, Yw3dDevice* device, IYw3dBaseTexture** texture)
+    {
+        // Layer file names are separated by white spaces.
+        std::stringstream arrayData(StringA((const char*)data, dataLength));
+        std::vector<StringA> layerTextureNames;
+        StringA layerTextureName;
+        while (arrayData >> layerTextureName)
+        {
+            layerTextureNames.push_back(layerTextureName);
+        }
+
+        const uint32_t numLayers = (uint32_t)layerTextureNames.size();
+        if (0 == numLayers)
+        {
+            LOGE(_T("TextureLoaderArray.LoadFromData: No layer file."));
+            return false;
+        }
+
+        // Load all layers, the array is created by the first one.
+        StringA fileDataDir = Paths::GetFilePathA(fileName);
+        Yw3dTextureArray** inputTexture = (Yw3dTextureArray**)texture;
+        YW_SAFE_RELEASE(*inputTexture);
+        m_GenerateMipmap = false;
+
+        for (uint32_t layer = 0; layer < numLayers; layer++)
+        {
+            Yw3dTexture* layerTexture = nullptr;
+            bool hasMipmap = false;
+            if (!LoadTextureByFileName(fileDataDir + layerTextureNames[layer], device, &layerTexture, hasMipmap))
+            {
+                YW_SAFE_RELEASE(*inputTexture);
+                return false;
+            }
+
+            if (0 == layer)
+            {
+                // Layers without mipmap get a full mip-chain generated later.
+                const uint32_t mipLevels = hasMipmap ? layerTexture->GetMipLevels() : 0;
+                if (YW3D_FAILED(device->CreateTextureArray(inputTexture, layerTexture->GetWidth(), layerTexture->GetHeight(), numLayers, mipLevels, layerTexture->GetFormat())))
+                {
+                    LOGE(_T("TextureLoaderArray.LoadFromData: Create texture array failed."));
+                    YW_SAFE_RELEASE(layerTexture);
+                    return false;
+                }
+            }
+
+            // Copy the stored mipmap if the layer has the mip-levels of the array, otherwise copy the first level and generate the rest.
+            Yw3dTexture* arrayLayer = (*inputTexture)->AcquireLayer(layer);
+            const bool copyMipmap = hasMipmap && (layerTexture->GetMipLevels() == arrayLayer->GetMipLevels()) &&
+                (layerTexture->GetWidth() == arrayLayer->GetWidth()) && (layerTexture->GetHeight() == arrayLayer->GetHeight());
+            const uint32_t copyMipLevels = copyMipmap ? arrayLayer->GetMipLevels() : 1;
+            bool copied = true;
+            for (uint32_t mipLevel = 0; copied && (mipLevel < copyMipLevels); mipLevel++)
+            {
+                copied = CopyTextureMipLevel(layerTexture, arrayLayer, mipLevel);
+            }
+
+            m_GenerateMipmap = m_GenerateMipmap || !copyMipmap;
+
+            YW_SAFE_RELEASE(arrayLayer);
+            YW_SAFE_RELEASE(layerTexture);
+
+            if (!copied)
+            {
+                LOGE(_T("TextureLoaderArray.LoadFromData: Copy layer failed."));
+                YW_SAFE_RELEASE(*inputTexture);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool TextureLoaderArray::GenerateMipmap(IYw3dBaseTexture* texture)
+    {
+        if (!m_GenerateMipmap)
+        {
+            return true;
+        }
+
+        Yw3dTextureArray* inputTexture = dynamic_cast<Yw3dTextureArray*>(texture);
+        if ((nullptr == inputTexture) || YW3D_FAILED(inputTexture->GenerateMipSubLevels(0)))
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TextureLoaderArray::LoadTextureByFileName(const StringA& fileName, Yw3dDevice* device, Yw3dTexture** texture, bool& hasMipmap)
+    {
+        StringA fileExt = Paths::GetFileExtensionA(fileName);
+        ITextureLoader* textureLoader = nullptr;
+        hasMipmap = false;
+        if ("bmp" == fileExt)
+        {
+            textureLoader = new TextureLoaderBMP();
+        }
+        else if ("png" == fileExt)
+        {
+            textureLoader = new TextureLoaderPNG();
+        }
+        else if ("tga" == fileExt)
+        {
+            textureLoader = new TextureLoaderTGA();
+        }
+        else if (("hdr" == fileExt) || ("rgbe" == fileExt) || ("xyze" == fileExt))
+        {
+            textureLoader = new TextureLoaderRGBE();
+        }
+        else if ("ywt" == fileExt)
+        {
+            // YWT map contains mipmap data by default.
+            textureLoader = new TextureLoaderYWT();
+            hasMipmap = true;
+        }
+        else
+        {
+            LOGE(_T("TextureLoaderArray.LoadTextureByFileName: Unsupported texture format."));
+            return false;
+        }
+
+        // Generating mipmap later by texture array, not here.
+        IYw3dBaseTexture** baseTexture = (IYw3dBaseTexture**)texture;
+        if (!textureLoader->Load(fileName, device, baseTexture, false, m_SRGB))
+        {
+            YW_SAFE_DELETE(textureLoader);
+            LOGE(_T("TextureLoaderArray.LoadTextureByFileName: Load texture failed."));
+            return false;
+        }
+
+        YW_SAFE_DELETE(textureLoader);
+        return true;
+    }
+
+    bool TextureLoaderArray::CopyTextureMipLevel(Yw3dTexture* srcTexture, Yw3dTexture* destTexture, uint32_t mipLevel)
+    {
+        Yw3dSurface* srcSurface = srcTexture->AcquireMipLevel(mipLevel);
+        Yw3dSurface* destSurface = destTexture->AcquireMipLevel(mipLevel);
+        const bool result = (nullptr != srcSurface) && (nullptr != destSurface) && YW3D_SUCCESSFUL(srcSurface->CopyToSurface(nullptr, destSurface, nullptr, Yw3d_TF_Linear));
+        YW_SAFE_RELEASE(destSurface);
+        YW_SAFE_RELEASE(srcSurface);
+
+        return result;
+    }
+}
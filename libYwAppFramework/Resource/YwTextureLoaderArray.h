@@ -0,0 +1,49 @@
+// Add by Yaukey at 2026-10-19.
+// YW texture loader for texture array class.
+
+#ifndef __YW_TEXTURE_LOADER_ARRAY_H__
+#define __YW_TEXTURE_LOADER_ARRAY_H__
+
+#include "YwTextureLoader.h"
+
+namespace yw
+{
+    // Loads a texture array from a text file listing the texture file of each layer, relative to the directory of the list.
+    // The first layer determines the size, format and mip-levels of the array, the other layers are converted and resampled to it.
+    class TextureLoaderArray : public ITextureLoader
+    {
+    public:
+        // Constructor.
+        TextureLoaderArray();
+
+        // Destructor.
+        ~TextureLoaderArray();
+
+    private:
+        // Load texture from kinds of data.
+        // @param[in] fileName the full path of the texture file.
+        // @param[in] data raw file data.
+        // @param[in] dataLength length in bytes of data.
+        // @param[in] device used to create texture.
+        // @param[out] texture the loaded data to fill.
+        virtual bool LoadFromData(const StringA& fileName, const uint8_t* data, uint32_t dataLength, class Yw3dDevice* device, class IYw3dBaseTexture** texture);
+
+        // Generate mipmap for texture.
+        // @param[out] texture the loaded data to fill.
+        virtual bool GenerateMipmap(class IYw3dBaseTexture* texture);
+
+    private:
+        // Get texture by file name, auto select loader.
+        // @param[out] hasMipmap receives true if the file contains its mipmap.
+        bool LoadTextureByFileName(const StringA& fileName, class Yw3dDevice* device, class Yw3dTexture** texture, bool& hasMipmap);
+
+        // Copy a mip level of a loaded texture to a layer, converts the format and resamples it if needed.
+        bool CopyTextureMipLevel(class Yw3dTexture* srcTexture, class Yw3dTexture* destTexture, uint32_t mipLevel);
+
+    private:
+        // Should generate mipmap or not, false if all layer files contain their mipmap.
+        bool m_GenerateMipmap;
+    };
+}
+
+#endif // !__YW_TEXTURE_LOADER_ARRAY_H__
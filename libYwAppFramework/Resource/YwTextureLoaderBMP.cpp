@@ -39,7 +39,7 @@ namespace yw
         BitMapInfoHeader* infoHeader = (BitMapInfoHeader*)(data + sizeof(BitMapFileHeader));
         int32_t texWidth = infoHeader->biWidth;
         int32_t texHeight = infoHeader->biHeight;
-        Yw3dFormat textureFormat = (32 == infoHeader->biBitCount) ? Yw3d_FMT_R32G32B32A32F : Yw3d_FMT_R32G32B32F;
+        Yw3dFormat textureFormat = (32 == infoHeader->biBitCount) ? (m_SRGB ? Yw3d_FMT_R8G8B8A8_SRGB : Yw3d_FMT_R8G8B8A8) : (m_SRGB ? Yw3d_FMT_R8G8B8_SRGB : Yw3d_FMT_R8G8B8);
         uint16_t bbp = infoHeader->biBitCount / 8;
         int32_t pitch = ((texWidth * bbp) + 3) / 4 * 4;
 
@@ -52,13 +52,13 @@ namespace yw
 
         // Create texture from device.
         YW_SAFE_RELEASE(*inputTexture);
-        if (YW3D_FAILED(device->CreateTexture(inputTexture, texWidth, texHeight, 0, textureFormat)))
+        if (YW3D_FAILED(device->CreateTexture(inputTexture, texWidth, texHeight, 0, textureFormat, Yw3d_SL_Tiled4x4)))
         {
             return false;
         }
 
-        // Lock texture data.
-        float* textureData = nullptr;
+        // Lock texture data, the bytes are kept as they are.
+        uint8_t* textureData = nullptr;
         Yw3dResult resLock = (*inputTexture)->LockRect(0, (void**)&textureData, nullptr);
         if (YW3D_FAILED(resLock))
         {
@@ -66,9 +66,6 @@ namespace yw
             return false;
         }
 
-        // Normalized color scale.
-        const float colorScale = 1.0f / 255.0f;
-
         // Fill data.
         uint8_t* srcTextureData = texDataRaw;
         for (int32_t yIdx = 0; yIdx < texHeight; yIdx++)
@@ -78,22 +75,15 @@ namespace yw
                 int32_t texIndex = (texHeight - 1 - yIdx) * texWidth + xIdx;
                 int32_t bmpIndex = yIdx * pitch + xIdx * bbp;
                 
-                if (Yw3d_FMT_R32G32B32A32F == textureFormat)
-                {
-                    Vector4* texData = (Vector4*)textureData + texIndex;
-                    uint8_t* bmpData = (uint8_t*)(srcTextureData + bmpIndex);
-                    texData->b = (float)((*bmpData) * colorScale);
-                    texData->g = (float)((*(bmpData + 1)) * colorScale);
-                    texData->r = (float)((*(bmpData + 2)) * colorScale);
-                    texData->a = (float)((*(bmpData + 3)) * colorScale);
-                }
-                else
+                // Bmp pixels are stored as bgr(a).
+                uint8_t* texData = textureData + texIndex * bbp;
+                uint8_t* bmpData = (uint8_t*)(srcTextureData + bmpIndex);
+                texData[0] = bmpData[2];
+                texData[1] = bmpData[1];
+                texData[2] = bmpData[0];
+                if (4 == bbp)
                 {
-                    Vector3* texData = (Vector3*)textureData + texIndex;
-                    uint8_t* bmpData = (uint8_t*)(srcTextureData + bmpIndex);
-                    texData->b = (float)((*bmpData) * colorScale);
-                    texData->g = (float)((*(bmpData + 1)) * colorScale);
-                    texData->r = (float)((*(bmpData + 2)) * colorScale);
+                    texData[3] = bmpData[3];
                 }
             }
         }
@@ -104,6 +94,36 @@ namespace yw
         return true;
     }
 
+    bool TextureLoaderBMP::LoadInfo(const uint8_t* data, uint32_t dataLength, bool srgb, TextureLoadInfo& info)
+    {
+        if ((nullptr == data) || (dataLength < sizeof(BitMapFileHeader) + sizeof(BitMapInfoHeader)))
+        {
+            return false;
+        }
+
+        // Read bit map file header.
+        const BitMapFileHeader* fileHeader = (const BitMapFileHeader*)data;
+        if (BITMAP_FILE_MAGIC != fileHeader->bfType)
+        {
+            return false;
+        }
+
+        // Read bit map info.
+        const BitMapInfoHeader* infoHeader = (const BitMapInfoHeader*)(data + sizeof(BitMapFileHeader));
+        if ((infoHeader->biWidth <= 0) || (infoHeader->biHeight <= 0))
+        {
+            return false;
+        }
+
+        info.width = infoHeader->biWidth;
+        info.height = infoHeader->biHeight;
+        info.mipLevels = 0;
+        info.format = (32 == infoHeader->biBitCount) ? (srgb ? Yw3d_FMT_R8G8B8A8_SRGB : Yw3d_FMT_R8G8B8A8) : (srgb ? Yw3d_FMT_R8G8B8_SRGB : Yw3d_FMT_R8G8B8);
+        info.layout = Yw3d_SL_Tiled4x4;
+
+        return true;
+    }
+
     bool TextureLoaderBMP::GenerateMipmap(IYw3dBaseTexture* texture)
     {
         return GenerateTextureMipmap(texture);
@@ -17,6 +17,14 @@ namespace yw
         // Destructor.
         ~TextureLoaderBMP();
 
+        // Read the dimensions and format of the texture the file data is loaded into, without decoding the pixels.
+        // @param[in] data raw file data.
+        // @param[in] dataLength length in bytes of data.
+        // @param[in] srgb true if the texture holds sRGB encoded colors.
+        // @param[out] info receives the description of the texture.
+        // @return true if the description was read, false if the data is invalid.
+        virtual bool LoadInfo(const uint8_t* data, uint32_t dataLength, bool srgb, TextureLoadInfo& info);
+
     private:
         // Load texture from kinds of data.
         // @param[in] fileName the full path of the texture file.
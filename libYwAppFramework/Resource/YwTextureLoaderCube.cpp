@@ -71,7 +71,6 @@ namespace yw
         uint32_t cubeEdgeLength = 0;
         uint32_t cubeMaxMipLeves = 0;
         Yw3dFormat cubeFormat = Yw3d_FMT_R32G32B32F;
-        uint32_t cubeFormatBytes = 0;
         for (int32_t i = 0; i < (int32_t)Yw3d_CF_NumCubeFaces; i++)
         {
             StringA faceFileName = fileDataDir + faceTextureNames[i];
@@ -88,7 +87,6 @@ namespace yw
                 cubeEdgeLength = faceTextures[i]->GetWidth();
                 cubeFormat = faceTextures[i]->GetFormat();
                 cubeMaxMipLeves = faceTextures[i]->GetMipLevels();
-                cubeFormatBytes = faceTextures[i]->GetFormatFloats() * sizeof(float);
             }
         }
 
@@ -107,19 +105,13 @@ namespace yw
         if (m_GenerateMipmapByDefault)
         {
             // Because we generate mipmap by "GenerateMipmap" method later, so we just copy first mipmap level here.
-            uint32_t copyBytes = cubeEdgeLength * cubeEdgeLength * cubeFormatBytes;
+            // Surfaces are copied directly whatever the format and layout of the loaded textures is.
             for (int32_t i = 0; i < (int32_t)Yw3d_CF_NumCubeFaces; i++)
             {
-                uint8_t* dst = nullptr;
-                (*inputTexture)->LockRect((Yw3dCubeFaces)i, 0, (void**)&dst, nullptr);
-
-                uint8_t* src = nullptr;
-                faceTextures[i]->LockRect(0, (void**)&src, nullptr);
-                memcpy(dst, src, copyBytes);
-                faceTextures[i]->UnlockRect(0);
+                Yw3dTexture* cubeFaceTexture = (*inputTexture)->AcquireCubeFace((Yw3dCubeFaces)i);
+                CopyTextureMipLevel(faceTextures[i], cubeFaceTexture, 0);
+                YW_SAFE_RELEASE(cubeFaceTexture);
                 YW_SAFE_RELEASE(faceTextures[i]);
-
-                (*inputTexture)->UnlockRect((Yw3dCubeFaces)i, 0);
             }
         }
         else
@@ -132,21 +124,14 @@ namespace yw
             for (int32_t i = 0; i < (int32_t)Yw3d_CF_NumCubeFaces; i++)
             {
                 const uint32_t maxMipLevels = (*inputTexture)->GetMipLevels();
+                Yw3dTexture* cubeFaceTexture = (*inputTexture)->AcquireCubeFace((Yw3dCubeFaces)i);
                 for (uint32_t mipLevel = 0; mipLevel < maxMipLevels; mipLevel++)
                 {
-                    uint32_t copyBytes = faceTextures[i]->GetWidth(mipLevel) * faceTextures[i]->GetHeight(mipLevel) * cubeFormatBytes;
-
-                    uint8_t* dst = nullptr;
-                    (*inputTexture)->LockRect((Yw3dCubeFaces)i, mipLevel, (void**)&dst, nullptr);
-
-                    uint8_t* src = nullptr;
-                    faceTextures[i]->LockRect(mipLevel, (void**)&src, nullptr);
-                    memcpy(dst, src, copyBytes);
-                    faceTextures[i]->UnlockRect(mipLevel);
-
-                    (*inputTexture)->UnlockRect((Yw3dCubeFaces)i, mipLevel);
+                    CopyTextureMipLevel(faceTextures[i], cubeFaceTexture, mipLevel);
                 }
 
+                YW_SAFE_RELEASE(cubeFaceTexture);
+
                 YW_SAFE_RELEASE(faceTextures[i]);
             }
         }
@@ -229,7 +214,7 @@ namespace yw
 
         // Generating mipmap later by cube map, not here.
         IYw3dBaseTexture** baseTexture = (IYw3dBaseTexture**)texture;
-        if (!textureLoader->Load(fileName, device, baseTexture, false))
+        if (!textureLoader->Load(fileName, device, baseTexture, false, m_SRGB))
         {
             YW_SAFE_DELETE(textureLoader);
             LOGE(_T("TextureLoaderCube.LoadTextureByFileName: Load texture failed."));
@@ -247,4 +232,15 @@ namespace yw
             YW_SAFE_RELEASE(textures[i]);
         }
     }
+
+    bool TextureLoaderCube::CopyTextureMipLevel(Yw3dTexture* srcTexture, Yw3dTexture* destTexture, uint32_t mipLevel)
+    {
+        Yw3dSurface* srcSurface = srcTexture->AcquireMipLevel(mipLevel);
+        Yw3dSurface* destSurface = destTexture->AcquireMipLevel(mipLevel);
+        const bool result = (nullptr != srcSurface) && (nullptr != destSurface) && YW3D_SUCCESSFUL(srcSurface->CopyToSurface(nullptr, destSurface, nullptr, Yw3d_TF_Point));
+        YW_SAFE_RELEASE(destSurface);
+        YW_SAFE_RELEASE(srcSurface);
+
+        return result;
+    }
 }
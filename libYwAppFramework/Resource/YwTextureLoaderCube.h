@@ -43,6 +43,9 @@ namespace yw
         // Release all loaded textures.
         void ReleaseAllLoadedTextures(class Yw3dTexture** textures, int32_t length);
 
+        // Copy a mip level of a loaded texture to a cube face, converts the format if needed.
+        bool CopyTextureMipLevel(class Yw3dTexture* srcTexture, class Yw3dTexture* destTexture, uint32_t mipLevel);
+
     private:
         // Should generate mipmap by default or not.
         bool m_GenerateMipmapByDefault;
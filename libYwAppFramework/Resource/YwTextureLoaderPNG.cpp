@@ -107,23 +107,21 @@ namespace yw
             png_set_gray_to_rgb(png_ptr);
         }
 
-        if (16 == png_get_bit_depth(png_ptr, info_ptr))
-        {
-            png_set_strip_16(png_ptr);
-        }
-
         png_read_update_info(png_ptr, info_ptr);
 
+        // 8-bit images are kept as unsigned normalized or sRGB bytes, 16-bit images are stored as half floats instead of being stripped to 8 bits.
         color_type = png_get_color_type(png_ptr, info_ptr);
         bool hasAlpha = (PNG_COLOR_TYPE_RGB_ALPHA == color_type);
-        Yw3dFormat textureFormat = hasAlpha ? Yw3d_FMT_R32G32B32A32F : Yw3d_FMT_R32G32B32F;
+        bool is16Bit = (16 == png_get_bit_depth(png_ptr, info_ptr));
+        uint32_t channels = hasAlpha ? 4 : 3;
+        Yw3dFormat textureFormat = is16Bit ? (hasAlpha ? Yw3d_FMT_R16G16B16A16F : Yw3d_FMT_R16G16B16F) : (hasAlpha ? (m_SRGB ? Yw3d_FMT_R8G8B8A8_SRGB : Yw3d_FMT_R8G8B8A8) : (m_SRGB ? Yw3d_FMT_R8G8B8_SRGB : Yw3d_FMT_R8G8B8));
 
         // Convert texture dynamic instance class.
         Yw3dTexture** inputTexture = (Yw3dTexture**)texture;
 
         // Create texture from device.
         YW_SAFE_RELEASE(*inputTexture);
-        if (YW3D_FAILED(device->CreateTexture(inputTexture, dimensionX, dimensionY, 0, textureFormat)))
+        if (YW3D_FAILED(device->CreateTexture(inputTexture, dimensionX, dimensionY, 0, textureFormat, Yw3d_SL_Tiled4x4)))
         {
             png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
             return false;
@@ -149,7 +147,7 @@ namespace yw
         png_destroy_read_struct(&png_ptr, &info_ptr, &end_info);
 
         // Lock texture data.
-        float* textureData = nullptr;
+        uint8_t* textureData = nullptr;
         Yw3dResult resLock = (*inputTexture)->LockRect(0, (void**)&textureData, nullptr);
         if (YW3D_FAILED(resLock))
         {
@@ -158,24 +156,23 @@ namespace yw
             return false;
         }
 
-        // Normalized color scale.
-        const float colorScale = 1.0f / 255.0f;
-
         // Fill data.
         uint8_t* srcTextureData = texDataRaw;
-        for (uint32_t yIdx = 0; yIdx < dimensionY; yIdx++)
+        if (is16Bit)
         {
-            for (uint32_t xIdx = 0; xIdx < dimensionX; xIdx++)
+            // Png samples are big endian, sRGB colors are decoded to linear here as half floats have no sRGB format.
+            const float colorScale = 1.0f / 65535.0f;
+            uint16_t* halfData = (uint16_t*)textureData;
+            for (uint32_t i = 0; i < dimensionX * dimensionY * channels; i++, srcTextureData += 2)
             {
-                (*textureData++) = (float)((*srcTextureData++) * colorScale);
-                (*textureData++) = (float)((*srcTextureData++) * colorScale);
-                (*textureData++) = (float)((*srcTextureData++) * colorScale);
-                if (hasAlpha)
-                {
-                    (*textureData++) = (float)((*srcTextureData++) * colorScale);
-                }
+                const float value = (float)((srcTextureData[0] << 8) | srcTextureData[1]) * colorScale;
+                (*halfData++) = EncodeHalf((m_SRGB && (i % channels < 3)) ? DecodeSRGB(value) : value);
             }
         }
+        else
+        {
+            memcpy(textureData, srcTextureData, dimensionX * dimensionY * channels);
+        }
         
         (*inputTexture)->UnlockRect(0);
 
@@ -185,6 +182,75 @@ namespace yw
         return true;
     }
 
+    bool TextureLoaderPNG::LoadInfo(const uint8_t* data, uint32_t dataLength, bool srgb, TextureLoadInfo& info)
+    {
+        if ((nullptr == data) || (dataLength < 8) || (0 != png_sig_cmp((png_const_bytep)data, 0, 8)))
+        {
+            return false;
+        }
+
+        // Create base structure.
+        png_structp png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+        if (nullptr == png_ptr)
+        {
+            return false;
+        }
+
+        png_infop info_ptr = png_create_info_struct(png_ptr);
+        if (nullptr == info_ptr)
+        {
+            png_destroy_read_struct(&png_ptr, (png_infopp)nullptr, (png_infopp)nullptr);
+            return false;
+        }
+
+        if (setjmp(png_jmpbuf(png_ptr)))
+        {
+            png_destroy_read_struct(&png_ptr, &info_ptr, (png_infopp)nullptr);
+            return false;
+        }
+
+        // Set png data wrapper.
+        PngDataWrapper dataWrapper;
+        dataWrapper.data = data;
+        dataWrapper.offset = 0;
+
+        // Only the header chunks are read, with the same transformations as LoadFromData() to get the same format.
+        png_set_read_fn(png_ptr, (png_voidp*)(&dataWrapper), png_read_data);
+        png_read_info(png_ptr, info_ptr);
+
+        int32_t color_type = png_get_color_type(png_ptr, info_ptr);
+        if ((PNG_COLOR_TYPE_PALETTE == color_type) && png_get_bit_depth(png_ptr, info_ptr) <= 8)
+        {
+            png_set_expand(png_ptr);
+        }
+
+        if ((PNG_COLOR_TYPE_GRAY == color_type) && png_get_bit_depth(png_ptr, info_ptr) < 8)
+        {
+            png_set_expand(png_ptr);
+        }
+
+        if ((PNG_COLOR_TYPE_GRAY == color_type) || (PNG_COLOR_TYPE_GRAY_ALPHA == color_type))
+        {
+            png_set_gray_to_rgb(png_ptr);
+        }
+
+        png_read_update_info(png_ptr, info_ptr);
+
+        color_type = png_get_color_type(png_ptr, info_ptr);
+        bool hasAlpha = (PNG_COLOR_TYPE_RGB_ALPHA == color_type);
+        bool is16Bit = (16 == png_get_bit_depth(png_ptr, info_ptr));
+
+        info.width = png_get_image_width(png_ptr, info_ptr);
+        info.height = png_get_image_height(png_ptr, info_ptr);
+        info.mipLevels = 0;
+        info.format = is16Bit ? (hasAlpha ? Yw3d_FMT_R16G16B16A16F : Yw3d_FMT_R16G16B16F) : (hasAlpha ? (srgb ? Yw3d_FMT_R8G8B8A8_SRGB : Yw3d_FMT_R8G8B8A8) : (srgb ? Yw3d_FMT_R8G8B8_SRGB : Yw3d_FMT_R8G8B8));
+        info.layout = Yw3d_SL_Tiled4x4;
+
+        png_destroy_read_struct(&png_ptr, &info_ptr, (png_infopp)nullptr);
+
+        return true;
+    }
+
     bool TextureLoaderPNG::GenerateMipmap(IYw3dBaseTexture* texture)
     {
         return GenerateTextureMipmap(texture);
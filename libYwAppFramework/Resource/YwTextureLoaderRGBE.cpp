@@ -50,13 +50,14 @@ namespace yw
 
         // Create texture from device.
         YW_SAFE_RELEASE(*inputTexture);
-        if (YW3D_FAILED(device->CreateTexture(inputTexture, texWidth, texHeight, 0, Yw3d_FMT_R32G32B32F)))
+        // Half floats hold the shared exponent range of common hdr images, larger values are clamped.
+        if (YW3D_FAILED(device->CreateTexture(inputTexture, texWidth, texHeight, 0, Yw3d_FMT_R16G16B16F)))
         {
             return false;
         }
 
         // Lock texture data.
-        float* textureData = nullptr;
+        uint16_t* textureData = nullptr;
         Yw3dResult resLock = (*inputTexture)->LockRect(0, (void**)&textureData, nullptr);
         if (YW3D_FAILED(resLock))
         {
@@ -76,11 +77,11 @@ namespace yw
                 int32_t texIndex = yIdx * texWidth + xIdx;
                 int32_t hdrIndex = yIdx * pitch + xIdx * bbp;
 
-                Vector3* texData = (Vector3*)textureData + texIndex;
+                uint16_t* texData = textureData + texIndex * bbp;
                 float* hdrData = srcTextureData + hdrIndex;
-                texData->r = (float)((*hdrData) * colorScale);
-                texData->g = (float)((*(hdrData + 1)) * colorScale);
-                texData->b = (float)((*(hdrData + 2)) * colorScale);
+                texData[0] = EncodeHalf(min((float)((*hdrData) * colorScale), YW3D_HALF_MAX));
+                texData[1] = EncodeHalf(min((float)((*(hdrData + 1)) * colorScale), YW3D_HALF_MAX));
+                texData[2] = EncodeHalf(min((float)((*(hdrData + 2)) * colorScale), YW3D_HALF_MAX));
             }
         }
 
@@ -32,20 +32,21 @@ namespace yw
         bool hasAlpha = (alphaBits > 0);
         int32_t bbp = 4;
         int32_t pitch = bbp * texWidth;
-        Yw3dFormat textureFormat = hasAlpha ? Yw3d_FMT_R32G32B32A32F : Yw3d_FMT_R32G32B32F;
+        Yw3dFormat textureFormat = hasAlpha ? (m_SRGB ? Yw3d_FMT_R8G8B8A8_SRGB : Yw3d_FMT_R8G8B8A8) : (m_SRGB ? Yw3d_FMT_R8G8B8_SRGB : Yw3d_FMT_R8G8B8);
+        int32_t textureBbp = hasAlpha ? 4 : 3;
 
         // Convert texture dynamic instance class.
         Yw3dTexture** inputTexture = (Yw3dTexture**)texture;
 
         // Create texture from device.
         YW_SAFE_RELEASE(*inputTexture);
-        if (YW3D_FAILED(device->CreateTexture(inputTexture, texWidth, texHeight, 0, textureFormat)))
+        if (YW3D_FAILED(device->CreateTexture(inputTexture, texWidth, texHeight, 0, textureFormat, Yw3d_SL_Tiled4x4)))
         {
             return false;
         }
 
-        // Lock texture data.
-        float* textureData = nullptr;
+        // Lock texture data, the bytes are kept as they are.
+        uint8_t* textureData = nullptr;
         Yw3dResult resLock = (*inputTexture)->LockRect(0, (void**)&textureData, nullptr);
         if (YW3D_FAILED(resLock))
         {
@@ -53,9 +54,6 @@ namespace yw
             return false;
         }
 
-        // Normalized color scale.
-        const float colorScale = 1.0f / 255.0f;
-
         // Fill data.
         // Tga file line is from bottom to top.
         uint8_t* srcTextureData = texDataRaw;
@@ -66,23 +64,7 @@ namespace yw
                 int32_t texIndex = (texHeight - 1 - yIdx) * texWidth + xIdx;
                 int32_t tgaIndex = yIdx * pitch + xIdx * bbp;
 
-                if (hasAlpha)
-                {
-                    Vector4* texData = (Vector4*)textureData + texIndex;
-                    uint8_t* tgaData = (uint8_t*)(srcTextureData + tgaIndex);
-                    texData->r = (float)((*tgaData) * colorScale);
-                    texData->g = (float)((*(tgaData + 1)) * colorScale);
-                    texData->b = (float)((*(tgaData + 2)) * colorScale);
-                    texData->a = (float)((*(tgaData + 3)) * colorScale);
-                }
-                else
-                {
-                    Vector3* texData = (Vector3*)textureData + texIndex;
-                    uint8_t* tgaData = (uint8_t*)(srcTextureData + tgaIndex);
-                    texData->r = (float)((*tgaData) * colorScale);
-                    texData->g = (float)((*(tgaData + 1)) * colorScale);
-                    texData->b = (float)((*(tgaData + 2)) * colorScale);
-                }
+                memcpy(textureData + texIndex * textureBbp, srcTextureData + tgaIndex, textureBbp);
             }
         }
 
@@ -96,6 +78,29 @@ namespace yw
         return true;
     }
 
+    bool TextureLoaderTGA::LoadInfo(const uint8_t* data, uint32_t dataLength, bool srgb, TextureLoadInfo& info)
+    {
+        // Tga file header is 18 bytes, the dimensions are little endian.
+        if ((nullptr == data) || (dataLength < 18))
+        {
+            return false;
+        }
+
+        info.width = data[12] | (data[13] << 8);
+        info.height = data[14] | (data[15] << 8);
+        if ((0 == info.width) || (0 == info.height))
+        {
+            return false;
+        }
+
+        bool hasAlpha = ((data[17] & 0x0f) > 0);
+        info.mipLevels = 0;
+        info.format = hasAlpha ? (srgb ? Yw3d_FMT_R8G8B8A8_SRGB : Yw3d_FMT_R8G8B8A8) : (srgb ? Yw3d_FMT_R8G8B8_SRGB : Yw3d_FMT_R8G8B8);
+        info.layout = Yw3d_SL_Tiled4x4;
+
+        return true;
+    }
+
     bool TextureLoaderTGA::GenerateMipmap(IYw3dBaseTexture* texture)
     {
         return GenerateTextureMipmap(texture);
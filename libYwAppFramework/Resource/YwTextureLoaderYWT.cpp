@@ -3,10 +3,52 @@
 
 #include "YwTextureLoaderYWT.h"
 #include "Yw3d.h"
+#include "YwFileIO.h"
 #include "ywt.h"
 
 namespace yw
 {
+    // Texture formats of the version 2 file format tags.
+    static const struct
+    {
+        YwTextureFormatTag tag;
+        Yw3dFormat format;
+    } s_YWT2Formats[] =
+    {
+        {YWT_FORMAT_R32F, Yw3d_FMT_R32F},
+        {YWT_FORMAT_R32G32F, Yw3d_FMT_R32G32F},
+        {YWT_FORMAT_R32G32B32F, Yw3d_FMT_R32G32B32F},
+        {YWT_FORMAT_R32G32B32A32F, Yw3d_FMT_R32G32B32A32F},
+        {YWT_FORMAT_R8, Yw3d_FMT_R8},
+        {YWT_FORMAT_R8G8, Yw3d_FMT_R8G8},
+        {YWT_FORMAT_R8G8B8, Yw3d_FMT_R8G8B8},
+        {YWT_FORMAT_R8G8B8A8, Yw3d_FMT_R8G8B8A8},
+        {YWT_FORMAT_R16F, Yw3d_FMT_R16F},
+        {YWT_FORMAT_R16G16F, Yw3d_FMT_R16G16F},
+        {YWT_FORMAT_R16G16B16F, Yw3d_FMT_R16G16B16F},
+        {YWT_FORMAT_R16G16B16A16F, Yw3d_FMT_R16G16B16A16F},
+        {YWT_FORMAT_R8G8B8_SRGB, Yw3d_FMT_R8G8B8_SRGB},
+        {YWT_FORMAT_R8G8B8A8_SRGB, Yw3d_FMT_R8G8B8A8_SRGB},
+        {YWT_FORMAT_BC1, Yw3d_FMT_BC1},
+        {YWT_FORMAT_BC3, Yw3d_FMT_BC3},
+        {YWT_FORMAT_BC5, Yw3d_FMT_BC5},
+        {YWT_FORMAT_BC6H, Yw3d_FMT_BC6H},
+    };
+
+    // Returns the texture layout of a version 2 file layout tag, Yw3d_SL_NumSurfaceLayouts if the tag is unknown.
+    static Yw3dSurfaceLayout GetLayoutFromTag(uint32_t layoutTag)
+    {
+        switch (layoutTag)
+        {
+        case YWT_LAYOUT_LINEAR:
+            return Yw3d_SL_Linear;
+        case YWT_LAYOUT_TILED4X4:
+            return Yw3d_SL_Tiled4x4;
+        default:
+            return Yw3d_SL_NumSurfaceLayouts;
+        }
+    }
+
     // ------------------------------------------------------------------
     // For texture loader.
 
@@ -21,8 +63,39 @@ namespace yw
 
     }
 
+    bool TextureLoaderYWT::LoadFromFile(const StringA& fileName, Yw3dDevice* device, IYw3dBaseTexture** texture)
+    {
+        // Map the file, pages are only read when the mip-levels are accessed.
+        FileIO file;
+        MappedFile* mappedFile = file.MapFile(fileName);
+        if (nullptr == mappedFile)
+        {
+            return false;
+        }
+
+        // Version 2 mip-levels keep the mapped file alive, version 1 files are loaded from the mapped data.
+        bool res = false;
+        if (IsYwTexture2DataValid(mappedFile->GetData(), mappedFile->GetSize()))
+        {
+            res = LoadFromYWT2Data(mappedFile->GetData(), device, texture, mappedFile);
+        }
+        else if (mappedFile->GetSize() <= 0xffffffff)
+        {
+            res = LoadFromData(fileName, mappedFile->GetData(), (uint32_t)mappedFile->GetSize(), device, texture);
+        }
+
+        YW_SAFE_RELEASE(mappedFile);
+        return res;
+    }
+
     bool TextureLoaderYWT::LoadFromData(const StringA& fileName, const uint8_t* data, uint32_t dataLength, Yw3dDevice* device, IYw3dBaseTexture** texture)
     {
+        // Version 2 data of a file already read is copied.
+        if (IsYwTexture2DataValid(data, dataLength))
+        {
+            return LoadFromYWT2Data((uint8_t*)data, device, texture, nullptr);
+        }
+
         // Read raw data to internal format.
         YwTextureData textureData;
         if (!LoadYwTextureFromData(data, dataLength, textureData))
@@ -86,9 +159,110 @@ namespace yw
         return true;
     }
 
+    bool TextureLoaderYWT::LoadFromYWT2Data(uint8_t* data, Yw3dDevice* device, IYw3dBaseTexture** texture, IBase* dataOwner)
+    {
+        const YwTexture2FileHeader* header = (const YwTexture2FileHeader*)data;
+        Yw3dFormat textureFormat = GetFormatFromTag(header->formatTag);
+        Yw3dSurfaceLayout textureLayout = GetLayoutFromTag(header->layoutTag);
+        if ((Yw3d_FMT_NumFormats == textureFormat) || (Yw3d_SL_NumSurfaceLayouts == textureLayout))
+        {
+            LOGE(_T("TextureLoaderYWT.LoadFromYWT2Data: Unknown format or layout."));
+            return false;
+        }
+
+        // Find the payloads of the mip-levels through the table of contents.
+        const YwTexture2MipEntry* mipEntries = GetYwTexture2MipEntries(data);
+        std::vector<void*> mipLevelsData(header->mipsCount);
+        std::vector<size_t> mipLevelsDataSize(header->mipsCount);
+        for (uint32_t i = 0; i < header->mipsCount; i++)
+        {
+            mipLevelsData[i] = data + mipEntries[i].dataOffset;
+            mipLevelsDataSize[i] = (size_t)mipEntries[i].dataSize;
+        }
+
+        // Create texture from device, the mip-levels are used in place if the data has an owner.
+        Yw3dTexture** inputTexture = (Yw3dTexture**)texture;
+        YW_SAFE_RELEASE(*inputTexture);
+        if (YW3D_FAILED(device->CreateTextureFromMemory(inputTexture, header->width, header->height, header->mipsCount, textureFormat, textureLayout, mipLevelsData.data(), mipLevelsDataSize.data(), dataOwner)))
+        {
+            LOGE(_T("TextureLoaderYWT.LoadFromYWT2Data: Mip level data are not match."));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool TextureLoaderYWT::LoadInfo(const uint8_t* data, uint32_t dataLength, bool /*srgb*/, TextureLoadInfo& info)
+    {
+        // The format is stored in the file, like LoadFromData() it is not changed for srgb.
+        if (IsYwTexture2DataValid(data, dataLength))
+        {
+            const YwTexture2FileHeader* header2 = (const YwTexture2FileHeader*)data;
+            info.width = header2->width;
+            info.height = header2->height;
+            info.mipLevels = header2->mipsCount;
+            info.format = GetFormatFromTag(header2->formatTag);
+            info.layout = GetLayoutFromTag(header2->layoutTag);
+
+            return (Yw3d_FMT_NumFormats != info.format) && (Yw3d_SL_NumSurfaceLayouts != info.layout);
+        }
+
+        if ((nullptr == data) || (dataLength < sizeof(YwTextureFileHeader)))
+        {
+            return false;
+        }
+
+        const YwTextureFileHeader* header = (const YwTextureFileHeader*)data;
+        if ((YWT_FILE_MAGIC != header->fileType) || (0 == header->width) || (0 == header->height) || (0 == header->mipsCount))
+        {
+            return false;
+        }
+
+        Yw3dFormat textureFormat = (Yw3dFormat)header->format;
+        if ((textureFormat < Yw3d_FMT_R32F) || (textureFormat > Yw3d_FMT_R32G32B32A32F))
+        {
+            return false;
+        }
+
+        // The mip-levels are stored in the file.
+        info.width = header->width;
+        info.height = header->height;
+        info.mipLevels = header->mipsCount;
+        info.format = textureFormat;
+        info.layout = Yw3d_SL_Linear;
+
+        return true;
+    }
+
     bool TextureLoaderYWT::GenerateMipmap(IYw3dBaseTexture* texture)
     {
         // Raw texture data has already got mipmap data, we do not need to generate it runtime anymore.
         return true;
     }
+
+    Yw3dFormat TextureLoaderYWT::GetFormatFromTag(uint32_t formatTag)
+    {
+        for (uint32_t i = 0; i < sizeof(s_YWT2Formats) / sizeof(s_YWT2Formats[0]); i++)
+        {
+            if (formatTag == (uint32_t)s_YWT2Formats[i].tag)
+            {
+                return s_YWT2Formats[i].format;
+            }
+        }
+
+        return Yw3d_FMT_NumFormats;
+    }
+
+    uint32_t TextureLoaderYWT::GetTagFromFormat(Yw3dFormat format)
+    {
+        for (uint32_t i = 0; i < sizeof(s_YWT2Formats) / sizeof(s_YWT2Formats[0]); i++)
+        {
+            if (format == s_YWT2Formats[i].format)
+            {
+                return s_YWT2Formats[i].tag;
+            }
+        }
+
+        return YWT_FORMAT_UNKNOWN;
+    }
 }
@@ -8,6 +8,7 @@
 
 namespace yw
 {
+    // Loads version 1 files and memory mapped version 2 files, whose mip-levels are used in place by the texture without copying.
     class TextureLoaderYWT : public ITextureLoader
     {
     public:
@@ -17,7 +18,29 @@ namespace yw
         // Destructor.
         ~TextureLoaderYWT();
 
+        // Read the dimensions and format of the texture the file data is loaded into, without decoding the pixels.
+        // @param[in] data raw file data.
+        // @param[in] dataLength length in bytes of data.
+        // @param[in] srgb true if the texture holds sRGB encoded colors.
+        // @param[out] info receives the description of the texture.
+        // @return true if the description was read, false if the data is invalid.
+        virtual bool LoadInfo(const uint8_t* data, uint32_t dataLength, bool srgb, TextureLoadInfo& info);
+
+        // Returns the texture format of a version 2 file format tag, Yw3d_FMT_NumFormats if the tag is unknown.
+        // @param[in] formatTag member of the enumeration YwTextureFormatTag.
+        static Yw3dFormat GetFormatFromTag(uint32_t formatTag);
+
+        // Returns the version 2 file format tag of a texture format, YWT_FORMAT_UNKNOWN if the format cannot be saved.
+        // @param[in] format member of the enumeration Yw3dFormat.
+        static uint32_t GetTagFromFormat(Yw3dFormat format);
+
     private:
+        // Load texture from a file, version 2 files are mapped and their mip-levels are used in place.
+        // @param[in] fileName the full path of the texture file.
+        // @param[in] device used to create texture.
+        // @param[out] texture the loaded data to fill.
+        virtual bool LoadFromFile(const StringA& fileName, class Yw3dDevice* device, class IYw3dBaseTexture** texture);
+
         // Load texture from kinds of data.
         // @param[in] fileName the full path of the texture file.
         // @param[in] data raw file data.
@@ -29,6 +52,13 @@ namespace yw
         // Generate mipmap for texture.
         // @param[out] texture the loaded data to fill.
         virtual bool GenerateMipmap(class IYw3dBaseTexture* texture);
+
+        // Load texture from version 2 file data.
+        // @param[in] data raw file data, only read if dataOwner is null. Must be checked by IsYwTexture2DataValid() before.
+        // @param[in] device used to create texture.
+        // @param[out] texture the loaded data to fill.
+        // @param[in] dataOwner object keeping data alive if the mip-levels use it in place, null to copy the mip-levels.
+        bool LoadFromYWT2Data(uint8_t* data, class Yw3dDevice* device, class IYw3dBaseTexture** texture, class IBase* dataOwner);
     };
 }
 
@@ -129,3 +129,160 @@ uint32_t GetYwTextureSaveDataSize(const YwTextureData& textureData)
     dataSize += sizeof(YwTextureFileMipmapHeader);
     return dataSize;
 }
+
+bool IsYwVirtualTextureHeaderValid(const YwVirtualTextureFileHeader& header)
+{
+    if ((YWVT_FILE_MAGIC != header.fileType) || (0 == header.width) || (0 == header.height) || (0 == header.mipsCount))
+    {
+        return false;
+    }
+
+    if ((0 == header.pageSize) || (0 != (header.pageSize & (header.pageSize - 1))) || (0 == header.pageDataSize))
+    {
+        return false;
+    }
+
+    // Every mip level has to be at least 1 pixel.
+    return ((header.width >> (header.mipsCount - 1)) > 0) && ((header.height >> (header.mipsCount - 1)) > 0);
+}
+
+uint32_t GetYwVirtualTexturePagesX(const YwVirtualTextureFileHeader& header, uint32_t mipLevel)
+{
+    return ((header.width >> mipLevel) + header.pageSize - 1) / header.pageSize;
+}
+
+uint32_t GetYwVirtualTexturePagesY(const YwVirtualTextureFileHeader& header, uint32_t mipLevel)
+{
+    return ((header.height >> mipLevel) + header.pageSize - 1) / header.pageSize;
+}
+
+uint32_t GetYwVirtualTexturePageCount(const YwVirtualTextureFileHeader& header)
+{
+    uint32_t pageCount = 0;
+    for (uint32_t i = 0; i < header.mipsCount; i++)
+    {
+        pageCount += GetYwVirtualTexturePagesX(header, i) * GetYwVirtualTexturePagesY(header, i);
+    }
+
+    return pageCount;
+}
+
+uint64_t GetYwVirtualTexturePageOffset(const YwVirtualTextureFileHeader& header, uint32_t mipLevel, uint32_t pageX, uint32_t pageY)
+{
+    uint64_t pageIndex = 0;
+    for (uint32_t i = 0; i < mipLevel; i++)
+    {
+        pageIndex += GetYwVirtualTexturePagesX(header, i) * GetYwVirtualTexturePagesY(header, i);
+    }
+
+    pageIndex += pageY * GetYwVirtualTexturePagesX(header, mipLevel) + pageX;
+    return sizeof(YwVirtualTextureFileHeader) + pageIndex * header.pageDataSize;
+}
+
+// Returns the offset aligned for a mip level payload.
+static uint64_t AlignYwTexture2Offset(uint64_t offset)
+{
+    return (offset + YWT2_PAYLOAD_ALIGNMENT - 1) & ~(uint64_t)(YWT2_PAYLOAD_ALIGNMENT - 1);
+}
+
+bool IsYwTexture2DataValid(const uint8_t* data, const uint64_t dataLength)
+{
+    if ((nullptr == data) || (dataLength < sizeof(YwTexture2FileHeader)))
+    {
+        return false;
+    }
+
+    const YwTexture2FileHeader* fileHeader = (const YwTexture2FileHeader*)data;
+    if ((YWT2_FILE_MAGIC != fileHeader->fileType) || (0 == fileHeader->width) || (0 == fileHeader->height) || (0 == fileHeader->mipsCount) || (fileHeader->mipsCount > 32))
+    {
+        return false;
+    }
+
+    // Table of contents has to be inside the file.
+    if ((fileHeader->tocOffset < sizeof(YwTexture2FileHeader)) || (fileHeader->tocOffset > dataLength) || 
+        ((dataLength - fileHeader->tocOffset) / sizeof(YwTexture2MipEntry) < fileHeader->mipsCount))
+    {
+        return false;
+    }
+
+    // Mip levels halve the dimensions and their payloads have to be aligned and inside the file.
+    const YwTexture2MipEntry* mipEntries = GetYwTexture2MipEntries(data);
+    for (uint32_t i = 0; i < fileHeader->mipsCount; i++)
+    {
+        const YwTexture2MipEntry& mipEntry = mipEntries[i];
+        if ((mipEntry.mipWidth != (fileHeader->width >> i)) || (mipEntry.mipHeight != (fileHeader->height >> i)) || (0 == mipEntry.mipWidth) || (0 == mipEntry.mipHeight))
+        {
+            return false;
+        }
+
+        if ((0 != (mipEntry.dataOffset % YWT2_PAYLOAD_ALIGNMENT)) || (0 == mipEntry.dataSize) || 
+            (mipEntry.dataOffset > dataLength) || (mipEntry.dataSize > dataLength - mipEntry.dataOffset))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const YwTexture2MipEntry* GetYwTexture2MipEntries(const uint8_t* data)
+{
+    const YwTexture2FileHeader* fileHeader = (const YwTexture2FileHeader*)data;
+    return (const YwTexture2MipEntry*)(data + fileHeader->tocOffset);
+}
+
+bool SaveYwTexture2ToData(const YwTexture2Data& textureData, uint8_t* data, uint64_t dataSize)
+{
+    if ((nullptr == data) || (0 == dataSize))
+    {
+        return false;
+    }
+
+    const uint64_t saveDataSize = GetYwTexture2SaveDataSize(textureData);
+    if (saveDataSize != dataSize)
+    {
+        return false;
+    }
+
+    // Padding between payloads is zero.
+    memset(data, 0, (size_t)dataSize);
+
+    // Save texture header, the table of contents follows it.
+    YwTexture2FileHeader* header = (YwTexture2FileHeader*)data;
+    header->fileType = YWT2_FILE_MAGIC;
+    header->width = textureData.width;
+    header->height = textureData.height;
+    header->formatTag = textureData.formatTag;
+    header->layoutTag = textureData.layoutTag;
+    header->mipsCount = (uint32_t)textureData.mipsData.size();
+    header->tocOffset = sizeof(YwTexture2FileHeader);
+
+    // Save the table of contents and the aligned payloads of all mips.
+    YwTexture2MipEntry* mipEntries = (YwTexture2MipEntry*)(data + header->tocOffset);
+    uint64_t dataOffset = AlignYwTexture2Offset(header->tocOffset + sizeof(YwTexture2MipEntry) * header->mipsCount);
+    for (uint32_t i = 0; i < header->mipsCount; i++)
+    {
+        const YwTextureMipData& textureMipData = textureData.mipsData[i];
+        YwTexture2MipEntry& mipEntry = mipEntries[i];
+        mipEntry.mipWidth = textureMipData.mipWidth;
+        mipEntry.mipHeight = textureMipData.mipHeight;
+        mipEntry.dataOffset = dataOffset;
+        mipEntry.dataSize = textureMipData.mipData.size();
+
+        memcpy(data + dataOffset, textureMipData.mipData.data(), textureMipData.mipData.size());
+        dataOffset = AlignYwTexture2Offset(dataOffset + mipEntry.dataSize);
+    }
+
+    return true;
+}
+
+uint64_t GetYwTexture2SaveDataSize(const YwTexture2Data& textureData)
+{
+    uint64_t dataSize = AlignYwTexture2Offset(sizeof(YwTexture2FileHeader) + sizeof(YwTexture2MipEntry) * textureData.mipsData.size());
+    for (size_t i = 0; i < textureData.mipsData.size(); i++)
+    {
+        dataSize = AlignYwTexture2Offset(dataSize + textureData.mipsData[i].mipData.size());
+    }
+
+    return dataSize;
+}
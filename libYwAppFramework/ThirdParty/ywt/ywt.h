@@ -67,4 +67,123 @@ bool LoadYwTextureFromData(const uint8_t* data, const uint32_t dataLength, YwTex
 bool SaveYwTextureToData(const YwTextureData& textureData, uint8_t* data, uint32_t dataSize);
 uint32_t GetYwTextureSaveDataSize(const YwTextureData& textureData);
 
+// ------------------------------------------------------------------
+// Paged virtual texture file, streamed page by page.
+// The header is followed by the pages of all mip levels, from mip level 0 to the last one, each level row by row.
+// Every page has pageSize * pageSize pixels, pixels of border pages outside the mip level are zero.
+
+// Paged file magic number.
+const uint32_t YWVT_FILE_MAGIC = ('Y' << 24) | ('W' << 16) | ('V' << 8) | 'T';
+
+// YWTexture paged file header.
+#pragma pack(push, 1)
+struct YwVirtualTextureFileHeader
+{
+    uint32_t fileType; // File type, magic number.
+    uint32_t width; // The width of the texture.
+    uint32_t height; // The height of the texture.
+    int8_t format; // The pixel format of the texture.
+    uint8_t mipsCount; // How many mips count of this texture.
+    uint32_t pageSize; // The width and height of a page, a power of two.
+    uint32_t pageDataSize; // The size, in bytes, of a page.
+};
+#pragma pack(pop)
+
+bool IsYwVirtualTextureHeaderValid(const YwVirtualTextureFileHeader& header);
+uint32_t GetYwVirtualTexturePagesX(const YwVirtualTextureFileHeader& header, uint32_t mipLevel);
+uint32_t GetYwVirtualTexturePagesY(const YwVirtualTextureFileHeader& header, uint32_t mipLevel);
+uint32_t GetYwVirtualTexturePageCount(const YwVirtualTextureFileHeader& header);
+uint64_t GetYwVirtualTexturePageOffset(const YwVirtualTextureFileHeader& header, uint32_t mipLevel, uint32_t pageX, uint32_t pageY);
+
+// ------------------------------------------------------------------
+// Version 2 texture file, made to be memory mapped and used in place.
+// The header is followed by a table of contents with an entry for each mip level, so any mip level is found without parsing the others.
+// Mip level payloads start at multiples of YWT2_PAYLOAD_ALIGNMENT bytes from the beginning of the file and hold the pixels in the final memory layout
+// of the renderer, including the padding of tiles and compressed blocks, so a mapped file is sampled without copying or converting the pixels.
+
+// Version 2 file magic number.
+const uint32_t YWT2_FILE_MAGIC = ('Y' << 24) | ('W' << 16) | ('T' << 8) | '2';
+
+// Alignment of mip level payloads in bytes.
+const uint32_t YWT2_PAYLOAD_ALIGNMENT = 64;
+
+// Pixel formats of version 2 files, the values are stored in files and never change.
+enum YwTextureFormatTag
+{
+    YWT_FORMAT_UNKNOWN = 0,
+
+    // 32-bit float channels.
+    YWT_FORMAT_R32F = 1,
+    YWT_FORMAT_R32G32F = 2,
+    YWT_FORMAT_R32G32B32F = 3,
+    YWT_FORMAT_R32G32B32A32F = 4,
+
+    // Compact formats, 8-bit unsigned normalized, 16-bit float and sRGB encoded channels.
+    YWT_FORMAT_R8 = 16,
+    YWT_FORMAT_R8G8 = 17,
+    YWT_FORMAT_R8G8B8 = 18,
+    YWT_FORMAT_R8G8B8A8 = 19,
+    YWT_FORMAT_R16F = 20,
+    YWT_FORMAT_R16G16F = 21,
+    YWT_FORMAT_R16G16B16F = 22,
+    YWT_FORMAT_R16G16B16A16F = 23,
+    YWT_FORMAT_R8G8B8_SRGB = 24,
+    YWT_FORMAT_R8G8B8A8_SRGB = 25,
+
+    // Block compressed formats, stored as 4x4 blocks row by row.
+    YWT_FORMAT_BC1 = 32,
+    YWT_FORMAT_BC3 = 33,
+    YWT_FORMAT_BC5 = 34,
+    YWT_FORMAT_BC6H = 35,
+};
+
+// Memory layouts of version 2 files, the values are stored in files and never change.
+enum YwTextureLayoutTag
+{
+    YWT_LAYOUT_LINEAR = 0, // Pixels row by row.
+    YWT_LAYOUT_TILED4X4 = 1, // 4x4 tiles row by row, pixels of a tile row by row.
+};
+
+// YWTexture version 2 file header.
+#pragma pack(push, 1)
+struct YwTexture2FileHeader
+{
+    uint32_t fileType; // File type, magic number.
+    uint32_t width; // The width of the texture.
+    uint32_t height; // The height of the texture.
+    uint16_t formatTag; // The pixel format of the texture, member of YwTextureFormatTag.
+    uint16_t layoutTag; // The memory layout of the mip levels, member of YwTextureLayoutTag.
+    uint32_t mipsCount; // How many mips count of this texture.
+    uint64_t tocOffset; // Offset of the table of contents from the beginning of the file.
+};
+#pragma pack(pop)
+
+// YWTexture version 2 table of contents entry of a mip level.
+#pragma pack(push, 1)
+struct YwTexture2MipEntry
+{
+    uint32_t mipWidth; // The width of this mip level.
+    uint32_t mipHeight; // The height of this mip level.
+    uint64_t dataOffset; // Offset of the payload from the beginning of the file, a multiple of YWT2_PAYLOAD_ALIGNMENT.
+    uint64_t dataSize; // The size, in bytes, of the payload.
+};
+#pragma pack(pop)
+
+// Texture data to be saved as version 2 file, the mip data is in the memory layout of the renderer.
+struct YwTexture2Data
+{
+    uint32_t width;
+    uint32_t height;
+    uint16_t formatTag;
+    uint16_t layoutTag;
+    std::vector<YwTextureMipData> mipsData;
+
+    YwTexture2Data(): width(0), height(0), formatTag(YWT_FORMAT_UNKNOWN), layoutTag(YWT_LAYOUT_LINEAR) {}
+};
+
+bool IsYwTexture2DataValid(const uint8_t* data, const uint64_t dataLength);
+const YwTexture2MipEntry* GetYwTexture2MipEntries(const uint8_t* data);
+bool SaveYwTexture2ToData(const YwTexture2Data& textureData, uint8_t* data, uint64_t dataSize);
+uint64_t GetYwTexture2SaveDataSize(const YwTexture2Data& textureData);
+
 #endif // !__YW_T_H__
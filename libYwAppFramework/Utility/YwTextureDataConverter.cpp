@@ -9,9 +9,30 @@
 #include "ywt.h"
 #include "YwFileIO.h"
 #include "YwPaths.h"
+#include "YwTextureLoaderYWT.h"
 
 namespace yw
 {
+    // Encodes each mip-level of a texture to the mip-level of a block compressed texture of the same size.
+    static bool CompressTextureMipLevels(Yw3dTexture* texture, Yw3dTexture* compressedTexture)
+    {
+        for (uint32_t i = 0; i < texture->GetMipLevels(); i++)
+        {
+            Yw3dSurface* srcMipLevel = texture->AcquireMipLevel(i);
+            Yw3dSurface* destMipLevel = compressedTexture->AcquireMipLevel(i);
+            const Yw3dResult resCopy = ((nullptr != srcMipLevel) && (nullptr != destMipLevel)) ? srcMipLevel->CopyToSurface(nullptr, destMipLevel, nullptr, Yw3d_TF_Point) : Yw3d_E_InvalidParameters;
+            YW_SAFE_RELEASE(destMipLevel);
+            YW_SAFE_RELEASE(srcMipLevel);
+
+            if (YW3D_FAILED(resCopy))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool YwTextureDataConverter::TextureDataLinearToGamma(Yw3dTexture* texture)
     {
         return TextureDataGammaCollect(texture, 1.0f / 2.2f);
@@ -34,7 +55,7 @@ namespace yw
 
     bool YwTextureDataConverter::TextureDataGammaCollect(Yw3dTexture* texture, const float gammaPower)
     {
-        if (nullptr == texture)
+        if ((nullptr == texture) || (0 == texture->GetFormatFloats()))
         {
             return false;
         }
@@ -108,9 +129,80 @@ namespace yw
         return true;
     }
 
+    bool YwTextureDataConverter::TextureDataCompress(Yw3dTexture* texture, Yw3dFormat format, Yw3dTexture** compressedTexture)
+    {
+        if ((nullptr == texture) || !IsBlockCompressedFormat(format) || (nullptr == compressedTexture))
+        {
+            return false;
+        }
+
+        Yw3dDevice* device = texture->AcquireDevice();
+        if (nullptr == device)
+        {
+            return false;
+        }
+
+        // Create texture from device, mip-levels are taken over from the source.
+        YW_SAFE_RELEASE(*compressedTexture);
+        const Yw3dResult resCreate = device->CreateTexture(compressedTexture, texture->GetWidth(), texture->GetHeight(), texture->GetMipLevels(), format);
+        YW_SAFE_RELEASE(device);
+        if (YW3D_FAILED(resCreate))
+        {
+            return false;
+        }
+
+        if (!CompressTextureMipLevels(texture, *compressedTexture))
+        {
+            YW_SAFE_RELEASE(*compressedTexture);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool YwTextureDataConverter::CubeTextureDataCompress(Yw3dCubeTexture* texture, Yw3dFormat format, Yw3dCubeTexture** compressedTexture)
+    {
+        if ((nullptr == texture) || !IsBlockCompressedFormat(format) || (nullptr == compressedTexture))
+        {
+            return false;
+        }
+
+        Yw3dDevice* device = texture->AcquireDevice();
+        if (nullptr == device)
+        {
+            return false;
+        }
+
+        // Create cube texture from device, mip-levels are taken over from the source.
+        YW_SAFE_RELEASE(*compressedTexture);
+        const Yw3dResult resCreate = device->CreateCubeTexture(compressedTexture, texture->GetEdgeLength(), texture->GetMipLevels(), format);
+        YW_SAFE_RELEASE(device);
+        if (YW3D_FAILED(resCreate))
+        {
+            return false;
+        }
+
+        for (int32_t i = 0; i < (int32_t)Yw3d_CF_NumCubeFaces; i++)
+        {
+            Yw3dTexture* cubeFaceTexture = texture->AcquireCubeFace((Yw3dCubeFaces)i);
+            Yw3dTexture* compressedFaceTexture = (*compressedTexture)->AcquireCubeFace((Yw3dCubeFaces)i);
+            const bool resCompress = (nullptr != cubeFaceTexture) && (nullptr != compressedFaceTexture) && CompressTextureMipLevels(cubeFaceTexture, compressedFaceTexture);
+            YW_SAFE_RELEASE(compressedFaceTexture);
+            YW_SAFE_RELEASE(cubeFaceTexture);
+
+            if (!resCompress)
+            {
+                YW_SAFE_RELEASE(*compressedTexture);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool YwTextureDataConverter::TextureDataToBMP(Yw3dTexture* texture, TextureConvertResult& results, bool withMipmap)
     {
-        if (nullptr == texture)
+        if ((nullptr == texture) || (0 == texture->GetFormatFloats()))
         {
             return false;
         }
@@ -208,7 +300,7 @@ namespace yw
 
     bool YwTextureDataConverter::TextureDataToRGBE(Yw3dTexture* texture, TextureConvertResult& results, bool withMipmap)
     {
-        if (nullptr == texture)
+        if ((nullptr == texture) || (0 == texture->GetFormatFloats()))
         {
             return false;
         }
@@ -276,47 +368,55 @@ namespace yw
             return false;
         }
 
-        YwTextureData saveTextureData;
+        // Saved as version 2 file, which keeps the format and memory layout of the texture so the file can be mapped and used in place.
+        YwTexture2Data saveTextureData;
         saveTextureData.width = texture->GetWidth();
         saveTextureData.height = texture->GetHeight();
-        saveTextureData.format = texture->GetFormat();
+        saveTextureData.formatTag = (uint16_t)TextureLoaderYWT::GetTagFromFormat(texture->GetFormat());
+        if (YWT_FORMAT_UNKNOWN == saveTextureData.formatTag)
+        {
+            return false;
+        }
 
-        uint8_t textureMipLevels = (uint8_t)texture->GetMipLevels();
-        for (uint8_t i = 0; i < textureMipLevels; i++)
+        uint32_t textureMipLevels = texture->GetMipLevels();
+        for (uint32_t i = 0; i < textureMipLevels; i++)
         {
-            float* textureData = nullptr;
-            Yw3dResult resLock = texture->LockRect(i, (void**)&textureData, nullptr);
-            if (YW3D_FAILED(resLock))
+            Yw3dSurface* mipLevel = texture->AcquireMipLevel(i);
+            if (nullptr == mipLevel)
             {
                 return false;
             }
 
+            saveTextureData.layoutTag = (Yw3d_SL_Tiled4x4 == mipLevel->GetLayout()) ? YWT_LAYOUT_TILED4X4 : YWT_LAYOUT_LINEAR;
+
+            // Copy the pixels in the memory layout of the mip-level, including padding.
+            const uint8_t* mipStorage = (const uint8_t*)mipLevel->GetStorage();
+            if (nullptr == mipStorage)
+            {
+                YW_SAFE_RELEASE(mipLevel);
+                return false;
+            }
+
             saveTextureData.mipsData.push_back(YwTextureMipData());
             YwTextureMipData& saveTextureMipData = saveTextureData.mipsData[i];
 
             saveTextureMipData.mipLevel = i;
             saveTextureMipData.mipWidth = texture->GetWidth(i);
             saveTextureMipData.mipHeight = texture->GetHeight(i);
+            saveTextureMipData.mipData.assign(mipStorage, mipStorage + mipLevel->GetStorageSize());
 
-            uint32_t mipDataSize = saveTextureMipData.mipWidth * saveTextureMipData.mipHeight * texture->GetFormatFloats() * sizeof(float);
-            saveTextureMipData.mipData.resize(mipDataSize);
-
-            // Copy mip texture data.
-            memcpy(saveTextureMipData.mipData.data(), textureData, mipDataSize);
-
-            // Unlock texture.
-            texture->UnlockRect(i);
+            YW_SAFE_RELEASE(mipLevel);
         }
 
         // Create a data buffer.
-        uint32_t totalSaveDataSize = GetYwTextureSaveDataSize(saveTextureData);
-        if (0 == totalSaveDataSize)
+        uint64_t totalSaveDataSize = GetYwTexture2SaveDataSize(saveTextureData);
+        if ((0 == totalSaveDataSize) || (totalSaveDataSize > 0xffffffff))
         {
             return false;
         }
 
-        uint8_t* saveData = new uint8_t[totalSaveDataSize];
-        bool convertResult = SaveYwTextureToData(saveTextureData, saveData, totalSaveDataSize);
+        uint8_t* saveData = new uint8_t[(size_t)totalSaveDataSize];
+        bool convertResult = SaveYwTexture2ToData(saveTextureData, saveData, totalSaveDataSize);
         if (!convertResult)
         {
             YW_SAFE_DELETE_ARRAY(saveData);
@@ -324,7 +424,71 @@ namespace yw
         }
 
         *resultData = saveData;
-        *resultDataLength = totalSaveDataSize;
+        *resultDataLength = (uint32_t)totalSaveDataSize;
+
+        return true;
+    }
+
+    bool YwTextureDataConverter::TextureDataToYWVT(Yw3dTexture* texture, uint32_t pageSize, uint8_t** resultData, uint32_t* resultDataLength)
+    {
+        if ((nullptr == texture) || (0 == texture->GetFormatFloats()) || (0 == pageSize) || (0 != (pageSize & (pageSize - 1))) || (nullptr == resultData) || (nullptr == resultDataLength))
+        {
+            return false;
+        }
+
+        const uint32_t pixelBytes = texture->GetFormatFloats() * sizeof(float);
+
+        YwVirtualTextureFileHeader header;
+        header.fileType = YWVT_FILE_MAGIC;
+        header.width = texture->GetWidth();
+        header.height = texture->GetHeight();
+        header.format = texture->GetFormat();
+        header.mipsCount = (uint8_t)texture->GetMipLevels();
+        header.pageSize = pageSize;
+        header.pageDataSize = pageSize * pageSize * pixelBytes;
+
+        // Create a data buffer, pixels of border pages outside the mip-level stay zero.
+        const uint64_t totalSaveDataSize = sizeof(YwVirtualTextureFileHeader) + (uint64_t)GetYwVirtualTexturePageCount(header) * header.pageDataSize;
+        if (totalSaveDataSize > 0xffffffff)
+        {
+            LOGE(_T("YwTextureDataConverter.TextureDataToYWVT: Texture is too large."));
+            return false;
+        }
+
+        uint8_t* saveData = new uint8_t[(size_t)totalSaveDataSize];
+        memset(saveData, 0, (size_t)totalSaveDataSize);
+        memcpy(saveData, &header, sizeof(YwVirtualTextureFileHeader));
+
+        for (uint32_t i = 0; i < header.mipsCount; i++)
+        {
+            const uint8_t* textureData = nullptr;
+            Yw3dResult resLock = texture->LockRect(i, (void**)&textureData, nullptr);
+            if (YW3D_FAILED(resLock))
+            {
+                YW_SAFE_DELETE_ARRAY(saveData);
+                return false;
+            }
+
+            // Copy the rows of the mip-level into the pages they belong to.
+            const uint32_t mipWidth = texture->GetWidth(i);
+            const uint32_t mipHeight = texture->GetHeight(i);
+            for (uint32_t y = 0; y < mipHeight; y++)
+            {
+                for (uint32_t pageX = 0; pageX < GetYwVirtualTexturePagesX(header, i); pageX++)
+                {
+                    const uint32_t x = pageX * pageSize;
+                    const uint32_t rowPixels = ((mipWidth - x) < pageSize) ? (mipWidth - x) : pageSize;
+                    uint8_t* pageRow = saveData + GetYwVirtualTexturePageOffset(header, i, pageX, y / pageSize) + (y % pageSize) * pageSize * pixelBytes;
+                    memcpy(pageRow, textureData + (y * mipWidth + x) * pixelBytes, rowPixels * pixelBytes);
+                }
+            }
+
+            // Unlock texture.
+            texture->UnlockRect(i);
+        }
+
+        *resultData = saveData;
+        *resultDataLength = (uint32_t)totalSaveDataSize;
 
         return true;
     }
@@ -483,6 +647,48 @@ namespace yw
         return true;
     }
 
+    bool YwTextureDataConverter::SaveTextureDataToYWVTFile(const StringA& fileName, Yw3dTexture* texture, uint32_t pageSize)
+    {
+        if (fileName.empty() || (nullptr == texture))
+        {
+            return false;
+        }
+
+        uint8_t* textureData = nullptr;
+        uint32_t textureDataLength = 0;
+        if (!TextureDataToYWVT(texture, pageSize, &textureData, &textureDataLength))
+        {
+            YW_SAFE_DELETE_ARRAY(textureData);
+            textureDataLength = 0;
+
+            return false;
+        }
+
+        // Get file names.
+        StringA filePath = Paths::GetFilePathA(fileName);
+        StringA filePureName = Paths::GetFileNameA(fileName);
+        StringA fileExt = Paths::GetFileExtensionA(fileName);
+        if (fileExt.empty() || ("ywvt" != fileExt))
+        {
+            fileExt = "ywvt";
+        }
+
+        FileIO file;
+        StringA fileSaveName = filePath + filePureName + "." + fileExt;
+        if (0 == file.WriteFile(fileSaveName, textureData, textureDataLength, false))
+        {
+            YW_SAFE_DELETE_ARRAY(textureData);
+            textureDataLength = 0;
+
+            return false;
+        }
+
+        YW_SAFE_DELETE_ARRAY(textureData);
+        textureDataLength = 0;
+
+        return true;
+    }
+
     bool YwTextureDataConverter::SaveCubeTextureDataToBMPFile(const StringA& fileName, Yw3dCubeTexture* cubeTexture, bool withMipmap)
     {
         if (fileName.empty() || (nullptr == cubeTexture))
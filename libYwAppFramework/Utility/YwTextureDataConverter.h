@@ -5,6 +5,7 @@
 #define __YW_TEXTURE_DATA_CONVERTER_H__
 
 #include "YwBase.h"
+#include "Yw3d.h"
 
 namespace yw
 {
@@ -50,13 +51,18 @@ namespace yw
         static bool TextureDataGammaCollect(class Yw3dTexture* texture, const float gammaPower);
         static bool CubeTextureDataGammaCollect(class Yw3dCubeTexture* texture, const float gammaPower);
 
+        static bool TextureDataCompress(class Yw3dTexture* texture, Yw3dFormat format, class Yw3dTexture** compressedTexture);
+        static bool CubeTextureDataCompress(class Yw3dCubeTexture* texture, Yw3dFormat format, class Yw3dCubeTexture** compressedTexture);
+
         static bool TextureDataToBMP(class Yw3dTexture* texture, TextureConvertResult& results, bool withMipmap);
         static bool TextureDataToRGBE(class Yw3dTexture* texture, TextureConvertResult& results, bool withMipmap);
         static bool TextureDataToYWT(class Yw3dTexture* texture, uint8_t** resultData, uint32_t* resultDataLength);
+        static bool TextureDataToYWVT(class Yw3dTexture* texture, uint32_t pageSize, uint8_t** resultData, uint32_t* resultDataLength);
 
         static bool SaveTextureDataToBMPFile(const StringA& fileName, class Yw3dTexture* texture, bool withMipmap);
         static bool SaveTextureDataToRGBEFile(const StringA& fileName, class Yw3dTexture* texture, bool withMipmap);
         static bool SaveTextureDataToYWTFile(const StringA& fileName, class Yw3dTexture* texture);
+        static bool SaveTextureDataToYWVTFile(const StringA& fileName, class Yw3dTexture* texture, uint32_t pageSize);
 
         static bool SaveCubeTextureDataToBMPFile(const StringA& fileName, class Yw3dCubeTexture* cubeTexture, bool withMipmap);
         static bool SaveCubeTextureDataToRGBEFile(const StringA& fileName, class Yw3dCubeTexture* cubeTexture, bool withMipmap);
@@ -29,6 +29,7 @@ solution "YwSoftRenderer"
 
     filter { "system:linux" }
         defines { "_LINUX" }
+        links { "pthread" }
 
    filter { "system:macosx" }
         defines { "_MAC_OSX" }
@@ -65,18 +66,28 @@ project "libYw3d"
         "libYw3d/Yw3dTypes.h",
         "libYw3d/YwBase.h",
 
+        "libYw3d/Core/Yw3dAllocator.h",
+        "libYw3d/Core/Yw3dAllocator.cpp",
         "libYw3d/Core/Yw3dBaseShader.h",
         "libYw3d/Core/Yw3dBaseShader.cpp",
         "libYw3d/Core/Yw3dBaseTexture.h",
         "libYw3d/Core/Yw3dBaseTexture.cpp",
+        "libYw3d/Core/Yw3dBlockCompression.h",
+        "libYw3d/Core/Yw3dBlockCompression.cpp",
+        "libYw3d/Core/Yw3dConstantBuffer.h",
+        "libYw3d/Core/Yw3dConstantBuffer.cpp",
         "libYw3d/Core/Yw3dCore.h",
         "libYw3d/Core/Yw3dCore.cpp",
+        "libYw3d/Core/Yw3dCpu.h",
+        "libYw3d/Core/Yw3dCpu.cpp",
         "libYw3d/Core/Yw3dCubeTexture.h",
         "libYw3d/Core/Yw3dCubeTexture.cpp",
         "libYw3d/Core/Yw3dDevice.h",
         "libYw3d/Core/Yw3dDevice.cpp",
         "libYw3d/Core/Yw3dIndexBuffer.h",
         "libYw3d/Core/Yw3dIndexBuffer.cpp",
+        "libYw3d/Core/Yw3dMipmap.h",
+        "libYw3d/Core/Yw3dMipmap.cpp",
         "libYw3d/Core/Yw3dPresentTarget.h",
         "libYw3d/Core/Yw3dPresentTarget.cpp",
         "libYw3d/Core/Yw3dPrimitiveAssembler.h",
@@ -84,21 +95,29 @@ project "libYw3d"
         "libYw3d/Core/Yw3dRenderTarget.cpp",
         "libYw3d/Core/Yw3dShader.h",
         "libYw3d/Core/Yw3dShader.cpp",
+        "libYw3d/Core/Yw3dShaderWide.h",
         "libYw3d/Core/Yw3dSurface.h",
         "libYw3d/Core/Yw3dSurface.cpp",
         "libYw3d/Core/Yw3dTexture.h",
         "libYw3d/Core/Yw3dTexture.cpp",
+        "libYw3d/Core/Yw3dTextureArray.h",
+        "libYw3d/Core/Yw3dTextureArray.cpp",
         "libYw3d/Core/Yw3dVertexBuffer.h",
         "libYw3d/Core/Yw3dVertexBuffer.cpp",
         "libYw3d/Core/Yw3dVertexFormat.h",
         "libYw3d/Core/Yw3dVertexFormat.cpp",
+        "libYw3d/Core/Yw3dVirtualTexture.h",
+        "libYw3d/Core/Yw3dVirtualTexture.cpp",
         "libYw3d/Core/Yw3dVolume.h",
         "libYw3d/Core/Yw3dVolume.cpp",
         "libYw3d/Core/Yw3dVolumeTexture.h",
         "libYw3d/Core/Yw3dVolumeTexture.cpp",
+        "libYw3d/Core/Yw3dWorkerPool.h",
+        "libYw3d/Core/Yw3dWorkerPool.cpp",
 
         "libYw3d/Math/YwMath.h",
         "libYw3d/Math/YwMathBaseDefine.h",
+        "libYw3d/Math/YwMathFast.h",
         "libYw3d/Math/YwMathMatrix.h",
         "libYw3d/Math/YwMathMatrix.inl",
         "libYw3d/Math/YwMathPlane.h",
@@ -190,6 +209,8 @@ project "libYwAppFramework"
         "libYwAppFramework/Resource/YwModelLoaderWavefrontObj.cpp",
         "libYwAppFramework/Resource/YwTextureLoader.h",
         "libYwAppFramework/Resource/YwTextureLoader.cpp",
+        "libYwAppFramework/Resource/YwTextureLoaderArray.h",
+        "libYwAppFramework/Resource/YwTextureLoaderArray.cpp",
         "libYwAppFramework/Resource/YwTextureLoaderBMP.h",
         "libYwAppFramework/Resource/YwTextureLoaderBMP.cpp",
         "libYwAppFramework/Resource/YwTextureLoaderCube.h",